@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Network topology
+//
+//       n0 ----------- n1
+//           1 Gbps
+//           50 ms
+//
+// This program benchmarks the SACK processing of TCP on a path with a large
+// bandwidth-delay product: a BulkSendApplication on n0 sends to n1 through a
+// link that drops packets at random, with buffers large enough to keep
+// thousands of segments in flight, so every ACK received during the recoveries
+// updates a large scoreboard in the TcpTxBuffer of the sender.
+//
+// The program reports the wall-clock time of the simulation, the number of
+// events executed, the goodput of the flow and the number of bytes the
+// receive buffer of n1 concatenated when delivering the data to the sink:
+//
+//   ./ns3 run "tcp-high-bdp-benchmark --errorRate=0.0001 --duration=20"
+//
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpHighBdpBenchmark");
+
+int
+main(int argc, char* argv[])
+{
+    std::string dataRate = "1Gbps";
+    std::string delay = "50ms";
+    double errorRate = 0.0001;
+    double duration = 10;
+    uint32_t segmentSize = 1448;
+    uint32_t bufferSize = 64 << 20;
+    bool sack = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("dataRate", "Data rate of the link", dataRate);
+    cmd.AddValue("delay", "One-way delay of the link", delay);
+    cmd.AddValue("errorRate", "Packet error rate of the link", errorRate);
+    cmd.AddValue("duration", "Duration of the transfer in seconds", duration);
+    cmd.AddValue("segmentSize", "TCP segment size", segmentSize);
+    cmd.AddValue("bufferSize", "Size of the TCP send and receive buffers", bufferSize);
+    cmd.AddValue("sack", "Enable or disable SACK", sack);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(segmentSize));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(bufferSize));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(bufferSize));
+    Config::SetDefault("ns3::TcpSocket::InitialCwnd", UintegerValue(10));
+    Config::SetDefault("ns3::TcpSocketBase::Sack", BooleanValue(sack));
+    Config::SetDefault("ns3::TcpSocketBase::WindowScaling", BooleanValue(true));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue(dataRate));
+    pointToPoint.SetChannelAttribute("Delay", StringValue(delay));
+    NetDeviceContainer devices = pointToPoint.Install(nodes);
+
+    Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+    errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    errorModel->SetRate(errorRate);
+    errorModel->AssignStreams(1);
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    uint16_t port = 9;
+    BulkSendHelper source("ns3::TcpSocketFactory",
+                          InetSocketAddress(interfaces.GetAddress(1), port));
+    source.SetAttribute("SendSize", UintegerValue(segmentSize));
+    ApplicationContainer sourceApps = source.Install(nodes.Get(0));
+    sourceApps.Start(Seconds(0.0));
+    sourceApps.Stop(Seconds(duration));
+
+    PacketSinkHelper sink("ns3::TcpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApps = sink.Install(nodes.Get(1));
+    sinkApps.Start(Seconds(0.0));
+    sinkApps.Stop(Seconds(duration));
+
+    Simulator::Stop(Seconds(duration));
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double wallClock =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Ptr<PacketSink> packetSink = DynamicCast<PacketSink>(sinkApps.Get(0));
+    uint64_t received = packetSink->GetTotalRx();
+
+    std::cout << dataRate << ", " << delay << " one-way delay, packet error rate " << errorRate
+              << ", SACK " << (sack ? "enabled" : "disabled") << std::endl;
+    std::cout << "wall-clock time: " << wallClock << " s for " << duration
+              << " s of simulated time" << std::endl;
+    std::cout << "events executed: " << Simulator::GetEventCount() << " ("
+              << Simulator::GetEventCount() / wallClock << " events/s)" << std::endl;
+    std::cout << "goodput: " << received * 8 / duration / 1e6 << " Mbps (" << received
+              << " bytes received)" << std::endl;
+    for (const auto& socket : packetSink->GetAcceptedSockets())
+    {
+        Ptr<TcpRxBuffer> rxBuffer = DynamicCast<TcpSocketBase>(socket)->GetRxBuffer();
+        std::cout << "receive buffer: " << rxBuffer->GetExtractedBytes() << " bytes extracted, "
+                  << rxBuffer->GetCopiedBytes() << " bytes copied" << std::endl;
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Network topology
+//
+//       n0 ----------- n1
+//           10 Gbps
+//           1 ms
+//           1500 bytes MTU
+//
+// This program benchmarks the IPv4 fragmentation and reassembly: a UdpClient
+// on n0 sends datagrams of 64 KB to a UdpServer on n1, hence every datagram
+// is split into 45 fragments by n0 and reassembled by n1. The link may drop
+// packets at random, in which case the datagrams missing a fragment expire
+// in the reassembly buffer of n1.
+//
+// The program reports the wall-clock time of the simulation, the number of
+// events executed, the datagrams received and the expired ones:
+//
+//   ./ns3 run "udp-fragmentation-benchmark --errorRate=0.001 --duration=2 --fragmentTimeout=1"
+//
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("UdpFragmentationBenchmark");
+
+/// Number of datagrams expired in the reassembly buffer
+static uint32_t g_expired = 0;
+
+/**
+ * Count the datagrams expired in the reassembly buffer.
+ *
+ * \param header The IPv4 header of the datagram.
+ * \param packet The partial datagram.
+ * \param reason The reason of the drop.
+ * \param ipv4 The IPv4 protocol.
+ * \param interface The interface index.
+ */
+static void
+Drop(const Ipv4Header& header,
+     Ptr<const Packet> packet,
+     Ipv4L3Protocol::DropReason reason,
+     Ptr<Ipv4> ipv4,
+     uint32_t interface)
+{
+    if (reason == Ipv4L3Protocol::DROP_FRAGMENT_TIMEOUT)
+    {
+        g_expired++;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string dataRate = "10Gbps";
+    std::string delay = "1ms";
+    uint32_t mtu = 1500;
+    uint32_t datagramSize = 65507;
+    double errorRate = 0;
+    double duration = 1;
+    double fragmentTimeout = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("dataRate", "Data rate of the link", dataRate);
+    cmd.AddValue("delay", "One-way delay of the link", delay);
+    cmd.AddValue("mtu", "MTU of the link", mtu);
+    cmd.AddValue("datagramSize", "Size of the UDP payload of the datagrams", datagramSize);
+    cmd.AddValue("errorRate", "Packet error rate of the link", errorRate);
+    cmd.AddValue("duration", "Duration of the transfer in seconds", duration);
+    cmd.AddValue("fragmentTimeout", "Reassembly timeout in seconds", fragmentTimeout);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::Ipv4L3Protocol::FragmentExpirationTimeout",
+                       TimeValue(Seconds(fragmentTimeout)));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue(dataRate));
+    pointToPoint.SetDeviceAttribute("Mtu", UintegerValue(mtu));
+    pointToPoint.SetChannelAttribute("Delay", StringValue(delay));
+    NetDeviceContainer devices = pointToPoint.Install(nodes);
+
+    Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+    errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    errorModel->SetRate(errorRate);
+    errorModel->AssignStreams(1);
+    devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    nodes.Get(1)->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext("Drop",
+                                                                          MakeCallback(&Drop));
+
+    // Send at the rate of the link, including the headers of the fragments
+    uint32_t fragments = (datagramSize + 8 + (mtu - 20) / 8 * 8 - 1) / ((mtu - 20) / 8 * 8);
+    uint32_t frameSize = datagramSize + 8 + fragments * (20 + 2);
+    Time interval = DataRate(dataRate).CalculateBytesTxTime(frameSize);
+
+    uint16_t port = 9;
+    UdpServerHelper server(port);
+    ApplicationContainer serverApps = server.Install(nodes.Get(1));
+    serverApps.Start(Seconds(0.0));
+    serverApps.Stop(Seconds(duration + fragmentTimeout + 1));
+
+    UdpClientHelper client(interfaces.GetAddress(1), port);
+    client.SetAttribute("MaxPackets", UintegerValue(std::numeric_limits<uint32_t>::max()));
+    client.SetAttribute("Interval", TimeValue(interval));
+    client.SetAttribute("PacketSize", UintegerValue(datagramSize));
+    ApplicationContainer clientApps = client.Install(nodes.Get(0));
+    clientApps.Start(Seconds(0.0));
+    clientApps.Stop(Seconds(duration));
+
+    // Leave the time for the last datagrams to expire
+    Simulator::Stop(Seconds(duration + fragmentTimeout + 1));
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double wallClock =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Ptr<UdpServer> udpServer = DynamicCast<UdpServer>(serverApps.Get(0));
+
+    std::cout << dataRate << ", " << delay << " one-way delay, " << mtu << " bytes MTU, "
+              << datagramSize << " bytes datagrams (" << fragments
+              << " fragments), packet error rate " << errorRate << std::endl;
+    std::cout << "wall-clock time: " << wallClock << " s for " << duration
+              << " s of simulated time" << std::endl;
+    std::cout << "events executed: " << Simulator::GetEventCount() << " ("
+              << Simulator::GetEventCount() / wallClock << " events/s)" << std::endl;
+    std::cout << "datagrams received: " << udpServer->GetReceived() << " ("
+              << udpServer->GetReceived() / wallClock << " datagrams/s), expired: " << g_expired
+              << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
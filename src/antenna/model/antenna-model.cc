@@ -46,4 +46,17 @@ AntennaModel::GetTypeId()
     return tid;
 }
 
+uint64_t
+AntennaModel::GetConfigurationVersion() const
+{
+    return m_configurationVersion;
+}
+
+void
+AntennaModel::NotifyConfigurationChanged()
+{
+    NS_LOG_FUNCTION(this);
+    m_configurationVersion++;
+}
+
 } // namespace ns3
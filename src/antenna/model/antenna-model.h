@@ -75,6 +75,27 @@ class AntennaModel : public Object
      * the antenna is expected to be included in the gain value.
      */
     virtual double GetGainDb(Angles a) = 0;
+
+    /**
+     * Get the version of the configuration of the antenna, which is incremented
+     * each time the radiation pattern is reconfigured (e.g., an attribute is set).
+     * This allows the users of the antenna to detect if the quantities they
+     * derived from the radiation pattern are outdated.
+     *
+     * \return the version of the configuration of the antenna
+     */
+    uint64_t GetConfigurationVersion() const;
+
+  protected:
+    /**
+     * Notify that the radiation pattern of the antenna has been reconfigured.
+     * This method is expected to be called by the subclasses whenever a parameter
+     * the radiation pattern depends on is changed.
+     */
+    void NotifyConfigurationChanged();
+
+  private:
+    uint64_t m_configurationVersion{0}; //!< the version of the configuration of the antenna
 };
 
 } // namespace ns3
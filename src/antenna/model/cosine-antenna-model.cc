@@ -66,7 +66,8 @@ CosineAntennaModel::GetTypeId()
             .AddAttribute("MaxGain",
                           "The gain (dB) at the antenna boresight (the direction of maximum gain)",
                           DoubleValue(0.0),
-                          MakeDoubleAccessor(&CosineAntennaModel::m_maxGain),
+                          MakeDoubleAccessor(&CosineAntennaModel::SetMaxGain,
+                                             &CosineAntennaModel::GetMaxGain),
                           MakeDoubleChecker<double>());
     return tid;
 }
@@ -111,6 +112,7 @@ CosineAntennaModel::SetVerticalBeamwidth(double verticalBeamwidthDegrees)
 {
     NS_LOG_FUNCTION(this << verticalBeamwidthDegrees);
     m_verticalExponent = GetExponentFromBeamwidth(verticalBeamwidthDegrees);
+    NotifyConfigurationChanged();
 }
 
 void
@@ -118,6 +120,7 @@ CosineAntennaModel::SetHorizontalBeamwidth(double horizontalBeamwidthDegrees)
 {
     NS_LOG_FUNCTION(this << horizontalBeamwidthDegrees);
     m_horizontalExponent = GetExponentFromBeamwidth(horizontalBeamwidthDegrees);
+    NotifyConfigurationChanged();
 }
 
 double
@@ -137,6 +140,7 @@ CosineAntennaModel::SetOrientation(double orientationDegrees)
 {
     NS_LOG_FUNCTION(this << orientationDegrees);
     m_orientationRadians = DegreesToRadians(orientationDegrees);
+    NotifyConfigurationChanged();
 }
 
 double
@@ -145,6 +149,20 @@ CosineAntennaModel::GetOrientation() const
     return RadiansToDegrees(m_orientationRadians);
 }
 
+void
+CosineAntennaModel::SetMaxGain(double maxGainDb)
+{
+    NS_LOG_FUNCTION(this << maxGainDb);
+    m_maxGain = maxGainDb;
+    NotifyConfigurationChanged();
+}
+
+double
+CosineAntennaModel::GetMaxGain() const
+{
+    return m_maxGain;
+}
+
 double
 CosineAntennaModel::GetGainDb(Angles a)
 {
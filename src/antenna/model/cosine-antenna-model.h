@@ -77,6 +77,12 @@ class CosineAntennaModel : public AntennaModel
      */
     double GetOrientation() const;
 
+    /**
+     * Get the gain of the antenna element towards the main orientation.
+     * \return the maximum gain in dB
+     */
+    double GetMaxGain() const;
+
   private:
     /**
      * Set the vertical 3 dB beamwidth (bilateral) of the cosine antenna model.
@@ -96,6 +102,12 @@ class CosineAntennaModel : public AntennaModel
      */
     void SetOrientation(double orientationDegrees);
 
+    /**
+     * Set the gain of the antenna element towards the main orientation.
+     * \param maxGainDb the maximum gain in dB
+     */
+    void SetMaxGain(double maxGainDb);
+
     /**
      * Compute the exponent of the cosine antenna model from the beamwidth
      * \param beamwidthDegrees the beamwidth in degrees
@@ -42,7 +42,8 @@ IsotropicAntennaModel::GetTypeId()
                             .AddAttribute("Gain",
                                           "The gain of the antenna in dB",
                                           DoubleValue(0),
-                                          MakeDoubleAccessor(&IsotropicAntennaModel::m_gainDb),
+                                          MakeDoubleAccessor(&IsotropicAntennaModel::SetGain,
+                                                             &IsotropicAntennaModel::GetGain),
                                           MakeDoubleChecker<double>());
     return tid;
 }
@@ -52,6 +53,20 @@ IsotropicAntennaModel::IsotropicAntennaModel()
     NS_LOG_FUNCTION(this);
 }
 
+void
+IsotropicAntennaModel::SetGain(double gainDb)
+{
+    NS_LOG_FUNCTION(this << gainDb);
+    m_gainDb = gainDb;
+    NotifyConfigurationChanged();
+}
+
+double
+IsotropicAntennaModel::GetGain() const
+{
+    return m_gainDb;
+}
+
 double
 IsotropicAntennaModel::GetGainDb(Angles a)
 {
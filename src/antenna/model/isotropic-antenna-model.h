@@ -48,6 +48,18 @@ class IsotropicAntennaModel : public AntennaModel
     // inherited from AntennaModel
     double GetGainDb(Angles a) override;
 
+    /**
+     * Set the gain of the antenna
+     * \param gainDb the gain in dB, in all directions
+     */
+    void SetGain(double gainDb);
+
+    /**
+     * Get the gain of the antenna
+     * \return the gain in dB, in all directions
+     */
+    double GetGain() const;
+
   protected:
     /**
      * gain of the antenna in dB, in all directions
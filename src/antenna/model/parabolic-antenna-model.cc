@@ -58,7 +58,8 @@ ParabolicAntennaModel::GetTypeId()
             .AddAttribute("MaxAttenuation",
                           "The maximum attenuation (dB) of the antenna radiation pattern.",
                           DoubleValue(20.0),
-                          MakeDoubleAccessor(&ParabolicAntennaModel::m_maxAttenuation),
+                          MakeDoubleAccessor(&ParabolicAntennaModel::SetMaxAttenuation,
+                                             &ParabolicAntennaModel::GetMaxAttenuation),
                           MakeDoubleChecker<double>());
     return tid;
 }
@@ -68,6 +69,7 @@ ParabolicAntennaModel::SetBeamwidth(double beamwidthDegrees)
 {
     NS_LOG_FUNCTION(this << beamwidthDegrees);
     m_beamwidthRadians = DegreesToRadians(beamwidthDegrees);
+    NotifyConfigurationChanged();
 }
 
 double
@@ -81,6 +83,7 @@ ParabolicAntennaModel::SetOrientation(double orientationDegrees)
 {
     NS_LOG_FUNCTION(this << orientationDegrees);
     m_orientationRadians = DegreesToRadians(orientationDegrees);
+    NotifyConfigurationChanged();
 }
 
 double
@@ -89,6 +92,20 @@ ParabolicAntennaModel::GetOrientation() const
     return RadiansToDegrees(m_orientationRadians);
 }
 
+void
+ParabolicAntennaModel::SetMaxAttenuation(double maxAttenuationDb)
+{
+    NS_LOG_FUNCTION(this << maxAttenuationDb);
+    m_maxAttenuation = maxAttenuationDb;
+    NotifyConfigurationChanged();
+}
+
+double
+ParabolicAntennaModel::GetMaxAttenuation() const
+{
+    return m_maxAttenuation;
+}
+
 double
 ParabolicAntennaModel::GetGainDb(Angles a)
 {
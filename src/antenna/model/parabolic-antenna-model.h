@@ -76,6 +76,16 @@ class ParabolicAntennaModel : public AntennaModel
      * \return antenna orientation in degrees
      */
     double GetOrientation() const;
+    /**
+     * Set the maximum attenuation of the antenna radiation pattern
+     * \param maxAttenuationDb the maximum attenuation in dB
+     */
+    void SetMaxAttenuation(double maxAttenuationDb);
+    /**
+     * Get the maximum attenuation of the antenna radiation pattern
+     * \return the maximum attenuation in dB
+     */
+    double GetMaxAttenuation() const;
 
   private:
     double m_beamwidthRadians;   //!< Beam width in radians
@@ -134,15 +134,17 @@ PhasedArrayModel::GetBeamformingVector(Angles a) const
 PhasedArrayModel::ComplexVector
 PhasedArrayModel::GetSteeringVector(Angles a) const
 {
+    // the direction cosines do not depend on the antenna element
+    double dirX = sin(a.GetInclination()) * cos(a.GetAzimuth());
+    double dirY = sin(a.GetInclination()) * sin(a.GetAzimuth());
+    double dirZ = cos(a.GetInclination());
+
     ComplexVector steeringVector;
     steeringVector.resize(GetNumberOfElements());
     for (uint64_t i = 0; i < GetNumberOfElements(); i++)
     {
         Vector loc = GetElementLocation(i);
-        double phase = -2 * M_PI *
-                       (sin(a.GetInclination()) * cos(a.GetAzimuth()) * loc.x +
-                        sin(a.GetInclination()) * sin(a.GetAzimuth()) * loc.y +
-                        cos(a.GetInclination()) * loc.z);
+        double phase = -2 * M_PI * (dirX * loc.x + dirY * loc.y + dirZ * loc.z);
         steeringVector[i] = std::polar<double>(1.0, phase);
     }
     return steeringVector;
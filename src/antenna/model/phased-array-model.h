@@ -103,7 +103,7 @@ class PhasedArrayModel : public Object
      * \param a the steering angle
      * \return the steering vector
      */
-    ComplexVector GetSteeringVector(Angles a) const;
+    virtual ComplexVector GetSteeringVector(Angles a) const;
 
     /**
      * Sets the antenna model to be used
@@ -21,15 +21,54 @@
 #include <ns3/boolean.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
+#include <ns3/pointer.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("UniformPlanarArray");
 
+NS_OBJECT_ENSURE_REGISTERED(FieldPatternTableCache);
 NS_OBJECT_ENSURE_REGISTERED(UniformPlanarArray);
 
+TypeId
+FieldPatternTableCache::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::FieldPatternTableCache")
+                            .SetParent<Object>()
+                            .AddConstructor<FieldPatternTableCache>()
+                            .SetGroupName("Antenna");
+    return tid;
+}
+
+Ptr<const FieldPatternTableCache::Table>
+FieldPatternTableCache::GetTable(const std::string& key) const
+{
+    auto it = m_tables.find(key);
+    return (it != m_tables.end() ? it->second : nullptr);
+}
+
+void
+FieldPatternTableCache::AddTable(const std::string& key, Ptr<const Table> table)
+{
+    NS_LOG_FUNCTION(this << key);
+    m_tables[key] = table;
+}
+
+void
+FieldPatternTableCache::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_tables.clear();
+    Object::DoDispose();
+}
+
 UniformPlanarArray::UniformPlanarArray()
     : PhasedArrayModel()
 {
@@ -86,7 +125,22 @@ UniformPlanarArray::GetTypeId()
                           "The polarization slant angle in radians",
                           DoubleValue(0.0),
                           MakeDoubleAccessor(&UniformPlanarArray::SetPolSlant),
-                          MakeDoubleChecker<double>(-M_PI, M_PI));
+                          MakeDoubleChecker<double>(-M_PI, M_PI))
+            .AddAttribute("LookupTableResolution",
+                          "If not zero, the resolution in radians of the grid of angles over "
+                          "which the field pattern of the antenna elements is tabulated and "
+                          "then interpolated. If zero, the field pattern is computed for each "
+                          "direction.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&UniformPlanarArray::SetLookupTableResolution),
+                          MakeDoubleChecker<double>(0.0, M_PI))
+            .AddAttribute("FieldPatternTableCache",
+                          "If not null, the cache through which the field pattern tables are "
+                          "shared with the other arrays using the same cache.",
+                          PointerValue(),
+                          MakePointerAccessor(&UniformPlanarArray::SetFieldPatternTableCache,
+                                              &UniformPlanarArray::GetFieldPatternTableCache),
+                          MakePointerChecker<FieldPatternTableCache>());
     return tid;
 }
 
@@ -130,6 +184,7 @@ UniformPlanarArray::SetAlpha(double alpha)
     m_alpha = alpha;
     m_cosAlpha = cos(m_alpha);
     m_sinAlpha = sin(m_alpha);
+    m_fieldPatternTable = nullptr;
 }
 
 void
@@ -138,6 +193,7 @@ UniformPlanarArray::SetBeta(double beta)
     m_beta = beta;
     m_cosBeta = cos(m_beta);
     m_sinBeta = sin(m_beta);
+    m_fieldPatternTable = nullptr;
 }
 
 void
@@ -146,6 +202,29 @@ UniformPlanarArray::SetPolSlant(double polSlant)
     m_polSlant = polSlant;
     m_cosPolSlant = cos(m_polSlant);
     m_sinPolSlant = sin(m_polSlant);
+    m_fieldPatternTable = nullptr;
+}
+
+void
+UniformPlanarArray::SetLookupTableResolution(double resolution)
+{
+    NS_LOG_FUNCTION(this << resolution);
+    m_tableResolution = resolution;
+    m_fieldPatternTable = nullptr;
+}
+
+void
+UniformPlanarArray::SetFieldPatternTableCache(Ptr<FieldPatternTableCache> cache)
+{
+    NS_LOG_FUNCTION(this << cache);
+    m_tableCache = cache;
+    m_fieldPatternTable = nullptr;
+}
+
+Ptr<FieldPatternTableCache>
+UniformPlanarArray::GetFieldPatternTableCache() const
+{
+    return m_tableCache;
 }
 
 void
@@ -191,6 +270,116 @@ UniformPlanarArray::GetElementFieldPattern(Angles a) const
 {
     NS_LOG_FUNCTION(this << a);
 
+    if (m_tableResolution == 0)
+    {
+        return ComputeElementFieldPattern(a);
+    }
+
+    Ptr<const FieldPatternTable> table = GetFieldPatternTable();
+
+    // bilinear interpolation between the four closest points of the grid
+    double x = std::clamp((a.GetAzimuth() + M_PI) / table->m_azimuthStep,
+                          0.0,
+                          table->m_numAzimuths - 1.0);
+    double y = std::clamp(a.GetInclination() / table->m_inclinationStep,
+                          0.0,
+                          table->m_numInclinations - 1.0);
+    uint32_t i = std::min(static_cast<uint32_t>(x), table->m_numAzimuths - 2);
+    uint32_t j = std::min(static_cast<uint32_t>(y), table->m_numInclinations - 2);
+    double dx = x - i;
+    double dy = y - j;
+
+    const auto* values = table->m_values.data() + i * table->m_numInclinations + j;
+    const auto& v00 = values[0];
+    const auto& v01 = values[1];
+    const auto& v10 = values[table->m_numInclinations];
+    const auto& v11 = values[table->m_numInclinations + 1];
+    double fieldPhi = (1 - dx) * ((1 - dy) * v00.first + dy * v01.first) +
+                      dx * ((1 - dy) * v10.first + dy * v11.first);
+    double fieldTheta = (1 - dx) * ((1 - dy) * v00.second + dy * v01.second) +
+                        dx * ((1 - dy) * v10.second + dy * v11.second);
+    return std::make_pair(fieldPhi, fieldTheta);
+}
+
+std::string
+UniformPlanarArray::GetFieldPatternTableKey() const
+{
+    std::ostringstream key;
+    key << std::setprecision(17) << m_tableResolution << " " << m_alpha << " " << m_beta << " "
+        << m_polSlant << " " << m_antennaElement->GetInstanceTypeId().GetName();
+    for (TypeId tid = m_antennaElement->GetInstanceTypeId(); tid != Object::GetTypeId();
+         tid = tid.GetParent())
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(i);
+            if ((info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter())
+            {
+                Ptr<AttributeValue> value = info.checker->Create();
+                m_antennaElement->GetAttribute(info.name, *value);
+                key << " " << info.name << "=" << value->SerializeToString(info.checker);
+            }
+        }
+    }
+    return key.str();
+}
+
+Ptr<const UniformPlanarArray::FieldPatternTable>
+UniformPlanarArray::GetFieldPatternTable() const
+{
+    // the table is reset when the array is reconfigured, while the antenna element
+    // may have been replaced or reconfigured since the table was computed
+    if (m_fieldPatternTable && m_tableElement == m_antennaElement &&
+        m_tableElementVersion == m_antennaElement->GetConfigurationVersion())
+    {
+        return m_fieldPatternTable;
+    }
+
+    NS_LOG_FUNCTION(this);
+    m_tableElement = m_antennaElement;
+    m_tableElementVersion = m_antennaElement->GetConfigurationVersion();
+
+    std::string key;
+    if (m_tableCache)
+    {
+        key = GetFieldPatternTableKey();
+        m_fieldPatternTable = m_tableCache->GetTable(key);
+        if (m_fieldPatternTable)
+        {
+            return m_fieldPatternTable;
+        }
+    }
+
+    NS_LOG_DEBUG("Computing the field pattern table for " << key);
+    Ptr<FieldPatternTable> table = Create<FieldPatternTable>();
+    table->m_numAzimuths = static_cast<uint32_t>(std::ceil(2 * M_PI / m_tableResolution)) + 1;
+    table->m_numInclinations = static_cast<uint32_t>(std::ceil(M_PI / m_tableResolution)) + 1;
+    table->m_azimuthStep = 2 * M_PI / (table->m_numAzimuths - 1);
+    table->m_inclinationStep = M_PI / (table->m_numInclinations - 1);
+    table->m_values.reserve(table->m_numAzimuths * table->m_numInclinations);
+    for (uint32_t i = 0; i < table->m_numAzimuths; i++)
+    {
+        for (uint32_t j = 0; j < table->m_numInclinations; j++)
+        {
+            double azimuth = std::min(-M_PI + i * table->m_azimuthStep, M_PI);
+            double inclination = std::min(j * table->m_inclinationStep, M_PI);
+            table->m_values.push_back(ComputeElementFieldPattern(Angles(azimuth, inclination)));
+        }
+    }
+
+    if (m_tableCache)
+    {
+        m_tableCache->AddTable(key, table);
+    }
+    m_fieldPatternTable = table;
+    return m_fieldPatternTable;
+}
+
+std::pair<double, double>
+UniformPlanarArray::ComputeElementFieldPattern(Angles a) const
+{
+    NS_LOG_FUNCTION(this << a);
+
     // convert the theta and phi angles from GCS to LCS using eq. 7.1-7 and 7.1-8 in 3GPP TR 38.901
     // NOTE we assume a fixed slant angle of 0 degrees
     double cosIncl = cos(a.GetInclination());
@@ -256,4 +445,42 @@ UniformPlanarArray::GetNumberOfElements() const
     return m_numRows * m_numColumns;
 }
 
+PhasedArrayModel::ComplexVector
+UniformPlanarArray::GetSteeringVector(Angles a) const
+{
+    if (m_tableResolution == 0)
+    {
+        return PhasedArrayModel::GetSteeringVector(a);
+    }
+
+    // the location of the element in row r and column c is c * h + r * v, where
+    // h (v) is the location of the element in row 0 (1) and column 1 (0), hence
+    // the phase of the element is the sum of the phase shifts between adjacent
+    // columns and between adjacent rows, multiplied by c and r, respectively
+    double dirX = sin(a.GetInclination()) * cos(a.GetAzimuth());
+    double dirY = sin(a.GetInclination()) * sin(a.GetAzimuth());
+    double dirZ = cos(a.GetInclination());
+    Vector h = GetElementLocation(1 % m_numColumns);
+    Vector v = GetElementLocation(m_numRows > 1 ? m_numColumns : 0);
+    double columnPhase = -2 * M_PI * (dirX * h.x + dirY * h.y + dirZ * h.z);
+    double rowPhase = -2 * M_PI * (dirX * v.x + dirY * v.y + dirZ * v.z);
+
+    ComplexVector columnShifts(m_numColumns);
+    for (uint32_t c = 0; c < m_numColumns; c++)
+    {
+        columnShifts[c] = std::polar<double>(1.0, c * columnPhase);
+    }
+
+    ComplexVector steeringVector(GetNumberOfElements());
+    for (uint32_t r = 0; r < m_numRows; r++)
+    {
+        std::complex<double> rowShift = std::polar<double>(1.0, r * rowPhase);
+        for (uint32_t c = 0; c < m_numColumns; c++)
+        {
+            steeringVector[r * m_numColumns + c] = rowShift * columnShifts[c];
+        }
+    }
+    return steeringVector;
+}
+
 } /* namespace ns3 */
@@ -22,9 +22,72 @@
 #include <ns3/object.h>
 #include <ns3/phased-array-model.h>
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
+/**
+ * \ingroup antenna
+ *
+ * \brief Cache of the field pattern tables of the antenna elements of uniform
+ * planar arrays
+ *
+ * The arrays configured with the same cache (through their FieldPatternTableCache
+ * attribute) share the field pattern tables computed for the same configuration,
+ * i.e., the same orientation, polarization slant angle, table resolution and
+ * antenna element type and attribute values. The tables are released when the
+ * cache is disposed of, the arrays keeping the tables they use.
+ */
+class FieldPatternTableCache : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * The field pattern of the antenna elements sampled over a grid of azimuth
+     * and inclination angles
+     */
+    struct Table : public SimpleRefCount<Table>
+    {
+        uint32_t m_numAzimuths{0};     //!< number of azimuth values, from -pi to pi
+        uint32_t m_numInclinations{0}; //!< number of inclination values, from 0 to pi
+        double m_azimuthStep{0};       //!< step between azimuth values (radians)
+        double m_inclinationStep{0};   //!< step between inclination values (radians)
+        std::vector<std::pair<double, double>>
+            m_values; //!< the (horizontal, vertical) components of the field pattern, the
+                      //!< value at azimuth index i and inclination index j being at position
+                      //!< i * m_numInclinations + j
+    };
+
+    /**
+     * Get the table computed for the given configuration
+     * \param key the key identifying the configuration
+     * \return the table, or a null pointer if no table has been added for the key
+     */
+    Ptr<const Table> GetTable(const std::string& key) const;
+
+    /**
+     * Add the table computed for the given configuration
+     * \param key the key identifying the configuration
+     * \param table the table
+     */
+    void AddTable(const std::string& key, Ptr<const Table> table);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    std::map<std::string, Ptr<const Table>> m_tables; //!< the tables, by configuration key
+};
+
 /**
  * \ingroup antenna
  *
@@ -32,6 +95,17 @@ namespace ns3
  *
  * \note the current implementation supports the modeling of antenna arrays
  * composed of a single panel and with single (configured) polarization.
+ *
+ * If the LookupTableResolution attribute is not zero, the field pattern of the
+ * antenna elements is bilinearly interpolated from its values over a grid of
+ * azimuth and inclination angles with the given resolution, rather than computed
+ * for each direction. The table is computed at the first query, and recomputed
+ * only if the array is reoriented or the antenna element is replaced or
+ * reconfigured (see AntennaModel::GetConfigurationVersion). The arrays sharing
+ * a FieldPatternTableCache also share the tables computed for the same
+ * configuration. Also, the steering vectors are computed from the phase shifts
+ * between adjacent columns and adjacent rows of the array, rather than from the
+ * location of each element.
  */
 class UniformPlanarArray : public PhasedArrayModel
 {
@@ -84,7 +158,62 @@ class UniformPlanarArray : public PhasedArrayModel
      */
     uint64_t GetNumberOfElements() const override;
 
+    /**
+     * Returns the steering vector that points toward the specified position
+     * \param a the steering angle
+     * \return the steering vector
+     */
+    ComplexVector GetSteeringVector(Angles a) const override;
+
   private:
+    /// the field pattern table
+    using FieldPatternTable = FieldPatternTableCache::Table;
+
+    /**
+     * Compute the horizontal and vertical components of the antenna element field
+     * pattern at the specified direction.
+     * \param a the angle indicating the interested direction
+     * \return a pair in which the first element is the horizontal component
+     *         of the field pattern and the second element is the vertical
+     *         component of the field pattern
+     */
+    std::pair<double, double> ComputeElementFieldPattern(Angles a) const;
+
+    /**
+     * Get the key identifying the configuration of the array the field pattern
+     * table depends on, i.e., the orientation and the polarization slant angle of
+     * the array, the resolution of the table, and the type and the attribute
+     * values of the antenna element, used to look up the table in the cache.
+     * \return the key of the field pattern table
+     */
+    std::string GetFieldPatternTableKey() const;
+
+    /**
+     * Get the field pattern table for the current configuration of the array.
+     * The table in use is returned unless the array or its antenna element have
+     * been reconfigured since it was computed. Otherwise, the table is taken from
+     * the cache, if any, or computed.
+     * \return the field pattern table
+     */
+    Ptr<const FieldPatternTable> GetFieldPatternTable() const;
+
+    /**
+     * Set the resolution of the field pattern table
+     * \param resolution the resolution in radians, or zero to disable the table
+     */
+    void SetLookupTableResolution(double resolution);
+
+    /**
+     * Set the cache of the field pattern tables
+     * \param cache the cache, or a null pointer to not share the tables
+     */
+    void SetFieldPatternTableCache(Ptr<FieldPatternTableCache> cache);
+
+    /**
+     * Get the cache of the field pattern tables
+     * \return the cache, or a null pointer if the tables are not shared
+     */
+    Ptr<FieldPatternTableCache> GetFieldPatternTableCache() const;
     /**
      * Set the number of columns of the phased array
      * This method resets the stored beamforming vector to a ComplexVector
@@ -178,6 +307,12 @@ class UniformPlanarArray : public PhasedArrayModel
     double m_polSlant{0.0};    //!< the polarization slant angle in radians
     double m_cosPolSlant{1.0}; //!< the cosine of polarization slant angle
     double m_sinPolSlant{0.0}; //!< the sine polarization slant angle
+
+    double m_tableResolution{0.0};                            //!< resolution of the table (rad)
+    Ptr<FieldPatternTableCache> m_tableCache;                 //!< the cache of the tables
+    mutable Ptr<const FieldPatternTable> m_fieldPatternTable; //!< the field pattern table
+    mutable Ptr<const AntennaModel> m_tableElement; //!< the antenna element of the table
+    mutable uint64_t m_tableElementVersion{0}; //!< the configuration version of m_tableElement
 };
 
 } /* namespace ns3 */
@@ -204,6 +204,150 @@ UniformPlanarArrayTestCase::DoRun()
                               "wrong value of the radiation pattern");
 }
 
+/**
+ * \ingroup antenna-tests
+ *
+ * \brief Test the lookup table of UniformPlanarArray
+ *
+ * The field patterns and the steering vectors of arrays using the lookup table
+ * are compared with those computed exactly, over a grid of directions which
+ * do not coincide with the points of the table, for several orientations of
+ * the array.
+ */
+class UniformPlanarArrayLookupTableTestCase : public TestCase
+{
+  public:
+    /**
+     * The constructor of the test case
+     * \param alpha the bearing angle [rad]
+     * \param beta the tilting angle [rad]
+     * \param polSlant the polarization slant angle [rad]
+     */
+    UniformPlanarArrayLookupTableTestCase(double alpha, double beta, double polSlant);
+
+  private:
+    /**
+     * Run the test
+     */
+    void DoRun() override;
+
+    /**
+     * Create the array under test
+     * \param resolution the resolution of the lookup table [rad]
+     * \param cache the cache of the lookup tables, if any
+     * \return the array
+     */
+    Ptr<UniformPlanarArray> CreateArray(double resolution,
+                                        Ptr<FieldPatternTableCache> cache = nullptr) const;
+
+    double m_alpha;    //!< the bearing angle [rad]
+    double m_beta;     //!< the titling angle [rad]
+    double m_polSlant; //!< the polarization slant angle [rad]
+};
+
+UniformPlanarArrayLookupTableTestCase::UniformPlanarArrayLookupTableTestCase(double alpha,
+                                                                             double beta,
+                                                                             double polSlant)
+    : TestCase("Lookup table of UPA with bearing=" + std::to_string(RadiansToDegrees(alpha)) +
+               " deg, tilting=" + std::to_string(RadiansToDegrees(beta)) +
+               " deg, polarization slant=" + std::to_string(RadiansToDegrees(polSlant)) + " deg"),
+      m_alpha(alpha),
+      m_beta(beta),
+      m_polSlant(polSlant)
+{
+}
+
+Ptr<UniformPlanarArray>
+UniformPlanarArrayLookupTableTestCase::CreateArray(double resolution,
+                                                   Ptr<FieldPatternTableCache> cache) const
+{
+    Ptr<UniformPlanarArray> a = CreateObject<UniformPlanarArray>();
+    a->SetAttribute("AntennaElement", PointerValue(CreateObject<ThreeGppAntennaModel>()));
+    a->SetAttribute("NumRows", UintegerValue(4));
+    a->SetAttribute("NumColumns", UintegerValue(8));
+    a->SetAttribute("AntennaVerticalSpacing", DoubleValue(0.7));
+    a->SetAttribute("BearingAngle", DoubleValue(m_alpha));
+    a->SetAttribute("DowntiltAngle", DoubleValue(m_beta));
+    a->SetAttribute("PolSlantAngle", DoubleValue(m_polSlant));
+    a->SetAttribute("LookupTableResolution", DoubleValue(resolution));
+    if (cache)
+    {
+        a->SetAttribute("FieldPatternTableCache", PointerValue(cache));
+    }
+    return a;
+}
+
+void
+UniformPlanarArrayLookupTableTestCase::DoRun()
+{
+    Ptr<UniformPlanarArray> exact = CreateArray(0);
+    Ptr<FieldPatternTableCache> cache = CreateObject<FieldPatternTableCache>();
+    Ptr<UniformPlanarArray> table = CreateArray(DegreesToRadians(0.5), cache);
+    // an array with the same configuration and cache shares the table
+    Ptr<UniformPlanarArray> sharedTable = CreateArray(DegreesToRadians(0.5), cache);
+
+    for (double azimuthDeg = -179.3; azimuthDeg < 180; azimuthDeg += 7.3)
+    {
+        for (double inclinationDeg = 0.7; inclinationDeg < 180; inclinationDeg += 5.1)
+        {
+            Angles direction(DegreesToRadians(azimuthDeg), DegreesToRadians(inclinationDeg));
+
+            // the field pattern is interpolated, the field magnitude being at most
+            // sqrt(10^(8/10)) ~ 2.5 for the 3GPP antenna element
+            auto exactFp = exact->GetElementFieldPattern(direction);
+            auto tableFp = table->GetElementFieldPattern(direction);
+            NS_TEST_EXPECT_MSG_EQ_TOL(tableFp.first,
+                                      exactFp.first,
+                                      0.01,
+                                      "Wrong horizontal field component at " << direction);
+            NS_TEST_EXPECT_MSG_EQ_TOL(tableFp.second,
+                                      exactFp.second,
+                                      0.01,
+                                      "Wrong vertical field component at " << direction);
+            auto sharedFp = sharedTable->GetElementFieldPattern(direction);
+            NS_TEST_EXPECT_MSG_EQ((sharedFp == tableFp),
+                                  true,
+                                  "Arrays with the same configuration should give the same "
+                                  "field pattern at "
+                                      << direction);
+
+            // the steering vector is computed from the phase shifts between rows and columns
+            auto exactSv = exact->GetSteeringVector(direction);
+            auto tableSv = table->GetSteeringVector(direction);
+            NS_TEST_ASSERT_MSG_EQ(tableSv.size(), exactSv.size(), "Wrong steering vector size");
+            for (std::size_t i = 0; i < exactSv.size(); i++)
+            {
+                NS_TEST_EXPECT_MSG_LT(std::abs(tableSv[i] - exactSv[i]),
+                                      1e-12,
+                                      "Wrong steering vector element " << i << " at "
+                                                                       << direction);
+            }
+        }
+    }
+
+    // the table follows the changes of the attributes of the antenna element
+    Ptr<AntennaModel> element = CreateObject<IsotropicAntennaModel>();
+    exact->SetAttribute("AntennaElement", PointerValue(element));
+    table->SetAttribute("AntennaElement", PointerValue(element));
+    Angles direction(DegreesToRadians(30.0), DegreesToRadians(60.0));
+    for (double gainDb : {0.0, 6.0})
+    {
+        element->SetAttribute("Gain", DoubleValue(gainDb));
+        auto exactFp = exact->GetElementFieldPattern(direction);
+        auto tableFp = table->GetElementFieldPattern(direction);
+        NS_TEST_EXPECT_MSG_EQ_TOL(tableFp.first,
+                                  exactFp.first,
+                                  1e-9,
+                                  "Wrong horizontal field component with gain " << gainDb << " dB");
+        NS_TEST_EXPECT_MSG_EQ_TOL(tableFp.second,
+                                  exactFp.second,
+                                  1e-9,
+                                  "Wrong vertical field component with gain " << gainDb << " dB");
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup antenna-tests
  *
@@ -389,6 +533,17 @@ UniformPlanarArrayTestSuite::UniformPlanarArrayTestSuite()
                                                Angles(DegreesToRadians(0), DegreesToRadians(135)),
                                                28.0),
                 TestCase::QUICK);
+
+    // lookup table
+    AddTestCase(new UniformPlanarArrayLookupTableTestCase(0, 0, 0), TestCase::QUICK);
+    AddTestCase(new UniformPlanarArrayLookupTableTestCase(DegreesToRadians(30),
+                                                          DegreesToRadians(10),
+                                                          DegreesToRadians(45)),
+                TestCase::QUICK);
+    AddTestCase(new UniformPlanarArrayLookupTableTestCase(DegreesToRadians(-120),
+                                                          DegreesToRadians(-20),
+                                                          DegreesToRadians(-45)),
+                TestCase::QUICK);
 }
 
 static UniformPlanarArrayTestSuite staticUniformPlanarArrayTestSuiteInstance;
@@ -32,10 +32,14 @@
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/socket.h"
+#include "ns3/tcp-socket-base.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/udp-socket.h"
 
+#include <limits>
+#include <vector>
+
 namespace ns3
 {
 
@@ -198,55 +202,78 @@ PacketSink::HandleRead(Ptr<Socket> socket)
     NS_LOG_FUNCTION(this << socket);
     Ptr<Packet> packet;
     Address from;
-    Address localAddress;
+    Ptr<TcpSocketBase> tcpSocket = DynamicCast<TcpSocketBase>(socket);
+    if (tcpSocket)
+    {
+        // read the segments held by the Rx buffer without concatenating them
+        std::vector<Ptr<Packet>> chain;
+        while (tcpSocket->RecvChain(std::numeric_limits<uint32_t>::max(), chain) > 0)
+        {
+            tcpSocket->GetPeerName(from);
+            for (const auto& chunk : chain)
+            {
+                HandleRx(socket, chunk, from);
+            }
+            chain.clear();
+        }
+        return;
+    }
     while ((packet = socket->RecvFrom(from)))
     {
         if (packet->GetSize() == 0)
         { // EOF
             break;
         }
-        m_totalRx += packet->GetSize();
-        if (InetSocketAddress::IsMatchingType(from))
+        HandleRx(socket, packet, from);
+    }
+}
+
+void
+PacketSink::HandleRx(Ptr<Socket> socket, Ptr<Packet> packet, const Address& from)
+{
+    NS_LOG_FUNCTION(this << socket << packet << from);
+    Address localAddress;
+    m_totalRx += packet->GetSize();
+    if (InetSocketAddress::IsMatchingType(from))
+    {
+        NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
+                               << packet->GetSize() << " bytes from "
+                               << InetSocketAddress::ConvertFrom(from).GetIpv4() << " port "
+                               << InetSocketAddress::ConvertFrom(from).GetPort() << " total Rx "
+                               << m_totalRx << " bytes");
+    }
+    else if (Inet6SocketAddress::IsMatchingType(from))
+    {
+        NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
+                               << packet->GetSize() << " bytes from "
+                               << Inet6SocketAddress::ConvertFrom(from).GetIpv6() << " port "
+                               << Inet6SocketAddress::ConvertFrom(from).GetPort()
+                               << " total Rx " << m_totalRx << " bytes");
+    }
+
+    if (!m_rxTrace.IsEmpty() || !m_rxTraceWithAddresses.IsEmpty() ||
+        (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader))
+    {
+        Ipv4PacketInfoTag interfaceInfo;
+        Ipv6PacketInfoTag interface6Info;
+        if (packet->RemovePacketTag(interfaceInfo))
         {
-            NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
-                                   << packet->GetSize() << " bytes from "
-                                   << InetSocketAddress::ConvertFrom(from).GetIpv4() << " port "
-                                   << InetSocketAddress::ConvertFrom(from).GetPort() << " total Rx "
-                                   << m_totalRx << " bytes");
+            localAddress = InetSocketAddress(interfaceInfo.GetAddress(), m_localPort);
         }
-        else if (Inet6SocketAddress::IsMatchingType(from))
+        else if (packet->RemovePacketTag(interface6Info))
         {
-            NS_LOG_INFO("At time " << Simulator::Now().As(Time::S) << " packet sink received "
-                                   << packet->GetSize() << " bytes from "
-                                   << Inet6SocketAddress::ConvertFrom(from).GetIpv6() << " port "
-                                   << Inet6SocketAddress::ConvertFrom(from).GetPort()
-                                   << " total Rx " << m_totalRx << " bytes");
+            localAddress = Inet6SocketAddress(interface6Info.GetAddress(), m_localPort);
         }
-
-        if (!m_rxTrace.IsEmpty() || !m_rxTraceWithAddresses.IsEmpty() ||
-            (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader))
+        else
         {
-            Ipv4PacketInfoTag interfaceInfo;
-            Ipv6PacketInfoTag interface6Info;
-            if (packet->RemovePacketTag(interfaceInfo))
-            {
-                localAddress = InetSocketAddress(interfaceInfo.GetAddress(), m_localPort);
-            }
-            else if (packet->RemovePacketTag(interface6Info))
-            {
-                localAddress = Inet6SocketAddress(interface6Info.GetAddress(), m_localPort);
-            }
-            else
-            {
-                socket->GetSockName(localAddress);
-            }
-            m_rxTrace(packet, from);
-            m_rxTraceWithAddresses(packet, from, localAddress);
+            socket->GetSockName(localAddress);
+        }
+        m_rxTrace(packet, from);
+        m_rxTraceWithAddresses(packet, from, localAddress);
 
-            if (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader)
-            {
-                PacketReceived(packet, from, localAddress);
-            }
+        if (!m_rxTraceWithSeqTsSize.IsEmpty() && m_enableSeqTsSizeHeader)
+        {
+            PacketReceived(packet, from, localAddress);
         }
     }
 }
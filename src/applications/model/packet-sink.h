@@ -70,6 +70,11 @@ class Packet;
  * as a callback on the receiving socket.  By default, when logging is
  * enabled, it prints out the size of packets and their address.
  * A tracing source to Receive() is also available.
+ *
+ * The data received by a TCP socket is read as the chain of the segments held
+ * by the receive buffer of the socket (see TcpSocketBase::RecvChain), rather
+ * than concatenated into a single packet, hence the tracing sources are
+ * invoked for each of these segments.
  */
 class PacketSink : public Application
 {
@@ -124,6 +129,14 @@ class PacketSink : public Application
      * \param socket the receiving socket
      */
     void HandleRead(Ptr<Socket> socket);
+
+    /**
+     * \brief Handle a packet read from a socket
+     * \param socket the receiving socket
+     * \param packet the packet
+     * \param from the address of the sender
+     */
+    void HandleRx(Ptr<Socket> socket, Ptr<Packet> packet, const Address& from);
     /**
      * \brief Handle an incoming connection
      * \param socket the incoming connection socket
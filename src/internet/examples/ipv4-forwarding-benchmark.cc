@@ -0,0 +1,286 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program benchmarks the forwarding table lookups of Ipv4StaticRouting
+// and Ipv4GlobalRouting. A node with a few interfaces is given a number of
+// random routes to overlapping prefixes of 10.0.0.0/8, some of them host
+// routes, and routes packets to random destinations of 10.0.0.0/8 with:
+//
+// - Ipv4StaticRouting::RouteOutput and Ipv4GlobalRouting::RouteOutput, which
+//   find the matching routes in a prefix trie
+// - a linear scan of a copy of the routing tables, as the protocols did before
+//   indexing the routes with a trie (longest prefix with the smallest metric
+//   for the static routing, first matching route for the global routing)
+//
+// The program reports the number of lookups per second of both versions and
+// checks that they select the same routes:
+//
+//   ./ns3 run "ipv4-forwarding-benchmark --numRoutes=100000 --numLookups=100000"
+//
+
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/// A route of the linear tables
+struct LinearRoute
+{
+    Ipv4RoutingTableEntry m_entry; //!< the route
+    uint32_t m_metric;             //!< the metric of the route
+};
+
+/**
+ * Find the static route to a destination by scanning the routes.
+ *
+ * \param routes the routes
+ * \param dest the destination
+ * \return the selected route, or nullptr
+ */
+static const LinearRoute*
+LookupStaticLinear(const std::vector<LinearRoute>& routes, Ipv4Address dest)
+{
+    const LinearRoute* selected = nullptr;
+    uint16_t longestMask = 0;
+    uint32_t shortestMetric = 0xffffffff;
+    for (const auto& route : routes)
+    {
+        Ipv4Mask mask = route.m_entry.GetDestNetworkMask();
+        uint16_t masklen = mask.GetPrefixLength();
+        if (!mask.IsMatch(dest, route.m_entry.GetDestNetwork()) || masklen < longestMask)
+        {
+            continue;
+        }
+        if (masklen > longestMask)
+        {
+            shortestMetric = 0xffffffff;
+        }
+        longestMask = masklen;
+        if (route.m_metric > shortestMetric)
+        {
+            continue;
+        }
+        shortestMetric = route.m_metric;
+        selected = &route;
+        if (masklen == 32)
+        {
+            break;
+        }
+    }
+    return selected;
+}
+
+/**
+ * Find the global route to a destination by scanning the host routes, then
+ * the network routes.
+ *
+ * \param routes the host routes, followed by the network routes
+ * \param dest the destination
+ * \return the selected route, or nullptr
+ */
+static const LinearRoute*
+LookupGlobalLinear(const std::vector<LinearRoute>& routes, Ipv4Address dest)
+{
+    for (const auto& route : routes)
+    {
+        if (route.m_entry.IsHost() ? route.m_entry.GetDest() == dest
+                                   : route.m_entry.GetDestNetworkMask().IsMatch(
+                                         dest,
+                                         route.m_entry.GetDestNetwork()))
+        {
+            return &route;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Check that a route returned by RouteOutput matches the one of the linear scan.
+ *
+ * \param route the route returned by RouteOutput
+ * \param expected the route of the linear scan
+ * \param ipv4 the IPv4 instance
+ * \return true if the routes match
+ */
+static bool
+IsSameRoute(Ptr<Ipv4Route> route, const LinearRoute* expected, Ptr<Ipv4> ipv4)
+{
+    if (!route || !expected)
+    {
+        return !route && !expected;
+    }
+    return route->GetGateway() == expected->m_entry.GetGateway() &&
+           route->GetOutputDevice() == ipv4->GetNetDevice(expected->m_entry.GetInterface());
+}
+
+/**
+ * \param duration a duration
+ * \param count the number of lookups done in the duration
+ * \return the number of lookups per second
+ */
+static double
+GetRate(std::chrono::steady_clock::duration duration, uint32_t count)
+{
+    return count / std::chrono::duration<double>(duration).count();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t numRoutes = 10000;
+    uint32_t numLookups = 100000;
+    double hostRouteFraction = 0.2;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("numRoutes", "Number of routes of each routing protocol", numRoutes);
+    cmd.AddValue("numLookups", "Number of lookups", numLookups);
+    cmd.AddValue("hostRouteFraction", "Fraction of host routes", hostRouteFraction);
+    cmd.Parse(argc, argv);
+
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(1);
+
+    Ptr<Node> node = CreateObject<Node>();
+    SimpleNetDeviceHelper deviceHelper;
+    NetDeviceContainer devices;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        devices.Add(deviceHelper.Install(node));
+    }
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ipv4AddressHelper addresses("192.168.0.0", "255.255.255.0");
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        addresses.Assign(devices.Get(i));
+        addresses.NewNetwork();
+    }
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    Ptr<Ipv4StaticRouting> staticRouting = Ipv4StaticRoutingHelper().GetStaticRouting(ipv4);
+    Ptr<Ipv4GlobalRouting> globalRouting = CreateObject<Ipv4GlobalRouting>();
+    globalRouting->SetIpv4(ipv4);
+
+    std::vector<LinearRoute> globalHostRoutes;
+    std::vector<LinearRoute> globalNetworkRoutes;
+    for (uint32_t i = 0; i < numRoutes; i++)
+    {
+        uint32_t interface = rand->GetInteger(1, devices.GetN());
+        Ipv4Address gateway(0xc0a80002 | (interface - 1) << 8);
+        Ipv4Address dest(0x0a000000 | rand->GetInteger(0, 0xffffff));
+        uint32_t metric = rand->GetInteger(0, 3);
+        if (rand->GetValue() < hostRouteFraction)
+        {
+            staticRouting->AddHostRouteTo(dest, gateway, interface, metric);
+            globalRouting->AddHostRouteTo(dest, gateway, interface);
+            globalHostRoutes.push_back(
+                {Ipv4RoutingTableEntry::CreateHostRouteTo(dest, gateway, interface), 0});
+        }
+        else
+        {
+            uint32_t length = rand->GetInteger(12, 28);
+            Ipv4Mask mask(0xffffffff << (32 - length));
+            dest = dest.CombineMask(mask);
+            staticRouting->AddNetworkRouteTo(dest, mask, gateway, interface, metric);
+            globalRouting->AddNetworkRouteTo(dest, mask, gateway, interface);
+            globalNetworkRoutes.push_back(
+                {Ipv4RoutingTableEntry::CreateNetworkRouteTo(dest, mask, gateway, interface), 0});
+        }
+    }
+    // the static routing also has the routes to the networks of the interfaces
+    std::vector<LinearRoute> staticRoutes;
+    for (uint32_t i = 0; i < staticRouting->GetNRoutes(); i++)
+    {
+        staticRoutes.push_back({staticRouting->GetRoute(i), staticRouting->GetMetric(i)});
+    }
+    std::vector<LinearRoute> globalRoutes(globalHostRoutes);
+    globalRoutes.insert(globalRoutes.end(), globalNetworkRoutes.begin(), globalNetworkRoutes.end());
+
+    std::vector<Ipv4Header> headers(numLookups);
+    for (auto& header : headers)
+    {
+        header.SetDestination(Ipv4Address(0x0a000000 | rand->GetInteger(0, 0xffffff)));
+    }
+    Ptr<Packet> packet = Create<Packet>();
+    Socket::SocketErrno sockerr;
+
+    std::vector<Ptr<Ipv4Route>> staticResults(numLookups);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numLookups; i++)
+    {
+        staticResults[i] = staticRouting->RouteOutput(packet, headers[i], nullptr, sockerr);
+    }
+    auto staticTrie = std::chrono::steady_clock::now() - start;
+
+    std::vector<Ptr<Ipv4Route>> globalResults(numLookups);
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numLookups; i++)
+    {
+        globalResults[i] = globalRouting->RouteOutput(packet, headers[i], nullptr, sockerr);
+    }
+    auto globalTrie = std::chrono::steady_clock::now() - start;
+
+    std::vector<const LinearRoute*> staticExpected(numLookups);
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numLookups; i++)
+    {
+        staticExpected[i] = LookupStaticLinear(staticRoutes, headers[i].GetDestination());
+    }
+    auto staticLinear = std::chrono::steady_clock::now() - start;
+
+    std::vector<const LinearRoute*> globalExpected(numLookups);
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < numLookups; i++)
+    {
+        globalExpected[i] = LookupGlobalLinear(globalRoutes, headers[i].GetDestination());
+    }
+    auto globalLinear = std::chrono::steady_clock::now() - start;
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < numLookups; i++)
+    {
+        mismatches += IsSameRoute(staticResults[i], staticExpected[i], ipv4) ? 0 : 1;
+        mismatches += IsSameRoute(globalResults[i], globalExpected[i], ipv4) ? 0 : 1;
+    }
+
+    std::cout << staticRoutes.size() << " static routes, " << globalRoutes.size()
+              << " global routes, " << numLookups << " lookups" << std::endl;
+    std::cout << "static routing: " << GetRate(staticTrie, numLookups) << " lookups/s (trie), "
+              << GetRate(staticLinear, numLookups) << " lookups/s (linear scan)" << std::endl;
+    std::cout << "global routing: " << GetRate(globalTrie, numLookups) << " lookups/s (trie), "
+              << GetRate(globalLinear, numLookups) << " lookups/s (linear scan)" << std::endl;
+    std::cout << "routes differing from the linear scan: " << mismatches << std::endl;
+
+    globalRouting->Dispose();
+    Simulator::Destroy();
+    return mismatches == 0 ? 0 : 1;
+}
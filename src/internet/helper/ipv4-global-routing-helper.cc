@@ -23,6 +23,7 @@
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/log.h"
+#include "ns3/node-list.h"
 
 namespace ns3
 {
@@ -31,9 +32,11 @@ NS_LOG_COMPONENT_DEFINE("GlobalRoutingHelper");
 
 Ipv4GlobalRoutingHelper::Ipv4GlobalRoutingHelper()
 {
+    m_factory.SetTypeId("ns3::Ipv4GlobalRouting");
 }
 
 Ipv4GlobalRoutingHelper::Ipv4GlobalRoutingHelper(const Ipv4GlobalRoutingHelper& o)
+    : m_factory(o.m_factory)
 {
 }
 
@@ -52,12 +55,18 @@ Ipv4GlobalRoutingHelper::Create(Ptr<Node> node) const
     node->AggregateObject(globalRouter);
 
     NS_LOG_LOGIC("Adding GlobalRouting Protocol to node " << node->GetId());
-    Ptr<Ipv4GlobalRouting> globalRouting = CreateObject<Ipv4GlobalRouting>();
+    Ptr<Ipv4GlobalRouting> globalRouting = m_factory.Create<Ipv4GlobalRouting>();
     globalRouter->SetRoutingProtocol(globalRouting);
 
     return globalRouting;
 }
 
+void
+Ipv4GlobalRoutingHelper::Set(std::string name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
 void
 Ipv4GlobalRoutingHelper::PopulateRoutingTables()
 {
@@ -68,9 +77,22 @@ Ipv4GlobalRoutingHelper::PopulateRoutingTables()
 void
 Ipv4GlobalRoutingHelper::RecomputeRoutingTables()
 {
-    GlobalRouteManager::DeleteGlobalRoutes();
-    GlobalRouteManager::BuildGlobalRoutingDatabase();
-    GlobalRouteManager::InitializeRoutes();
+    GlobalRouteManager::RecomputeRoutes();
+}
+
+std::size_t
+Ipv4GlobalRoutingHelper::GetMemoryUsage()
+{
+    std::size_t usage = Ipv4GlobalRouting::GetSharedMemoryUsage();
+    for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<GlobalRouter> router = (*i)->GetObject<GlobalRouter>();
+        if (router && router->GetRoutingProtocol())
+        {
+            usage += router->GetRoutingProtocol()->GetMemoryUsage();
+        }
+    }
+    return usage;
 }
 
 } // namespace ns3
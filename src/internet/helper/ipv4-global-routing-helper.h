@@ -22,6 +22,7 @@
 
 #include "ns3/ipv4-routing-helper.h"
 #include "ns3/node-container.h"
+#include "ns3/object-factory.h"
 
 namespace ns3
 {
@@ -66,6 +67,15 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      */
     Ptr<Ipv4RoutingProtocol> Create(Ptr<Node> node) const override;
 
+    /**
+     * \param name the name of the attribute to set
+     * \param value the value of the attribute to set.
+     *
+     * This method controls the attributes of ns3::Ipv4GlobalRouting, e.g.,
+     * CompactRoutingTable to store the routes in compact routing tables.
+     */
+    void Set(std::string name, const AttributeValue& value);
+
     /**
      * \brief Build a routing database and initialize the routing tables of
      * the nodes in the simulation.  Makes all nodes in the simulation into
@@ -87,8 +97,23 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * Users must first call PopulateRoutingTables() and then may subsequently
      * call RecomputeRoutingTables() at any later time in the simulation.
      *
+     * If the GlobalRoutingIncrementalUpdate global value is true, only the
+     * routes affected by the changes of the topology are updated (see
+     * GlobalRouteManagerImpl::RecomputeRoutes ()).
      */
     static void RecomputeRoutingTables();
+
+    /**
+     * \brief Get the memory used by the global routing tables of all the nodes,
+     * including the table of destinations shared by the compact routing tables.
+     *
+     * \returns the estimated number of bytes used by the routing tables
+     * \see Ipv4GlobalRouting::GetMemoryUsage
+     */
+    static std::size_t GetMemoryUsage();
+
+  private:
+    ObjectFactory m_factory; //!< Object Factory
 };
 
 } // namespace ns3
@@ -32,6 +32,9 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -39,6 +42,23 @@ NS_LOG_COMPONENT_DEFINE("ArpCache");
 
 NS_OBJECT_ENSURE_REGISTERED(ArpCache);
 
+/**
+ * \brief Get the key of a MAC address in the index of the entries by MAC address.
+ *
+ * The key ignores the type of the address, since addresses of type zero,
+ * such as those read from ARP headers, are equal to addresses of any type.
+ *
+ * \param address the MAC address
+ * \returns the bytes of the address
+ */
+static std::string
+GetMacKey(const Address& address)
+{
+    uint8_t buffer[Address::MAX_SIZE];
+    uint32_t length = address.CopyTo(buffer);
+    return std::string(reinterpret_cast<const char*>(buffer), length);
+}
+
 TypeId
 ArpCache::GetTypeId()
 {
@@ -199,12 +219,17 @@ void
 ArpCache::HandleWaitReplyTimeout()
 {
     NS_LOG_FUNCTION(this);
-    ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // the entries leave m_waitReplyEntries when they are marked dead
+    std::vector<ArpCache::Entry*> waitReplyEntries;
+    waitReplyEntries.reserve(m_waitReplyEntries.size());
+    for (const auto& waitReplyEntry : m_waitReplyEntries)
+    {
+        waitReplyEntries.push_back(waitReplyEntry.second);
+    }
+    for (ArpCache::Entry* entry : waitReplyEntries)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        if (entry->IsWaitReply())
         {
             if (entry->GetRetries() < m_maxRetries)
             {
@@ -252,6 +277,8 @@ ArpCache::Flush()
         delete (*i).second;
     }
     m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_waitReplyEntries.clear();
+    m_macEntries.clear();
     if (m_waitReplyTimer.IsRunning())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -266,7 +293,9 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // print the entries in the order of their IPv4 addresses
+    std::map<Ipv4Address, ArpCache::Entry*> entries(m_arpCache.begin(), m_arpCache.end());
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -308,16 +337,17 @@ void
 ArpCache::RemoveAutoGeneratedEntries()
 {
     NS_LOG_FUNCTION(this);
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end();)
+    std::vector<ArpCache::Entry*> autoGenerated;
+    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
     {
         if (i->second->IsAutoGenerated())
         {
-            i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete i->second;
-            m_arpCache.erase(i++);
-            continue;
+            autoGenerated.push_back(i->second);
         }
-        i++;
+    }
+    for (ArpCache::Entry* entry : autoGenerated)
+    {
+        DeleteEntry(entry);
     }
 }
 
@@ -327,14 +357,18 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto range = m_macEntries.equal_range(GetMacKey(to));
+    for (auto i = range.first; i != range.second; i++)
     {
-        ArpCache::Entry* entry = (*i).second;
+        ArpCache::Entry* entry = i->second;
         if (entry->GetMacAddress() == to)
         {
             entryList.push_back(entry);
         }
     }
+    entryList.sort([](ArpCache::Entry* a, ArpCache::Entry* b) {
+        return a->GetIpv4Address() < b->GetIpv4Address();
+    });
     return entryList;
 }
 
@@ -359,6 +393,7 @@ ArpCache::Add(Ipv4Address to)
     ArpCache::Entry* entry = new ArpCache::Entry(this);
     m_arpCache[to] = entry;
     entry->SetIpv4Address(to);
+    IndexMacAddress(entry);
     return entry;
 }
 
@@ -367,17 +402,47 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (CacheI i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    CacheI i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && i->second == entry)
+    {
+        DeleteEntry(entry);
+        return;
+    }
+    NS_LOG_WARN("Entry not found in this ARP Cache");
+}
+
+void
+ArpCache::DeleteEntry(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    m_arpCache.erase(entry->GetIpv4Address());
+    if (entry->IsWaitReply())
+    {
+        m_waitReplyEntries.erase(entry->GetIpv4Address());
+    }
+    UnindexMacAddress(entry);
+    entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+    delete entry;
+}
+
+void
+ArpCache::IndexMacAddress(ArpCache::Entry* entry)
+{
+    m_macEntries.emplace(GetMacKey(entry->GetMacAddress()), entry);
+}
+
+void
+ArpCache::UnindexMacAddress(ArpCache::Entry* entry)
+{
+    auto range = m_macEntries.equal_range(GetMacKey(entry->GetMacAddress()));
+    for (auto i = range.first; i != range.second; i++)
     {
-        if ((*i).second == entry)
+        if (i->second == entry)
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
+            m_macEntries.erase(i);
             return;
         }
     }
-    NS_LOG_WARN("Entry not found in this ARP Cache");
 }
 
 ArpCache::Entry::Entry(ArpCache* arp)
@@ -428,7 +493,7 @@ ArpCache::Entry::MarkDead()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_state == ALIVE || m_state == WAIT_REPLY || m_state == DEAD);
-    m_state = DEAD;
+    SetState(DEAD);
     ClearRetries();
     UpdateSeen();
 }
@@ -438,8 +503,8 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
-    m_macAddress = macAddress;
-    m_state = ALIVE;
+    SetMacAddress(macAddress);
+    SetState(ALIVE);
     ClearRetries();
     UpdateSeen();
 }
@@ -450,7 +515,7 @@ ArpCache::Entry::MarkPermanent()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = PERMANENT;
+    SetState(PERMANENT);
     ClearRetries();
     UpdateSeen();
 }
@@ -461,7 +526,7 @@ ArpCache::Entry::MarkAutoGenerated()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = STATIC_AUTOGENERATED;
+    SetState(STATIC_AUTOGENERATED);
     ClearRetries();
     UpdateSeen();
 }
@@ -491,7 +556,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     NS_ASSERT(m_pending.empty());
     NS_ASSERT_MSG(waiting.first, "Can not add a null packet to the ARP queue");
 
-    m_state = WAIT_REPLY;
+    SetState(WAIT_REPLY);
     m_pending.push_back(waiting);
     UpdateSeen();
     m_arp->StartWaitReplyTimer();
@@ -508,7 +573,9 @@ void
 ArpCache::Entry::SetMacAddress(Address macAddress)
 {
     NS_LOG_FUNCTION(this);
+    m_arp->UnindexMacAddress(this);
     m_macAddress = macAddress;
+    m_arp->IndexMacAddress(this);
 }
 
 Ipv4Address
@@ -522,9 +589,29 @@ void
 ArpCache::Entry::SetIpv4Address(Ipv4Address destination)
 {
     NS_LOG_FUNCTION(this << destination);
+    if (m_state == WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries.erase(m_ipv4Address);
+        m_arp->m_waitReplyEntries[destination] = this;
+    }
     m_ipv4Address = destination;
 }
 
+void
+ArpCache::Entry::SetState(ArpCacheEntryState_e state)
+{
+    NS_LOG_FUNCTION(this << state);
+    if (m_state == WAIT_REPLY && state != WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries.erase(m_ipv4Address);
+    }
+    else if (m_state != WAIT_REPLY && state == WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries[m_ipv4Address] = this;
+    }
+    m_state = state;
+}
+
 Time
 ArpCache::Entry::GetTimeout() const
 {
@@ -35,6 +35,8 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <string>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -49,6 +51,12 @@ class Ipv4Header;
  *
  * A cached lookup table for translating layer 3 addresses to layer 2.
  * This implementation does lookups from IPv4 to a MAC address
+ *
+ * The entries are kept in a hash table, and indexed by MAC address for the
+ * inverse lookups.  The single WaitReply timer of the cache only visits the
+ * entries waiting for a reply, in the order of their IPv4 addresses; the
+ * Alive and Dead timeouts are checked when the entries are looked up, and
+ * need no event.
  */
 class ArpCache : public Object
 {
@@ -309,6 +317,13 @@ class ArpCache : public Object
          */
         Time GetTimeout() const;
 
+        /**
+         * \brief Change the state of the entry, and keep track of the
+         * entries waiting for a reply in the ARP cache.
+         * \param state the new state
+         */
+        void SetState(ArpCacheEntryState_e state);
+
         ArpCache* m_arp;              //!< pointer to the ARP cache owning the entry
         ArpCacheEntryState_e m_state; //!< state of the entry
         Time m_lastSeen;              //!< last moment a packet from that address has been seen
@@ -322,14 +337,30 @@ class ArpCache : public Object
     /**
      * \brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash> Cache;
     /**
      * \brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     void DoDispose() override;
 
+    /**
+     * \brief Add an entry to the index of the entries by MAC address.
+     * \param entry the entry
+     */
+    void IndexMacAddress(ArpCache::Entry* entry);
+    /**
+     * \brief Remove an entry from the index of the entries by MAC address.
+     * \param entry the entry
+     */
+    void UnindexMacAddress(ArpCache::Entry* entry);
+    /**
+     * \brief Remove an entry from the indexes, and delete it.
+     * \param entry the entry
+     */
+    void DeleteEntry(ArpCache::Entry* entry);
+
     Ptr<NetDevice> m_device;        //!< NetDevice associated with the cache
     Ptr<Ipv4Interface> m_interface; //!< Ipv4Interface associated with the cache
     Time m_aliveTimeout;            //!< cache alive state timeout
@@ -348,6 +379,10 @@ class ArpCache : public Object
     void HandleWaitReplyTimeout();
     uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
     Cache m_arpCache;            //!< the ARP cache
+    std::map<Ipv4Address, ArpCache::Entry*>
+        m_waitReplyEntries; //!< the entries in WAIT_REPLY state, by IPv4 address
+    std::unordered_multimap<std::string, ArpCache::Entry*>
+        m_macEntries; //!< the entries, by the bytes of their MAC address
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
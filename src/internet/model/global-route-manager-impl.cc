@@ -29,16 +29,27 @@
 #include "ipv4-global-routing.h"
 
 #include "ns3/assert.h"
+#include "ns3/boolean.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/ipv4.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <queue>
+#include <set>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -47,6 +58,22 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/// The number of threads running the SPF calculations
+static GlobalValue g_globalRoutingSpfThreads =
+    GlobalValue("GlobalRoutingSpfThreads",
+                "The number of threads running the SPF calculations of the global routers, "
+                "including the simulator thread",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>(1));
+
+/// Whether the global routes are updated incrementally after a change of the topology
+static GlobalValue g_globalRoutingIncrementalUpdate =
+    GlobalValue("GlobalRoutingIncrementalUpdate",
+                "If true, only the global routes affected by a change of the topology are "
+                "computed again when the routing tables are recomputed",
+                BooleanValue(false),
+                MakeBooleanChecker());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -478,6 +505,14 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     else
     {
         m_database.insert(LSDBPair_t(addr, lsa));
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                m_transitLinkData.insert(std::make_pair(lr->GetLinkData(), lsa));
+            }
+        }
     }
 }
 
@@ -502,13 +537,10 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    LSDBMap_t::const_iterator i;
-    for (i = m_database.begin(); i != m_database.end(); i++)
+    LSDBMap_t::const_iterator i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -518,24 +550,178 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up an LSA by the link data of its transit network records, which
+    // are indexed when the LSA is inserted.
     //
-    LSDBMap_t::const_iterator i;
-    for (i = m_database.begin(); i != m_database.end(); i++)
+    std::map<Ipv4Address, GlobalRoutingLSA*>::const_iterator i = m_transitLinkData.find(addr);
+    if (i != m_transitLinkData.end())
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
+        return i->second;
+    }
+    return nullptr;
+}
+
+std::vector<GlobalRoutingLSA*>
+GlobalRouteManagerLSDB::GetLSAs() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<GlobalRoutingLSA*> lsas;
+    lsas.reserve(m_database.size());
+    for (LSDBMap_t::const_iterator i = m_database.begin(); i != m_database.end(); i++)
+    {
+        lsas.push_back(i->second);
+    }
+    return lsas;
+}
+
+// ---------------------------------------------------------------------------
+//
+// SPFReverseGraph Implementation
+//
+// ---------------------------------------------------------------------------
+
+/**
+ * \ingroup globalrouting
+ *
+ * @brief The routers of an LSDB and their point-to-point links, used to
+ * compute the distances of all the routers to a given router.
+ *
+ * The incremental update of the routes (see GlobalRouteManagerImpl::RecomputeRoutes)
+ * uses these distances to find the routers whose shortest path trees are not
+ * changed by a change of the topology, without running their SPF calculations.
+ */
+class SPFReverseGraph
+{
+  public:
+    /// The distance of the routers that cannot reach the target router
+    static constexpr uint64_t INFINITE_DISTANCE = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @brief Construct the graph of the router LSAs of an LSDB.
+     * @param lsdb the LSDB
+     */
+    explicit SPFReverseGraph(const GlobalRouteManagerLSDB* lsdb);
+
+    /**
+     * @brief Get the index of a router in the graph.
+     * @param routerId the router ID
+     * @returns the index of the router, or -1 if it is not in the graph
+     */
+    int32_t GetIndex(Ipv4Address routerId) const;
+
+    /**
+     * @brief Get the LSA of a router.
+     * @param index the index of the router
+     * @returns the LSA of the router
+     */
+    GlobalRoutingLSA* GetLSA(uint32_t index) const;
+
+    /**
+     * @brief Check whether some links have a null metric, in which case the
+     * distances do not determine the order in which the SPF calculation
+     * explores the routers.
+     * @returns true if some links have a null metric
+     */
+    bool HasNullMetric() const;
+
+    /**
+     * @brief Compute the distances of all the routers to a router.
+     * @param target the index of the router
+     * @returns the distances, indexed by router, INFINITE_DISTANCE if unreachable
+     */
+    std::vector<uint64_t> GetDistancesTo(uint32_t target) const;
+
+  private:
+    /// A link arriving to a router: the index of the source router and the metric
+    typedef std::pair<uint32_t, uint16_t> InEdge_t;
+
+    std::vector<GlobalRoutingLSA*> m_lsas;         //!< the LSAs of the routers
+    std::map<Ipv4Address, uint32_t> m_indices;     //!< the indices of the router IDs
+    std::vector<std::vector<InEdge_t>> m_inEdges; //!< the links arriving to each router
+    bool m_nullMetric;                             //!< whether some links have a null metric
+};
+
+SPFReverseGraph::SPFReverseGraph(const GlobalRouteManagerLSDB* lsdb)
+    : m_nullMetric(false)
+{
+    NS_LOG_FUNCTION(this << lsdb);
+    for (GlobalRoutingLSA* lsa : lsdb->GetLSAs())
+    {
+        if (lsa->GetLSType() == GlobalRoutingLSA::RouterLSA)
+        {
+            m_indices.insert(std::make_pair(lsa->GetLinkStateId(), m_lsas.size()));
+            m_lsas.push_back(lsa);
+        }
+    }
+    m_inEdges.resize(m_lsas.size());
+    for (uint32_t i = 0; i < m_lsas.size(); i++)
+    {
+        for (uint32_t j = 0; j < m_lsas[i]->GetNLinkRecords(); j++)
         {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
+            GlobalRoutingLinkRecord* l = m_lsas[i]->GetLinkRecord(j);
+            if (l->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
             {
-                return temp;
+                continue;
+            }
+            int32_t w = GetIndex(l->GetLinkId());
+            if (w >= 0)
+            {
+                m_inEdges[w].emplace_back(i, l->GetMetric());
+                m_nullMetric |= (l->GetMetric() == 0);
             }
         }
     }
-    return nullptr;
+}
+
+int32_t
+SPFReverseGraph::GetIndex(Ipv4Address routerId) const
+{
+    std::map<Ipv4Address, uint32_t>::const_iterator i = m_indices.find(routerId);
+    return i == m_indices.end() ? -1 : static_cast<int32_t>(i->second);
+}
+
+GlobalRoutingLSA*
+SPFReverseGraph::GetLSA(uint32_t index) const
+{
+    NS_ASSERT(index < m_lsas.size());
+    return m_lsas[index];
+}
+
+bool
+SPFReverseGraph::HasNullMetric() const
+{
+    return m_nullMetric;
+}
+
+std::vector<uint64_t>
+SPFReverseGraph::GetDistancesTo(uint32_t target) const
+{
+    NS_LOG_FUNCTION(this << target);
+    NS_ASSERT(target < m_lsas.size());
+    std::vector<uint64_t> distances(m_lsas.size(), INFINITE_DISTANCE);
+    typedef std::pair<uint64_t, uint32_t> Entry_t;
+    std::priority_queue<Entry_t, std::vector<Entry_t>, std::greater<Entry_t>> queue;
+    distances[target] = 0;
+    queue.emplace(0, target);
+    while (!queue.empty())
+    {
+        Entry_t entry = queue.top();
+        queue.pop();
+        if (entry.first > distances[entry.second])
+        {
+            continue;
+        }
+        for (const InEdge_t& edge : m_inEdges[entry.second])
+        {
+            uint64_t distance = entry.first + edge.second;
+            if (distance < distances[edge.first])
+            {
+                distances[edge.first] = distance;
+                queue.emplace(distance, edge.first);
+            }
+        }
+    }
+    return distances;
 }
 
 // ---------------------------------------------------------------------------
@@ -545,16 +731,30 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_ownsLsdb(true),
+      m_routesComputed(false),
+      m_spfRootIpv4(nullptr)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl(const GlobalRouteManagerImpl* owner)
+    : m_spfroot(nullptr),
+      m_lsdb(owner->m_lsdb),
+      m_ownsLsdb(false),
+      m_routesComputed(false),
+      m_routers(owner->m_routers),
+      m_spfRootIpv4(nullptr)
+{
+    NS_LOG_FUNCTION(this << owner);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
 {
     NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    if (m_lsdb && m_ownsLsdb)
     {
         delete m_lsdb;
     }
@@ -569,6 +769,7 @@ GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
         delete m_lsdb;
     }
     m_lsdb = lsdb;
+    m_routesComputed = false;
 }
 
 void
@@ -585,18 +786,8 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
             continue;
         }
         Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
         NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
-        {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
-        }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        gr->RemoveAllRoutes();
     }
     if (m_lsdb)
     {
@@ -604,6 +795,7 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
         delete m_lsdb;
         m_lsdb = new GlobalRouteManagerLSDB();
     }
+    m_routesComputed = false;
 }
 
 //
@@ -702,10 +894,22 @@ void
 GlobalRouteManagerImpl::InitializeRoutes()
 {
     NS_LOG_FUNCTION(this);
+    FindRouters();
+    NS_LOG_INFO("About to start SPF calculation");
+    CalculateRoutes(m_roots);
+    m_routesComputed = true;
+    NS_LOG_INFO("Finished SPF calculation");
+}
+
+void
+GlobalRouteManagerImpl::FindRouters()
+{
+    NS_LOG_FUNCTION(this);
+    m_routers.clear();
+    m_roots.clear();
     //
     // Walk the list of nodes in the system.
     //
-    NS_LOG_INFO("About to start SPF calculation");
     NodeList::Iterator listEnd = NodeList::End();
     for (NodeList::Iterator i = NodeList::Begin(); i != listEnd; i++)
     {
@@ -715,6 +919,14 @@ GlobalRouteManagerImpl::InitializeRoutes()
         // participating in routing.
         //
         Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        if (!rtr)
+        {
+            continue;
+        }
+        RouterInfo info;
+        info.m_ipv4 = node->GetObject<Ipv4>();
+        info.m_routing = rtr->GetRoutingProtocol();
+        m_routers.insert(std::make_pair(rtr->GetRouterId(), info));
 
         uint32_t systemId = Simulator::GetSystemId();
         // Ignore nodes that are not assigned to our systemId (distributed sim)
@@ -727,12 +939,586 @@ GlobalRouteManagerImpl::InitializeRoutes()
         // if the node has a global router interface, then run the global routing
         // algorithms.
         //
-        if (rtr && rtr->GetNumLSAs())
+        if (rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            m_roots.push_back(rtr->GetRouterId());
         }
     }
-    NS_LOG_INFO("Finished SPF calculation");
+}
+
+void
+GlobalRouteManagerImpl::CalculateRoutes(const std::vector<Ipv4Address>& roots)
+{
+    NS_LOG_FUNCTION(this << roots.size());
+    UintegerValue nThreadsValue;
+    g_globalRoutingSpfThreads.GetValue(nThreadsValue);
+    uint32_t nThreads = std::min<std::size_t>(nThreadsValue.Get(), roots.size());
+    //
+    // The node list is only accessed by the simulator thread.
+    //
+    bool haveNodes = NodeList::GetNNodes() > 0;
+    //
+    // Log messages would be interleaved, hence use the simulator thread only
+    // when logging is enabled.
+    //
+    if (nThreads <= 1 || !g_log.IsNoneEnabled())
+    {
+        for (const auto& root : roots)
+        {
+            SPFCalculate(root, haveNodes);
+            InstallRoutes(root, m_spfRoutes);
+        }
+        m_spfRoutes.clear();
+        return;
+    }
+
+    //
+    // The calculations only read the LSDB, and each instance keeps the state of
+    // its current calculation (including the status of the LSAs).  The roots are
+    // processed in batches, so that the routes waiting to be installed do not
+    // take more memory than a few forwarding tables per thread.
+    //
+    std::vector<GlobalRouteManagerImpl*> workers{this};
+    for (uint32_t t = 1; t < nThreads; t++)
+    {
+        workers.push_back(new GlobalRouteManagerImpl(this));
+    }
+    const std::size_t batchSize = 16 * nThreads;
+    for (std::size_t start = 0; start < roots.size(); start += batchSize)
+    {
+        std::size_t end = std::min(start + batchSize, roots.size());
+        std::vector<std::vector<SPFRoute>> routes(end - start);
+        std::atomic<std::size_t> next(start);
+        auto work = [&roots, &routes, &next, start, end, haveNodes](
+                        GlobalRouteManagerImpl* worker) {
+            for (std::size_t i = next++; i < end; i = next++)
+            {
+                worker->SPFCalculate(roots[i], haveNodes);
+                routes[i - start].swap(worker->m_spfRoutes);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (uint32_t t = 1; t < nThreads; t++)
+        {
+            threads.emplace_back(work, workers[t]);
+        }
+        work(this);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        // install the routes in the order of the roots
+        for (std::size_t i = start; i < end; i++)
+        {
+            InstallRoutes(roots[i], routes[i - start]);
+        }
+    }
+    for (uint32_t t = 1; t < nThreads; t++)
+    {
+        delete workers[t];
+    }
+    m_spfRoutes.clear();
+}
+
+void
+GlobalRouteManagerImpl::InstallRoutes(Ipv4Address root, const std::vector<SPFRoute>& routes) const
+{
+    NS_LOG_FUNCTION(this << root << routes.size());
+    RouterMap_t::const_iterator router = m_routers.find(root);
+    if (router == m_routers.end() || !router->second.m_routing)
+    {
+        NS_LOG_LOGIC("No routing protocol for router " << root);
+        return;
+    }
+    Ptr<Ipv4GlobalRouting> gr = router->second.m_routing;
+    for (const auto& route : routes)
+    {
+        switch (route.m_type)
+        {
+        case SPFRoute::HOST:
+            gr->AddHostRouteTo(route.m_dest, route.m_nextHop, route.m_interface);
+            break;
+        case SPFRoute::NETWORK:
+            gr->AddNetworkRouteTo(route.m_dest, route.m_mask, route.m_nextHop, route.m_interface);
+            break;
+        case SPFRoute::EXTERNAL:
+            gr->AddASExternalRouteTo(route.m_dest,
+                                     route.m_mask,
+                                     route.m_nextHop,
+                                     route.m_interface);
+            break;
+        }
+    }
+}
+
+void
+GlobalRouteManagerImpl::AddRoute(SPFRoute::Type type,
+                                 Ipv4Address dest,
+                                 Ipv4Mask mask,
+                                 Ipv4Address nextHop,
+                                 uint32_t outIf)
+{
+    NS_LOG_FUNCTION(this << type << dest << mask << nextHop << outIf);
+    SPFRoute route;
+    route.m_type = type;
+    route.m_dest = dest;
+    route.m_mask = mask;
+    route.m_nextHop = nextHop;
+    route.m_interface = outIf;
+    m_spfRoutes.push_back(route);
+}
+
+GlobalRoutingLSA::SPFStatus
+GlobalRouteManagerImpl::GetLSAStatus(const GlobalRoutingLSA* lsa) const
+{
+    auto it = m_lsaStatus.find(lsa);
+    return it == m_lsaStatus.end() ? GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED : it->second;
+}
+
+void
+GlobalRouteManagerImpl::SetLSAStatus(const GlobalRoutingLSA* lsa,
+                                     GlobalRoutingLSA::SPFStatus status)
+{
+    m_lsaStatus[lsa] = status;
+}
+
+/**
+ * @brief Get the link records of given type of a router LSA, as sorted
+ * (link ID, link data, metric) tuples.
+ * @param lsa the router LSA
+ * @param type the type of link records
+ * @returns the sorted link records
+ */
+static std::vector<std::tuple<Ipv4Address, Ipv4Address, uint16_t>>
+GetSortedLinkRecords(const GlobalRoutingLSA* lsa, GlobalRoutingLinkRecord::LinkType type)
+{
+    std::vector<std::tuple<Ipv4Address, Ipv4Address, uint16_t>> records;
+    for (uint32_t i = 0; i < lsa->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* l = lsa->GetLinkRecord(i);
+        if (l->GetLinkType() == type)
+        {
+            records.emplace_back(l->GetLinkId(), l->GetLinkData(), l->GetMetric());
+        }
+    }
+    std::sort(records.begin(), records.end());
+    return records;
+}
+
+/**
+ * @brief Check whether two router LSAs have the same link records, in the same order.
+ * @param a the first LSA
+ * @param b the second LSA
+ * @returns true if the link records are the same
+ */
+static bool
+HaveSameLinkRecords(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (a->GetNLinkRecords() != b->GetNLinkRecords())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* la = a->GetLinkRecord(i);
+        GlobalRoutingLinkRecord* lb = b->GetLinkRecord(i);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() || la->GetMetric() != lb->GetMetric())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+GlobalRouteManagerImpl::RecomputeRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    BooleanValue incremental;
+    g_globalRoutingIncrementalUpdate.GetValue(incremental);
+    if (!incremental.Get() || !m_routesComputed)
+    {
+        DeleteGlobalRoutes();
+        BuildGlobalRoutingDatabase();
+        InitializeRoutes();
+        return;
+    }
+
+    GlobalRouteManagerLSDB* oldLsdb = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+    FindRouters();
+
+    auto deleteRoutes = [this](Ipv4Address root) {
+        RouterMap_t::const_iterator router = m_routers.find(root);
+        if (router != m_routers.end() && router->second.m_routing)
+        {
+            router->second.m_routing->RemoveAllRoutes();
+        }
+    };
+
+    //
+    // Find the routers whose LSAs changed.  Only changes of the point-to-point
+    // links and of the stub networks of routers are handled incrementally; the
+    // routers and the external routes must be the same, and there must be no
+    // transit networks (whose vertices only propagate the first of their exit
+    // directions in the SPF calculation).
+    //
+    std::vector<GlobalRoutingLSA*> oldLsas = oldLsdb->GetLSAs();
+    std::vector<GlobalRoutingLSA*> newLsas = m_lsdb->GetLSAs();
+    bool full = oldLsas.size() != newLsas.size() ||
+                oldLsdb->GetNumExtLSAs() != m_lsdb->GetNumExtLSAs();
+    for (uint32_t i = 0; !full && i < m_lsdb->GetNumExtLSAs(); i++)
+    {
+        GlobalRoutingLSA* oldExt = oldLsdb->GetExtLSA(i);
+        GlobalRoutingLSA* newExt = m_lsdb->GetExtLSA(i);
+        full = oldExt->GetLinkStateId() != newExt->GetLinkStateId() ||
+               oldExt->GetNetworkLSANetworkMask() != newExt->GetNetworkLSANetworkMask() ||
+               oldExt->GetAdvertisingRouter() != newExt->GetAdvertisingRouter();
+    }
+    std::vector<std::pair<GlobalRoutingLSA*, GlobalRoutingLSA*>> changed;
+    std::set<Ipv4Address> changedIds;
+    for (std::size_t i = 0; !full && i < newLsas.size(); i++)
+    {
+        if (oldLsas[i]->GetLinkStateId() != newLsas[i]->GetLinkStateId() ||
+            oldLsas[i]->GetLSType() != GlobalRoutingLSA::RouterLSA ||
+            newLsas[i]->GetLSType() != GlobalRoutingLSA::RouterLSA)
+        {
+            full = true;
+        }
+        else if (!HaveSameLinkRecords(oldLsas[i], newLsas[i]))
+        {
+            changed.emplace_back(oldLsas[i], newLsas[i]);
+            changedIds.insert(newLsas[i]->GetLinkStateId());
+        }
+    }
+    SPFReverseGraph oldGraph(oldLsdb);
+    SPFReverseGraph newGraph(m_lsdb);
+    full = full || oldGraph.HasNullMetric() || newGraph.HasNullMetric();
+    if (full)
+    {
+        NS_LOG_INFO("Recomputing all the routes");
+        delete oldLsdb;
+        for (const auto& router : m_routers)
+        {
+            deleteRoutes(router.first);
+        }
+        InitializeRoutes();
+        return;
+    }
+
+    //
+    // Find the point-to-point links that were removed or added.
+    //
+    typedef std::tuple<Ipv4Address, Ipv4Address, uint16_t> Edge_t; // (from, to, metric)
+    std::vector<Edge_t> removedEdges;
+    std::vector<Edge_t> addedEdges;
+    for (const auto& lsas : changed)
+    {
+        auto oldRecords = GetSortedLinkRecords(lsas.first, GlobalRoutingLinkRecord::PointToPoint);
+        auto newRecords = GetSortedLinkRecords(lsas.second, GlobalRoutingLinkRecord::PointToPoint);
+        decltype(oldRecords) removed;
+        decltype(oldRecords) added;
+        std::set_difference(oldRecords.begin(),
+                            oldRecords.end(),
+                            newRecords.begin(),
+                            newRecords.end(),
+                            std::back_inserter(removed));
+        std::set_difference(newRecords.begin(),
+                            newRecords.end(),
+                            oldRecords.begin(),
+                            oldRecords.end(),
+                            std::back_inserter(added));
+        Ipv4Address from = lsas.first->GetLinkStateId();
+        for (const auto& record : removed)
+        {
+            removedEdges.emplace_back(from, std::get<0>(record), std::get<2>(record));
+        }
+        for (const auto& record : added)
+        {
+            addedEdges.emplace_back(from, std::get<0>(record), std::get<2>(record));
+        }
+    }
+
+    // the distances of all the routers to the given router, computed on demand
+    std::map<Ipv4Address, std::vector<uint64_t>> oldDistances;
+    std::map<Ipv4Address, std::vector<uint64_t>> newDistances;
+    auto getDistances = [](const SPFReverseGraph& graph,
+                           std::map<Ipv4Address, std::vector<uint64_t>>& cache,
+                           Ipv4Address target) -> const std::vector<uint64_t>& {
+        auto it = cache.find(target);
+        if (it == cache.end())
+        {
+            int32_t index = graph.GetIndex(target);
+            NS_ASSERT(index >= 0);
+            it = cache.emplace(target, graph.GetDistancesTo(index)).first;
+        }
+        return it->second;
+    };
+    const uint64_t infinite = SPFReverseGraph::INFINITE_DISTANCE;
+
+    //
+    // The shortest path tree of a router, and hence the exit directions of its
+    // vertices, are unchanged if no removed link was on a shortest path before
+    // the change, and no added link is on a shortest path after the change.
+    // Then only the routes to the links and stub networks of the changed routers
+    // need to be updated.  The routers adjacent to a changed router are computed
+    // again, since their next hops are read from the LSAs of the changed routers.
+    //
+    std::vector<Ipv4Address> recomputed;
+    uint32_t nPatched = 0;
+    for (const auto& root : m_roots)
+    {
+        int32_t rootIndex = newGraph.GetIndex(root);
+        if (rootIndex < 0)
+        {
+            continue;
+        }
+        bool recompute = changedIds.count(root) > 0;
+        GlobalRoutingLSA* rootLsa = newGraph.GetLSA(rootIndex);
+        uint32_t nTransits = 0;
+        Ipv4Address neighbor;
+        for (uint32_t i = 0; !recompute && i < rootLsa->GetNLinkRecords(); i++)
+        {
+            GlobalRoutingLinkRecord* l = rootLsa->GetLinkRecord(i);
+            if (l->GetLinkType() != GlobalRoutingLinkRecord::StubNetwork)
+            {
+                nTransits++;
+                neighbor = l->GetLinkId();
+                recompute = changedIds.count(neighbor) > 0;
+            }
+        }
+        if (!recompute && nTransits <= 1)
+        {
+            // a stub router only has a default route to its unchanged neighbor
+            // (see CheckForStubNode ())
+            bool stub = (nTransits == 0);
+            int32_t neighborIndex = newGraph.GetIndex(neighbor);
+            GlobalRoutingLSA* neighborLsa =
+                (neighborIndex < 0 ? nullptr : newGraph.GetLSA(neighborIndex));
+            for (uint32_t i = 0; !stub && neighborLsa && i < neighborLsa->GetNLinkRecords(); i++)
+            {
+                GlobalRoutingLinkRecord* l = neighborLsa->GetLinkRecord(i);
+                stub = l->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint &&
+                       l->GetLinkId() == root;
+            }
+            if (stub)
+            {
+                continue;
+            }
+        }
+        for (const auto& edge : removedEdges)
+        {
+            if (recompute)
+            {
+                break;
+            }
+            const std::vector<uint64_t>& from =
+                getDistances(oldGraph, oldDistances, std::get<0>(edge));
+            int32_t toIndex = oldGraph.GetIndex(std::get<1>(edge));
+            if (toIndex < 0 || from[rootIndex] == infinite)
+            {
+                continue;
+            }
+            const std::vector<uint64_t>& to =
+                getDistances(oldGraph, oldDistances, std::get<1>(edge));
+            recompute = std::get<1>(edge) == root ||
+                        from[rootIndex] + std::get<2>(edge) == to[rootIndex];
+        }
+        for (const auto& edge : addedEdges)
+        {
+            if (recompute)
+            {
+                break;
+            }
+            const std::vector<uint64_t>& from =
+                getDistances(newGraph, newDistances, std::get<0>(edge));
+            int32_t toIndex = newGraph.GetIndex(std::get<1>(edge));
+            if (toIndex < 0 || from[rootIndex] == infinite)
+            {
+                continue;
+            }
+            const std::vector<uint64_t>& to =
+                getDistances(newGraph, newDistances, std::get<1>(edge));
+            recompute = std::get<1>(edge) == root ||
+                        from[rootIndex] + std::get<2>(edge) <= to[rootIndex];
+        }
+        Ptr<Ipv4> rootIpv4;
+        Ptr<Ipv4GlobalRouting> gr;
+        RouterMap_t::const_iterator router = m_routers.find(root);
+        if (router != m_routers.end())
+        {
+            rootIpv4 = router->second.m_ipv4;
+            gr = router->second.m_routing;
+        }
+        std::vector<std::vector<SPFVertex::NodeExit_t>> exits(changed.size());
+        for (std::size_t c = 0; !recompute && c < changed.size(); c++)
+        {
+            Ipv4Address id = changed[c].second->GetLinkStateId();
+            std::vector<SPFVertex::NodeExit_t> oldExits;
+            recompute =
+                !rootIpv4 || !gr ||
+                !GetRootExitDirections(oldGraph.GetLSA(rootIndex),
+                                       rootIpv4,
+                                       oldGraph,
+                                       getDistances(oldGraph, oldDistances, id),
+                                       oldExits) ||
+                !GetRootExitDirections(rootLsa,
+                                       rootIpv4,
+                                       newGraph,
+                                       getDistances(newGraph, newDistances, id),
+                                       exits[c]) ||
+                oldExits != exits[c];
+        }
+        if (recompute)
+        {
+            recomputed.push_back(root);
+            continue;
+        }
+
+        //
+        // Update the routes to the links and stub networks of the changed routers.
+        //
+        for (std::size_t c = 0; c < changed.size(); c++)
+        {
+            for (const auto& lsa : {changed[c].first, changed[c].second})
+            {
+                bool add = (lsa == changed[c].second);
+                const GlobalRoutingLSA* other = add ? changed[c].first : changed[c].second;
+                auto records = GetSortedLinkRecords(lsa, GlobalRoutingLinkRecord::PointToPoint);
+                auto otherRecords =
+                    GetSortedLinkRecords(other, GlobalRoutingLinkRecord::PointToPoint);
+                std::multiset<Ipv4Address> hosts;
+                for (const auto& record : otherRecords)
+                {
+                    hosts.insert(std::get<1>(record));
+                }
+                for (const auto& record : records)
+                {
+                    auto host = hosts.find(std::get<1>(record));
+                    if (host != hosts.end())
+                    {
+                        hosts.erase(host);
+                        continue;
+                    }
+                    for (const auto& exit : exits[c])
+                    {
+                        if (exit.second < 0)
+                        {
+                            continue;
+                        }
+                        if (add)
+                        {
+                            gr->AddHostRouteTo(std::get<1>(record), exit.first, exit.second);
+                        }
+                        else
+                        {
+                            gr->RemoveHostRouteTo(std::get<1>(record), exit.first, exit.second);
+                        }
+                    }
+                }
+                records = GetSortedLinkRecords(lsa, GlobalRoutingLinkRecord::StubNetwork);
+                otherRecords = GetSortedLinkRecords(other, GlobalRoutingLinkRecord::StubNetwork);
+                std::multiset<std::pair<Ipv4Address, Ipv4Address>> networks;
+                for (const auto& record : otherRecords)
+                {
+                    networks.emplace(std::get<0>(record), std::get<1>(record));
+                }
+                for (const auto& record : records)
+                {
+                    auto network = networks.find({std::get<0>(record), std::get<1>(record)});
+                    if (network != networks.end())
+                    {
+                        networks.erase(network);
+                        continue;
+                    }
+                    Ipv4Mask mask(std::get<1>(record).Get());
+                    Ipv4Address dest = std::get<0>(record).CombineMask(mask);
+                    for (const auto& exit : exits[c])
+                    {
+                        if (exit.second < 0)
+                        {
+                            continue;
+                        }
+                        if (add)
+                        {
+                            gr->AddNetworkRouteTo(dest, mask, exit.first, exit.second);
+                        }
+                        else
+                        {
+                            gr->RemoveNetworkRouteTo(dest, mask, exit.first, exit.second);
+                        }
+                    }
+                }
+            }
+        }
+        nPatched++;
+    }
+    NS_LOG_INFO(changed.size() << " routers changed, routes of " << nPatched
+                               << " routers updated, " << recomputed.size()
+                               << " routers computed again");
+    for (const auto& root : recomputed)
+    {
+        deleteRoutes(root);
+    }
+    CalculateRoutes(recomputed);
+    delete oldLsdb;
+}
+
+bool
+GlobalRouteManagerImpl::GetRootExitDirections(const GlobalRoutingLSA* rootLsa,
+                                              Ptr<Ipv4> rootIpv4,
+                                              const SPFReverseGraph& graph,
+                                              const std::vector<uint64_t>& distances,
+                                              std::vector<SPFVertex::NodeExit_t>& exits)
+{
+    NS_LOG_FUNCTION(rootLsa << rootIpv4 << &graph);
+    exits.clear();
+    uint64_t best = SPFReverseGraph::INFINITE_DISTANCE;
+    for (uint32_t i = 0; i < rootLsa->GetNLinkRecords(); i++)
+    {
+        GlobalRoutingLinkRecord* l = rootLsa->GetLinkRecord(i);
+        if (l->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
+        {
+            continue;
+        }
+        int32_t neighbor = graph.GetIndex(l->GetLinkId());
+        if (neighbor < 0 || distances[neighbor] == SPFReverseGraph::INFINITE_DISTANCE)
+        {
+            continue;
+        }
+        uint64_t distance = distances[neighbor] + l->GetMetric();
+        if (distance > best)
+        {
+            continue;
+        }
+        if (distance < best)
+        {
+            best = distance;
+            exits.clear();
+        }
+        // as in SPFNexthopCalculation (), the next hop is the link data of the
+        // first link record of the neighbor pointing back to the root
+        GlobalRoutingLSA* neighborLsa = graph.GetLSA(neighbor);
+        GlobalRoutingLinkRecord* linkRemote = nullptr;
+        for (uint32_t j = 0; !linkRemote && j < neighborLsa->GetNLinkRecords(); j++)
+        {
+            if (neighborLsa->GetLinkRecord(j)->GetLinkId() == rootLsa->GetLinkStateId())
+            {
+                linkRemote = neighborLsa->GetLinkRecord(j);
+            }
+        }
+        if (!linkRemote)
+        {
+            return false;
+        }
+        exits.emplace_back(linkRemote->GetLinkData(),
+                           rootIpv4->GetInterfaceForPrefix(l->GetLinkData(), Ipv4Mask::GetOnes()));
+    }
+    std::sort(exits.begin(), exits.end());
+    exits.erase(std::unique(exits.begin(), exits.end()), exits.end());
+    return true;
 }
 
 //
@@ -838,7 +1624,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // If the link is to a router that is already in the shortest path first tree
         // then we have it covered -- ignore it.
         //
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
         {
             NS_LOG_LOGIC("Skipping ->  LSA " << w_lsa->GetLinkStateId() << " already in SPF tree");
             continue;
@@ -862,7 +1648,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         NS_LOG_LOGIC("Considering w_lsa " << w_lsa->GetLinkStateId());
 
         // Is there already vertex w in candidate list?
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
             // Calculate nexthop to w
             // We need to figure out how to actually get to the new router represented
@@ -874,7 +1660,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
             w = new SPFVertex(w_lsa);
             if (SPFNexthopCalculation(v, w, l, distance))
             {
-                w_lsa->SetStatus(GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+                SetLSAStatus(w_lsa, GlobalRoutingLSA::LSA_SPF_CANDIDATE);
                 //
                 // Push this new vertex onto the priority queue (ordered by distance from the
                 // root node).
@@ -891,7 +1677,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                                   << "return false, but it does now!");
             }
         }
-        else if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+        else if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
             //
             // We have already considered the link represented by <w>.  What wse have to
@@ -1245,7 +2031,9 @@ void
 GlobalRouteManagerImpl::DebugSPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
-    SPFCalculate(root);
+    FindRouters();
+    SPFCalculate(root, NodeList::GetNNodes() > 0);
+    InstallRoutes(root, m_spfRoutes);
 }
 
 //
@@ -1318,14 +2106,11 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
-                    NS_ASSERT(router);
-                    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                    NS_ASSERT(gr);
-                    gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
-                                          Ipv4Mask("0.0.0.0"),
-                                          lr->GetLinkData(),
-                                          FindOutgoingInterfaceId(transitLink->GetLinkData()));
+                    AddRoute(SPFRoute::NETWORK,
+                             Ipv4Address("0.0.0.0"),
+                             Ipv4Mask("0.0.0.0"),
+                             lr->GetLinkData(),
+                             FindOutgoingInterfaceId(transitLink->GetLinkData()));
                     NS_LOG_LOGIC("Inserting default route for node "
                                  << myRouterId << " to next hop " << lr->GetLinkData()
                                  << " via interface "
@@ -1340,15 +2125,30 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
 
 // quagga ospf_spf_calculate
 void
-GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
+GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root, bool haveNodes)
 {
-    NS_LOG_FUNCTION(this << root);
+    NS_LOG_FUNCTION(this << root << haveNodes);
 
     SPFVertex* v;
     //
-    // Initialize the Link State Database.
+    // Initialize the status of the Link State Advertisements, which is kept by
+    // this instance so that several instances can share the Link State Database.
+    //
+    m_lsaStatus.clear();
+    m_spfRoutes.clear();
     //
-    m_lsdb->Initialize();
+    // Find the Ipv4 interface of the router we are computing the routes of.  A
+    // plain pointer is kept, as the reference count of the Ipv4 object must not
+    // be modified by the threads running the calculations.
+    //
+    RouterMap_t::const_iterator router = m_routers.find(root);
+    if (router != m_routers.end())
+    {
+        NS_ASSERT_MSG(router->second.m_ipv4,
+                      "GlobalRouteManagerImpl::SPFCalculate (): "
+                      "GetObject for <Ipv4> interface failed");
+        m_spfRootIpv4 = PeekPointer(router->second.m_ipv4);
+    }
     //
     // The candidate queue is a priority queue of SPFVertex objects, with the top
     // of the queue being the closest vertex in terms of distance from the root
@@ -1368,7 +2168,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     m_spfroot = v;
     v->SetDistanceFromRoot(0);
-    v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+    SetLSAStatus(v->GetLSA(), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
 
     //
@@ -1378,10 +2178,12 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (haveNodes && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
+        m_spfroot = nullptr;
+        m_spfRootIpv4 = nullptr;
         return;
     }
 
@@ -1429,7 +2231,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         // Update the status field of the vertex to indicate that it is in the SPF
         // tree.
         //
-        v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        SetLSAStatus(v->GetLSA(), GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
         //
         // The current vertex has a parent pointer.  By calling this rather oddly
         // named method (blame quagga) we add the current vertex to the list of
@@ -1503,6 +2305,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     delete m_spfroot;
     m_spfroot = nullptr;
+    m_spfRootIpv4 = nullptr;
 }
 
 void
@@ -1559,105 +2362,39 @@ GlobalRouteManagerImpl::SPFAddASExternal(GlobalRoutingLSA* extlsa, SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The routes are recorded for the router at the root of the SPF tree, and
+    // installed in its forwarding table once the SPF calculation is completed.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFAddASExternal (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = extlsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+    //
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    //
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            AddRoute(SPFRoute::EXTERNAL, tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " add external network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface " << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = extlsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add external network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 // Processing logic from RFC 2328, page 166 and quagga ospf_spf_process_stubs ()
@@ -1716,114 +2453,47 @@ GlobalRouteManagerImpl::SPFIntraAddStub(GlobalRoutingLinkRecord* l, SPFVertex* v
     NS_LOG_LOGIC("Stub is on remote host: " << v->GetVertexId() << "; installing");
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries.  The routes are recorded
+    // during the SPF calculation and installed in the forwarding table of the
+    // root once the calculation is completed.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddStub (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask(l->GetLinkData().Get());
+    Ipv4Address tempip = l->GetLinkId();
+    tempip = tempip.CombineMask(tempmask);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The vertex <v> (corresponding to the node that has this stub network) has
+    // the next hop addresses and the outbound interfaces precalculated for us,
+    // which the root node should use to forward packets to the stub network.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    //
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            AddRoute(SPFRoute::NETWORK, tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " add network route to "
+                                   << tempip << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask(l->GetLinkData().Get());
-            Ipv4Address tempip = l->GetLinkId();
-            tempip = tempip.CombineMask(tempmask);
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
-        } // if
-    }     // for
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
@@ -1838,69 +2508,25 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask)
 {
     NS_LOG_FUNCTION(this << a << amask);
     //
-    // We have an IP address <a> and a vertex ID of the root of the SPF tree.
-    // The question is what interface index does this address correspond to.
-    // The answer is a little complicated since we have to find a pointer to
-    // the node corresponding to the vertex ID, find the Ipv4 interface on that
-    // node in order to iterate the interfaces and find the one corresponding to
-    // the address in question.
-    //
-    Ipv4Address routerId = m_spfroot->GetVertexId();
-    //
-    // Walk the list of nodes in the system looking for the one corresponding to
-    // the node at the root of the SPF tree.  This is the node for which we are
-    // building the routing table.
+    // We have an IP address <a> and the Ipv4 interface of the node at the root
+    // of the SPF tree, found when the SPF calculation started.  The question is
+    // what interface index does this address correspond to.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    if (!m_spfRootIpv4)
     {
-        Ptr<Node> node = *i;
-
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
         //
-        // If the node doesn't have a GlobalRouter interface it can't be the one
-        // we're interested in.
+        // Couldn't find the root node.
         //
-        if (!rtr)
-        {
-            continue;
-        }
-
-        if (rtr->GetRouterId() == routerId)
-        {
-            //
-            // This is the node we're building the routing table for.  We're going to need
-            // the Ipv4 interface to look for the ipv4 interface index.  Since this node
-            // is participating in routing IP version 4 packets, it certainly must have
-            // an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Look through the interfaces on this node for one that has the IP address
-            // we're looking for.  If we find one, return the corresponding interface
-            // index, or -1 if not found.
-            //
-            int32_t interface = ipv4->GetInterfaceForPrefix(a, amask);
-
-#if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif
-            return interface;
-        }
+        NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node "
+                     << m_spfroot->GetVertexId());
+        return -1;
     }
     //
-    // Couldn't find it.
+    // Look through the interfaces on this node for one that has the IP address
+    // we're looking for.  If we find one, return the corresponding interface
+    // index, or -1 if not found.
     //
-    NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
-    return -1;
+    return m_spfRootIpv4->GetInterfaceForPrefix(a, amask);
 }
 
 //
@@ -1927,139 +2553,81 @@ GlobalRouteManagerImpl::SPFIntraAddRouter(SPFVertex* v)
     NS_ASSERT_MSG(m_spfroot, "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root pointer not set");
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries.  The routes are recorded
+    // during the SPF calculation and installed in the forwarding table of the
+    // root once the calculation is completed.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+
+    uint32_t nLinkRecords = lsa->GetNLinkRecords();
+    //
+    // Iterate through the link records on the vertex to which we're going to add
+    // routes.  To make sure we're being clear, we're going to add routing table
+    // entries to the tables on the node corresping to the root of the SPF tree.
+    // These entries will have routes to the IP addresses we find from looking at
+    // the local side of the point-to-point links found on the node described by
+    // the vertex <v>.
+    //
+    NS_LOG_LOGIC(" Router " << routerId << " found " << nLinkRecords << " link records in LSA "
+                            << lsa << "with LinkStateId " << lsa->GetLinkStateId());
+    for (uint32_t j = 0; j < nLinkRecords; ++j)
     {
-        Ptr<Node> node = *i;
         //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
+        // We are only concerned about point-to-point links
         //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
             continue;
         }
         //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
+        // Here's why we did all of that work.  We're going to add a host route to the
+        // host address found in the m_linkData field of the point-to-point link
+        // record.  In the case of a point-to-point link, this is the local IP address
+        // of the node connected to the link.  Each of these point-to-point links
+        // will correspond to a local interface that has an IP address to which
+        // the node at the root of the SPF tree can send packets.  The vertex <v>
+        // (corresponding to the node that has these links and interfaces) has
+        // an m_nextHop address precalculated for us that is the address to which the
+        // root node should send packets to be forwarded to these IP addresses.
+        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+        // which the packets should be send for forwarding.
         //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        // walk through all available exit directions due to ECMP,
+        // and add host route for each of the exit direction toward
+        // the vertex 'v'
+        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-
-            uint32_t nLinkRecords = lsa->GetNLinkRecords();
-            //
-            // Iterate through the link records on the vertex to which we're going to add
-            // routes.  To make sure we're being clear, we're going to add routing table
-            // entries to the tables on the node corresping to the root of the SPF tree.
-            // These entries will have routes to the IP addresses we find from looking at
-            // the local side of the point-to-point links found on the node described by
-            // the vertex <v>.
-            //
-            NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
-                                  << " link records in LSA " << lsa << "with LinkStateId "
-                                  << lsa->GetLinkStateId());
-            for (uint32_t j = 0; j < nLinkRecords; ++j)
+            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+            Ipv4Address nextHop = exit.first;
+            int32_t outIf = exit.second;
+            if (outIf >= 0)
             {
-                //
-                // We are only concerned about point-to-point links
-                //
-                GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
-                if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                    continue;
-                }
-                //
-                // Here's why we did all of that work.  We're going to add a host route to the
-                // host address found in the m_linkData field of the point-to-point link
-                // record.  In the case of a point-to-point link, this is the local IP address
-                // of the node connected to the link.  Each of these point-to-point links
-                // will correspond to a local interface that has an IP address to which
-                // the node at the root of the SPF tree can send packets.  The vertex <v>
-                // (corresponding to the node that has these links and interfaces) has
-                // an m_nextHop address precalculated for us that is the address to which the
-                // root node should send packets to be forwarded to these IP addresses.
-                // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-                // which the packets should be send for forwarding.
-                //
-                Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-                if (!router)
-                {
-                    continue;
-                }
-                Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                NS_ASSERT(gr);
-                // walk through all available exit directions due to ECMP,
-                // and add host route for each of the exit direction toward
-                // the vertex 'v'
-                for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-                {
-                    SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                    Ipv4Address nextHop = exit.first;
-                    int32_t outIf = exit.second;
-                    if (outIf >= 0)
-                    {
-                        gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " adding host route to " << lr->GetLinkData()
-                                               << " using next hop " << nextHop
-                                               << " and outgoing interface " << outIf);
-                    }
-                    else
-                    {
-                        NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                               << " NOT able to add host route to "
-                                               << lr->GetLinkData() << " using next hop " << nextHop
-                                               << " since outgoing interface id is negative "
-                                               << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
+                AddRoute(SPFRoute::HOST, lr->GetLinkData(), Ipv4Mask::GetOnes(), nextHop, outIf);
+                NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " adding host route to "
+                                       << lr->GetLinkData() << " using next hop " << nextHop
+                                       << " and outgoing interface " << outIf);
             }
-            //
-            // Done adding the routes for the selected node.
-            //
-            return;
-        }
+            else
+            {
+                NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                       << " NOT able to add host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'v'
     }
 }
 
@@ -2071,100 +2639,46 @@ GlobalRouteManagerImpl::SPFIntraAddTransit(SPFVertex* v)
     NS_ASSERT_MSG(m_spfroot, "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root pointer not set");
     //
     // The root of the Shortest Path First tree is the router to which we are
-    // going to write the actual routing table entries.  The vertex corresponding
-    // to this router has a vertex ID which is the router ID of that node.  We're
-    // going to use this ID to discover which node it is that we're actually going
-    // to update.
+    // going to write the actual routing table entries.  The routes are recorded
+    // during the SPF calculation and installed in the forwarding table of the
+    // root once the calculation is completed.
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to, which describes the transit network.
     //
-    NodeList::Iterator i = NodeList::Begin();
-    NodeList::Iterator listEnd = NodeList::End();
-    for (; i != listEnd; i++)
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = lsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+    // walk through all available exit directions due to ECMP,
+    // and add host route for each of the exit direction toward
+    // the vertex 'v'
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
 
-        if (!rtr)
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            AddRoute(SPFRoute::NETWORK, tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId << " add network route to "
+                                   << tempip << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = lsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Router " << routerId
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative " << outIf);
         }
     }
 }
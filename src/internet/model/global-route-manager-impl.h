@@ -32,6 +32,7 @@
 #include <map>
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -40,7 +41,9 @@ namespace ns3
 const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
+class Ipv4;
 class Ipv4GlobalRouting;
+class SPFReverseGraph;
 
 /**
  * \ingroup globalrouting
@@ -640,6 +643,14 @@ class GlobalRouteManagerLSDB
      */
     GlobalRoutingLSA* GetLSAByLinkData(Ipv4Address addr) const;
 
+    /**
+     * @brief Get the Link State Advertisements of the routers and of the
+     * transit networks, i.e., all but the External Link State Advertisements.
+     *
+     * @returns the Link State Advertisements, ordered by link state ID
+     */
+    std::vector<GlobalRoutingLSA*> GetLSAs() const;
+
     /**
      * @brief Set all LSA flags to an initialized state, for SPF computation
      *
@@ -682,6 +693,8 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+    /// the Link State Advertisements indexed by the link data of their transit network records
+    std::map<Ipv4Address, GlobalRoutingLSA*> m_transitLinkData;
 };
 
 /**
@@ -723,9 +736,35 @@ class GlobalRouteManagerImpl
     /**
      * @brief Compute routes using a Dijkstra SPF computation and populate
      * per-node forwarding tables
+     *
+     * The SPF calculations of the routers are run by the number of threads
+     * set by the GlobalRoutingSpfThreads global value, sharing the LSDB, and
+     * the resulting routes are installed in the order of the routers, so that
+     * the forwarding tables do not depend on the number of threads.  The
+     * calculations are run by the simulator thread only if the logging of the
+     * GlobalRouteManagerImpl component is enabled; the logging of the Ipv4
+     * implementation should not be enabled when using several threads.
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Rebuild the routing database and update the forwarding tables
+     * after a change of the topology (e.g., an interface going up or down).
+     *
+     * If the GlobalRoutingIncrementalUpdate global value is false, or routes have
+     * not been computed yet, this is equivalent to calling DeleteGlobalRoutes (),
+     * BuildGlobalRoutingDatabase () and InitializeRoutes ().  Otherwise, the new
+     * LSDB is compared to the previous one, the SPF calculation is run again only
+     * for the routers whose shortest path trees may have changed, and the routes
+     * to the links and stub networks of the changed routers are updated in the
+     * forwarding tables of the other routers.  The forwarding tables then contain
+     * the same routes as with a full recomputation, possibly in a different order,
+     * and the routes added manually to the routers that are not recomputed are
+     * kept.  Changes involving transit networks, external routes, or routers
+     * joining or leaving the routing domain cause a full recomputation.
+     */
+    virtual void RecomputeRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -739,8 +778,121 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /// A route computed by the SPF calculation for the router at the root of the tree
+    struct SPFRoute
+    {
+        /// The type of route
+        enum Type
+        {
+            HOST,    //!< host route, added with AddHostRouteTo ()
+            NETWORK, //!< network route, added with AddNetworkRouteTo ()
+            EXTERNAL //!< AS external route, added with AddASExternalRouteTo ()
+        };
+
+        Type m_type;           //!< the type of route
+        Ipv4Address m_dest;    //!< the destination host or network
+        Ipv4Mask m_mask;       //!< the mask of the destination network
+        Ipv4Address m_nextHop; //!< the next hop
+        uint32_t m_interface;  //!< the outgoing interface
+    };
+
+    /// The objects of a router involved in the computation of its routes
+    struct RouterInfo
+    {
+        Ptr<Ipv4> m_ipv4;                 //!< the Ipv4 of the router
+        Ptr<Ipv4GlobalRouting> m_routing; //!< the global routing protocol of the router
+    };
+
+    /// Container of the router IDs / routers
+    typedef std::map<Ipv4Address, RouterInfo> RouterMap_t;
+
+    /**
+     * @brief Construct an instance running SPF calculations on the LSDB of another
+     * instance, which is not modified nor deleted.
+     * @param owner the instance owning the LSDB
+     */
+    explicit GlobalRouteManagerImpl(const GlobalRouteManagerImpl* owner);
+
+    /**
+     * @brief Find the routers of the simulation, i.e., the nodes with a GlobalRouter
+     * interface, and those whose routes are computed by this system.
+     */
+    void FindRouters();
+
+    /**
+     * @brief Run the SPF calculations of the given routers and install the resulting
+     * routes, possibly using several threads.
+     * @param roots the router IDs of the routers
+     */
+    void CalculateRoutes(const std::vector<Ipv4Address>& roots);
+
+    /**
+     * @brief Install routes in the forwarding table of a router.
+     * @param root the router ID of the router
+     * @param routes the routes
+     */
+    void InstallRoutes(Ipv4Address root, const std::vector<SPFRoute>& routes) const;
+
+    /**
+     * @brief Record a route of the router at the root of the SPF tree.
+     * @param type the type of route
+     * @param dest the destination host or network
+     * @param mask the mask of the destination network
+     * @param nextHop the next hop
+     * @param outIf the outgoing interface
+     */
+    void AddRoute(SPFRoute::Type type,
+                  Ipv4Address dest,
+                  Ipv4Mask mask,
+                  Ipv4Address nextHop,
+                  uint32_t outIf);
+
+    /**
+     * @brief Get the status of an LSA in the current SPF calculation.
+     * @param lsa the LSA
+     * @returns the status of the LSA
+     */
+    GlobalRoutingLSA::SPFStatus GetLSAStatus(const GlobalRoutingLSA* lsa) const;
+
+    /**
+     * @brief Set the status of an LSA in the current SPF calculation.
+     * @param lsa the LSA
+     * @param status the status of the LSA
+     */
+    void SetLSAStatus(const GlobalRoutingLSA* lsa, GlobalRoutingLSA::SPFStatus status);
+
+    /**
+     * @brief Compute the exit directions of the router at the root of the SPF tree
+     * towards a vertex, from the distances of all the vertices to that vertex.
+     *
+     * Only the point-to-point links of the root are considered, and the exit
+     * directions are those the SPF calculation would set in the vertex.
+     *
+     * @param rootLsa the LSA of the root
+     * @param rootIpv4 the Ipv4 of the root
+     * @param graph the graph of the LSDB
+     * @param distances the distances of the vertices of the graph to the vertex
+     * @param exits the exit directions (output)
+     * @returns false if the exit directions cannot be computed this way
+     */
+    static bool GetRootExitDirections(const GlobalRoutingLSA* rootLsa,
+                                      Ptr<Ipv4> rootIpv4,
+                                      const SPFReverseGraph& graph,
+                                      const std::vector<uint64_t>& distances,
+                                      std::vector<SPFVertex::NodeExit_t>& exits);
+
     SPFVertex* m_spfroot;           //!< the root node
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    bool m_ownsLsdb;                //!< whether the LSDB is deleted by this instance
+    bool m_routesComputed;          //!< whether the routes of the current LSDB are installed
+    RouterMap_t m_routers;          //!< the routers of the simulation
+    /// the router IDs of the routers whose routes are computed
+    std::vector<Ipv4Address> m_roots;
+    const Ipv4* m_spfRootIpv4; //!< the Ipv4 of the root of the SPF tree
+    /// the routes computed for the root of the SPF tree
+    std::vector<SPFRoute> m_spfRoutes;
+    /// the status of the LSAs in the current SPF calculation (not explored if missing)
+    std::unordered_map<const GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus> m_lsaStatus;
 
     /**
      * \brief Test if a node is a stub, from an OSPF sense.
@@ -758,9 +910,16 @@ class GlobalRouteManagerImpl
      * \brief Calculate the shortest path first (SPF) tree
      *
      * Equivalent to quagga ospf_spf_calculate
+     *
+     * This method may be run by several threads at once (see CalculateRoutes ()),
+     * hence it must not access the node list nor the reference counts of the
+     * objects of the simulation.
+     *
      * \param root the root node
+     * \param haveNodes whether the node list is not empty (if it is, the stub node
+     *        optimization is disabled)
      */
-    void SPFCalculate(Ipv4Address root);
+    void SPFCalculate(Ipv4Address root, bool haveNodes);
 
     /**
      * \brief Process Stub nodes
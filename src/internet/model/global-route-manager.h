@@ -71,6 +71,15 @@ class GlobalRouteManager
      * per-node forwarding tables
      */
     static void InitializeRoutes();
+
+    /**
+     * @brief Rebuild the routing database and update the per-node forwarding
+     * tables after a change of the topology
+     *
+     * The forwarding tables are computed again from scratch, unless the
+     * GlobalRoutingIncrementalUpdate global value is true.
+     */
+    static void RecomputeRoutes();
 };
 
 } // namespace ns3
@@ -25,11 +25,57 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("Ipv4EndPointDemux");
 
+/**
+ * \brief Remove an endpoint from an index.
+ * \param index the index
+ * \param key the key the endpoint is indexed with
+ * \param endPoint the endpoint
+ */
+template <typename Index, typename Key>
+static void
+EraseEndPoint(Index& index, const Key& key, Ipv4EndPoint* endPoint)
+{
+    auto range = index.equal_range(key);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        if (it->second == endPoint)
+        {
+            index.erase(it);
+            return;
+        }
+    }
+    NS_ASSERT_MSG(false, "Endpoint " << endPoint << " not indexed");
+}
+
+bool
+Ipv4EndPointDemux::Tuple::operator==(const Tuple& other) const
+{
+    return m_localAddress == other.m_localAddress && m_localPort == other.m_localPort &&
+           m_peerAddress == other.m_peerAddress && m_peerPort == other.m_peerPort;
+}
+
+std::size_t
+Ipv4EndPointDemux::TupleHash::operator()(const Tuple& tuple) const
+{
+    uint64_t addresses =
+        static_cast<uint64_t>(tuple.m_localAddress.Get()) << 32 | tuple.m_peerAddress.Get();
+    uint64_t ports = static_cast<uint64_t>(tuple.m_localPort) << 16 | tuple.m_peerPort;
+    // mix the bits, as the addresses of the endpoints often differ in a few bits only
+    uint64_t hash = addresses ^ (ports * 0x9e3779b97f4a7c15ULL);
+    hash ^= hash >> 32;
+    hash *= 0xd6e8feb86659fd93ULL;
+    hash ^= hash >> 32;
+    return static_cast<std::size_t>(hash);
+}
+
 Ipv4EndPointDemux::Ipv4EndPointDemux()
     : m_ephemeral(49152),
       m_portLast(65535),
@@ -47,30 +93,110 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_entries.clear();
+    m_tuples.clear();
+    m_locals.clear();
+    m_ports.clear();
 }
 
-bool
-Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv4EndPointDemux::Tuple
+Ipv4EndPointDemux::GetTuple(Ipv4EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return {endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+}
+
+void
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Entry& entry = m_entries[endPoint];
+    entry.m_position = m_endPoints.insert(m_endPoints.end(), endPoint);
+    entry.m_tuple = GetTuple(endPoint);
+    Index(endPoint, entry.m_tuple);
+    endPoint->SetChangeCallback(MakeCallback(&Ipv4EndPointDemux::Reindex, this, endPoint));
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint, const Tuple& tuple)
+{
+    m_tuples.emplace(tuple, endPoint);
+    m_locals.emplace(Tuple{tuple.m_localAddress, tuple.m_localPort, Ipv4Address::GetAny(), 0},
+                     endPoint);
+    m_ports[tuple.m_localPort]++;
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint, const Tuple& tuple)
+{
+    EraseEndPoint(m_tuples, tuple, endPoint);
+    EraseEndPoint(m_locals,
+                  Tuple{tuple.m_localAddress, tuple.m_localPort, Ipv4Address::GetAny(), 0},
+                  endPoint);
+    auto port = m_ports.find(tuple.m_localPort);
+    if (--port->second == 0)
+    {
+        m_ports.erase(port);
+    }
+}
+
+void
+Ipv4EndPointDemux::Reindex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto entry = m_entries.find(endPoint);
+    NS_ASSERT_MSG(entry != m_entries.end(), "Endpoint " << endPoint << " not allocated");
+    Unindex(endPoint, entry->second.m_tuple);
+    entry->second.m_tuple = GetTuple(endPoint);
+    Index(endPoint, entry->second.m_tuple);
+}
+
+void
+Ipv4EndPointDemux::Find(const Tuple& tuple,
+                        Ptr<Ipv4Interface> incomingInterface,
+                        EndPoints& endPoints)
+{
+    auto range = m_tuples.equal_range(tuple);
+    for (auto it = range.first; it != range.second; it++)
     {
-        if ((*i)->GetLocalPort() == port)
+        Ipv4EndPoint* endP = it->second;
+        if (!endP->IsRxEnabled())
         {
-            return true;
+            NS_LOG_LOGIC("Skipping endpoint " << endP
+                                              << " because endpoint can not receive packets");
+            continue;
+        }
+        if (endP->GetBoundNetDevice() &&
+            (!incomingInterface || endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            NS_LOG_LOGIC("Skipping endpoint " << endP
+                                              << " because endpoint is bound to specific device "
+                                              << endP->GetBoundNetDevice()
+                                              << " which does not match packet device");
+            continue;
         }
+        endPoints.push_back(endP);
     }
-    return false;
+}
+
+bool
+Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto range = m_locals.equal_range(Tuple{addr, port, Ipv4Address::GetAny(), 0});
+    for (auto it = range.first; it != range.second; it++)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        if (it->second->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -89,8 +215,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -105,8 +230,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -128,8 +252,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -141,11 +264,10 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto range = m_tuples.equal_range(Tuple{localAddress, localPort, peerAddress, peerPort});
+    for (auto it = range.first; it != range.second; it++)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        if (it->second->GetBoundNetDevice() == boundNetDevice || !it->second->GetBoundNetDevice())
         {
             NS_LOG_WARN("Duplicated endpoint.");
             return nullptr;
@@ -153,10 +275,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
     }
     Ipv4EndPoint* endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -164,14 +283,13 @@ void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto entry = m_entries.find(endPoint);
+    if (entry != m_entries.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        Unindex(endPoint, entry->second.m_tuple);
+        m_endPoints.erase(entry->second.m_position);
+        m_entries.erase(entry);
+        delete endPoint;
     }
 }
 
@@ -193,9 +311,19 @@ Ipv4EndPointDemux::GetAllEndPoints()
 }
 
 /*
- * If we have an exact match, we return it.
- * Otherwise, if we find a generic match, we return it.
- * Otherwise, we return 0.
+ * The endpoints matching a packet are, from the most to the least exact:
+ *   4. those with the local address, local port, peer address and peer port
+ *      of the packet
+ *   3. those with a wildcard local address, and the local port, peer address
+ *      and peer port of the packet
+ *   2. those with the local address and local port of the packet, and a
+ *      wildcard peer
+ *   1. those with a wildcard local address, the local port of the packet, and
+ *      a wildcard peer
+ * where a wildcard local address is either Any, or the network address of an
+ * address of the incoming interface whose network contains the destination
+ * (which matches subnet-directed broadcast packets).  Each case is found by
+ * looking up the corresponding tuples in the index.
  */
 Ipv4EndPointDemux::EndPoints
 Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
@@ -205,160 +333,62 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
                           Ptr<Ipv4Interface> incomingInterface)
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; // Matches exact on local port, wildcards on others
-    EndPoints retval2; // Matches exact on local port/adder, wildcards on others
-    EndPoints retval3; // Matches all but local address
-    EndPoints retval4; // Exact match on all 4
-
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv4EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
 
-        if (endP->GetLocalPort() != dport)
+    EndPoints retval;
+    Find(Tuple{daddr, dport, saddr, sport}, incomingInterface, retval);
+    if (!retval.empty())
+    { // All 4 match - this is the case of an open TCP connection, for example.
+        NS_LOG_LOGIC("Found an endpoint for case 4");
+    }
+    else
+    {
+        // The wildcard local addresses matching the destination address
+        std::vector<Ipv4Address> wildcards;
+        if (daddr != Ipv4Address::GetAny())
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
+            wildcards.push_back(Ipv4Address::GetAny());
         }
-        if (endP->GetBoundNetDevice())
+        for (uint32_t i = 0; incomingInterface && i < incomingInterface->GetNAddresses(); i++)
         {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+            if (addrNetpart != daddr && daddr.CombineMask(addr.GetMask()) == addrNetpart &&
+                std::find(wildcards.begin(), wildcards.end(), addrNetpart) == wildcards.end())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
+                wildcards.push_back(addrNetpart);
             }
         }
 
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
-
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
-
-        if (endP->GetLocalAddress() == daddr)
+        for (const auto& wildcard : wildcards)
         {
-            // Case 1:
-            localAddressMatchesExact = true;
+            Find(Tuple{wildcard, dport, saddr, sport}, incomingInterface, retval);
         }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
+        if (!retval.empty())
+        { // All but local address - no idea what this case could be.
+            NS_LOG_LOGIC("Found an endpoint for case 3");
         }
         else
         {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
+            Find(Tuple{daddr, dport, Ipv4Address::GetAny(), 0}, incomingInterface, retval);
+            if (!retval.empty())
+            { // Only local port and local address matches exactly - Not yet opened connection
+                NS_LOG_LOGIC("Found an endpoint for case 2");
+            }
+            else
             {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
-
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
+                for (const auto& wildcard : wildcards)
                 {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
-
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
-                    {
-                        localAddressIsSubnetAny = true;
-                    }
+                    Find(Tuple{wildcard, dport, Ipv4Address::GetAny(), 0},
+                         incomingInterface,
+                         retval);
                 }
+                // Only local port matches exactly - Endpoint open to "any" connection
+                NS_LOG_LOGIC("Found " << retval.size() << " endpoints for case 1");
             }
-
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
-            {
-                continue;
-            }
-        }
-
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
-
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
-
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
         }
     }
 
-    // Here we find the most exact match
-    EndPoints retval;
-    if (!retval4.empty())
-    {
-        retval = retval4;
-    }
-    else if (!retval3.empty())
-    {
-        retval = retval3;
-    }
-    else if (!retval2.empty())
-    {
-        retval = retval2;
-    }
-    else
-    {
-        retval = retval1;
-    }
-
     NS_ABORT_MSG_IF(retval.size() > 1,
                     "Too many endpoints - perhaps you created too many sockets without binding "
                     "them to different NetDevices.");
@@ -373,6 +403,13 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    Tuple tuple{daddr, dport, saddr, sport};
+    if (m_tuples.count(tuple) == 1)
+    {
+        /* this is an exact match. */
+        return m_tuples.find(tuple)->second;
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
     uint32_t genericity = 3;
@@ -27,6 +27,7 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -43,6 +44,13 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are indexed in hash tables by their four-tuple, by their
+ * local address and port, and by their local port, so that the lookups do
+ * not scan the whole list.  A lookup probes the exact four-tuple of the
+ * packet first, then the four-tuples of the endpoints with wildcards that
+ * may match it.  The endpoints notify the demux when their addresses or
+ * ports change.
  */
 
 class Ipv4EndPointDemux
@@ -172,6 +180,87 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    /**
+     * \brief The local address and port, and the peer address and port, of an endpoint.
+     */
+    struct Tuple
+    {
+        Ipv4Address m_localAddress; //!< the local address
+        uint16_t m_localPort;       //!< the local port
+        Ipv4Address m_peerAddress;  //!< the peer address
+        uint16_t m_peerPort;        //!< the peer port
+
+        /**
+         * \brief Equality operator.
+         * \param other the tuple to compare with
+         * \returns true if the tuples are equal
+         */
+        bool operator==(const Tuple& other) const;
+    };
+
+    /**
+     * \brief Hash function of the tuples.
+     */
+    struct TupleHash
+    {
+        /**
+         * \brief Hash a tuple.
+         * \param tuple the tuple
+         * \returns the hash of the tuple
+         */
+        std::size_t operator()(const Tuple& tuple) const;
+    };
+
+    /**
+     * \brief The position of an endpoint in the list, and the tuple it is indexed with.
+     */
+    struct Entry
+    {
+        EndPointsI m_position; //!< the position of the endpoint in the list
+        Tuple m_tuple;         //!< the tuple the endpoint is indexed with
+    };
+
+    /**
+     * \brief Get the tuple of an endpoint.
+     * \param endPoint the endpoint
+     * \returns the tuple
+     */
+    static Tuple GetTuple(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Add an endpoint to the list and to the indexes.
+     * \param endPoint the endpoint
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Add an endpoint to the indexes.
+     * \param endPoint the endpoint
+     * \param tuple the tuple of the endpoint
+     */
+    void Index(Ipv4EndPoint* endPoint, const Tuple& tuple);
+
+    /**
+     * \brief Remove an endpoint from the indexes.
+     * \param endPoint the endpoint
+     * \param tuple the tuple the endpoint is indexed with
+     */
+    void Unindex(Ipv4EndPoint* endPoint, const Tuple& tuple);
+
+    /**
+     * \brief Index again an endpoint whose addresses or ports changed.
+     * \param endPoint the endpoint
+     */
+    void Reindex(Ipv4EndPoint* endPoint);
+
+    /**
+     * \brief Find the endpoints with a tuple which can receive packets from an interface.
+     * \param tuple the tuple
+     * \param incomingInterface the incoming interface
+     * \param endPoints the list the endpoints found are added to
+     */
+    void Find(const Tuple& tuple, Ptr<Ipv4Interface> incomingInterface, EndPoints& endPoints);
+
     /**
      * \brief Allocate an ephemeral port.
      * \returns the ephemeral port
@@ -197,6 +286,27 @@ class Ipv4EndPointDemux
      * \brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * \brief The entries of the endpoints.
+     */
+    std::unordered_map<Ipv4EndPoint*, Entry> m_entries;
+
+    /**
+     * \brief The endpoints indexed by their tuple.
+     */
+    std::unordered_multimap<Tuple, Ipv4EndPoint*, TupleHash> m_tuples;
+
+    /**
+     * \brief The endpoints indexed by their local address and port (in a
+     * tuple with a wildcard peer).
+     */
+    std::unordered_multimap<Tuple, Ipv4EndPoint*, TupleHash> m_locals;
+
+    /**
+     * \brief The number of endpoints of each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_ports;
 };
 
 } // namespace ns3
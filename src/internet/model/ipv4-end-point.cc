@@ -49,6 +49,7 @@ Ipv4EndPoint::~Ipv4EndPoint()
     m_rxCallback.Nullify();
     m_icmpCallback.Nullify();
     m_destroyCallback.Nullify();
+    m_changeCallback.Nullify();
 }
 
 Ipv4Address
@@ -63,6 +64,10 @@ Ipv4EndPoint::SetLocalAddress(Ipv4Address address)
 {
     NS_LOG_FUNCTION(this << address);
     m_localAddr = address;
+    if (!m_changeCallback.IsNull())
+    {
+        m_changeCallback();
+    }
 }
 
 uint16_t
@@ -92,6 +97,10 @@ Ipv4EndPoint::SetPeer(Ipv4Address address, uint16_t port)
     NS_LOG_FUNCTION(this << address << port);
     m_peerAddr = address;
     m_peerPort = port;
+    if (!m_changeCallback.IsNull())
+    {
+        m_changeCallback();
+    }
 }
 
 void
@@ -131,6 +140,13 @@ Ipv4EndPoint::SetDestroyCallback(Callback<void> callback)
     m_destroyCallback = callback;
 }
 
+void
+Ipv4EndPoint::SetChangeCallback(Callback<void> callback)
+{
+    NS_LOG_FUNCTION(this << &callback);
+    m_changeCallback = callback;
+}
+
 void
 Ipv4EndPoint::ForwardUp(Ptr<Packet> p,
                         const Ipv4Header& header,
@@ -144,6 +144,15 @@ class Ipv4EndPoint
      * \param callback callback function
      */
     void SetDestroyCallback(Callback<void> callback);
+    /**
+     * \brief Set the callback invoked when the local address, or the peer
+     * address and port, of the endpoint change.
+     *
+     * The Ipv4EndPointDemux uses it to keep its indexes up to date.
+     *
+     * \param callback callback function
+     */
+    void SetChangeCallback(Callback<void> callback);
 
     /**
      * \brief Forward the packet to the upper level.
@@ -231,6 +240,11 @@ class Ipv4EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * \brief The change callback.
+     */
+    Callback<void> m_changeCallback;
+
     /**
      * \brief true if the endpoint can receive packets.
      */
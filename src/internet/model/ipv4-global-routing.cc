@@ -31,7 +31,10 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <numeric>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -41,6 +44,212 @@ NS_LOG_COMPONENT_DEFINE("Ipv4GlobalRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4GlobalRouting);
 
+/**
+ * \ingroup ipv4
+ *
+ * \brief The destinations of the compact routing tables.
+ *
+ * A single table is shared by all the Ipv4GlobalRouting instances with a
+ * compact routing table, whose routes refer to their destination by index.  The
+ * destinations are kept until no compact routing table uses the table anymore.
+ */
+class Ipv4GlobalRouting::Destinations : public SimpleRefCount<Ipv4GlobalRouting::Destinations>
+{
+  public:
+    ~Destinations();
+
+    /**
+     * \return the shared table, created if needed
+     */
+    static Ptr<Destinations> Get();
+
+    /**
+     * \return the estimated number of bytes used by the shared table, if any
+     */
+    static std::size_t GetSharedMemoryUsage();
+
+    /**
+     * \brief Add a destination, if not in the table yet.
+     * \param network the network (or host)
+     * \param mask the mask
+     * \return the index of the destination
+     */
+    uint32_t Add(Ipv4Address network, Ipv4Mask mask);
+
+    /**
+     * \brief Find a destination.
+     * \param network the network (or host)
+     * \param mask the mask
+     * \param index the index of the destination (output)
+     * \return true if the destination is in the table
+     */
+    bool Find(Ipv4Address network, Ipv4Mask mask, uint32_t& index) const;
+
+    /**
+     * \brief Find the destinations containing an address.
+     * \param dest the address
+     * \param destinations the vector to which the destinations are appended
+     */
+    void Lookup(Ipv4Address dest, std::vector<Ipv4PrefixTrie<uint32_t>::Entry>& destinations) const;
+
+    /**
+     * \param index the index of a destination
+     * \return the network (or host) of the destination
+     */
+    Ipv4Address GetNetwork(uint32_t index) const;
+
+    /**
+     * \param index the index of a destination
+     * \return the mask of the destination
+     */
+    Ipv4Mask GetMask(uint32_t index) const;
+
+  private:
+    /**
+     * \param network the network (or host)
+     * \param mask the mask
+     * \return the key of the destination in m_indexes
+     */
+    static uint64_t GetKey(Ipv4Address network, Ipv4Mask mask);
+
+    static Destinations* s_destinations; //!< the shared table
+
+    std::vector<std::pair<Ipv4Address, Ipv4Mask>> m_destinations; //!< the destinations
+    std::unordered_map<uint64_t, uint32_t> m_indexes; //!< the indexes of the destinations
+    Ipv4PrefixTrie<uint32_t> m_trie;                  //!< the indexes by prefix
+};
+
+Ipv4GlobalRouting::Destinations* Ipv4GlobalRouting::Destinations::s_destinations = nullptr;
+
+Ipv4GlobalRouting::Destinations::~Destinations()
+{
+    s_destinations = nullptr;
+}
+
+Ptr<Ipv4GlobalRouting::Destinations>
+Ipv4GlobalRouting::Destinations::Get()
+{
+    if (!s_destinations)
+    {
+        s_destinations = new Destinations();
+        // the table is deleted when the last compact routing table releases it
+        return Ptr<Destinations>(s_destinations, false);
+    }
+    return Ptr<Destinations>(s_destinations);
+}
+
+std::size_t
+Ipv4GlobalRouting::Destinations::GetSharedMemoryUsage()
+{
+    if (!s_destinations)
+    {
+        return 0;
+    }
+    const Destinations* table = s_destinations;
+    // a node of the hash table holds a pointer to the next node besides the value
+    return sizeof(Destinations) +
+           table->m_destinations.capacity() * sizeof(std::pair<Ipv4Address, Ipv4Mask>) +
+           table->m_indexes.size() * (sizeof(std::pair<const uint64_t, uint32_t>) + sizeof(void*)) +
+           table->m_indexes.bucket_count() * sizeof(void*) + table->m_trie.GetMemoryUsage();
+}
+
+uint64_t
+Ipv4GlobalRouting::Destinations::GetKey(Ipv4Address network, Ipv4Mask mask)
+{
+    return (static_cast<uint64_t>(network.Get()) << 32) | mask.Get();
+}
+
+uint32_t
+Ipv4GlobalRouting::Destinations::Add(Ipv4Address network, Ipv4Mask mask)
+{
+    auto result = m_indexes.emplace(GetKey(network, mask), m_destinations.size());
+    if (result.second)
+    {
+        m_destinations.emplace_back(network, mask);
+        m_trie.Insert(network, mask, result.first->second);
+    }
+    return result.first->second;
+}
+
+bool
+Ipv4GlobalRouting::Destinations::Find(Ipv4Address network, Ipv4Mask mask, uint32_t& index) const
+{
+    auto it = m_indexes.find(GetKey(network, mask));
+    if (it == m_indexes.end())
+    {
+        return false;
+    }
+    index = it->second;
+    return true;
+}
+
+void
+Ipv4GlobalRouting::Destinations::Lookup(
+    Ipv4Address dest,
+    std::vector<Ipv4PrefixTrie<uint32_t>::Entry>& destinations) const
+{
+    m_trie.Lookup(dest, destinations);
+}
+
+Ipv4Address
+Ipv4GlobalRouting::Destinations::GetNetwork(uint32_t index) const
+{
+    return m_destinations[index].first;
+}
+
+Ipv4Mask
+Ipv4GlobalRouting::Destinations::GetMask(uint32_t index) const
+{
+    return m_destinations[index].second;
+}
+
+void
+Ipv4GlobalRouting::CompactRoutes::Find(
+    const std::vector<Ipv4PrefixTrie<uint32_t>::Entry>& destinations,
+    std::vector<uint32_t>& positions)
+{
+    if (!m_indexed)
+    {
+        // the routes are added in bursts, and indexed again at the first lookup
+        m_routes.shrink_to_fit();
+        m_index.resize(m_routes.size());
+        std::iota(m_index.begin(), m_index.end(), 0);
+        std::stable_sort(m_index.begin(), m_index.end(), [this](uint32_t a, uint32_t b) {
+            return m_routes[a].m_destination < m_routes[b].m_destination;
+        });
+        m_index.shrink_to_fit();
+        m_indexed = true;
+    }
+    std::size_t begin = positions.size();
+    for (const auto& destination : destinations)
+    {
+        auto it = std::lower_bound(m_index.begin(),
+                                   m_index.end(),
+                                   destination.second,
+                                   [this](uint32_t position, uint32_t index) {
+                                       return m_routes[position].m_destination < index;
+                                   });
+        for (; it != m_index.end() && m_routes[*it].m_destination == destination.second; it++)
+        {
+            positions.push_back(*it);
+        }
+    }
+    std::sort(positions.begin() + begin, positions.end());
+}
+
+void
+Ipv4GlobalRouting::CompactRoutes::Erase(uint32_t position)
+{
+    m_routes.erase(m_routes.begin() + position);
+    m_indexed = false;
+}
+
+std::size_t
+Ipv4GlobalRouting::CompactRoutes::GetMemoryUsage() const
+{
+    return m_routes.capacity() * sizeof(CompactRoute) + m_index.capacity() * sizeof(uint32_t);
+}
+
 TypeId
 Ipv4GlobalRouting::GetTypeId()
 {
@@ -48,6 +257,7 @@ Ipv4GlobalRouting::GetTypeId()
         TypeId("ns3::Ipv4GlobalRouting")
             .SetParent<Object>()
             .SetGroupName("Internet")
+            .AddConstructor<Ipv4GlobalRouting>()
             .AddAttribute("RandomEcmpRouting",
                           "Set to true if packets are randomly routed among ECMP; set to false for "
                           "using only one route consistently",
@@ -59,13 +269,21 @@ Ipv4GlobalRouting::GetTypeId()
                           "Interface notification events (up/down, or add/remove address)",
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_respondToInterfaceEvents),
+                          MakeBooleanChecker())
+            .AddAttribute("CompactRoutingTable",
+                          "Set to true to store the routes in a compact routing table, which "
+                          "shares the destinations of the routes with the other nodes. It must "
+                          "be set before any route is added.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&Ipv4GlobalRouting::m_compactRoutingTable),
                           MakeBooleanChecker());
     return tid;
 }
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_compactRoutingTable(false)
 {
     NS_LOG_FUNCTION(this);
 
@@ -81,18 +299,34 @@ void
 Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_t interface)
 {
     NS_LOG_FUNCTION(this << dest << nextHop << interface);
+    if (m_compactRoutingTable)
+    {
+        AddCompactRoute(m_compactHostRoutes, dest, Ipv4Mask::GetOnes(), nextHop, interface);
+        return;
+    }
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    m_hostRouteTrie.Insert(dest, Ipv4Mask::GetOnes(), route);
 }
 
 void
 Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
 {
     NS_LOG_FUNCTION(this << dest << interface);
+    if (m_compactRoutingTable)
+    {
+        AddCompactRoute(m_compactHostRoutes,
+                        dest,
+                        Ipv4Mask::GetOnes(),
+                        Ipv4Address::GetZero(),
+                        interface);
+        return;
+    }
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    m_hostRouteTrie.Insert(dest, Ipv4Mask::GetOnes(), route);
 }
 
 void
@@ -102,18 +336,34 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
                                      uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    if (m_compactRoutingTable)
+    {
+        AddCompactRoute(m_compactNetworkRoutes, network, networkMask, nextHop, interface);
+        return;
+    }
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    m_networkRouteTrie.Insert(network, networkMask, route);
 }
 
 void
 Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask, uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << interface);
+    if (m_compactRoutingTable)
+    {
+        AddCompactRoute(m_compactNetworkRoutes,
+                        network,
+                        networkMask,
+                        Ipv4Address::GetZero(),
+                        interface);
+        return;
+    }
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    m_networkRouteTrie.Insert(network, networkMask, route);
 }
 
 void
@@ -123,9 +373,112 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
                                         uint32_t interface)
 {
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    if (m_compactRoutingTable)
+    {
+        AddCompactRoute(m_compactASexternalRoutes, network, networkMask, nextHop, interface);
+        return;
+    }
     Ipv4RoutingTableEntry* route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    m_ASexternalRouteTrie.Insert(network, networkMask, route);
+}
+
+void
+Ipv4GlobalRouting::AddCompactRoute(CompactRoutes& routes,
+                                   Ipv4Address network,
+                                   Ipv4Mask networkMask,
+                                   Ipv4Address nextHop,
+                                   uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    if (!m_destinations)
+    {
+        m_destinations = Destinations::Get();
+    }
+    uint32_t destination = m_destinations->Add(network, networkMask);
+    routes.m_routes.push_back({destination, nextHop.Get(), interface});
+    routes.m_indexed = false;
+}
+
+bool
+Ipv4GlobalRouting::RemoveCompactRoute(CompactRoutes& routes,
+                                      Ipv4Address network,
+                                      Ipv4Mask networkMask,
+                                      Ipv4Address nextHop,
+                                      uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    uint32_t destination;
+    if (!m_destinations || !m_destinations->Find(network, networkMask, destination))
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < routes.m_routes.size(); i++)
+    {
+        const CompactRoute& route = routes.m_routes[i];
+        if (route.m_destination == destination && route.m_gateway == nextHop.Get() &&
+            route.m_interface == interface)
+        {
+            routes.Erase(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+Ipv4RoutingTableEntry
+Ipv4GlobalRouting::GetCompactRoute(const CompactRoute& route) const
+{
+    return Ipv4RoutingTableEntry::CreateNetworkRouteTo(
+        m_destinations->GetNetwork(route.m_destination),
+        m_destinations->GetMask(route.m_destination),
+        Ipv4Address(route.m_gateway),
+        route.m_interface);
+}
+
+void
+Ipv4GlobalRouting::LookupCompact(Ipv4Address dest,
+                                 Ptr<NetDevice> oif,
+                                 std::vector<Ipv4RoutingTableEntry>& routes)
+{
+    NS_LOG_FUNCTION(this << dest << oif);
+    if (!m_destinations)
+    {
+        return;
+    }
+    std::vector<Ipv4PrefixTrie<uint32_t>::Entry> destinations;
+    m_destinations->Lookup(dest, destinations);
+    // as in LookupGlobal, all the host routes, else all the network routes, else
+    // the first external route
+    CompactRoutes* tables[] = {&m_compactHostRoutes,
+                               &m_compactNetworkRoutes,
+                               &m_compactASexternalRoutes};
+    std::vector<uint32_t> positions;
+    for (CompactRoutes* table : tables)
+    {
+        positions.clear();
+        table->Find(destinations, positions);
+        for (uint32_t position : positions)
+        {
+            const CompactRoute& route = table->m_routes[position];
+            if (oif && oif != m_ipv4->GetNetDevice(route.m_interface))
+            {
+                NS_LOG_LOGIC("Not on requested interface, skipping");
+                continue;
+            }
+            routes.push_back(GetCompactRoute(route));
+            NS_LOG_LOGIC(routes.size() << " Found compact route to " << routes.back().GetDest());
+            if (table == &m_compactASexternalRoutes)
+            {
+                break;
+            }
+        }
+        if (!routes.empty())
+        {
+            break;
+        }
+    }
 }
 
 Ptr<Ipv4Route>
@@ -133,74 +486,89 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
 {
     NS_LOG_FUNCTION(this << dest << oif);
     NS_LOG_LOGIC("Looking for route for destination " << dest);
-    Ptr<Ipv4Route> rtentry = nullptr;
     // store all available routes that bring packets to their destination
-    typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
+    typedef std::vector<const Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
+    if (m_compactRoutingTable)
+    {
+        std::vector<Ipv4RoutingTableEntry> compactRoutes;
+        LookupCompact(dest, oif, compactRoutes);
+        for (const auto& route : compactRoutes)
+        {
+            allRoutes.push_back(&route);
+        }
+        return SelectRoute(allRoutes);
+    }
+
+    // the tries return the matching routes in the order of the lists
+    std::vector<Ipv4PrefixTrie<Ipv4RoutingTableEntry*>::Entry> matches;
+
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (HostRoutesCI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    m_hostRouteTrie.Lookup(dest, matches);
+    for (const auto& match : matches)
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        Ipv4RoutingTableEntry* route = match.second;
+        NS_ASSERT(route->IsHost() && route->GetDest() == dest);
+        if (oif)
         {
-            if (oif)
+            if (oif != m_ipv4->GetNetDevice(route->GetInterface()))
             {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
-                {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
-                    continue;
-                }
+                NS_LOG_LOGIC("Not on requested interface, skipping");
+                continue;
             }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
         }
+        allRoutes.push_back(route);
+        NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << route);
     }
     if (allRoutes.size() == 0) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        matches.clear();
+        m_networkRouteTrie.Lookup(dest, matches);
+        for (const auto& match : matches)
         {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+            Ipv4RoutingTableEntry* route = match.second;
+            if (oif)
             {
-                if (oif)
+                if (oif != m_ipv4->GetNetDevice(route->GetInterface()))
                 {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
                 }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
             }
+            allRoutes.push_back(route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << route);
         }
     }
     if (allRoutes.size() == 0) // consider external if no host/network found
     {
-        for (ASExternalRoutesI k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
+        matches.clear();
+        m_ASexternalRouteTrie.Lookup(dest, matches);
+        for (const auto& match : matches)
         {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+            Ipv4RoutingTableEntry* route = match.second;
+            NS_LOG_LOGIC("Found external route" << route);
+            if (oif)
             {
-                NS_LOG_LOGIC("Found external route" << *k);
-                if (oif)
+                if (oif != m_ipv4->GetNetDevice(route->GetInterface()))
                 {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
-                    {
-                        NS_LOG_LOGIC("Not on requested interface, skipping");
-                        continue;
-                    }
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
                 }
-                allRoutes.push_back(*k);
-                break;
             }
+            allRoutes.push_back(route);
+            break;
         }
     }
-    if (allRoutes.size() > 0) // if route(s) is found
+    return SelectRoute(allRoutes);
+}
+
+Ptr<Ipv4Route>
+Ipv4GlobalRouting::SelectRoute(const std::vector<const Ipv4RoutingTableEntry*>& routes)
+{
+    NS_LOG_FUNCTION(this << routes.size());
+    if (routes.size() > 0) // if route(s) is found
     {
         // pick up one of the routes uniformly at random if random
         // ECMP routing is enabled, or always select the first route
@@ -208,15 +576,15 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
         uint32_t selectIndex;
         if (m_randomEcmpRouting)
         {
-            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
+            selectIndex = m_rand->GetInteger(0, routes.size() - 1);
         }
         else
         {
             selectIndex = 0;
         }
-        Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
+        const Ipv4RoutingTableEntry* route = routes.at(selectIndex);
         // create a Ipv4Route object from the selected routing table entry
-        rtentry = Create<Ipv4Route>();
+        Ptr<Ipv4Route> rtentry = Create<Ipv4Route>();
         rtentry->SetDestination(route->GetDest());
         /// \todo handle multi-address case
         rtentry->SetSource(m_ipv4->GetAddress(route->GetInterface(), 0).GetLocal());
@@ -239,13 +607,30 @@ Ipv4GlobalRouting::GetNRoutes() const
     n += m_hostRoutes.size();
     n += m_networkRoutes.size();
     n += m_ASexternalRoutes.size();
+    n += m_compactHostRoutes.m_routes.size();
+    n += m_compactNetworkRoutes.m_routes.size();
+    n += m_compactASexternalRoutes.m_routes.size();
     return n;
 }
 
-Ipv4RoutingTableEntry*
+Ipv4RoutingTableEntry
 Ipv4GlobalRouting::GetRoute(uint32_t index) const
 {
     NS_LOG_FUNCTION(this << index);
+    if (m_compactRoutingTable)
+    {
+        for (const CompactRoutes* routes :
+             {&m_compactHostRoutes, &m_compactNetworkRoutes, &m_compactASexternalRoutes})
+        {
+            if (index < routes->m_routes.size())
+            {
+                return GetCompactRoute(routes->m_routes[index]);
+            }
+            index -= routes->m_routes.size();
+        }
+        NS_ASSERT(false);
+        return Ipv4RoutingTableEntry();
+    }
     if (index < m_hostRoutes.size())
     {
         uint32_t tmp = 0;
@@ -253,7 +638,7 @@ Ipv4GlobalRouting::GetRoute(uint32_t index) const
         {
             if (tmp == index)
             {
-                return *i;
+                return **i;
             }
             tmp++;
         }
@@ -266,7 +651,7 @@ Ipv4GlobalRouting::GetRoute(uint32_t index) const
         {
             if (tmp == index)
             {
-                return *j;
+                return **j;
             }
             tmp++;
         }
@@ -277,19 +662,34 @@ Ipv4GlobalRouting::GetRoute(uint32_t index) const
     {
         if (tmp == index)
         {
-            return *k;
+            return **k;
         }
         tmp++;
     }
     NS_ASSERT(false);
     // quiet compiler.
-    return nullptr;
+    return Ipv4RoutingTableEntry();
 }
 
 void
 Ipv4GlobalRouting::RemoveRoute(uint32_t index)
 {
     NS_LOG_FUNCTION(this << index);
+    if (m_compactRoutingTable)
+    {
+        for (CompactRoutes* routes :
+             {&m_compactHostRoutes, &m_compactNetworkRoutes, &m_compactASexternalRoutes})
+        {
+            if (index < routes->m_routes.size())
+            {
+                routes->Erase(index);
+                return;
+            }
+            index -= routes->m_routes.size();
+        }
+        NS_ASSERT(false);
+        return;
+    }
     if (index < m_hostRoutes.size())
     {
         uint32_t tmp = 0;
@@ -298,6 +698,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                m_hostRouteTrie.Remove((*i)->GetDest(), Ipv4Mask::GetOnes(), *i);
                 delete *i;
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
@@ -314,6 +715,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            m_networkRouteTrie.Remove((*j)->GetDestNetwork(), (*j)->GetDestNetworkMask(), *j);
             delete *j;
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
@@ -329,6 +731,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
+            m_ASexternalRouteTrie.Remove((*k)->GetDestNetwork(), (*k)->GetDestNetworkMask(), *k);
             delete *k;
             m_ASexternalRoutes.erase(k);
             NS_LOG_LOGIC("Done removing network route "
@@ -340,6 +743,57 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
     NS_ASSERT(false);
 }
 
+bool
+Ipv4GlobalRouting::RemoveHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << dest << nextHop << interface);
+    if (m_compactRoutingTable)
+    {
+        return RemoveCompactRoute(m_compactHostRoutes,
+                                  dest,
+                                  Ipv4Mask::GetOnes(),
+                                  nextHop,
+                                  interface);
+    }
+    for (HostRoutesI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    {
+        if ((*i)->GetDest() == dest && (*i)->GetGateway() == nextHop &&
+            (*i)->GetInterface() == interface)
+        {
+            m_hostRouteTrie.Remove(dest, Ipv4Mask::GetOnes(), *i);
+            delete *i;
+            m_hostRoutes.erase(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+Ipv4GlobalRouting::RemoveNetworkRouteTo(Ipv4Address network,
+                                        Ipv4Mask networkMask,
+                                        Ipv4Address nextHop,
+                                        uint32_t interface)
+{
+    NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
+    if (m_compactRoutingTable)
+    {
+        return RemoveCompactRoute(m_compactNetworkRoutes, network, networkMask, nextHop, interface);
+    }
+    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    {
+        if ((*j)->GetDestNetwork() == network && (*j)->GetDestNetworkMask() == networkMask &&
+            (*j)->GetGateway() == nextHop && (*j)->GetInterface() == interface)
+        {
+            m_networkRouteTrie.Remove(network, networkMask, *j);
+            delete *j;
+            m_networkRoutes.erase(j);
+            return true;
+        }
+    }
+    return false;
+}
+
 int64_t
 Ipv4GlobalRouting::AssignStreams(int64_t stream)
 {
@@ -349,7 +803,7 @@ Ipv4GlobalRouting::AssignStreams(int64_t stream)
 }
 
 void
-Ipv4GlobalRouting::DoDispose()
+Ipv4GlobalRouting::RemoveAllRoutes()
 {
     NS_LOG_FUNCTION(this);
     for (HostRoutesI i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i = m_hostRoutes.erase(i))
@@ -366,6 +820,43 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostRouteTrie.Clear();
+    m_networkRouteTrie.Clear();
+    m_ASexternalRouteTrie.Clear();
+    m_compactHostRoutes = CompactRoutes();
+    m_compactNetworkRoutes = CompactRoutes();
+    m_compactASexternalRoutes = CompactRoutes();
+}
+
+std::size_t
+Ipv4GlobalRouting::GetMemoryUsage() const
+{
+    NS_LOG_FUNCTION(this);
+    // an entry of the lists is allocated with a list node, which holds two
+    // pointers besides the pointer to the entry
+    std::size_t usage = (m_hostRoutes.size() + m_networkRoutes.size() + m_ASexternalRoutes.size()) *
+                        (sizeof(Ipv4RoutingTableEntry) + 3 * sizeof(void*));
+    usage += m_hostRouteTrie.GetMemoryUsage();
+    usage += m_networkRouteTrie.GetMemoryUsage();
+    usage += m_ASexternalRouteTrie.GetMemoryUsage();
+    usage += m_compactHostRoutes.GetMemoryUsage();
+    usage += m_compactNetworkRoutes.GetMemoryUsage();
+    usage += m_compactASexternalRoutes.GetMemoryUsage();
+    return usage;
+}
+
+std::size_t
+Ipv4GlobalRouting::GetSharedMemoryUsage()
+{
+    return Destinations::GetSharedMemoryUsage();
+}
+
+void
+Ipv4GlobalRouting::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    RemoveAllRoutes();
+    m_destinations = nullptr;
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -534,9 +1025,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -546,9 +1035,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -558,9 +1045,7 @@ Ipv4GlobalRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress add
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -570,9 +1055,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -20,15 +20,19 @@
 #ifndef IPV4_GLOBAL_ROUTING_H
 #define IPV4_GLOBAL_ROUTING_H
 
+#include "ipv4-prefix-trie.h"
+
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4.h"
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
 
 #include <list>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -66,6 +70,13 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * If the CompactRoutingTable attribute is true, the routes are not stored as
+ * Ipv4RoutingTableEntry objects, but as compact records referring to a table of
+ * destinations shared by all the compact routing tables of the simulation.  This
+ * cuts the memory used by the routing tables of large topologies, in which every
+ * router has a route to every destination.  The routes are selected in the same
+ * way in both cases.
+ *
  * \see Ipv4RoutingProtocol
  * \see GlobalRouteManager
  */
@@ -196,13 +207,12 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      *
      * \param i The index (into the routing table) of the route to retrieve.  If
      * the default route has been set, it will occupy index zero.
-     * \return If route is set, a pointer to that Ipv4RoutingTableEntry is returned, otherwise
-     * a zero pointer is returned.
+     * \return a copy of the Ipv4RoutingTableEntry of the route
      *
      * \see Ipv4RoutingTableEntry
      * \see Ipv4GlobalRouting::RemoveRoute
      */
-    Ipv4RoutingTableEntry* GetRoute(uint32_t i) const;
+    Ipv4RoutingTableEntry GetRoute(uint32_t i) const;
 
     /**
      * \brief Remove a route from the global unicast routing table.
@@ -222,6 +232,54 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     void RemoveRoute(uint32_t i);
 
+    /**
+     * \brief Remove a host route from the global routing table.
+     *
+     * \param dest The Ipv4Address destination of the route.
+     * \param nextHop The Ipv4Address of the next hop in the route.
+     * \param interface The network interface index of the route.
+     * \return true if a matching route was found and removed.
+     */
+    bool RemoveHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_t interface);
+
+    /**
+     * \brief Remove a network route from the global routing table.
+     *
+     * \param network The Ipv4Address network of the route.
+     * \param networkMask The Ipv4Mask of the network.
+     * \param nextHop The next hop in the route to the destination network.
+     * \param interface The network interface index of the route.
+     * \return true if a matching route was found and removed.
+     */
+    bool RemoveNetworkRouteTo(Ipv4Address network,
+                              Ipv4Mask networkMask,
+                              Ipv4Address nextHop,
+                              uint32_t interface);
+
+    /**
+     * \brief Remove all the routes from the global routing table.
+     */
+    void RemoveAllRoutes();
+
+    /**
+     * \brief Get the memory used by the routing table.
+     *
+     * The estimate does not include the overhead of the memory allocator, nor the
+     * table of destinations shared by the compact routing tables (see
+     * GetSharedMemoryUsage ()).
+     *
+     * \return the estimated number of bytes used by the routing table
+     */
+    std::size_t GetMemoryUsage() const;
+
+    /**
+     * \brief Get the memory used by the table of destinations shared by the
+     * compact routing tables.
+     *
+     * \return the estimated number of bytes used by the shared table
+     */
+    static std::size_t GetSharedMemoryUsage();
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -266,6 +324,95 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// iterator of container of Ipv4RoutingTableEntry (routes to external AS)
     typedef std::list<Ipv4RoutingTableEntry*>::iterator ASExternalRoutesI;
 
+    /// The table of the destinations of the compact routing tables
+    class Destinations;
+
+    /// A route of a compact routing table
+    struct CompactRoute
+    {
+        uint32_t m_destination; //!< the index of the destination in the shared table
+        uint32_t m_gateway;     //!< the gateway
+        uint32_t m_interface;   //!< the output interface
+    };
+
+    /**
+     * \brief The host, network or external routes of a compact routing table.
+     *
+     * The routes are kept in the order in which they are added, and indexed by
+     * destination when they are looked up.
+     */
+    struct CompactRoutes
+    {
+        /**
+         * \brief Find the routes to some destinations.
+         * \param destinations the destinations
+         * \param positions the vector to which the positions of the routes are
+         * appended, in the order of the routes
+         */
+        void Find(const std::vector<Ipv4PrefixTrie<uint32_t>::Entry>& destinations,
+                  std::vector<uint32_t>& positions);
+
+        /**
+         * \brief Remove a route.
+         * \param position the position of the route
+         */
+        void Erase(uint32_t position);
+
+        /**
+         * \return the estimated number of bytes used by the routes
+         */
+        std::size_t GetMemoryUsage() const;
+
+        std::vector<CompactRoute> m_routes; //!< the routes
+        std::vector<uint32_t> m_index;      //!< the positions of the routes, sorted by destination
+        bool m_indexed{true};               //!< whether the index is up to date
+    };
+
+    /**
+     * \brief Add a route to a compact routing table.
+     * \param routes the routes of the kind of the route
+     * \param network the destination network (or host)
+     * \param networkMask the mask of the destination
+     * \param nextHop the next hop
+     * \param interface the output interface
+     */
+    void AddCompactRoute(CompactRoutes& routes,
+                         Ipv4Address network,
+                         Ipv4Mask networkMask,
+                         Ipv4Address nextHop,
+                         uint32_t interface);
+
+    /**
+     * \brief Remove a route from a compact routing table.
+     * \param routes the routes of the kind of the route
+     * \param network the destination network (or host)
+     * \param networkMask the mask of the destination
+     * \param nextHop the next hop
+     * \param interface the output interface
+     * \return true if a matching route was found and removed
+     */
+    bool RemoveCompactRoute(CompactRoutes& routes,
+                            Ipv4Address network,
+                            Ipv4Mask networkMask,
+                            Ipv4Address nextHop,
+                            uint32_t interface);
+
+    /**
+     * \param route a route of a compact routing table
+     * \return the route as an entry of the routing table
+     */
+    Ipv4RoutingTableEntry GetCompactRoute(const CompactRoute& route) const;
+
+    /**
+     * \brief Lookup in the compact forwarding table for destination.
+     * \param dest destination address
+     * \param oif output interface if any (put 0 otherwise)
+     * \param routes the vector to which the routes that can be used are appended
+     */
+    void LookupCompact(Ipv4Address dest,
+                       Ptr<NetDevice> oif,
+                       std::vector<Ipv4RoutingTableEntry>& routes);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -274,10 +421,29 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /**
+     * \brief Select one of the routes to a destination.
+     * \param routes the routes that can be used
+     * \return Ipv4Route to route the packet with the selected route, or nullptr
+     */
+    Ptr<Ipv4Route> SelectRoute(const std::vector<const Ipv4RoutingTableEntry*>& routes);
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    /// The routes indexed by destination, to find the matching ones in list order
+    Ipv4PrefixTrie<Ipv4RoutingTableEntry*> m_hostRouteTrie;
+    Ipv4PrefixTrie<Ipv4RoutingTableEntry*> m_networkRouteTrie;    //!< \copydoc m_hostRouteTrie
+    Ipv4PrefixTrie<Ipv4RoutingTableEntry*> m_ASexternalRouteTrie; //!< \copydoc m_hostRouteTrie
+
+    /// Set to true to store the routes in a compact routing table
+    bool m_compactRoutingTable;
+    CompactRoutes m_compactHostRoutes;       //!< Routes to hosts of the compact routing table
+    CompactRoutes m_compactNetworkRoutes;    //!< Routes to networks of the compact routing table
+    CompactRoutes m_compactASexternalRoutes; //!< External routes of the compact routing table
+    Ptr<Destinations> m_destinations; //!< the destinations of the compact routing tables
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
@@ -24,8 +24,11 @@
 #include "arp-l3-protocol.h"
 #include "icmpv4-l4-protocol.h"
 #include "ipv4-interface.h"
+#include "ipv4-queue-disc-item.h"
 #include "ipv4-raw-socket-impl.h"
 #include "loopback-net-device.h"
+#include "tcp-header.h"
+#include "tcp-tso-tag.h"
 
 #include "ns3/boolean.h"
 #include "ns3/callback.h"
@@ -44,6 +47,8 @@
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -337,6 +342,7 @@ Ipv4L3Protocol::DoDispose()
     }
 
     m_fragments.clear();
+    m_fragmentsPool.clear();
     m_timeoutEventList.clear();
     if (m_timeoutEvent.IsRunning())
     {
@@ -1020,11 +1026,52 @@ Ipv4L3Protocol::SendRealOut(Ptr<Ipv4Route> route, Ptr<Packet> packet, const Ipv4
     if (outInterface->IsUp())
     {
         NS_LOG_LOGIC("Send to " << targetLabel << " " << target);
-        if (packet->GetSize() + ipHeader.GetSerializedSize() > outInterface->GetDevice()->GetMtu())
+        TcpTsoTag tsoTag;
+        if (packet->PeekPacketTag(tsoTag))
         {
-            std::list<Ipv4PayloadHeaderPair> listFragments;
+            // A TCP super-segment whose segments fit in the MTU of the device
+            // is not fragmented, it is split into segments by the traffic
+            // control layer. Reserve the identifications of the segments
+            // following the first one. A super-segment sent to a local
+            // address does not reach the traffic control layer, and is delivered
+            // as is, like the segments coalesced by the receive offload of
+            // TcpL4Protocol
+            NS_LOG_LOGIC("Send TCP super-segment of " << tsoTag.GetSegments() << " segments");
+            uint64_t src = ipHeader.GetSource().Get();
+            uint64_t dst = ipHeader.GetDestination().Get();
+            uint64_t srcDst = dst | (src << 32);
+            std::pair<uint64_t, uint8_t> key = std::make_pair(srcDst, ipHeader.GetProtocol());
+            m_identification[key] += tsoTag.GetSegments() - 1;
+
+            TcpHeader tcpHeader;
+            packet->PeekHeader(tcpHeader);
+            if (ipHeader.GetSerializedSize() + tcpHeader.GetSerializedSize() +
+                    tsoTag.GetSegmentSize() <=
+                outInterface->GetDevice()->GetMtu())
+            {
+                CallTxTrace(ipHeader, packet, this, interface);
+                outInterface->Send(packet, ipHeader, target);
+                return;
+            }
+
+            // The segments do not fit in the MTU of the device: split the
+            // super-segment here, and send (and fragment) each segment as if
+            // the segmentation offload was disabled
+            NS_LOG_LOGIC("Split TCP super-segment larger than the MTU");
+            std::vector<Ptr<QueueDiscItem>> segments;
+            Create<Ipv4QueueDiscItem>(packet, target, PROT_NUMBER, ipHeader)->Segment(segments);
+            for (const auto& segment : segments)
+            {
+                Ptr<Ipv4QueueDiscItem> item = DynamicCast<Ipv4QueueDiscItem>(segment);
+                SendRealOut(route, item->GetPacket(), item->GetHeader());
+            }
+        }
+        else if (packet->GetSize() + ipHeader.GetSerializedSize() >
+                 outInterface->GetDevice()->GetMtu())
+        {
+            std::vector<Ipv4PayloadHeaderPair> listFragments;
             DoFragmentation(packet, ipHeader, outInterface->GetDevice()->GetMtu(), listFragments);
-            for (std::list<Ipv4PayloadHeaderPair>::iterator it = listFragments.begin();
+            for (std::vector<Ipv4PayloadHeaderPair>::iterator it = listFragments.begin();
                  it != listFragments.end();
                  it++)
             {
@@ -1486,7 +1533,7 @@ void
 Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
                                 const Ipv4Header& ipv4Header,
                                 uint32_t outIfaceMtu,
-                                std::list<Ipv4PayloadHeaderPair>& listFragments)
+                                std::vector<Ipv4PayloadHeaderPair>& listFragments)
 {
     // BEWARE: here we do assume that the header options are not present.
     // a much more complex handling is necessary in case there are options.
@@ -1495,8 +1542,6 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
     NS_LOG_FUNCTION(this << *packet << outIfaceMtu << &listFragments);
 
-    Ptr<Packet> p = packet->Copy();
-
     NS_ASSERT_MSG((ipv4Header.GetSerializedSize() == 5 * 4),
                   "IPv4 fragmentation implementation only works without option headers.");
 
@@ -1513,11 +1558,14 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
     NS_LOG_LOGIC("Fragmenting - Target Size: " << fragmentSize);
 
+    uint32_t nFragments = (packet->GetSize() + fragmentSize - 1) / fragmentSize;
+    listFragments.reserve(listFragments.size() + nFragments);
+
     do
     {
         Ipv4Header fragmentHeader = ipv4Header;
 
-        if (p->GetSize() > offset + fragmentSize)
+        if (packet->GetSize() > offset + fragmentSize)
         {
             moreFragment = true;
             currentFragmentablePartSize = fragmentSize;
@@ -1526,7 +1574,7 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
         else
         {
             moreFragment = false;
-            currentFragmentablePartSize = p->GetSize() - offset;
+            currentFragmentablePartSize = packet->GetSize() - offset;
             if (!isLastFragment)
             {
                 fragmentHeader.SetMoreFragments();
@@ -1538,7 +1586,7 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
         }
 
         NS_LOG_LOGIC("Fragment creation - " << offset << ", " << currentFragmentablePartSize);
-        Ptr<Packet> fragment = p->CreateFragment(offset, currentFragmentablePartSize);
+        Ptr<Packet> fragment = packet->CreateFragment(offset, currentFragmentablePartSize);
         NS_LOG_LOGIC("Fragment created - " << offset << ", " << fragment->GetSize());
 
         fragmentHeader.SetFragmentOffset(offset + originalOffset);
@@ -1553,10 +1601,6 @@ Ipv4L3Protocol::DoFragmentation(Ptr<Packet> packet,
 
         NS_LOG_LOGIC("New fragment Header " << fragmentHeader);
 
-        std::ostringstream oss;
-        oss << fragmentHeader;
-        fragment->Print(oss);
-
         NS_LOG_LOGIC("New fragment " << *fragment);
 
         listFragments.emplace_back(fragment, fragmentHeader);
@@ -1577,7 +1621,6 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
         uint32_t(ipHeader.GetIdentification()) << 16 | uint32_t(ipHeader.GetProtocol());
     FragmentKey_t key;
     bool ret = false;
-    Ptr<Packet> p = packet->Copy();
 
     key.first = addressCombination;
     key.second = idProto;
@@ -1587,7 +1630,7 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
     MapFragments_t::iterator it = m_fragments.find(key);
     if (it == m_fragments.end())
     {
-        fragments = Create<Fragments>();
+        fragments = AllocateFragments();
         m_fragments.insert(std::make_pair(key, fragments));
 
         FragmentsTimeoutsListI_t iter = SetTimeout(key, ipHeader, iif);
@@ -1601,20 +1644,49 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
     NS_LOG_LOGIC("Adding fragment - Size: " << packet->GetSize()
                                             << " - Offset: " << (ipHeader.GetFragmentOffset()));
 
-    fragments->AddFragment(p, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
+    // The packet is owned by LocalDeliver, which made a copy of it: the fragment
+    // is stored without a further copy, and GetPacket appends to it in place.
+    fragments->AddFragment(packet, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
 
     if (fragments->IsEntire())
     {
         packet = fragments->GetPacket();
         m_timeoutEventList.erase(fragments->GetTimeoutIter());
-        fragments = nullptr;
         m_fragments.erase(key);
+        RecycleFragments(fragments);
         ret = true;
     }
 
     return ret;
 }
 
+Ptr<Ipv4L3Protocol::Fragments>
+Ipv4L3Protocol::AllocateFragments()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_fragmentsPool.empty())
+    {
+        return Create<Fragments>();
+    }
+    Ptr<Fragments> fragments = m_fragmentsPool.back();
+    m_fragmentsPool.pop_back();
+    return fragments;
+}
+
+void
+Ipv4L3Protocol::RecycleFragments(Ptr<Fragments> fragments)
+{
+    NS_LOG_FUNCTION(this << fragments);
+
+    // release the fragments, but keep the capacity of the container
+    fragments->Clear();
+    if (m_fragmentsPool.size() < FRAGMENTS_POOL_SIZE)
+    {
+        m_fragmentsPool.push_back(fragments);
+    }
+}
+
 Ipv4L3Protocol::Fragments::Fragments()
     : m_moreFragment(0)
 {
@@ -1628,21 +1700,21 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
-    {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
-    }
-
-    if (it == m_fragments.end())
+    // the fragments usually arrive in order, hence they are appended
+    if (m_fragments.empty() || m_fragments.back().second <= fragmentOffset)
     {
         m_moreFragment = moreFragment;
+        m_fragments.emplace_back(fragment, fragmentOffset);
+        return;
     }
 
+    std::vector<std::pair<Ptr<Packet>, uint16_t>>::iterator it =
+        std::upper_bound(m_fragments.begin(),
+                         m_fragments.end(),
+                         fragmentOffset,
+                         [](uint16_t offset, const std::pair<Ptr<Packet>, uint16_t>& f) {
+                             return offset < f.second;
+                         });
     m_fragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
 }
 
@@ -1657,7 +1729,7 @@ Ipv4L3Protocol::Fragments::IsEntire() const
     {
         uint16_t lastEndOffset = 0;
 
-        for (std::list<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it = m_fragments.begin();
+        for (std::vector<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it = m_fragments.begin();
              it != m_fragments.end();
              it++)
         {
@@ -1679,13 +1751,16 @@ Ipv4L3Protocol::Fragments::IsEntire() const
 }
 
 Ptr<Packet>
-Ipv4L3Protocol::Fragments::GetPacket() const
+Ipv4L3Protocol::Fragments::GetPacket()
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it = m_fragments.begin();
+    std::vector<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it = m_fragments.begin();
 
-    Ptr<Packet> p = it->first->Copy();
+    // Append to the first fragment, which is not shared: when the buffers of the
+    // fragments are not shared either, adjacent zero areas are merged by
+    // Buffer::AddAtEnd without being copied.
+    Ptr<Packet> p = it->first;
     uint16_t lastEndOffset = p->GetSize();
     it++;
 
@@ -1721,7 +1796,7 @@ Ipv4L3Protocol::Fragments::GetPartialPacket() const
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it = m_fragments.begin();
+    std::vector<std::pair<Ptr<Packet>, uint16_t>>::const_iterator it = m_fragments.begin();
 
     Ptr<Packet> p = Create<Packet>();
     uint16_t lastEndOffset = 0;
@@ -1763,6 +1838,14 @@ Ipv4L3Protocol::Fragments::GetTimeoutIter()
     return m_timeoutIter;
 }
 
+void
+Ipv4L3Protocol::Fragments::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_moreFragment = false;
+    m_fragments.clear();
+}
+
 void
 Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader, uint32_t iif)
 {
@@ -1780,9 +1863,9 @@ Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader,
     m_dropTrace(ipHeader, packet, DROP_FRAGMENT_TIMEOUT, this, iif);
 
     // clear the buffers
-    it->second = nullptr;
-
-    m_fragments.erase(key);
+    Ptr<Fragments> fragments = it->second;
+    m_fragments.erase(it);
+    RecycleFragments(fragments);
 }
 
 bool
@@ -1894,7 +1977,9 @@ Ipv4L3Protocol::SetTimeout(FragmentKey_t key, Ipv4Header ipHeader, uint32_t iif)
 {
     Time now = Simulator::Now() + m_fragmentExpirationTimeout;
 
-    if (m_timeoutEventList.empty())
+    // The event may still be pending for an entry removed since, in which case
+    // HandleTimeout will reschedule it for the first entry left.
+    if (!m_timeoutEvent.IsRunning())
     {
         m_timeoutEvent =
             Simulator::Schedule(m_fragmentExpirationTimeout, &Ipv4L3Protocol::HandleTimeout, this);
@@ -1911,7 +1996,7 @@ Ipv4L3Protocol::HandleTimeout()
 {
     Time now = Simulator::Now();
 
-    while (!m_timeoutEventList.empty() && std::get<0>(*m_timeoutEventList.begin()) == now)
+    while (!m_timeoutEventList.empty() && std::get<0>(*m_timeoutEventList.begin()) <= now)
     {
         HandleFragmentsTimeout(std::get<1>(*m_timeoutEventList.begin()),
                                std::get<2>(*m_timeoutEventList.begin()),
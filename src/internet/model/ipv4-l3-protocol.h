@@ -406,11 +406,13 @@ class Ipv4L3Protocol : public Ipv4
      * \param ipv4Header the IPv4 header
      * \param outIfaceMtu the MTU of the interface
      * \param listFragments the list of fragments
+     *
+     * The fragments share the buffer of the packet, which is not copied.
      */
     void DoFragmentation(Ptr<Packet> packet,
                          const Ipv4Header& ipv4Header,
                          uint32_t outIfaceMtu,
-                         std::list<Ipv4PayloadHeaderPair>& listFragments);
+                         std::vector<Ipv4PayloadHeaderPair>& listFragments);
 
     /**
      * \brief Process a packet fragment
@@ -528,6 +530,10 @@ class Ipv4L3Protocol : public Ipv4
 
     /**
      * \brief Handles a fragmented packet timeout
+     *
+     * The timeouts of all the fragmented packets share a single event: since
+     * they all last m_fragmentExpirationTimeout, m_timeoutEventList is sorted
+     * by expiration time and the event is scheduled for its first entry only.
      */
     void HandleTimeout();
 
@@ -562,9 +568,14 @@ class Ipv4L3Protocol : public Ipv4
 
         /**
          * \brief Get the entire packet.
+         *
+         * The fragments are appended to the first one, which is returned: the
+         * buffers of the fragments are chained without copying their zero
+         * areas. Hence, this method can be called once only.
+         *
          * \return the entire packet
          */
-        Ptr<Packet> GetPacket() const;
+        Ptr<Packet> GetPacket();
 
         /**
          * \brief Get the complete part of the packet.
@@ -584,6 +595,11 @@ class Ipv4L3Protocol : public Ipv4
          */
         FragmentsTimeoutsListI_t GetTimeoutIter();
 
+        /**
+         * \brief Remove all the fragments, to reuse this object for another packet.
+         */
+        void Clear();
+
       private:
         /**
          * \brief True if other fragments will be sent.
@@ -591,9 +607,9 @@ class Ipv4L3Protocol : public Ipv4
         bool m_moreFragment;
 
         /**
-         * \brief The current fragments.
+         * \brief The current fragments, sorted by offset.
          */
-        std::list<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
+        std::vector<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
 
         /**
          * \brief Timeout iterator to "event" handler
@@ -607,6 +623,24 @@ class Ipv4L3Protocol : public Ipv4
     MapFragments_t m_fragments;       //!< Fragmented packets.
     Time m_fragmentExpirationTimeout; //!< Expiration timeout
 
+    /**
+     * \brief Get a Fragments object for a new fragmented packet.
+     * \return a recycled Fragments object, or a new one
+     */
+    Ptr<Fragments> AllocateFragments();
+
+    /**
+     * \brief Recycle the Fragments object of a reassembled or expired packet.
+     * \param fragments the Fragments object
+     */
+    void RecycleFragments(Ptr<Fragments> fragments);
+
+    /// Maximum number of Fragments objects kept for reuse
+    static const uint32_t FRAGMENTS_POOL_SIZE = 64;
+
+    /// Fragments objects kept for reuse, along with the capacity of their containers
+    std::vector<Ptr<Fragments>> m_fragmentsPool;
+
     /// IETF RFC 6621, Section 6.2 de-duplication w/o IPSec
     /// RFC 6621 recommended duplicate packet tuple: {IPV hash, IP protocol, IP source address, IP
     /// destination address}
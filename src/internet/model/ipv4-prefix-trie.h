@@ -0,0 +1,480 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef IPV4_PREFIX_TRIE_H
+#define IPV4_PREFIX_TRIE_H
+
+#include "ns3/assert.h"
+#include "ns3/ipv4-address.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup ipv4Routing
+ *
+ * \brief A path-compressed binary trie (Patricia trie) of IPv4 prefixes,
+ * used by the routing protocols to find the routes matching a destination.
+ *
+ * Each prefix holds the values inserted with it.  A value is tagged with a
+ * sequence number increasing with each insertion, so that the values matching
+ * a destination are returned in insertion order, as they would be found by
+ * scanning a list of routes to which the routes are appended.  A lookup visits
+ * at most 33 nodes, whatever the number of prefixes.
+ *
+ * The values inserted with a non-contiguous mask (which is allowed by
+ * Ipv4Mask, but cannot be stored in the trie) are kept in a list scanned at
+ * every lookup.
+ *
+ * \tparam T the type of the values, which must be equality comparable
+ */
+template <typename T>
+class Ipv4PrefixTrie
+{
+  public:
+    /// A value and its sequence number
+    typedef std::pair<uint64_t, T> Entry;
+
+    Ipv4PrefixTrie();
+
+    /**
+     * \brief Insert a value.
+     * \param network the network of the prefix (the bits out of the mask are ignored)
+     * \param mask the mask of the prefix
+     * \param value the value
+     */
+    void Insert(Ipv4Address network, Ipv4Mask mask, const T& value);
+
+    /**
+     * \brief Remove a value.
+     * \param network the network of the prefix (the bits out of the mask are ignored)
+     * \param mask the mask of the prefix
+     * \param value the value
+     * \return true if the value was found (and its first occurrence removed)
+     */
+    bool Remove(Ipv4Address network, Ipv4Mask mask, const T& value);
+
+    /**
+     * \brief Remove all the values.
+     */
+    void Clear();
+
+    /**
+     * \return the number of values
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * \return the estimated number of bytes used by the trie, not counting the
+     * overhead of the memory allocator
+     */
+    std::size_t GetMemoryUsage() const;
+
+    /**
+     * \brief Find the values of a prefix.
+     * \param network the network of the prefix (the bits out of the mask are ignored)
+     * \param mask the mask of the prefix
+     * \param values the vector to which the values of the prefix are appended,
+     * in insertion order
+     */
+    void Find(Ipv4Address network, Ipv4Mask mask, std::vector<Entry>& values) const;
+
+    /**
+     * \brief Find the values of all the prefixes containing an address.
+     * \param dest the address
+     * \param matches the vector to which the values are appended, in insertion order
+     */
+    void Lookup(Ipv4Address dest, std::vector<Entry>& matches) const;
+
+  private:
+    /// A node of the trie, i.e., a prefix
+    struct Node
+    {
+        /**
+         * \brief Constructor.
+         * \param prefix the bits of the prefix
+         * \param length the length of the prefix
+         */
+        Node(uint32_t prefix, uint8_t length)
+            : m_prefix(prefix),
+              m_length(length)
+        {
+        }
+
+        uint32_t m_prefix;                   //!< the bits of the prefix (the others are 0)
+        uint8_t m_length;                    //!< the length of the prefix
+        std::vector<Entry> m_values;         //!< the values of the prefix
+        std::unique_ptr<Node> m_children[2]; //!< the longer prefixes, by their next bit
+    };
+
+    /**
+     * \param length the length of a prefix
+     * \return the bits of the mask of the prefix
+     */
+    static uint32_t GetMask(uint8_t length);
+
+    /**
+     * \param a the first bits
+     * \param b the second bits
+     * \param max the maximum length
+     * \return the length of the common prefix of a and b, up to max
+     */
+    static uint8_t GetCommonLength(uint32_t a, uint32_t b, uint8_t max);
+
+    /**
+     * \param bits the bits
+     * \param index the index of the bit, from the most significant one
+     * \return the bit
+     */
+    static uint32_t GetBit(uint32_t bits, uint8_t index);
+
+    /**
+     * \param mask the mask
+     * \param length the length of the prefix (output)
+     * \return true if the mask is contiguous
+     */
+    static bool GetLength(Ipv4Mask mask, uint8_t& length);
+
+    /**
+     * \brief Remove a value from a subtree, and remove the nodes that are not needed anymore.
+     * \param slot the root of the subtree
+     * \param prefix the bits of the prefix
+     * \param length the length of the prefix
+     * \param value the value
+     * \return true if the value was found
+     */
+    bool Remove(std::unique_ptr<Node>& slot, uint32_t prefix, uint8_t length, const T& value);
+
+    /**
+     * \brief Sort the entries of a vector by sequence number, from the given position.
+     * \param entries the entries
+     * \param begin the position of the first entry to sort
+     */
+    static void Sort(std::vector<Entry>& entries, std::size_t begin);
+
+    /**
+     * \param node the root of a subtree
+     * \return the estimated number of bytes used by the subtree
+     */
+    static std::size_t GetMemoryUsage(const Node* node);
+
+    /// A value with a non-contiguous mask: the network, the mask and the entry
+    typedef std::pair<std::pair<uint32_t, uint32_t>, Entry> OtherEntry;
+
+    std::unique_ptr<Node> m_root;     //!< the root of the trie
+    std::vector<OtherEntry> m_others; //!< the values with a non-contiguous mask
+    uint64_t m_nextSequence;          //!< the sequence number of the next value
+    std::size_t m_size;               //!< the number of values
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename T>
+Ipv4PrefixTrie<T>::Ipv4PrefixTrie()
+    : m_nextSequence(0),
+      m_size(0)
+{
+}
+
+template <typename T>
+uint32_t
+Ipv4PrefixTrie<T>::GetMask(uint8_t length)
+{
+    return length == 0 ? 0 : (0xffffffff << (32 - length));
+}
+
+template <typename T>
+uint8_t
+Ipv4PrefixTrie<T>::GetCommonLength(uint32_t a, uint32_t b, uint8_t max)
+{
+    uint32_t diff = a ^ b;
+    uint8_t length = 0;
+    while (length < max && (diff & 0x80000000) == 0)
+    {
+        diff <<= 1;
+        length++;
+    }
+    return length;
+}
+
+template <typename T>
+uint32_t
+Ipv4PrefixTrie<T>::GetBit(uint32_t bits, uint8_t index)
+{
+    NS_ASSERT(index < 32);
+    return (bits >> (31 - index)) & 1;
+}
+
+template <typename T>
+bool
+Ipv4PrefixTrie<T>::GetLength(Ipv4Mask mask, uint8_t& length)
+{
+    uint32_t inverse = ~mask.Get();
+    if ((inverse & (inverse + 1)) != 0)
+    {
+        return false;
+    }
+    length = mask.GetPrefixLength();
+    return true;
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::Sort(std::vector<Entry>& entries, std::size_t begin)
+{
+    if (entries.size() - begin > 1)
+    {
+        std::sort(entries.begin() + begin,
+                  entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.first < b.first; });
+    }
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::Insert(Ipv4Address network, Ipv4Mask mask, const T& value)
+{
+    Entry entry(m_nextSequence++, value);
+    m_size++;
+    uint8_t length;
+    if (!GetLength(mask, length))
+    {
+        m_others.emplace_back(std::make_pair(network.Get() & mask.Get(), mask.Get()), entry);
+        return;
+    }
+    uint32_t prefix = network.Get() & GetMask(length);
+    std::unique_ptr<Node>* slot = &m_root;
+    while (true)
+    {
+        if (!*slot)
+        {
+            slot->reset(new Node(prefix, length));
+            (*slot)->m_values.push_back(entry);
+            return;
+        }
+        Node* node = slot->get();
+        uint8_t common =
+            GetCommonLength(prefix, node->m_prefix, std::min(length, node->m_length));
+        if (common == node->m_length && common == length)
+        {
+            // same prefix
+            node->m_values.push_back(entry);
+            return;
+        }
+        if (common == node->m_length)
+        {
+            // the node is a prefix of the new prefix
+            slot = &node->m_children[GetBit(prefix, common)];
+            continue;
+        }
+        std::unique_ptr<Node> parent;
+        if (common == length)
+        {
+            // the new prefix is a prefix of the node
+            parent.reset(new Node(prefix, length));
+            parent->m_values.push_back(entry);
+        }
+        else
+        {
+            // the prefixes diverge: add a node for their common prefix
+            parent.reset(new Node(prefix & GetMask(common), common));
+            Node* leaf = new Node(prefix, length);
+            leaf->m_values.push_back(entry);
+            parent->m_children[GetBit(prefix, common)].reset(leaf);
+        }
+        uint32_t bit = GetBit(node->m_prefix, common);
+        parent->m_children[bit] = std::move(*slot);
+        *slot = std::move(parent);
+        return;
+    }
+}
+
+template <typename T>
+bool
+Ipv4PrefixTrie<T>::Remove(Ipv4Address network, Ipv4Mask mask, const T& value)
+{
+    uint8_t length;
+    bool found = false;
+    if (!GetLength(mask, length))
+    {
+        std::pair<uint32_t, uint32_t> key(network.Get() & mask.Get(), mask.Get());
+        for (auto it = m_others.begin(); it != m_others.end(); it++)
+        {
+            if (it->first == key && it->second.second == value)
+            {
+                m_others.erase(it);
+                found = true;
+                break;
+            }
+        }
+    }
+    else
+    {
+        found = Remove(m_root, network.Get() & GetMask(length), length, value);
+    }
+    if (found)
+    {
+        m_size--;
+    }
+    return found;
+}
+
+template <typename T>
+bool
+Ipv4PrefixTrie<T>::Remove(std::unique_ptr<Node>& slot,
+                          uint32_t prefix,
+                          uint8_t length,
+                          const T& value)
+{
+    Node* node = slot.get();
+    if (!node || node->m_length > length ||
+        (prefix & GetMask(node->m_length)) != node->m_prefix)
+    {
+        return false;
+    }
+    bool found = false;
+    if (node->m_length == length)
+    {
+        for (auto it = node->m_values.begin(); it != node->m_values.end(); it++)
+        {
+            if (it->second == value)
+            {
+                node->m_values.erase(it);
+                found = true;
+                break;
+            }
+        }
+    }
+    else
+    {
+        found = Remove(node->m_children[GetBit(prefix, node->m_length)], prefix, length, value);
+    }
+    if (found && node->m_values.empty())
+    {
+        // a node without values is only needed to join two subtrees
+        if (!node->m_children[0] || !node->m_children[1])
+        {
+            std::unique_ptr<Node> child =
+                std::move(node->m_children[node->m_children[0] ? 0 : 1]);
+            slot = std::move(child);
+        }
+    }
+    return found;
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::Clear()
+{
+    m_root.reset();
+    m_others.clear();
+    m_size = 0;
+}
+
+template <typename T>
+std::size_t
+Ipv4PrefixTrie<T>::GetSize() const
+{
+    return m_size;
+}
+
+template <typename T>
+std::size_t
+Ipv4PrefixTrie<T>::GetMemoryUsage() const
+{
+    return GetMemoryUsage(m_root.get()) + m_others.capacity() * sizeof(OtherEntry);
+}
+
+template <typename T>
+std::size_t
+Ipv4PrefixTrie<T>::GetMemoryUsage(const Node* node)
+{
+    if (!node)
+    {
+        return 0;
+    }
+    return sizeof(Node) + node->m_values.capacity() * sizeof(Entry) +
+           GetMemoryUsage(node->m_children[0].get()) + GetMemoryUsage(node->m_children[1].get());
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::Find(Ipv4Address network, Ipv4Mask mask, std::vector<Entry>& values) const
+{
+    uint8_t length;
+    if (!GetLength(mask, length))
+    {
+        std::pair<uint32_t, uint32_t> key(network.Get() & mask.Get(), mask.Get());
+        for (const auto& other : m_others)
+        {
+            if (other.first == key)
+            {
+                values.push_back(other.second);
+            }
+        }
+        return;
+    }
+    uint32_t prefix = network.Get() & GetMask(length);
+    const Node* node = m_root.get();
+    while (node && node->m_length <= length &&
+           (prefix & GetMask(node->m_length)) == node->m_prefix)
+    {
+        if (node->m_length == length)
+        {
+            values.insert(values.end(), node->m_values.begin(), node->m_values.end());
+            break;
+        }
+        node = node->m_children[GetBit(prefix, node->m_length)].get();
+    }
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::Lookup(Ipv4Address dest, std::vector<Entry>& matches) const
+{
+    std::size_t begin = matches.size();
+    uint32_t address = dest.Get();
+    const Node* node = m_root.get();
+    while (node && (address & GetMask(node->m_length)) == node->m_prefix)
+    {
+        matches.insert(matches.end(), node->m_values.begin(), node->m_values.end());
+        if (node->m_length == 32)
+        {
+            break;
+        }
+        node = node->m_children[GetBit(address, node->m_length)].get();
+    }
+    for (const auto& other : m_others)
+    {
+        if ((address & other.first.second) == other.first.first)
+        {
+            matches.push_back(other.second);
+        }
+    }
+    Sort(matches, begin);
+}
+
+} // namespace ns3
+
+#endif /* IPV4_PREFIX_TRIE_H */
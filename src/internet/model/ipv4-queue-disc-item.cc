@@ -19,7 +19,9 @@
 #include "ipv4-queue-disc-item.h"
 
 #include "ns3/log.h"
+#include "ns3/node.h"
 #include "ns3/tcp-header.h"
+#include "ns3/tcp-tso-tag.h"
 #include "ns3/udp-header.h"
 
 namespace ns3
@@ -170,4 +172,52 @@ Ipv4QueueDiscItem::Hash(uint32_t perturbation) const
     return hash;
 }
 
+bool
+Ipv4QueueDiscItem::Segment(std::vector<Ptr<QueueDiscItem>>& segments) const
+{
+    NS_LOG_FUNCTION(this);
+
+    TcpTsoTag tsoTag;
+    if (m_headerAdded || !GetPacket()->PeekPacketTag(tsoTag))
+    {
+        return false;
+    }
+    NS_ASSERT(m_header.GetProtocol() == 6 && tsoTag.GetSegmentSize() > 0);
+
+    Ptr<Packet> payload = GetPacket()->Copy();
+    payload->RemovePacketTag(tsoTag);
+    TcpHeader tcpHeader;
+    payload->RemoveHeader(tcpHeader);
+
+    // The segments take consecutive identifications, which have been reserved
+    // by the IPv4 layer when sending the super-segment
+    uint16_t identification = m_header.GetIdentification();
+    std::size_t first = segments.size();
+    uint32_t size = payload->GetSize();
+    for (uint32_t offset = 0; offset < size; offset += tsoTag.GetSegmentSize())
+    {
+        Ptr<Packet> segment =
+            payload->CreateFragment(offset, std::min(tsoTag.GetSegmentSize(), size - offset));
+
+        TcpHeader segmentTcpHeader = tcpHeader;
+        segmentTcpHeader.SetSequenceNumber(tcpHeader.GetSequenceNumber() +
+                                           SequenceNumber32(offset));
+        if (Node::ChecksumEnabled())
+        {
+            segmentTcpHeader.EnableChecksums();
+        }
+        segmentTcpHeader.InitializeChecksum(m_header.GetSource(), m_header.GetDestination(), 6);
+        segment->AddHeader(segmentTcpHeader);
+
+        Ipv4Header segmentHeader = m_header;
+        segmentHeader.SetPayloadSize(segment->GetSize());
+        segmentHeader.SetIdentification(identification++);
+
+        segments.push_back(
+            Create<Ipv4QueueDiscItem>(segment, GetAddress(), GetProtocol(), segmentHeader));
+    }
+    NS_ASSERT(segments.size() - first == tsoTag.GetSegments());
+    return true;
+}
+
 } // namespace ns3
@@ -106,6 +106,19 @@ class Ipv4QueueDiscItem : public QueueDiscItem
      */
     uint32_t Hash(uint32_t perturbation) const override;
 
+    /**
+     * \brief Split a TCP super-segment into segments
+     *
+     * If the packet is a TCP super-segment, built by a socket with the TCP
+     * segmentation offload enabled (see TcpTsoTag), create an item per segment,
+     * with copies of the IPv4 and TCP headers updated for the segment: the IPv4
+     * payload length and identification, the TCP sequence number and the checksums.
+     *
+     * \param segments the vector to which the items of the segments are appended
+     * \return true if the packet is a super-segment, false otherwise
+     */
+    bool Segment(std::vector<Ptr<QueueDiscItem>>& segments) const override;
+
   private:
     Ipv4Header m_header; //!< The IPv4 header.
     bool m_headerAdded;  //!< True if the header has already been added to the packet.
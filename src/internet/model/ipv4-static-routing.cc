@@ -81,6 +81,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     {
         Ipv4RoutingTableEntry* routePtr = new Ipv4RoutingTableEntry(route);
         m_networkRoutes.emplace_back(routePtr, metric);
+        m_networkRouteTrie.Insert(network, networkMask, m_networkRoutes.back());
     }
 }
 
@@ -99,6 +100,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry* routePtr = new Ipv4RoutingTableEntry(route);
 
         m_networkRoutes.emplace_back(routePtr, metric);
+        m_networkRouteTrie.Insert(network, networkMask, m_networkRoutes.back());
     }
 }
 
@@ -154,6 +156,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Mask networkMask = Ipv4Mask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
     m_networkRoutes.emplace_back(route, 0);
+    m_networkRouteTrie.Insert(network, networkMask, m_networkRoutes.back());
 }
 
 uint32_t
@@ -225,14 +228,16 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (NetworkRoutesI j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    std::vector<NetworkRouteTrie::Entry> routes;
+    m_networkRouteTrie.Find(route.GetDestNetwork(), route.GetDestNetworkMask(), routes);
+    for (const auto& j : routes)
     {
-        Ipv4RoutingTableEntry* rtentry = j->first;
+        Ipv4RoutingTableEntry* rtentry = j.second.first;
 
         if (rtentry->GetDest() == route.GetDest() &&
             rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
             rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() && j->second == metric)
+            rtentry->GetInterface() == route.GetInterface() && j.second.second == metric)
         {
             return true;
         }
@@ -262,10 +267,13 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (NetworkRoutesI i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
+    // the trie returns the matching routes in the order of m_networkRoutes
+    std::vector<NetworkRouteTrie::Entry> matches;
+    m_networkRouteTrie.Lookup(dest, matches);
+    for (const auto& match : matches)
     {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
+        Ipv4RoutingTableEntry* j = match.second.first;
+        uint32_t metric = match.second.second;
         Ipv4Mask mask = (j)->GetDestNetworkMask();
         uint16_t masklen = mask.GetPrefixLength();
         Ipv4Address entry = (j)->GetDestNetwork();
@@ -458,6 +466,9 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
+            m_networkRouteTrie.Remove(j->first->GetDestNetwork(),
+                                      j->first->GetDestNetworkMask(),
+                                      *j);
             delete j->first;
             m_networkRoutes.erase(j);
             return;
@@ -594,6 +605,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRouteTrie.Clear();
     for (MulticastRoutesI i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -633,6 +645,9 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
+            m_networkRouteTrie.Remove(it->first->GetDestNetwork(),
+                                      it->first->GetDestNetworkMask(),
+                                      *it);
             delete it->first;
             it = m_networkRoutes.erase(it);
         }
@@ -678,6 +693,9 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
+            m_networkRouteTrie.Remove(it->first->GetDestNetwork(),
+                                      it->first->GetDestNetworkMask(),
+                                      *it);
             delete it->first;
             it = m_networkRoutes.erase(it);
         }
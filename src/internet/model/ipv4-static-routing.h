@@ -22,6 +22,8 @@
 #ifndef IPV4_STATIC_ROUTING_H
 #define IPV4_STATIC_ROUTING_H
 
+#include "ipv4-prefix-trie.h"
+
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
 #include "ns3/ipv4-routing-protocol.h"
@@ -372,6 +374,9 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the network routes
     typedef std::list<std::pair<Ipv4RoutingTableEntry*, uint32_t>>::iterator NetworkRoutesI;
 
+    /// Trie indexing the network routes by destination
+    typedef Ipv4PrefixTrie<std::pair<Ipv4RoutingTableEntry*, uint32_t>> NetworkRouteTrie;
+
     /// Container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*> MulticastRoutes;
 
@@ -411,6 +416,12 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the network routes indexed by destination, to find the matching
+     * ones in the order of m_networkRoutes.
+     */
+    NetworkRouteTrie m_networkRouteTrie;
+
     /**
      * \brief the forwarding table for multicast.
      */
@@ -29,6 +29,46 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Ipv6EndPointDemux");
 
+/**
+ * \brief Remove an endpoint from an index.
+ * \param index the index
+ * \param key the key the endpoint is indexed with
+ * \param endPoint the endpoint
+ */
+template <typename Index, typename Key>
+static void
+EraseEndPoint(Index& index, const Key& key, Ipv6EndPoint* endPoint)
+{
+    auto range = index.equal_range(key);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        if (it->second == endPoint)
+        {
+            index.erase(it);
+            return;
+        }
+    }
+    NS_ASSERT_MSG(false, "Endpoint " << endPoint << " not indexed");
+}
+
+bool
+Ipv6EndPointDemux::Tuple::operator==(const Tuple& other) const
+{
+    return m_localAddress == other.m_localAddress && m_localPort == other.m_localPort &&
+           m_peerAddress == other.m_peerAddress && m_peerPort == other.m_peerPort;
+}
+
+std::size_t
+Ipv6EndPointDemux::TupleHash::operator()(const Tuple& tuple) const
+{
+    Ipv6AddressHash addressHash;
+    std::size_t hash = addressHash(tuple.m_localAddress);
+    std::size_t ports = static_cast<std::size_t>(tuple.m_localPort) << 16 | tuple.m_peerPort;
+    hash ^= addressHash(tuple.m_peerAddress) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= ports + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
 Ipv6EndPointDemux::Ipv6EndPointDemux()
     : m_ephemeral(49152),
       m_portFirst(49152),
@@ -46,30 +86,110 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
         delete endPoint;
     }
     m_endPoints.clear();
+    m_entries.clear();
+    m_tuples.clear();
+    m_locals.clear();
+    m_ports.clear();
 }
 
-bool
-Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+Ipv6EndPointDemux::Tuple
+Ipv6EndPointDemux::GetTuple(Ipv6EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    return {endPoint->GetLocalAddress(),
+            endPoint->GetLocalPort(),
+            endPoint->GetPeerAddress(),
+            endPoint->GetPeerPort()};
+}
+
+void
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    Entry& entry = m_entries[endPoint];
+    entry.m_position = m_endPoints.insert(m_endPoints.end(), endPoint);
+    entry.m_tuple = GetTuple(endPoint);
+    Index(endPoint, entry.m_tuple);
+    endPoint->SetChangeCallback(MakeCallback(&Ipv6EndPointDemux::Reindex, this, endPoint));
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint, const Tuple& tuple)
+{
+    m_tuples.emplace(tuple, endPoint);
+    m_locals.emplace(Tuple{tuple.m_localAddress, tuple.m_localPort, Ipv6Address::GetAny(), 0},
+                     endPoint);
+    m_ports[tuple.m_localPort]++;
+}
+
+void
+Ipv6EndPointDemux::Unindex(Ipv6EndPoint* endPoint, const Tuple& tuple)
+{
+    EraseEndPoint(m_tuples, tuple, endPoint);
+    EraseEndPoint(m_locals,
+                  Tuple{tuple.m_localAddress, tuple.m_localPort, Ipv6Address::GetAny(), 0},
+                  endPoint);
+    auto port = m_ports.find(tuple.m_localPort);
+    if (--port->second == 0)
+    {
+        m_ports.erase(port);
+    }
+}
+
+void
+Ipv6EndPointDemux::Reindex(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto entry = m_entries.find(endPoint);
+    NS_ASSERT_MSG(entry != m_entries.end(), "Endpoint " << endPoint << " not allocated");
+    Unindex(endPoint, entry->second.m_tuple);
+    entry->second.m_tuple = GetTuple(endPoint);
+    Index(endPoint, entry->second.m_tuple);
+}
+
+void
+Ipv6EndPointDemux::Find(const Tuple& tuple,
+                        Ptr<Ipv6Interface> incomingInterface,
+                        EndPoints& endPoints)
+{
+    auto range = m_tuples.equal_range(tuple);
+    for (auto it = range.first; it != range.second; it++)
     {
-        if ((*i)->GetLocalPort() == port)
+        Ipv6EndPoint* endP = it->second;
+        if (!endP->IsRxEnabled())
         {
-            return true;
+            NS_LOG_LOGIC("Skipping endpoint " << endP
+                                              << " because endpoint can not receive packets");
+            continue;
         }
+        if (endP->GetBoundNetDevice() &&
+            (!incomingInterface || endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            NS_LOG_LOGIC("Skipping endpoint " << endP
+                                              << " because endpoint is bound to specific device "
+                                              << endP->GetBoundNetDevice()
+                                              << " which does not match packet device");
+            continue;
+        }
+        endPoints.push_back(endP);
     }
-    return false;
+}
+
+bool
+Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
+{
+    NS_LOG_FUNCTION(this << port);
+    return m_ports.find(port) != m_ports.end();
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto range = m_locals.equal_range(Tuple{addr, port, Ipv6Address::GetAny(), 0});
+    for (auto it = range.first; it != range.second; it++)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        if (it->second->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -88,8 +208,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -104,8 +223,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -127,8 +245,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    Insert(endPoint);
     return endPoint;
 }
 
@@ -140,11 +257,10 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto range = m_tuples.equal_range(Tuple{localAddress, localPort, peerAddress, peerPort});
+    for (auto it = range.first; it != range.second; it++)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        if (it->second->GetBoundNetDevice() == boundNetDevice || !it->second->GetBoundNetDevice())
         {
             NS_LOG_WARN("Duplicated endpoint.");
             return nullptr;
@@ -152,32 +268,35 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
     }
     Ipv6EndPoint* endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
+    Insert(endPoint);
     return endPoint;
 }
 
 void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
-    NS_LOG_FUNCTION(this);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    NS_LOG_FUNCTION(this << endPoint);
+    auto entry = m_entries.find(endPoint);
+    if (entry != m_entries.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        Unindex(endPoint, entry->second.m_tuple);
+        m_endPoints.erase(entry->second.m_position);
+        m_entries.erase(entry);
+        delete endPoint;
     }
 }
 
 /*
- * If we have an exact match, we return it.
- * Otherwise, if we find a generic match, we return it.
- * Otherwise, we return 0.
+ * The endpoints matching a packet are, from the most to the least exact:
+ *   4. those with the local address, local port, peer address and peer port
+ *      of the packet
+ *   3. those with the Any local address, and the local port, peer address
+ *      and peer port of the packet
+ *   2. those with the local address and local port of the packet, and a
+ *      wildcard peer
+ *   1. those with the Any local address, the local port of the packet, and
+ *      a wildcard peer
+ * Each case is found by looking up the corresponding tuple in the index.
  */
 Ipv6EndPointDemux::EndPoints
 Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
@@ -187,119 +306,22 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
                           Ptr<Ipv6Interface> incomingInterface)
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport << incomingInterface);
-
-    EndPoints retval1; /* Matches exact on local port, wildcards on others */
-    EndPoints retval2; /* Matches exact on local port/adder, wildcards on others */
-    EndPoints retval3; /* Matches all but local address */
-    EndPoints retval4; /* Exact match on all 4 */
-
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (EndPointsI i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv6EndPoint* endP = *i;
-
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
-
-        if (endP->GetBoundNetDevice())
-        {
-            if (!incomingInterface)
-            {
-                continue;
-            }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
-            {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
-                continue;
-            }
-        }
-
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
-
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
-
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
 
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
-        }
-    }
-
-    // Here we find the most exact match
     EndPoints retval;
-    if (!retval4.empty())
-    {
-        retval = retval4;
+    Ipv6Address any = Ipv6Address::GetAny();
+    Find(Tuple{daddr, dport, saddr, sport}, incomingInterface, retval);
+    if (retval.empty() && daddr != any)
+    { /* All but local address */
+        Find(Tuple{any, dport, saddr, sport}, incomingInterface, retval);
     }
-    else if (!retval3.empty())
-    {
-        retval = retval3;
-    }
-    else if (!retval2.empty())
-    {
-        retval = retval2;
+    if (retval.empty())
+    { /* Only local port and local address matches exactly */
+        Find(Tuple{daddr, dport, any, 0}, incomingInterface, retval);
     }
-    else
-    {
-        retval = retval1;
+    if (retval.empty() && daddr != any)
+    { /* Only local port matches exactly */
+        Find(Tuple{any, dport, any, 0}, incomingInterface, retval);
     }
 
     NS_ABORT_MSG_IF(retval.size() > 1,
@@ -311,6 +333,13 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    Tuple tuple{dst, dport, src, sport};
+    if (m_tuples.count(tuple) == 1)
+    {
+        /* this is an exact match. */
+        return m_tuples.find(tuple)->second;
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
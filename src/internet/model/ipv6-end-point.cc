@@ -47,6 +47,7 @@ Ipv6EndPoint::~Ipv6EndPoint()
     m_rxCallback.Nullify();
     m_icmpCallback.Nullify();
     m_destroyCallback.Nullify();
+    m_changeCallback.Nullify();
 }
 
 Ipv6Address
@@ -59,6 +60,10 @@ void
 Ipv6EndPoint::SetLocalAddress(Ipv6Address addr)
 {
     m_localAddr = addr;
+    if (!m_changeCallback.IsNull())
+    {
+        m_changeCallback();
+    }
 }
 
 uint16_t
@@ -71,6 +76,10 @@ void
 Ipv6EndPoint::SetLocalPort(uint16_t port)
 {
     m_localPort = port;
+    if (!m_changeCallback.IsNull())
+    {
+        m_changeCallback();
+    }
 }
 
 Ipv6Address
@@ -102,6 +111,10 @@ Ipv6EndPoint::SetPeer(Ipv6Address addr, uint16_t port)
 {
     m_peerAddr = addr;
     m_peerPort = port;
+    if (!m_changeCallback.IsNull())
+    {
+        m_changeCallback();
+    }
 }
 
 void
@@ -124,6 +137,12 @@ Ipv6EndPoint::SetDestroyCallback(Callback<void> callback)
     m_destroyCallback = callback;
 }
 
+void
+Ipv6EndPoint::SetChangeCallback(Callback<void> callback)
+{
+    m_changeCallback = callback;
+}
+
 void
 Ipv6EndPoint::ForwardUp(Ptr<Packet> p,
                         Ipv6Header header,
@@ -151,6 +151,15 @@ class Ipv6EndPoint
      * \param callback callback function
      */
     void SetDestroyCallback(Callback<void> callback);
+    /**
+     * \brief Set the callback invoked when the local address or port, or the
+     * peer address and port, of the endpoint change.
+     *
+     * The Ipv6EndPointDemux uses it to keep its indexes up to date.
+     *
+     * \param callback callback function
+     */
+    void SetChangeCallback(Callback<void> callback);
 
     /**
      * \brief Forward the packet to the upper level.
@@ -235,6 +244,11 @@ class Ipv6EndPoint
      */
     Callback<void> m_destroyCallback;
 
+    /**
+     * \brief The change callback.
+     */
+    Callback<void> m_changeCallback;
+
     /**
      * \brief true if the endpoint can receive packets.
      */
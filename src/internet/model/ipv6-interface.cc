@@ -33,6 +33,7 @@
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
 #include "ns3/traffic-control-layer.h"
 
 namespace ns3
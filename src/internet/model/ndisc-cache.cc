@@ -27,8 +27,13 @@
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 namespace ns3
 {
 
@@ -36,6 +41,23 @@ NS_LOG_COMPONENT_DEFINE("NdiscCache");
 
 NS_OBJECT_ENSURE_REGISTERED(NdiscCache);
 
+/**
+ * \brief Get the key of a MAC address in the index of the entries by MAC address.
+ *
+ * The key ignores the type of the address, since addresses of type zero are
+ * equal to addresses of any type.
+ *
+ * \param address the MAC address
+ * \returns the bytes of the address
+ */
+static std::string
+GetMacKey(const Address& address)
+{
+    uint8_t buffer[Address::MAX_SIZE];
+    uint32_t length = address.CopyTo(buffer);
+    return std::string(reinterpret_cast<const char*>(buffer), length);
+}
+
 TypeId
 NdiscCache::GetTypeId()
 {
@@ -51,6 +73,7 @@ NdiscCache::GetTypeId()
 }
 
 NdiscCache::NdiscCache()
+    : m_nudTimerSeq(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -119,15 +142,19 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto range = m_macEntries.equal_range(GetMacKey(dst));
+    for (auto i = range.first; i != range.second; i++)
     {
-        NdiscCache::Entry* entry = (*i).second;
+        NdiscCache::Entry* entry = i->second;
         if (entry->GetMacAddress() == dst)
         {
             NS_LOG_LOGIC("Found an entry:" << (*entry));
             entryList.push_back(entry);
         }
     }
+    entryList.sort([](NdiscCache::Entry* a, NdiscCache::Entry* b) {
+        return a->GetIpv6Address() < b->GetIpv6Address();
+    });
     return entryList;
 }
 
@@ -140,6 +167,7 @@ NdiscCache::Add(Ipv6Address to)
     NdiscCache::Entry* entry = new NdiscCache::Entry(this);
     entry->SetIpv6Address(to);
     m_ndCache[to] = entry;
+    IndexMacAddress(entry);
     return entry;
 }
 
@@ -148,18 +176,117 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    CacheI i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && i->second == entry)
     {
-        if ((*i).second == entry)
+        DeleteEntry(entry);
+    }
+}
+
+void
+NdiscCache::DeleteEntry(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    m_ndCache.erase(entry->GetIpv6Address());
+    UnindexMacAddress(entry);
+    entry->ClearWaitingPacket();
+    delete entry;
+}
+
+void
+NdiscCache::IndexMacAddress(NdiscCache::Entry* entry)
+{
+    m_macEntries.emplace(GetMacKey(entry->GetMacAddress()), entry);
+}
+
+void
+NdiscCache::UnindexMacAddress(NdiscCache::Entry* entry)
+{
+    auto range = m_macEntries.equal_range(GetMacKey(entry->GetMacAddress()));
+    for (auto i = range.first; i != range.second; i++)
+    {
+        if (i->second == entry)
         {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
+            m_macEntries.erase(i);
             return;
         }
     }
 }
 
+std::list<NdiscCache::Entry::NudTimer>::iterator
+NdiscCache::StartNudTimer(NdiscCache::Entry* entry, Entry::NudQueue_e queue, Time delay)
+{
+    NS_LOG_FUNCTION(this << entry << queue << delay);
+    std::list<Entry::NudTimer>& timers = m_nudTimers[queue];
+    Entry::NudTimer timer(Simulator::Now() + delay, m_nudTimerSeq++, entry);
+    // the timers of a queue have the same delay, unless it is changed, so
+    // the new timer usually goes to the back of the queue
+    auto position = timers.end();
+    while (position != timers.begin() && std::get<0>(*std::prev(position)) > std::get<0>(timer))
+    {
+        position--;
+    }
+    auto i = timers.insert(position, timer);
+    ScheduleNudEvent();
+    return i;
+}
+
+void
+NdiscCache::StopNudTimer(Entry::NudQueue_e queue, std::list<Entry::NudTimer>::iterator timer)
+{
+    NS_LOG_FUNCTION(this << queue);
+    // the NUD event is left scheduled: if no timer is due, it reschedules itself
+    m_nudTimers[queue].erase(timer);
+}
+
+void
+NdiscCache::HandleNudTimers()
+{
+    NS_LOG_FUNCTION(this);
+    m_nudEventTime = Time();
+    while (true)
+    {
+        // expire the timers in the order of their expiration and start
+        std::list<Entry::NudTimer>* earliest = nullptr;
+        for (auto& timers : m_nudTimers)
+        {
+            if (!timers.empty() && (earliest == nullptr || timers.front() < earliest->front()))
+            {
+                earliest = &timers;
+            }
+        }
+        if (earliest == nullptr || std::get<0>(earliest->front()) > Simulator::Now())
+        {
+            break;
+        }
+        NdiscCache::Entry* entry = std::get<2>(earliest->front());
+        earliest->pop_front();
+        entry->ExpireNudTimer();
+    }
+    ScheduleNudEvent();
+}
+
+void
+NdiscCache::ScheduleNudEvent()
+{
+    Time earliest = Time::Max();
+    for (const auto& timers : m_nudTimers)
+    {
+        if (!timers.empty())
+        {
+            earliest = std::min(earliest, std::get<0>(timers.front()));
+        }
+    }
+    if (earliest == Time::Max() || (m_nudEvent.IsRunning() && m_nudEventTime <= earliest))
+    {
+        return;
+    }
+    m_nudEvent.Cancel();
+    m_nudEventTime = earliest;
+    m_nudEvent =
+        Simulator::Schedule(earliest - Simulator::Now(), &NdiscCache::HandleNudTimers, this);
+}
+
 void
 NdiscCache::Flush()
 {
@@ -171,6 +298,8 @@ NdiscCache::Flush()
     }
 
     m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_macEntries.clear();
+    m_nudEvent.Cancel();
 }
 
 void
@@ -193,7 +322,9 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // print the entries in the order of their IPv6 addresses
+    std::map<Ipv6Address, NdiscCache::Entry*> entries(m_ndCache.begin(), m_ndCache.end());
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -248,13 +379,21 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
+      m_nudFunction(nullptr),
+      m_nudQueue(NUD_REACHABLE_QUEUE),
+      m_nudTimerRunning(false),
       m_lastReachabilityConfirmation(Seconds(0.0)),
       m_nsRetransmit(0)
 {
     NS_LOG_FUNCTION(this);
 }
 
+NdiscCache::Entry::~Entry()
+{
+    NS_LOG_FUNCTION(this);
+    CancelNudTimer();
+}
+
 void
 NdiscCache::Entry::SetRouter(bool router)
 {
@@ -470,15 +609,10 @@ void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionReachableTimeout,
+                  NUD_REACHABLE_QUEUE,
+                  m_ndCache->m_icmpv6->GetReachableTime());
 }
 
 void
@@ -489,11 +623,7 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
-        {
-            m_nudTimer.Cancel();
-        }
-        m_nudTimer.Schedule();
+        RestartNudTimer();
     }
 }
 
@@ -501,50 +631,80 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionProbeTimeout,
+                  NUD_RETRANSMIT_QUEUE,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionDelayTimeout,
+                  NUD_DELAY_QUEUE,
+                  m_ndCache->m_icmpv6->GetDelayFirstProbe());
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
+    StartNudTimer(&NdiscCache::Entry::FunctionRetransmitTimeout,
+                  NUD_RETRANSMIT_QUEUE,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
+}
+
+void
+NdiscCache::Entry::StopNudTimer()
+{
+    NS_LOG_FUNCTION(this);
+    CancelNudTimer();
+    m_nsRetransmit = 0;
+}
+
+void
+NdiscCache::Entry::StartNudTimer(void (NdiscCache::Entry::*function)(),
+                                 NudQueue_e queue,
+                                 Time delay)
+{
+    NS_LOG_FUNCTION(this << queue << delay);
+    m_nudFunction = function;
+    m_nudQueue = queue;
+    m_nudDelay = delay;
+    RestartNudTimer();
+}
+
+void
+NdiscCache::Entry::RestartNudTimer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_nudFunction == nullptr)
     {
-        m_nudTimer.Cancel();
+        return;
     }
+    CancelNudTimer();
+    m_nudTimer = m_ndCache->StartNudTimer(this, m_nudQueue, m_nudDelay);
+    m_nudTimerRunning = true;
+}
 
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+void
+NdiscCache::Entry::CancelNudTimer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_nudTimerRunning)
+    {
+        m_ndCache->StopNudTimer(m_nudQueue, m_nudTimer);
+        m_nudTimerRunning = false;
+    }
 }
 
 void
-NdiscCache::Entry::StopNudTimer()
+NdiscCache::Entry::ExpireNudTimer()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
-    m_nsRetransmit = 0;
+    // the timer has been removed from its queue; the function may delete the entry
+    m_nudTimerRunning = false;
+    (this->*m_nudFunction)();
 }
 
 void
@@ -564,7 +724,7 @@ NdiscCache::Entry::MarkReachable(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = REACHABLE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -594,7 +754,7 @@ NdiscCache::Entry::MarkStale(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = STALE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -681,7 +841,16 @@ void
 NdiscCache::Entry::SetMacAddress(Address mac)
 {
     NS_LOG_FUNCTION(this << mac << int(m_state));
+    m_ndCache->UnindexMacAddress(this);
     m_macAddress = mac;
+    m_ndCache->IndexMacAddress(this);
+}
+
+NdiscCache::Entry::NdiscCacheEntryState_e
+NdiscCache::Entry::GetEntryState() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_state;
 }
 
 void
@@ -718,16 +887,17 @@ void
 NdiscCache::RemoveAutoGeneratedEntries()
 {
     NS_LOG_FUNCTION(this);
-    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end();)
+    std::vector<NdiscCache::Entry*> autoGenerated;
+    for (CacheI i = m_ndCache.begin(); i != m_ndCache.end(); i++)
     {
         if (i->second->IsAutoGenerated())
         {
-            i->second->ClearWaitingPacket();
-            delete i->second;
-            m_ndCache.erase(i++);
-            continue;
+            autoGenerated.push_back(i->second);
         }
-        i++;
+    }
+    for (NdiscCache::Entry* entry : autoGenerated)
+    {
+        DeleteEntry(entry);
     }
 }
 
@@ -21,17 +21,20 @@
 #ifndef NDISC_CACHE_H
 #define NDISC_CACHE_H
 
+#include "ns3/event-id.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
-#include "ns3/timer.h"
 
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <string>
+#include <tuple>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -45,6 +48,14 @@ class Icmpv6L4Protocol;
  * \ingroup ipv6
  *
  * \brief IPv6 Neighbor Discovery cache.
+ *
+ * The entries are stored in a hash table, and indexed by MAC address for
+ * the reverse lookups done for each received packet. The NUD timers of the
+ * entries do not schedule their own events: they are kept in per-cache
+ * queues, one per timeout, ordered by expiration time, and a single event
+ * expires the earliest ones. Restarting the reachable timer of an entry,
+ * which happens for each packet received from it, moves the timer to the
+ * back of its queue.
  */
 class NdiscCache : public Object
 {
@@ -173,7 +184,10 @@ class NdiscCache : public Object
          */
         Entry(NdiscCache* nd);
 
-        virtual ~Entry() = default;
+        /**
+         * \brief Destructor, which stops the NUD timer.
+         */
+        virtual ~Entry();
 
         /**
          * \brief The Entry state enumeration.
@@ -413,6 +427,47 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        friend class NdiscCache;
+
+        /**
+         * \brief A NUD timer: the expiration time, the sequence number of its start and its entry.
+         */
+        typedef std::tuple<Time, uint64_t, NdiscCache::Entry*> NudTimer;
+
+        /**
+         * \brief The NUD timer queues, one for each timeout.
+         */
+        enum NudQueue_e
+        {
+            NUD_REACHABLE_QUEUE,  /**< Reachable timers */
+            NUD_RETRANSMIT_QUEUE, /**< Retransmit and probe timers */
+            NUD_DELAY_QUEUE,      /**< Delay timers */
+            NUD_QUEUES            /**< Number of queues */
+        };
+
+        /**
+         * \brief Start the NUD timer.
+         * \param function the function called when the timer expires
+         * \param queue the queue of the timer
+         * \param delay the delay of the timer
+         */
+        void StartNudTimer(void (NdiscCache::Entry::*function)(), NudQueue_e queue, Time delay);
+
+        /**
+         * \brief Restart the NUD timer with the last function and delay.
+         */
+        void RestartNudTimer();
+
+        /**
+         * \brief Cancel the NUD timer, if it is running.
+         */
+        void CancelNudTimer();
+
+        /**
+         * \brief Called by the cache when the NUD timer expires.
+         */
+        void ExpireNudTimer();
+
         /**
          * \brief The IPv6 address.
          */
@@ -434,9 +489,29 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * \brief Timer (used for NUD).
+         * \brief The function called when the NUD timer expires.
+         */
+        void (NdiscCache::Entry::*m_nudFunction)();
+
+        /**
+         * \brief The queue of the NUD timer.
+         */
+        NudQueue_e m_nudQueue;
+
+        /**
+         * \brief The delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * \brief True if the NUD timer is running.
+         */
+        bool m_nudTimerRunning;
+
+        /**
+         * \brief The NUD timer in its queue, if it is running.
          */
-        Timer m_nudTimer;
+        std::list<NudTimer>::iterator m_nudTimer;
 
         /**
          * \brief Last time we see a reachability confirmation.
@@ -458,11 +533,11 @@ class NdiscCache : public Object
     /**
      * \brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * \brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     /**
      * \brief A list of Entry.
@@ -470,6 +545,78 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * \brief Add an entry to the index of the entries by MAC address.
+     * \param entry the entry
+     */
+    void IndexMacAddress(NdiscCache::Entry* entry);
+
+    /**
+     * \brief Remove an entry from the index of the entries by MAC address.
+     * \param entry the entry
+     */
+    void UnindexMacAddress(NdiscCache::Entry* entry);
+
+    /**
+     * \brief Delete an entry of the cache.
+     * \param entry the entry
+     */
+    void DeleteEntry(NdiscCache::Entry* entry);
+
+    /**
+     * \brief Add a NUD timer to a queue.
+     * \param entry the entry of the timer
+     * \param queue the queue
+     * \param delay the delay of the timer
+     * \return the timer in the queue
+     */
+    std::list<Entry::NudTimer>::iterator StartNudTimer(NdiscCache::Entry* entry,
+                                                        Entry::NudQueue_e queue,
+                                                        Time delay);
+
+    /**
+     * \brief Remove a NUD timer from its queue.
+     * \param queue the queue
+     * \param timer the timer
+     */
+    void StopNudTimer(Entry::NudQueue_e queue, std::list<Entry::NudTimer>::iterator timer);
+
+    /**
+     * \brief Expire the NUD timers that are due, then schedule the next expiration.
+     */
+    void HandleNudTimers();
+
+    /**
+     * \brief Schedule the NUD event at the expiration of the earliest timer,
+     * unless an earlier event is already scheduled.
+     */
+    void ScheduleNudEvent();
+
+    /**
+     * \brief The entries, indexed by the bytes of their MAC address.
+     */
+    std::unordered_multimap<std::string, NdiscCache::Entry*> m_macEntries;
+
+    /**
+     * \brief The NUD timer queues, ordered by expiration time and sequence number.
+     */
+    std::list<Entry::NudTimer> m_nudTimers[Entry::NUD_QUEUES];
+
+    /**
+     * \brief The sequence number of the next NUD timer start.
+     */
+    uint64_t m_nudTimerSeq;
+
+    /**
+     * \brief The event expiring the NUD timers.
+     */
+    EventId m_nudEvent;
+
+    /**
+     * \brief The time of m_nudEvent.
+     */
+    Time m_nudEventTime;
+
     /**
      * \brief The NetDevice.
      */
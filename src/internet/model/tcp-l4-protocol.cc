@@ -22,6 +22,7 @@
 
 #include "ipv4-end-point-demux.h"
 #include "ipv4-end-point.h"
+#include "ipv4-interface.h"
 #include "ipv4-l3-protocol.h"
 #include "ipv6-end-point-demux.h"
 #include "ipv6-end-point.h"
@@ -35,6 +36,7 @@
 #include "tcp-recovery-ops.h"
 #include "tcp-socket-base.h"
 #include "tcp-socket-factory-impl.h"
+#include "tcp-tso-tag.h"
 
 #include "ns3/assert.h"
 #include "ns3/boolean.h"
@@ -47,6 +49,8 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <vector>
@@ -96,7 +100,20 @@ TcpL4Protocol::GetTypeId()
                                           "The list of sockets associated to this protocol.",
                                           ObjectVectorValue(),
                                           MakeObjectVectorAccessor(&TcpL4Protocol::m_sockets),
-                                          MakeObjectVectorChecker<TcpSocketBase>());
+                                          MakeObjectVectorChecker<TcpSocketBase>())
+                            .AddAttribute("Gro",
+                                          "Enable or disable the generic receive offload (IPv4 "
+                                          "only): coalesce the in-order data segments of a "
+                                          "connection",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&TcpL4Protocol::m_gro),
+                                          MakeBooleanChecker())
+                            .AddAttribute("GroFlushTimeout",
+                                          "Time the generic receive offload holds the data "
+                                          "segments before forwarding them up to the sockets",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&TcpL4Protocol::m_groFlushTimeout),
+                                          MakeTimeChecker());
     return tid;
 }
 
@@ -166,6 +183,8 @@ void
 TcpL4Protocol::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_groEvent.Cancel();
+    m_groSegments.clear();
     m_sockets.clear();
 
     if (m_endPoints != nullptr)
@@ -510,6 +529,12 @@ TcpL4Protocol::Receive(Ptr<Packet> packet,
     }
 
     NS_ASSERT_MSG(endPoints.size() == 1, "Demux returned more than one endpoint");
+
+    if (m_gro && GroReceive(packet, incomingTcpHeader, incomingIpHeader, incomingInterface))
+    {
+        return IpL4Protocol::RX_OK;
+    }
+
     NS_LOG_LOGIC("TcpL4Protocol " << this
                                   << " received a packet and"
                                      " now forwarding it up to endpoint/socket");
@@ -580,6 +605,163 @@ TcpL4Protocol::Receive(Ptr<Packet> packet,
     return IpL4Protocol::RX_OK;
 }
 
+/**
+ * \brief Check if two TCP headers carry the same options
+ *
+ * As in Linux, two segments are coalesced only if their options are
+ * identical, e.g., if they carry the same timestamps.
+ *
+ * \param lhs the first header
+ * \param rhs the second header
+ * \return true if the serialized options are equal
+ */
+static bool
+HaveSameOptions(const TcpHeader& lhs, const TcpHeader& rhs)
+{
+    if (lhs.GetOptionLength() != rhs.GetOptionLength())
+    {
+        return false;
+    }
+    if (lhs.GetOptionLength() == 0)
+    {
+        return true;
+    }
+
+    uint32_t size = lhs.GetSerializedSize();
+    Buffer lhsBuffer;
+    lhsBuffer.AddAtStart(size);
+    lhs.Serialize(lhsBuffer.Begin());
+    Buffer rhsBuffer;
+    rhsBuffer.AddAtStart(size);
+    rhs.Serialize(rhsBuffer.Begin());
+
+    // the options follow the 20 bytes of the fixed header
+    return std::memcmp(lhsBuffer.PeekData() + 20, rhsBuffer.PeekData() + 20, size - 20) == 0;
+}
+
+bool
+TcpL4Protocol::GroReceive(Ptr<Packet> packet,
+                          const TcpHeader& tcpHeader,
+                          const Ipv4Header& ipHeader,
+                          Ptr<Ipv4Interface> interface)
+{
+    NS_LOG_FUNCTION(this << packet << tcpHeader << ipHeader);
+
+    GroFlow flow(ipHeader.GetSource(),
+                 ipHeader.GetDestination(),
+                 tcpHeader.GetSourcePort(),
+                 tcpHeader.GetDestinationPort());
+    auto held = m_groSegments.find(flow);
+
+    // Only the data segments without control flags other than ACK and ECE are held
+    uint32_t payloadSize = packet->GetSize() - tcpHeader.GetSerializedSize();
+    bool isData = payloadSize > 0 && (tcpHeader.GetFlags() & TcpHeader::ACK) &&
+                  !(tcpHeader.GetFlags() & ~(TcpHeader::ACK | TcpHeader::ECE));
+
+    // A super-segment delivered locally is made of several segments
+    TcpTsoTag tsoTag;
+    bool isSuperSegment = packet->PeekPacketTag(tsoTag);
+
+    if (held != m_groSegments.end())
+    {
+        GroSegment& heldSegment = held->second;
+        uint32_t heldSize = heldSegment.m_payload->GetSize();
+        if (isData &&
+            heldSegment.m_header.GetSequenceNumber() + SequenceNumber32(heldSize) ==
+                tcpHeader.GetSequenceNumber() &&
+            heldSegment.m_header.GetAckNumber() == tcpHeader.GetAckNumber() &&
+            heldSegment.m_header.GetFlags() == tcpHeader.GetFlags() &&
+            heldSegment.m_header.GetWindowSize() == tcpHeader.GetWindowSize() &&
+            heldSegment.m_ipHeader.GetTos() == ipHeader.GetTos() &&
+            heldSegment.m_ipHeader.GetTtl() == ipHeader.GetTtl() &&
+            heldSize + payloadSize <= 65535 - ipHeader.GetSerializedSize() -
+                                          tcpHeader.GetSerializedSize() &&
+            HaveSameOptions(heldSegment.m_header, tcpHeader))
+        {
+            NS_LOG_LOGIC("Coalesce segment " << tcpHeader << " of size " << payloadSize);
+            Ptr<Packet> payload = packet->Copy();
+            payload->RemoveAtStart(tcpHeader.GetSerializedSize());
+            heldSegment.m_payload->AddAtEnd(payload);
+            heldSegment.m_segments += isSuperSegment ? tsoTag.GetSegments() : 1;
+            return true;
+        }
+
+        // The held segment precedes this one
+        GroSegment segment = heldSegment;
+        m_groSegments.erase(held);
+        GroForwardUp(segment);
+    }
+
+    if (!isData)
+    {
+        return false;
+    }
+
+    NS_LOG_LOGIC("Hold segment " << tcpHeader << " of size " << payloadSize);
+    Ptr<Packet> payload = packet->Copy();
+    payload->RemoveAtStart(tcpHeader.GetSerializedSize());
+    m_groSegments.emplace(flow,
+                          GroSegment{payload,
+                                     tcpHeader,
+                                     ipHeader,
+                                     interface,
+                                     isSuperSegment ? tsoTag.GetSegmentSize() : payloadSize,
+                                     isSuperSegment ? tsoTag.GetSegments() : 1});
+    if (!m_groEvent.IsRunning())
+    {
+        m_groEvent = Simulator::Schedule(m_groFlushTimeout, &TcpL4Protocol::GroFlush, this);
+    }
+    return true;
+}
+
+void
+TcpL4Protocol::GroForwardUp(const GroSegment& segment)
+{
+    NS_LOG_FUNCTION(this << segment.m_header << segment.m_payload->GetSize());
+
+    // The header keeps the checksum settings of the first segment, hence the
+    // checksum is computed again over the coalesced payload
+    Ptr<Packet> packet = segment.m_payload;
+    packet->AddHeader(segment.m_header);
+    if (segment.m_segments > 1)
+    {
+        // Tell the socket the number of coalesced segments, as for a super-segment
+        TcpTsoTag tsoTag(segment.m_segmentSize, segment.m_segments);
+        packet->ReplacePacketTag(tsoTag);
+    }
+    Ipv4Header ipHeader = segment.m_ipHeader;
+    ipHeader.SetPayloadSize(packet->GetSize());
+
+    // The endpoint may have been deallocated since the segment was held
+    Ipv4EndPointDemux::EndPoints endPoints = m_endPoints->Lookup(ipHeader.GetDestination(),
+                                                                 segment.m_header.GetDestinationPort(),
+                                                                 ipHeader.GetSource(),
+                                                                 segment.m_header.GetSourcePort(),
+                                                                 segment.m_interface);
+    if (endPoints.empty())
+    {
+        NoEndPointsFound(segment.m_header, ipHeader.GetSource(), ipHeader.GetDestination());
+        return;
+    }
+
+    (*endPoints.begin())
+        ->ForwardUp(packet, ipHeader, segment.m_header.GetSourcePort(), segment.m_interface);
+}
+
+void
+TcpL4Protocol::GroFlush()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Forwarding up a segment may cause other segments to be received
+    std::map<GroFlow, GroSegment> segments;
+    segments.swap(m_groSegments);
+    for (const auto& [flow, segment] : segments)
+    {
+        GroForwardUp(segment);
+    }
+}
+
 void
 TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
                             const TcpHeader& outgoing,
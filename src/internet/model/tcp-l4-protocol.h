@@ -22,19 +22,24 @@
 #define TCP_L4_PROTOCOL_H
 
 #include "ip-l4-protocol.h"
+#include "ipv4-header.h"
+#include "tcp-header.h"
 
+#include "ns3/event-id.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
+#include "ns3/nstime.h"
 #include "ns3/sequence-number.h"
 
+#include <map>
 #include <stdint.h>
+#include <tuple>
 
 namespace ns3
 {
 
 class Node;
 class Socket;
-class TcpHeader;
 class Ipv4EndPointDemux;
 class Ipv6EndPointDemux;
 class Ipv4Interface;
@@ -72,6 +77,19 @@ class NetDevice;
  * and SHOULD checksum packets its receives from the socket layer going down
  * the stack, but currently checksumming is disabled.
  *
+ * When the Gro attribute is set, this class coalesces the in-order data
+ * segments of a connection received over IPv4, like the Linux generic receive
+ * offload, and forwards them up to the socket as a single segment when the
+ * GroFlushTimeout expires after the first of them is received. The coalesced
+ * segment carries a TcpTsoTag with the number of segments it is made of, which
+ * the socket counts for the delayed ACKs. This saves the per-segment
+ * processing of the socket for bursts of segments, such as the aggregated
+ * frames of some link layers or the segments of a TCP super-segment (see the
+ * Tso attribute of TcpSocketBase). As the gro_flush_timeout of Linux,
+ * a non-zero timeout delays the segments up to the timeout; the default zero
+ * timeout only coalesces the segments received at the same simulation time
+ * before the held ones are forwarded up.
+ *
  * \see CreateSocket
  * \see NotifyNewAggregate
  * \see SendPacket
@@ -335,6 +353,55 @@ class TcpL4Protocol : public IpL4Protocol
                           const Address& incomingDAddr);
 
   private:
+    /**
+     * \brief A data segment held by the generic receive offload, into which the
+     *        following in-order data segments of the connection are coalesced
+     */
+    struct GroSegment
+    {
+        Ptr<Packet> m_payload;          //!< Payload of the coalesced segments
+        TcpHeader m_header;             //!< TCP header of the first segment
+        Ipv4Header m_ipHeader;          //!< IPv4 header of the first segment
+        Ptr<Ipv4Interface> m_interface; //!< Interface the first segment was received on
+        uint32_t m_segmentSize;         //!< Size of the payload of the first segment
+        uint32_t m_segments;            //!< Number of coalesced segments
+    };
+
+    /**
+     * \brief The connection of a segment held by the generic receive offload: its
+     *        source address, destination address, source port and destination port
+     */
+    typedef std::tuple<Ipv4Address, Ipv4Address, uint16_t, uint16_t> GroFlow;
+
+    /**
+     * \brief Hold a data segment received over IPv4, or coalesce it into the
+     *        segment held for its connection
+     *
+     * A segment which cannot be coalesced first causes the segment held for its
+     * connection, if any, to be forwarded up.
+     *
+     * \param packet the received packet, starting with the TCP header
+     * \param tcpHeader the TCP header
+     * \param ipHeader the IPv4 header
+     * \param interface the interface the packet was received on
+     * \return true if the segment has been held, false if it must be forwarded up now
+     */
+    bool GroReceive(Ptr<Packet> packet,
+                    const TcpHeader& tcpHeader,
+                    const Ipv4Header& ipHeader,
+                    Ptr<Ipv4Interface> interface);
+
+    /**
+     * \brief Forward up a segment held by the generic receive offload
+     * \param segment the held segment
+     */
+    void GroForwardUp(const GroSegment& segment);
+
+    /**
+     * \brief Forward up all the segments held by the generic receive offload
+     */
+    void GroFlush();
+
     Ptr<Node> m_node;                                //!< the node this stack is associated with
     Ipv4EndPointDemux* m_endPoints;                  //!< A list of IPv4 end points.
     Ipv6EndPointDemux* m_endPoints6;                 //!< A list of IPv6 end points.
@@ -344,6 +411,10 @@ class TcpL4Protocol : public IpL4Protocol
     std::vector<Ptr<TcpSocketBase>> m_sockets;       //!< list of sockets
     IpL4Protocol::DownTargetCallback m_downTarget;   //!< Callback to send packets over IPv4
     IpL4Protocol::DownTargetCallback6 m_downTarget6; //!< Callback to send packets over IPv6
+    bool m_gro{false};                               //!< Generic receive offload enabled
+    Time m_groFlushTimeout;                          //!< Time segments are held by the offload
+    std::map<GroFlow, GroSegment> m_groSegments;     //!< Segments held by the receive offload
+    EventId m_groEvent;                              //!< Event forwarding up the held segments
 
     /**
      * \brief Send a packet via TCP (IPv4)
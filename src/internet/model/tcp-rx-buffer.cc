@@ -172,8 +172,14 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
             headSeq = tailSeq;
         }
     }
-    // Remove overlapped bytes from packet
-    BufIterator i = m_data.begin();
+    // Remove overlapped bytes from packet. The chunks before the last one
+    // starting at or before headSeq end before headSeq, as the chunks do not
+    // overlap, hence they are not visited
+    BufIterator i = m_data.upper_bound(headSeq);
+    if (i != m_data.begin())
+    {
+        --i;
+    }
     while (i != m_data.end() && i->first <= tailSeq)
     {
         SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second->GetSize());
@@ -222,16 +228,8 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
     NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
     // Update variables
     m_size += p->GetSize(); // Occupancy
-    for (i = m_data.begin(); i != m_data.end(); ++i)
+    for (i = m_data.lower_bound(m_nextRxSeq); i != m_data.end() && i->first == m_nextRxSeq; ++i)
     {
-        if (i->first < m_nextRxSeq)
-        {
-            continue;
-        }
-        else if (i->first > m_nextRxSeq)
-        {
-            break;
-        };
         m_nextRxSeq = i->first + SequenceNumber32(i->second->GetSize());
         m_availBytes += i->second->GetSize();
         ClearSackList(m_nextRxSeq);
@@ -382,15 +380,40 @@ TcpRxBuffer::Extract(uint32_t maxSize)
 {
     NS_LOG_FUNCTION(this << maxSize);
 
+    std::vector<Ptr<Packet>> chain;
+    if (ExtractChain(maxSize, chain) == 0)
+    {
+        NS_LOG_LOGIC("Nothing extracted.");
+        return nullptr; // No contiguous block to return
+    }
+    if (chain.size() == 1)
+    {
+        return chain.front();
+    }
+
+    Ptr<Packet> outPkt = Create<Packet>(); // The packet that contains all the data to return
+    for (const auto& chunk : chain)
+    {
+        outPkt->AddAtEnd(chunk);
+    }
+    m_copiedBytes += outPkt->GetSize();
+    return outPkt;
+}
+
+uint32_t
+TcpRxBuffer::ExtractChain(uint32_t maxSize, std::vector<Ptr<Packet>>& chain)
+{
+    NS_LOG_FUNCTION(this << maxSize);
+
     uint32_t extractSize = std::min(maxSize, m_availBytes);
     NS_LOG_LOGIC("Requested to extract " << extractSize
                                          << " bytes from TcpRxBuffer of size=" << m_size);
     if (extractSize == 0)
     {
-        return nullptr; // No contiguous block to return
+        return 0; // No contiguous block to return
     }
-    NS_ASSERT(m_data.size());              // At least we have something to extract
-    Ptr<Packet> outPkt = Create<Packet>(); // The packet that contains all the data to return
+    NS_ASSERT(m_data.size()); // At least we have something to extract
+    uint32_t extracted = extractSize;
     BufIterator i;
     while (extractSize)
     { // Check the buffered data for delivery
@@ -400,7 +423,11 @@ TcpRxBuffer::Extract(uint32_t maxSize)
         uint32_t pktSize = i->second->GetSize();
         if (pktSize <= extractSize)
         { // Whole packet is extracted
-            outPkt->AddAtEnd(i->second);
+            // As with a concatenation, the packet tags are not delivered; they
+            // are removed from a copy, as the packet may be referenced elsewhere
+            Ptr<Packet> chunk = i->second->Copy();
+            chunk->RemoveAllPacketTags();
+            chain.push_back(chunk);
             m_data.erase(i);
             m_size -= pktSize;
             m_availBytes -= pktSize;
@@ -408,7 +435,9 @@ TcpRxBuffer::Extract(uint32_t maxSize)
         }
         else
         { // Partial is extracted and done
-            outPkt->AddAtEnd(i->second->CreateFragment(0, extractSize));
+            Ptr<Packet> fragment = i->second->CreateFragment(0, extractSize);
+            fragment->RemoveAllPacketTags();
+            chain.push_back(fragment);
             m_data[i->first + SequenceNumber32(extractSize)] =
                 i->second->CreateFragment(extractSize, pktSize - extractSize);
             m_data.erase(i);
@@ -417,14 +446,22 @@ TcpRxBuffer::Extract(uint32_t maxSize)
             extractSize = 0;
         }
     }
-    if (outPkt->GetSize() == 0)
-    {
-        NS_LOG_LOGIC("Nothing extracted.");
-        return nullptr;
-    }
-    NS_LOG_LOGIC("Extracted " << outPkt->GetSize() << " bytes, bufsize=" << m_size
+    m_extractedBytes += extracted;
+    NS_LOG_LOGIC("Extracted " << extracted << " bytes, bufsize=" << m_size
                               << ", num pkts in buffer=" << m_data.size());
-    return outPkt;
+    return extracted;
+}
+
+uint64_t
+TcpRxBuffer::GetExtractedBytes() const
+{
+    return m_extractedBytes;
+}
+
+uint64_t
+TcpRxBuffer::GetCopiedBytes() const
+{
+    return m_copiedBytes;
 }
 
 } // namespace ns3
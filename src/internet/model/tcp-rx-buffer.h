@@ -29,6 +29,7 @@
 #include "ns3/traced-value.h"
 
 #include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -55,6 +56,13 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * The data is stored as the chunks received by Add, which are never copied
+ * into each other. ExtractChain returns the ordered data as the chain of these
+ * chunks (only the last one may be a fragment of a stored chunk), while
+ * Extract concatenates the chain into a single packet when it holds more than
+ * one chunk. The number of bytes extracted and of bytes concatenated by
+ * Extract are returned by GetExtractedBytes and GetCopiedBytes.
+ *
  * SACK list
  * ---------
  *
@@ -160,6 +168,32 @@ class TcpRxBuffer : public Object
      */
     Ptr<Packet> Extract(uint32_t maxSize);
 
+    /**
+     * Extract data from the head of the buffer as indicated by nextRxSeq,
+     * without concatenating the stored chunks.
+     *
+     * \param maxSize maximum number of bytes to extract
+     * \param chain the vector the extracted chunks are appended to, in order
+     * \returns the number of bytes extracted
+     */
+    uint32_t ExtractChain(uint32_t maxSize, std::vector<Ptr<Packet>>& chain);
+
+    /**
+     * \brief Get the number of bytes extracted from the buffer
+     * \return the number of bytes returned by Extract and ExtractChain
+     */
+    uint64_t GetExtractedBytes() const;
+
+    /**
+     * \brief Get the number of bytes copied by Extract
+     *
+     * These are the bytes of the chunks Extract concatenated into a new packet
+     * because the extracted data was made of more than one chunk.
+     *
+     * \return the number of bytes concatenated
+     */
+    uint64_t GetCopiedBytes() const;
+
     /**
      * \brief Get the sack list
      *
@@ -232,6 +266,8 @@ class TcpRxBuffer : public Object
     uint32_t m_maxBuffer;  //!< Upper bound of the number of data bytes in buffer (RCV.WND)
     uint32_t m_availBytes; //!< Number of bytes available to read, i.e. contiguous block at head
     std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Corresponding data (may be null)
+    uint64_t m_extractedBytes{0}; //!< Number of bytes extracted
+    uint64_t m_copiedBytes{0};    //!< Number of bytes concatenated by Extract
 };
 
 } // namespace ns3
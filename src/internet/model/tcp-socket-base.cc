@@ -40,6 +40,7 @@
 #include "tcp-option-winscale.h"
 #include "tcp-recovery-ops.h"
 #include "tcp-rx-buffer.h"
+#include "tcp-tso-tag.h"
 #include "tcp-tx-buffer.h"
 
 #include "ns3/abort.h"
@@ -174,6 +175,27 @@ TcpSocketBase::GetTypeId()
                                           "On",
                                           TcpSocketState::AcceptOnly,
                                           "AcceptOnly"))
+            .AddAttribute("AckBatching",
+                          "Enable or disable the batching of the ACKs: the in-sequence data "
+                          "segments received at the same time, e.g., in an A-MPDU, are "
+                          "acknowledged by a single ACK sent at the end of the time step "
+                          "(duplicate ACKs are always sent immediately)",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TcpSocketBase::m_ackBatching),
+                          MakeBooleanChecker())
+            .AddAttribute("Tso",
+                          "Enable or disable the TCP segmentation offload (IPv4 only): the "
+                          "consecutive segments sent at once traverse the IP stack as a "
+                          "super-segment, split by the traffic control layer (the Tx trace "
+                          "source is invoked once for the super-segment)",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TcpSocketBase::m_tso),
+                          MakeBooleanChecker())
+            .AddAttribute("TsoMaxSegments",
+                          "Maximum number of segments of a super-segment",
+                          UintegerValue(44),
+                          MakeUintegerAccessor(&TcpSocketBase::m_tsoMaxSegments),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddTraceSource("RTO",
                             "Retransmission timeout",
                             MakeTraceSourceAccessor(&TcpSocketBase::m_rto),
@@ -239,7 +261,8 @@ TcpSocketBase::GetTypeId()
                             MakeTraceSourceAccessor(&TcpSocketBase::m_ssThTrace),
                             "ns3::TracedValueCallback::Uint32")
             .AddTraceSource("Tx",
-                            "Send tcp packet to IP protocol",
+                            "Send tcp packet to IP protocol (a super-segment, if the "
+                            "segmentation offload is enabled)",
                             MakeTraceSourceAccessor(&TcpSocketBase::m_txTrace),
                             "ns3::TcpSocketBase::TcpTxRxTracedCallback")
             .AddTraceSource("Rx",
@@ -333,6 +356,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_dupAckCount(sock.m_dupAckCount),
       m_delAckCount(0),
       m_delAckMaxCount(sock.m_delAckMaxCount),
+      m_ackBatching(sock.m_ackBatching),
       m_noDelay(sock.m_noDelay),
       m_synCount(sock.m_synCount),
       m_synRetries(sock.m_synRetries),
@@ -371,6 +395,8 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_tso(sock.m_tso),
+      m_tsoMaxSegments(sock.m_tsoMaxSegments),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -913,6 +939,13 @@ TcpSocketBase::Recv(uint32_t maxSize, uint32_t flags)
     return outPacket;
 }
 
+uint32_t
+TcpSocketBase::RecvChain(uint32_t maxSize, std::vector<Ptr<Packet>>& chain)
+{
+    NS_LOG_FUNCTION(this << maxSize);
+    return m_tcb->m_rxBuffer->ExtractChain(maxSize, chain);
+}
+
 /* Inherit from Socket class: Recv and return the remote's address */
 Ptr<Packet>
 TcpSocketBase::RecvFrom(uint32_t maxSize, uint32_t flags, Address& fromAddress)
@@ -2746,6 +2779,9 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
         return;
     }
 
+    // The super-segment being built, if any, holds data sent before this packet
+    SendTsoSegment();
+
     Ptr<Packet> p = Create<Packet>();
     TcpHeader header;
     SequenceNumber32 s = m_tcb->m_nextTxSequence;
@@ -2759,6 +2795,11 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
         ++s;
     }
 
+    if (flags & TcpHeader::ACK)
+    { // This packet acknowledges all the data received so far
+        m_ackBatchPending = false;
+    }
+
     AddSocketTags(p);
 
     header.SetFlags(flags);
@@ -3114,6 +3155,9 @@ TcpSocketBase::AddSocketTags(const Ptr<Packet>& p) const
     }
 }
 
+/// Maximum payload of a super-segment, sent in an IPv4 datagram with the largest headers
+static const uint32_t TSO_MAX_PAYLOAD = 65535 - 20 - 60;
+
 /* Extract at most maxSize bytes from the TxBuffer at sequence seq, add the
     TCP header, and send to TcpL4Protocol */
 uint32_t
@@ -3161,6 +3205,7 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     {
         m_delAckEvent.Cancel();
         m_delAckCount = 0;
+        m_ackBatchPending = false;
     }
 
     if (m_tcb->m_ecnState == TcpSocketState::ECN_ECE_RCVD &&
@@ -3216,10 +3261,40 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
     }
 
-    m_txTrace(p, header, this);
+    // A segment is appended to the super-segment being built if it follows
+    // its last, full-sized, segment and carries the same flags
+    if (m_tsoSegments > 0 &&
+        (m_tsoHeader.GetSequenceNumber() + SequenceNumber32(m_tsoPacket->GetSize()) != seq ||
+         m_tsoHeader.GetFlags() != flags || m_tsoSegments >= m_tsoMaxSegments ||
+         m_tsoPacket->GetSize() + sz > TSO_MAX_PAYLOAD))
+    {
+        SendTsoSegment();
+    }
 
-    if (m_endPoint)
+    if (m_tsoBatching && !(flags & (TcpHeader::FIN | TcpHeader::CWR)))
+    {
+        if (m_tsoSegments == 0)
+        {
+            m_tsoPacket = p;
+            m_tsoHeader = header;
+        }
+        else
+        {
+            m_tsoPacket->AddAtEnd(p);
+        }
+        ++m_tsoSegments;
+        NS_LOG_DEBUG("Add segment of size " << sz << " with remaining data " << remainingData
+                                            << " to the super-segment of " << m_tsoSegments
+                                            << " segments. Header " << m_tsoHeader);
+
+        if (sz < m_tcb->m_segmentSize)
+        {
+            SendTsoSegment();
+        }
+    }
+    else if (m_endPoint)
     {
+        m_txTrace(p, header, this);
         m_tcp->SendPacket(p,
                           header,
                           m_endPoint->GetLocalAddress(),
@@ -3231,6 +3306,7 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     }
     else
     {
+        m_txTrace(p, header, this);
         m_tcp->SendPacket(p,
                           header,
                           m_endPoint6->GetLocalAddress(),
@@ -3262,6 +3338,36 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     return sz;
 }
 
+void
+TcpSocketBase::SendTsoSegment()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_tsoSegments == 0)
+    {
+        return;
+    }
+
+    Ptr<Packet> p = m_tsoPacket;
+    if (m_tsoSegments > 1)
+    {
+        p->AddPacketTag(TcpTsoTag(m_tcb->m_segmentSize, m_tsoSegments));
+    }
+    m_tsoPacket = nullptr;
+    m_tsoSegments = 0;
+
+    NS_ASSERT(m_endPoint);
+    m_txTrace(p, m_tsoHeader, this);
+    m_tcp->SendPacket(p,
+                      m_tsoHeader,
+                      m_endPoint->GetLocalAddress(),
+                      m_endPoint->GetPeerAddress(),
+                      m_boundnetdevice);
+    NS_LOG_DEBUG("Send super-segment of size " << p->GetSize() << " via TcpL4Protocol to "
+                                               << m_endPoint->GetPeerAddress() << ". Header "
+                                               << m_tsoHeader);
+}
+
 void
 TcpSocketBase::UpdateRttHistory(const SequenceNumber32& seq, uint32_t sz, bool isRetransmission)
 {
@@ -3305,6 +3411,10 @@ TcpSocketBase::SendPendingData(bool withAck)
     uint32_t nPacketsSent = 0;
     uint32_t availableWindow = AvailableWindow();
 
+    // With the segmentation offload, SendDataPacket collects the segments
+    // in super-segments, sent before returning
+    m_tsoBatching = m_tso && m_endPoint != nullptr && !IsPacingEnabled();
+
     // RFC 6675, Section (C)
     // If cwnd - pipe >= 1 SMSS, the sender SHOULD transmit one or more
     // segments as follows:
@@ -3428,6 +3538,9 @@ TcpSocketBase::SendPendingData(bool withAck)
         // loop again!
     }
 
+    SendTsoSegment();
+    m_tsoBatching = false;
+
     if (nPacketsSent > 0)
     {
         if (!m_sackEnabled)
@@ -3528,6 +3641,11 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     NS_LOG_DEBUG("Data segment, seq=" << tcpHeader.GetSequenceNumber()
                                       << " pkt size=" << p->GetSize());
 
+    // A segment coalesced by the receive offload, or a super-segment delivered
+    // locally, counts as the segments it is made of for the delayed ACKs
+    TcpTsoTag tsoTag;
+    uint32_t segments = p->RemovePacketTag(tsoTag) ? tsoTag.GetSegments() : 1;
+
     // Put into Rx buffer
     SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence();
     if (!m_tcb->m_rxBuffer->Add(p, tcpHeader))
@@ -3569,6 +3687,7 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     if (m_tcb->m_rxBuffer->Size() > m_tcb->m_rxBuffer->Available() ||
         m_tcb->m_rxBuffer->NextRxSequence() > expectedSeq + p->GetSize())
     { // A gap exists in the buffer, or we filled a gap: Always ACK
+        // (the duplicate ACKs are not batched, as they trigger the fast retransmit)
         m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_NON_DELAYED_ACK);
         if (m_tcb->m_ecnState == TcpSocketState::ECN_CE_RCVD ||
             m_tcb->m_ecnState == TcpSocketState::ECN_SENDING_ECE)
@@ -3584,7 +3703,12 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        m_delAckCount += segments;
+        if (m_delAckCount >= m_delAckMaxCount && m_ackBatching)
+        { // Acknowledge also the other segments received at once
+            DeferAck();
+        }
+        else if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
@@ -3872,6 +3996,48 @@ TcpSocketBase::DelAckTimeout()
     }
 }
 
+void
+TcpSocketBase::DeferAck()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The segments delivered at once (e.g., from an A-MPDU) are received in
+    // events of the current time step which are already scheduled, hence they
+    // are processed before the deferred ACK is sent
+    m_ackBatchPending = true;
+    if (!m_ackBatchEvent.IsRunning())
+    {
+        m_ackBatchEvent = Simulator::ScheduleNow(&TcpSocketBase::SendDeferredAck, this);
+    }
+}
+
+void
+TcpSocketBase::SendDeferredAck()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_ackBatchPending)
+    {
+        NS_LOG_LOGIC("The received data has already been acknowledged");
+        return;
+    }
+
+    m_delAckEvent.Cancel();
+    m_delAckCount = 0;
+    m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_NON_DELAYED_ACK);
+    if (m_tcb->m_ecnState == TcpSocketState::ECN_CE_RCVD ||
+        m_tcb->m_ecnState == TcpSocketState::ECN_SENDING_ECE)
+    {
+        SendEmptyPacket(TcpHeader::ACK | TcpHeader::ECE);
+        NS_LOG_DEBUG(TcpSocketState::EcnStateName[m_tcb->m_ecnState] << " -> ECN_SENDING_ECE");
+        m_tcb->m_ecnState = TcpSocketState::ECN_SENDING_ECE;
+    }
+    else
+    {
+        SendEmptyPacket(TcpHeader::ACK);
+    }
+}
+
 void
 TcpSocketBase::LastAckTimeout()
 {
@@ -3998,6 +4164,7 @@ TcpSocketBase::CancelAllTimers()
     m_retxEvent.Cancel();
     m_persistEvent.Cancel();
     m_delAckEvent.Cancel();
+    m_ackBatchEvent.Cancel();
     m_lastAckEvent.Cancel();
     m_timewaitEvent.Cancel();
     m_sendPendingDataEvent.Cancel();
@@ -26,6 +26,7 @@
 #include "ns3/ipv6-header.h"
 #include "ns3/node.h"
 #include "ns3/sequence-number.h"
+#include "ns3/tcp-header.h"
 #include "ns3/tcp-socket-state.h"
 #include "ns3/tcp-socket.h"
 #include "ns3/timer.h"
@@ -33,6 +34,7 @@
 
 #include <queue>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -42,7 +44,6 @@ class Ipv6EndPoint;
 class Node;
 class Packet;
 class TcpL4Protocol;
-class TcpHeader;
 class TcpCongestionOps;
 class TcpRecoveryOps;
 class RttEstimator;
@@ -577,6 +578,18 @@ class TcpSocketBase : public TcpSocket
      */
     void SetPaceInitialWindow(bool paceWindow);
 
+    /**
+     * \brief Receive data as the chain of the chunks held by the Rx buffer
+     *
+     * Unlike Recv, the chunks are not concatenated into a single packet (see
+     * TcpRxBuffer::ExtractChain).
+     *
+     * \param maxSize maximum number of bytes to receive
+     * \param chain the vector the received chunks are appended to, in order
+     * \return the number of bytes received, zero if no data is available
+     */
+    uint32_t RecvChain(uint32_t maxSize, std::vector<Ptr<Packet>>& chain);
+
     // Necessary implementations of null functions from ns3::Socket
     enum SocketErrno GetErrno() const override;     // returns m_errno
     enum SocketType GetSocketType() const override; // returns socket type
@@ -809,6 +822,15 @@ class TcpSocketBase : public TcpSocket
      */
     virtual uint32_t SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withAck);
 
+    /**
+     * \brief Send the super-segment built by the TCP segmentation offload, if any
+     *
+     * When the Tso attribute is set, SendPendingData collects the consecutive
+     * segments prepared by SendDataPacket in a super-segment, with the header of
+     * the first segment, that traverses the IPv4 stack as a single packet.
+     */
+    void SendTsoSegment();
+
     /**
      * \brief Send a empty packet that carries a flag, e.g., ACK
      *
@@ -1102,6 +1124,18 @@ class TcpSocketBase : public TcpSocket
      */
     virtual void DelAckTimeout();
 
+    /**
+     * \brief Defer the ACK required by a received segment to the end of the
+     *        current time step (see the AckBatching attribute)
+     */
+    void DeferAck();
+
+    /**
+     * \brief Send the ACK deferred by DeferAck, unless a packet sent since
+     *        already acknowledged the received data
+     */
+    void SendDeferredAck();
+
     /**
      * \brief Timeout at LAST_ACK, close the connection
      */
@@ -1285,6 +1319,9 @@ class TcpSocketBase : public TcpSocket
     uint32_t m_dupAckCount{0};    //!< Dupack counter
     uint32_t m_delAckCount{0};    //!< Delayed ACK counter
     uint32_t m_delAckMaxCount{0}; //!< Number of packet to fire an ACK before delay timeout
+    bool m_ackBatching{false};    //!< Send a single ACK for the segments received at once
+    bool m_ackBatchPending{false}; //!< The segments received at once require an ACK
+    EventId m_ackBatchEvent{};     //!< Event sending the ACK of the segments received at once
 
     // Nagle algorithm
     bool m_noDelay{false}; //!< Set to true to disable Nagle's algorithm
@@ -1364,6 +1401,14 @@ class TcpSocketBase : public TcpSocket
     uint32_t m_retxThresh{3};    //!< Fast Retransmit threshold
     bool m_limitedTx{true};      //!< perform limited transmit
 
+    // Segmentation offload
+    bool m_tso{false};             //!< TCP segmentation offload enabled (IPv4 only)
+    uint32_t m_tsoMaxSegments{44}; //!< Maximum number of segments of a super-segment
+    bool m_tsoBatching{false};     //!< SendDataPacket builds a super-segment
+    Ptr<Packet> m_tsoPacket;       //!< Payload of the super-segment being built
+    TcpHeader m_tsoHeader;         //!< Header of the super-segment being built
+    uint32_t m_tsoSegments{0};     //!< Number of segments of the super-segment being built
+
     // Transmission Control Block
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
     Ptr<TcpCongestionOps> m_congestionControl; //!< Congestion control
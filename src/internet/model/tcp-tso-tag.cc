@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tcp-tso-tag.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TcpTsoTag");
+
+NS_OBJECT_ENSURE_REGISTERED(TcpTsoTag);
+
+TcpTsoTag::TcpTsoTag()
+    : m_segmentSize(0),
+      m_segments(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpTsoTag::TcpTsoTag(uint32_t segmentSize, uint32_t segments)
+    : m_segmentSize(segmentSize),
+      m_segments(segments)
+{
+    NS_LOG_FUNCTION(this << segmentSize << segments);
+}
+
+uint32_t
+TcpTsoTag::GetSegmentSize() const
+{
+    return m_segmentSize;
+}
+
+uint32_t
+TcpTsoTag::GetSegments() const
+{
+    return m_segments;
+}
+
+TypeId
+TcpTsoTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpTsoTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpTsoTag>();
+    return tid;
+}
+
+TypeId
+TcpTsoTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+TcpTsoTag::GetSerializedSize() const
+{
+    return 2 * sizeof(uint32_t);
+}
+
+void
+TcpTsoTag::Serialize(TagBuffer i) const
+{
+    i.WriteU32(m_segmentSize);
+    i.WriteU32(m_segments);
+}
+
+void
+TcpTsoTag::Deserialize(TagBuffer i)
+{
+    m_segmentSize = i.ReadU32();
+    m_segments = i.ReadU32();
+}
+
+void
+TcpTsoTag::Print(std::ostream& os) const
+{
+    os << "TSO [SegmentSize: " << m_segmentSize << ", Segments: " << m_segments << "] ";
+}
+
+} // namespace ns3
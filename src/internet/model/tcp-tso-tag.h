@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TCP_TSO_TAG_H
+#define TCP_TSO_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Mark a TCP super-segment built by the segmentation offload
+ *
+ * When the TCP segmentation offload is enabled (see the Tso attribute of
+ * TcpSocketBase), a socket may send several consecutive segments as a single
+ * super-segment, with a single TCP header, which traverses the IPv4 stack
+ * once. This tag tells the lower layers the size of the segments to split the
+ * super-segment into: the IPv4 layer does not fragment it, and the
+ * Ipv4QueueDiscItem holding it is split into segments by the traffic control
+ * layer, before the queue disc or the device (see QueueDiscItem::Segment).
+ * If the segments do not fit in the MTU of the output device, the IPv4 layer
+ * splits the super-segment itself, and fragments the segments as usual.
+ * The receive offload of TcpL4Protocol (see its Gro attribute) marks the
+ * segments it coalesces in the same way, and the receiving socket counts a
+ * marked segment as the segments it is made of for the delayed ACKs.
+ *
+ * This is similar to the gso_size and gso_segs fields of the Linux sk_buff.
+ */
+class TcpTsoTag : public Tag
+{
+  public:
+    TcpTsoTag();
+
+    /**
+     * \brief Constructor
+     * \param segmentSize the size of the payload of the segments
+     * \param segments the number of segments
+     */
+    TcpTsoTag(uint32_t segmentSize, uint32_t segments);
+
+    /**
+     * \brief Get the size of the payload of the segments
+     * \return the segment size, the last segment may be shorter
+     */
+    uint32_t GetSegmentSize() const;
+
+    /**
+     * \brief Get the number of segments of the super-segment
+     * \return the number of segments
+     */
+    uint32_t GetSegments() const;
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint32_t m_segmentSize; //!< Size of the payload of the segments
+    uint32_t m_segments;    //!< Number of segments
+};
+
+} // namespace ns3
+
+#endif /* TCP_TSO_TAG_H */
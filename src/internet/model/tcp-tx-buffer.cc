@@ -28,6 +28,8 @@
 
 #include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <vector>
 
 namespace ns3
 {
@@ -298,7 +300,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    IndexSentItem(m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -312,37 +314,34 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(m_sentList.size() >= 1);
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    auto found = m_sentIndex.find(seq);
+    if (found != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = found->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -351,7 +350,9 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     if (!item->m_retrans)
     {
         m_retrans += item->m_packet->GetSize();
+        UnindexFlags(item);
         item->m_retrans = true;
+        IndexFlags(item);
     }
 
     return item;
@@ -404,7 +405,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -440,12 +441,25 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     TcpTxItem* outItem = nullptr;
     PacketList::iterator it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+    bool isSentList = (&list == &m_sentList);
+
+    if (isSentList)
+    {
+        // start from the item that contains seq, instead of walking the list
+        auto found = m_sentIndex.upper_bound(seq);
+        if (found != m_sentIndex.begin())
+        {
+            --found;
+            it = found->second;
+            beginOfCurrentPacket = found->first;
+        }
+    }
 
     while (it != list.end())
     {
         currentItem = *it;
         currentPacket = currentItem->m_packet;
-        NS_ASSERT_MSG(list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+        NS_ASSERT_MSG(!isSentList || currentItem->m_startSeq >= m_firstByteSeq,
                       "start: " << m_firstByteSeq
                                 << " currentItem start: " << currentItem->m_startSeq);
 
@@ -471,10 +485,19 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                          << " and now we recurse because packet ends at "
                                          << beginOfCurrentPacket + currentPacket->GetSize());
                 TcpTxItem* firstPart = new TcpTxItem();
+                if (isSentList)
+                {
+                    UnindexSentItem(currentItem);
+                }
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -537,10 +560,19 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 // the end is inside the current packet, but it isn't exactly
                 // the packet end. Just fragment, fix the list, and return.
                 TcpTxItem* firstPart = new TcpTxItem();
+                if (isSentList)
+                {
+                    UnindexSentItem(currentItem);
+                }
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -568,8 +600,17 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
             TcpTxItem* next = (*it); // Please remember we have incremented it
                                      // in the previous if
 
+            if (isSentList)
+            {
+                UnindexSentItem(next);
+                UnindexFlags(currentItem);
+            }
             MergeItems(currentItem, next);
             list.erase(it);
+            if (isSentList)
+            {
+                IndexFlags(currentItem);
+            }
 
             delete next;
 
@@ -653,16 +694,16 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // Only the item that precedes ack can end at ack
+    auto it = m_sentIndex.lower_bound(ack);
+    if (it == m_sentIndex.begin())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    --it;
+    TcpTxItem* item = *it->second;
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -710,6 +751,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            UnindexSentItem(item);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -727,8 +769,10 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             pktSize -= offset;
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
+            UnindexSentItem(item);
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
             item->m_startSeq += offset;
+            IndexSentItem(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -756,7 +800,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             // It is not possible to have the UNA sacked; otherwise, it would
             // have been ACKed. This is, most likely, our wrong guessing
             // when adding Reno dupacks in the count.
+            UnindexFlags(head);
             head->m_sacked = false;
+            IndexFlags(head);
             m_sackedOut -= head->m_packet->GetSize();
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
             AddRenoSack();
@@ -791,64 +837,30 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        PacketList::iterator item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
-        while (item_it != m_sentList.end())
+        // Only the items not sacked yet, starting in the block, can be sacked by it
+        auto unsacked_it = m_unsackedSeqs.lower_bound((*option_it).first);
+
+        while (unsacked_it != m_unsackedSeqs.end())
         {
+            SequenceNumber32 beginOfCurrentPacket = *unsacked_it;
+            PacketList::iterator item_it = m_sentIndex.find(beginOfCurrentPacket)->second;
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
 
+            // The item leaves the set of the unsacked items when it is sacked
+            ++unsacked_it;
+
             // Check the boundary of this packet ... only mark as sacked if
             // it is precisely mapped over the option. It means that if the receiver
             // is reporting as sacked single range bytes that are not mapped 1:1
             // in what we have, the option is discarded. There's room for improvement
             // here.
-            if (beginOfCurrentPacket >= (*option_it).first &&
-                beginOfCurrentPacket + pktSize <= (*option_it).second)
-            {
-                if ((*item_it)->m_sacked)
-                {
-                    NS_ASSERT(!(*item_it)->m_lost);
-                    NS_LOG_INFO("Received block " << *option_it << ", checking sentList for block "
-                                                  << *(*item_it)
-                                                  << ", found in the sackboard already sacked");
-                }
-                else
-                {
-                    if ((*item_it)->m_lost)
-                    {
-                        (*item_it)->m_lost = false;
-                        m_lostOut -= (*item_it)->m_packet->GetSize();
-                    }
-
-                    (*item_it)->m_sacked = true;
-                    m_sackedOut += (*item_it)->m_packet->GetSize();
-                    bytesSacked += (*item_it)->m_packet->GetSize();
-
-                    if (m_highestSack.first == m_sentList.end() ||
-                        m_highestSack.second <= beginOfCurrentPacket + pktSize)
-                    {
-                        m_highestSack = std::make_pair(item_it, beginOfCurrentPacket);
-                    }
-
-                    NS_LOG_INFO("Received block "
-                                << *option_it << ", checking sentList for block " << *(*item_it)
-                                << ", found in the sackboard, sacking, current highSack: "
-                                << m_highestSack.second);
-
-                    if (!sackedCb.IsNull())
-                    {
-                        sackedCb(*item_it);
-                    }
-                }
-            }
-            else if (beginOfCurrentPacket + pktSize > (*option_it).second)
+            if (beginOfCurrentPacket + pktSize > (*option_it).second)
             {
                 // We already passed the received block end. Exit from the loop
                 NS_LOG_INFO("Received block [" << *option_it << ", checking sentList for block "
@@ -856,8 +868,33 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
                 break;
             }
 
-            beginOfCurrentPacket += pktSize;
-            ++item_it;
+            UnindexFlags(*item_it);
+            if ((*item_it)->m_lost)
+            {
+                (*item_it)->m_lost = false;
+                m_lostOut -= (*item_it)->m_packet->GetSize();
+            }
+
+            (*item_it)->m_sacked = true;
+            IndexFlags(*item_it);
+            m_sackedOut += (*item_it)->m_packet->GetSize();
+            bytesSacked += (*item_it)->m_packet->GetSize();
+
+            if (m_highestSack.first == m_sentList.end() ||
+                m_highestSack.second <= beginOfCurrentPacket + pktSize)
+            {
+                m_highestSack = std::make_pair(item_it, beginOfCurrentPacket);
+            }
+
+            NS_LOG_INFO("Received block " << *option_it << ", checking sentList for block "
+                                          << *(*item_it)
+                                          << ", found in the sackboard, sacking, current highSack: "
+                                          << m_highestSack.second);
+
+            if (!sackedCb.IsNull())
+            {
+                sackedCb(*item_it);
+            }
         }
     }
 
@@ -879,8 +916,6 @@ void
 TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
-    uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
     if (m_highestSack.first == m_sentList.end())
     {
         NS_LOG_INFO("Status before the update: " << *this
@@ -892,33 +927,40 @@ TcpTxBuffer::UpdateLostCount()
                                                  << *(*m_highestSack.first));
     }
 
-    for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
+    // Find the "dupack thresh"-th sacked item, counting down from the highest
+    // sacked one and excluding the head: the items below it are lost
+    SequenceNumber32 headSeq = m_sentList.front()->m_startSeq;
+    SequenceNumber32 lostBelow = m_highestSack.second + 1;
+    uint32_t sacked = 0;
+    auto it = m_sackedSeqs.upper_bound(m_highestSack.second);
+    while (sacked < m_dupAckThresh && it != m_sackedSeqs.begin() && *std::prev(it) > headSeq)
     {
-        TcpTxItem* item = *it;
-        if (item->m_sacked)
-        {
-            sacked++;
-        }
-
-        if (sacked >= m_dupAckThresh)
-        {
-            if (!item->m_sacked && !item->m_lost)
-            {
-                item->m_lost = true;
-                m_lostOut += item->m_packet->GetSize();
-            }
-        }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
+        --it;
+        ++sacked;
+        lostBelow = *it;
     }
 
     if (sacked >= m_dupAckThresh)
     {
-        TcpTxItem* item = *m_sentList.begin();
-        if (!item->m_lost)
+        // Mark as lost the items below which are neither sacked nor already lost
+        while (!m_unmarkedSeqs.empty() && *m_unmarkedSeqs.begin() < lostBelow)
         {
+            TcpTxItem* item = GetSentItem(*m_unmarkedSeqs.begin());
+            UnindexFlags(item);
             item->m_lost = true;
+            IndexFlags(item);
             m_lostOut += item->m_packet->GetSize();
         }
+
+        // The head is lost even when it is sacked
+        TcpTxItem* head = m_sentList.front();
+        if (!head->m_lost)
+        {
+            UnindexFlags(head);
+            head->m_lost = true;
+            IndexFlags(head);
+            m_lostOut += head->m_packet->GetSize();
+        }
     }
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
@@ -929,37 +971,25 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
 {
     NS_LOG_FUNCTION(this << seq);
 
-    SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-    PacketList::const_iterator it;
-
     if (seq >= m_highestSack.second)
     {
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (it = m_sentList.begin(); it != m_sentList.end(); ++it)
-    {
-        // Search for the right iterator before calling IsLost()
-        if (beginOfCurrentPacket >= seq)
-        {
-            if ((*it)->m_lost == true)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
-
-            if ((*it)->m_sacked == true)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
-        }
+    // The first item starting at or after seq that is lost or sacked decides
+    auto lost = m_lostSeqs.lower_bound(seq);
+    auto sacked = m_sackedSeqs.lower_bound(seq);
 
-        beginOfCurrentPacket += (*it)->m_packet->GetSize();
+    if (lost != m_lostSeqs.end() && (sacked == m_sackedSeqs.end() || *lost <= *sacked))
+    {
+        NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+        return true;
     }
 
+    if (sacked != m_sackedSeqs.end())
+    {
+        NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+    }
     return false;
 }
 
@@ -981,36 +1011,34 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
      *
      *     (1.c) IsLost (S2) returns true.
      */
-    PacketList::const_iterator it;
-    TcpTxItem* item;
     SequenceNumber32 seqPerRule3;
     bool isSeqPerRule3Valid = false;
-    SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
 
-    for (it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Condition 1.a , 1.b , and 1.c
+    if (!m_retransmitSeqs.empty())
     {
-        item = *it;
+        NS_LOG_INFO("IsLost, returning" << *m_retransmitSeqs.begin());
+        *seq = *m_retransmitSeqs.begin();
+        *seqHigh = *seq + m_segmentSize;
+        return true;
+    }
 
-        // Condition 1.a , 1.b , and 1.c
-        if (item->m_retrans == false && item->m_sacked == false)
+    if (isRecovery)
+    {
+        // The first item neither sacked, lost nor retransmitted (not starting at 0)
+        for (const auto& unmarked : m_unmarkedSeqs)
         {
-            if (item->m_lost)
+            if (seqPerRule3.GetValue() == 0 && !GetSentItem(unmarked)->m_retrans)
             {
-                NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
-                *seq = beginOfCurrentPkt;
-                *seqHigh = *seq + m_segmentSize;
-                return true;
+                NS_LOG_INFO("Saving for rule 3 the seq " << unmarked);
+                isSeqPerRule3Valid = true;
+                seqPerRule3 = unmarked;
             }
-            else if (seqPerRule3.GetValue() == 0 && isRecovery)
+            if (seqPerRule3.GetValue() != 0)
             {
-                NS_LOG_INFO("Saving for rule 3 the seq " << beginOfCurrentPkt);
-                isSeqPerRule3Valid = true;
-                seqPerRule3 = beginOfCurrentPkt;
+                break;
             }
         }
-
-        // Nothing found, iterate
-        beginOfCurrentPkt += item->m_packet->GetSize();
     }
 
     /* (2) If no sequence number 'S2' per rule (1) exists but there
@@ -1221,9 +1249,13 @@ TcpTxBuffer::ResetRenoSack()
     NS_LOG_FUNCTION(this);
 
     m_sackedOut = 0;
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    std::vector<SequenceNumber32> sacked(m_sackedSeqs.begin(), m_sackedSeqs.end());
+    for (const auto& seq : sacked)
     {
-        (*it)->m_sacked = false;
+        TcpTxItem* item = GetSentItem(seq);
+        UnindexFlags(item);
+        item->m_sacked = false;
+        IndexFlags(item);
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
@@ -1251,6 +1283,7 @@ TcpTxBuffer::ResetSentList()
         m_sentList.pop_back();
     }
 
+    ClearIndex();
     m_sentSize = 0;
     m_lostOut = 0;
     m_retrans = 0;
@@ -1266,6 +1299,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        UnindexSentItem(item);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1296,6 +1330,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
 
     for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
+        UnindexFlags(*it);
         if (resetSack)
         {
             (*it)->m_sacked = false;
@@ -1317,6 +1352,7 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         }
 
         (*it)->m_retrans = false;
+        IndexFlags(*it);
     }
 
     NS_LOG_INFO("Set sent list lost, status: " << *this);
@@ -1349,7 +1385,9 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead()
 
     if (m_sentList.front()->m_retrans)
     {
+        UnindexFlags(m_sentList.front());
         m_sentList.front()->m_retrans = false;
+        IndexFlags(m_sentList.front());
         m_retrans -= m_sentList.front()->m_packet->GetSize();
     }
     ConsistencyCheck();
@@ -1360,6 +1398,8 @@ TcpTxBuffer::MarkHeadAsLost()
 {
     if (m_sentList.size() > 0)
     {
+        UnindexFlags(m_sentList.front());
+
         // If the head is sacked (reneging by the receiver the previously sent
         // information) we revert the sacked flag.
         // A sacked head means that we should advance SND.UNA.. so it's an error.
@@ -1380,6 +1420,8 @@ TcpTxBuffer::MarkHeadAsLost()
             m_sentList.front()->m_lost = true;
             m_lostOut += m_sentList.front()->m_packet->GetSize();
         }
+
+        IndexFlags(m_sentList.front());
     }
     ConsistencyCheck();
 }
@@ -1400,19 +1442,21 @@ TcpTxBuffer::AddRenoSack()
 
     m_renoSack = true;
 
-    // We can _never_ SACK the head, so start from the second segment sent
-    auto it = ++m_sentList.begin();
-
-    // Find the "highest sacked" point, that is SND.UNA + m_sackedOut
-    while (it != m_sentList.end() && (*it)->m_sacked)
+    // We can _never_ SACK the head, so start from the second segment sent,
+    // and find the "highest sacked" point, that is SND.UNA + m_sackedOut
+    auto unsacked = m_unsackedSeqs.upper_bound(m_sentList.front()->m_startSeq);
+    auto it = m_sentList.end();
+    if (unsacked != m_unsackedSeqs.end())
     {
-        ++it;
+        it = m_sentIndex.find(*unsacked)->second;
     }
 
     // Add to the sacked size the size of the first "not sacked" segment
     if (it != m_sentList.end())
     {
+        UnindexFlags(*it);
         (*it)->m_sacked = true;
+        IndexFlags(*it);
         m_sackedOut += (*it)->m_packet->GetSize();
         m_highestSack = std::make_pair(it, (*it)->m_startSeq);
         NS_LOG_INFO("Added a Reno SACK, status: " << *this);
@@ -1426,6 +1470,77 @@ TcpTxBuffer::AddRenoSack()
     ConsistencyCheck();
 }
 
+void
+TcpTxBuffer::IndexSentItem(PacketList::iterator it)
+{
+    NS_ASSERT(m_sentIndex.find((*it)->m_startSeq) == m_sentIndex.end());
+    m_sentIndex.emplace((*it)->m_startSeq, it);
+    IndexFlags(*it);
+}
+
+void
+TcpTxBuffer::UnindexSentItem(const TcpTxItem* item)
+{
+    m_sentIndex.erase(item->m_startSeq);
+    UnindexFlags(item);
+}
+
+void
+TcpTxBuffer::IndexFlags(const TcpTxItem* item)
+{
+    const SequenceNumber32& seq = item->m_startSeq;
+    if (item->m_sacked)
+    {
+        m_sackedSeqs.insert(seq);
+    }
+    else
+    {
+        m_unsackedSeqs.insert(seq);
+        if (!item->m_lost)
+        {
+            m_unmarkedSeqs.insert(seq);
+        }
+        else if (!item->m_retrans)
+        {
+            m_retransmitSeqs.insert(seq);
+        }
+    }
+    if (item->m_lost)
+    {
+        m_lostSeqs.insert(seq);
+    }
+}
+
+void
+TcpTxBuffer::UnindexFlags(const TcpTxItem* item)
+{
+    const SequenceNumber32& seq = item->m_startSeq;
+    m_sackedSeqs.erase(seq);
+    m_lostSeqs.erase(seq);
+    m_unsackedSeqs.erase(seq);
+    m_unmarkedSeqs.erase(seq);
+    m_retransmitSeqs.erase(seq);
+}
+
+void
+TcpTxBuffer::ClearIndex()
+{
+    m_sentIndex.clear();
+    m_sackedSeqs.clear();
+    m_lostSeqs.clear();
+    m_unsackedSeqs.clear();
+    m_unmarkedSeqs.clear();
+    m_retransmitSeqs.clear();
+}
+
+TcpTxItem*
+TcpTxBuffer::GetSentItem(const SequenceNumber32& seq) const
+{
+    auto it = m_sentIndex.find(seq);
+    NS_ASSERT_MSG(it != m_sentIndex.end(), "No item starting at " << seq);
+    return *it->second;
+}
+
 void
 TcpTxBuffer::ConsistencyCheck() const
 {
@@ -1461,6 +1576,24 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
+    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    {
+        const TcpTxItem* item = *it;
+        auto found = m_sentIndex.find(item->m_startSeq);
+        NS_ASSERT_MSG(found != m_sentIndex.end() && found->second == it,
+                      "Item " << *item << " not indexed");
+        NS_ASSERT(m_sackedSeqs.count(item->m_startSeq) == (item->m_sacked ? 1 : 0));
+        NS_ASSERT(m_lostSeqs.count(item->m_startSeq) == (item->m_lost ? 1 : 0));
+        NS_ASSERT(m_unsackedSeqs.count(item->m_startSeq) == (!item->m_sacked ? 1 : 0));
+        NS_ASSERT(m_unmarkedSeqs.count(item->m_startSeq) ==
+                  (!item->m_sacked && !item->m_lost ? 1 : 0));
+        NS_ASSERT(m_retransmitSeqs.count(item->m_startSeq) ==
+                  (!item->m_sacked && item->m_lost && !item->m_retrans ? 1 : 0));
+    }
+    NS_ASSERT(m_sackedSeqs.size() + m_unsackedSeqs.size() == m_sentList.size());
 }
 
 std::ostream&
@@ -28,6 +28,10 @@
 #include "ns3/tcp-tx-item.h"
 #include "ns3/traced-value.h"
 
+#include <list>
+#include <map>
+#include <set>
+
 namespace ns3
 {
 class Packet;
@@ -71,8 +75,17 @@ class Packet;
  * associated with every segment sent. This is done through the use of the
  * class TcpTxItem: instead of storing a list of packets, we store a list of
  * TcpTxItem. Each item has different flags (check the corresponding
- * documentation) and maintaining the scoreboard is a matter of travelling the
- * list and set the SACK flag on the corresponding segment sent.
+ * documentation) and maintaining the scoreboard is a matter of finding the
+ * segments sent that correspond to a SACK block and set their SACK flag.
+ *
+ * To avoid walking the list for each SACK block and for each question about
+ * the scoreboard, the items of the SentList are indexed by their starting
+ * sequence number in an ordered map, and the starting sequence numbers of the
+ * items that are sacked, lost, not sacked, neither sacked nor lost, and lost
+ * but neither sacked nor retransmitted are kept in ordered sets. Updating the
+ * scoreboard with a SACK block, checking if a sequence is lost, and finding
+ * the next segment to retransmit take a logarithmic time in the number of
+ * segments in flight.
  *
  * Item properties
  * ---------------
@@ -428,8 +441,8 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
+     * and updates the lost count. It only visits the "dupack thresh" highest
+     * sacked segments and the segments that become lost.
      *
      */
     void UpdateLostCount();
@@ -564,7 +577,7 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * \brief Merge two TcpTxItem
@@ -590,6 +603,45 @@ class TcpTxBuffer : public Object
      */
     void SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const;
 
+    /**
+     * \brief Add an item of the sent list to the scoreboard index
+     * \param it the item in the sent list
+     */
+    void IndexSentItem(PacketList::iterator it);
+
+    /**
+     * \brief Remove an item of the sent list from the scoreboard index
+     * \param item the item
+     */
+    void UnindexSentItem(const TcpTxItem* item);
+
+    /**
+     * \brief Add an item to the sets of the scoreboard index matching its flags
+     *
+     * Must be called after changing the flags of an item of the sent list,
+     * which must have been removed from the sets with UnindexFlags before.
+     * \param item the item
+     */
+    void IndexFlags(const TcpTxItem* item);
+
+    /**
+     * \brief Remove an item from the sets of the scoreboard index
+     * \param item the item
+     */
+    void UnindexFlags(const TcpTxItem* item);
+
+    /**
+     * \brief Remove all the items from the scoreboard index
+     */
+    void ClearIndex();
+
+    /**
+     * \brief Get the item of the sent list starting at a sequence number
+     * \param seq the starting sequence number of the item, which must be in the index
+     * \return the item
+     */
+    TcpTxItem* GetSentItem(const SequenceNumber32& seq) const;
+
     /**
      * \brief Check if the values of sacked, lost, retrans, are in sync
      * with the sent list.
@@ -613,6 +665,17 @@ class TcpTxBuffer : public Object
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
 
+    /// Container of the starting sequence numbers of some items of the sent list
+    typedef std::set<SequenceNumber32> SequenceSet;
+
+    std::map<SequenceNumber32, PacketList::iterator>
+        m_sentIndex;              //!< Items of the sent list, by starting sequence number
+    SequenceSet m_sackedSeqs;     //!< Items sacked
+    SequenceSet m_lostSeqs;       //!< Items lost
+    SequenceSet m_unsackedSeqs;   //!< Items not sacked
+    SequenceSet m_unmarkedSeqs;   //!< Items neither sacked nor lost
+    SequenceSet m_retransmitSeqs; //!< Items lost, but neither sacked nor retransmitted
+
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
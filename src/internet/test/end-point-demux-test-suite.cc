@@ -0,0 +1,509 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface-address.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("EndPointDemuxTestSuite");
+
+/**
+ * \param rand the random variable
+ * \param values the values
+ * \return one of the values, chosen at random
+ */
+template <typename T>
+static T
+GetRandom(Ptr<UniformRandomVariable> rand, const std::vector<T>& values)
+{
+    return values[rand->GetInteger(0, values.size() - 1)];
+}
+
+/**
+ * \brief Find the endpoints matching a packet by scanning the endpoints, as
+ * Ipv4EndPointDemux::Lookup did before indexing them.
+ *
+ * \param endPoints the endpoints
+ * \param daddr destination address
+ * \param dport destination port
+ * \param saddr source address
+ * \param sport source port
+ * \param incomingInterface the incoming interface
+ * \return the most exact matches
+ */
+static Ipv4EndPointDemux::EndPoints
+LookupLinear(const Ipv4EndPointDemux::EndPoints& endPoints,
+             Ipv4Address daddr,
+             uint16_t dport,
+             Ipv4Address saddr,
+             uint16_t sport,
+             Ptr<Ipv4Interface> incomingInterface)
+{
+    Ipv4EndPointDemux::EndPoints matches[4];
+    for (Ipv4EndPoint* endP : endPoints)
+    {
+        if (!endP->IsRxEnabled() || endP->GetLocalPort() != dport ||
+            (endP->GetBoundNetDevice() &&
+             endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            continue;
+        }
+        bool localExact = endP->GetLocalAddress() == daddr;
+        bool localWildcard = !localExact && endP->GetLocalAddress() == Ipv4Address::GetAny();
+        uint32_t nAddresses = localExact ? 0 : incomingInterface->GetNAddresses();
+        for (uint32_t i = 0; !localWildcard && i < nAddresses; i++)
+        {
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+            localWildcard = endP->GetLocalAddress() == addrNetpart &&
+                            daddr.CombineMask(addr.GetMask()) == addrNetpart;
+        }
+        bool peerExact = endP->GetPeerPort() == sport && endP->GetPeerAddress() == saddr;
+        bool peerWildcard =
+            endP->GetPeerPort() == 0 && endP->GetPeerAddress() == Ipv4Address::GetAny();
+        if (localExact && peerExact)
+        {
+            matches[3].push_back(endP);
+        }
+        if (localWildcard && peerExact)
+        {
+            matches[2].push_back(endP);
+        }
+        if (localExact && peerWildcard)
+        {
+            matches[1].push_back(endP);
+        }
+        if (localWildcard && peerWildcard)
+        {
+            matches[0].push_back(endP);
+        }
+    }
+    for (uint32_t i = 3; i > 0; i--)
+    {
+        if (!matches[i].empty())
+        {
+            return matches[i];
+        }
+    }
+    return matches[0];
+}
+
+/**
+ * \brief Find the endpoints matching a packet by scanning the endpoints, as
+ * Ipv6EndPointDemux::Lookup did before indexing them.
+ *
+ * \param endPoints the endpoints
+ * \param daddr destination address
+ * \param dport destination port
+ * \param saddr source address
+ * \param sport source port
+ * \param incomingInterface the incoming interface
+ * \return the most exact matches
+ */
+static Ipv6EndPointDemux::EndPoints
+LookupLinear(const Ipv6EndPointDemux::EndPoints& endPoints,
+             Ipv6Address daddr,
+             uint16_t dport,
+             Ipv6Address saddr,
+             uint16_t sport,
+             Ptr<Ipv6Interface> incomingInterface)
+{
+    Ipv6EndPointDemux::EndPoints matches[4];
+    for (Ipv6EndPoint* endP : endPoints)
+    {
+        if (!endP->IsRxEnabled() || endP->GetLocalPort() != dport ||
+            (endP->GetBoundNetDevice() &&
+             endP->GetBoundNetDevice() != incomingInterface->GetDevice()))
+        {
+            continue;
+        }
+        bool localExact = endP->GetLocalAddress() == daddr;
+        bool localWildcard = endP->GetLocalAddress() == Ipv6Address::GetAny();
+        bool peerExact = endP->GetPeerPort() == sport && endP->GetPeerAddress() == saddr;
+        bool peerWildcard =
+            endP->GetPeerPort() == 0 && endP->GetPeerAddress() == Ipv6Address::GetAny();
+        if (localExact && peerExact)
+        {
+            matches[3].push_back(endP);
+        }
+        if (localWildcard && peerExact)
+        {
+            matches[2].push_back(endP);
+        }
+        if (localExact && peerWildcard)
+        {
+            matches[1].push_back(endP);
+        }
+        if (localWildcard && peerWildcard)
+        {
+            matches[0].push_back(endP);
+        }
+    }
+    for (uint32_t i = 3; i > 0; i--)
+    {
+        if (!matches[i].empty())
+        {
+            return matches[i];
+        }
+    }
+    return matches[0];
+}
+
+/**
+ * \brief Find the endpoint of an ICMP error by scanning the endpoints, as
+ * SimpleLookup does.
+ *
+ * \param endPoints the endpoints
+ * \param daddr destination address
+ * \param dport destination port
+ * \param saddr source address
+ * \param sport source port
+ * \param any the Any address
+ * \return the exact match, or the most generic one
+ */
+template <typename EndPoints, typename Address>
+static typename EndPoints::value_type
+SimpleLookupLinear(const EndPoints& endPoints,
+                   Address daddr,
+                   uint16_t dport,
+                   Address saddr,
+                   uint16_t sport,
+                   Address any)
+{
+    uint32_t genericity = 3;
+    typename EndPoints::value_type generic = nullptr;
+    for (auto endP : endPoints)
+    {
+        if (endP->GetLocalPort() != dport)
+        {
+            continue;
+        }
+        if (endP->GetLocalAddress() == daddr && endP->GetPeerPort() == sport &&
+            endP->GetPeerAddress() == saddr)
+        {
+            return endP;
+        }
+        uint32_t tmp =
+            (endP->GetLocalAddress() == any ? 1 : 0) + (endP->GetPeerAddress() == any ? 1 : 0);
+        if (tmp < genericity)
+        {
+            generic = endP;
+            genericity = tmp;
+        }
+    }
+    return generic;
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Test the IPv4 and IPv6 endpoint demuxes against a scan of their endpoints.
+ *
+ * Endpoints with exact and wildcard addresses and ports, bound or not to a
+ * device, are randomly allocated, deallocated and changed.  The endpoints
+ * found by Lookup, SimpleLookup, LookupLocal and LookupPortLocal must be the
+ * ones found by scanning all the endpoints.  Lookup is only checked when at
+ * most one endpoint matches, since it aborts otherwise.
+ */
+class EndPointDemuxTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param ipv6 whether the IPv6 demux is tested
+     */
+    EndPointDemuxTestCase(bool ipv6);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Run the test with the IPv4 demux.
+     */
+    void RunIpv4();
+
+    /**
+     * \brief Run the test with the IPv6 demux.
+     */
+    void RunIpv6();
+
+    /**
+     * \brief Run the random operations on a demux.
+     * \param demux the demux
+     * \param endPoints the endpoints allocated, in order
+     * \param devices the devices the endpoints may be bound to
+     * \param localAddresses the local addresses of the endpoints and of the packets
+     * \param peerAddresses the peer addresses of the endpoints and of the packets
+     * \param interfaces the interfaces receiving the packets
+     * \param any the Any address
+     */
+    template <typename Demux, typename EndPoint, typename Address, typename Interface>
+    void Run(Demux& demux,
+             std::vector<EndPoint*>& endPoints,
+             const std::vector<Ptr<NetDevice>>& devices,
+             const std::vector<Address>& localAddresses,
+             const std::vector<Address>& peerAddresses,
+             const std::vector<Ptr<Interface>>& interfaces,
+             Address any);
+
+    bool m_ipv6;                              //!< whether the IPv6 demux is tested
+    Ptr<UniformRandomVariable> m_rand;        //!< the random variable
+    uint32_t m_matches;                       //!< the number of lookups finding an endpoint
+    static const uint32_t N_STEPS = 1000;     //!< the number of random operations
+    static const uint32_t N_LOOKUPS = 20;     //!< the number of lookups after each operation
+    static const uint32_t MAX_ENDPOINTS = 24; //!< the maximum number of endpoints
+};
+
+EndPointDemuxTestCase::EndPointDemuxTestCase(bool ipv6)
+    : TestCase(ipv6 ? "Ipv6EndPointDemux lookups" : "Ipv4EndPointDemux lookups"),
+      m_ipv6(ipv6),
+      m_matches(0)
+{
+}
+
+template <typename Demux, typename EndPoint, typename Address, typename Interface>
+void
+EndPointDemuxTestCase::Run(Demux& demux,
+                           std::vector<EndPoint*>& endPoints,
+                           const std::vector<Ptr<NetDevice>>& devices,
+                           const std::vector<Address>& localAddresses,
+                           const std::vector<Address>& peerAddresses,
+                           const std::vector<Ptr<Interface>>& interfaces,
+                           Address any)
+{
+    const std::vector<uint16_t> localPorts{80, 81};
+    const std::vector<uint16_t> peerPorts{0, 1000, 1001};
+    for (uint32_t step = 0; step < N_STEPS; step++)
+    {
+        uint32_t operation = m_rand->GetInteger(0, 9);
+        if (endPoints.size() >= MAX_ENDPOINTS && operation < 4)
+        {
+            operation = 4;
+        }
+        EndPoint* endPoint = endPoints.empty() ? nullptr : GetRandom(m_rand, endPoints);
+        if (operation < 4)
+        {
+            Ptr<NetDevice> device = GetRandom(m_rand, devices);
+            Address local = GetRandom(m_rand, localAddresses);
+            uint16_t localPort = GetRandom(m_rand, localPorts);
+            EndPoint* allocated =
+                operation == 0 ? demux.Allocate(local)
+                : operation == 1
+                    ? demux.Allocate(device, local, localPort)
+                    : demux.Allocate(device,
+                                     local,
+                                     localPort,
+                                     GetRandom(m_rand, peerAddresses),
+                                     GetRandom(m_rand, peerPorts));
+            if (allocated)
+            {
+                endPoints.push_back(allocated);
+            }
+        }
+        else if (operation == 4 && endPoint)
+        {
+            endPoints.erase(std::find(endPoints.begin(), endPoints.end(), endPoint));
+            demux.DeAllocate(endPoint);
+        }
+        else if (operation == 5 && endPoint)
+        {
+            endPoint->SetPeer(GetRandom(m_rand, peerAddresses), GetRandom(m_rand, peerPorts));
+        }
+        else if (operation == 6 && endPoint)
+        {
+            endPoint->SetLocalAddress(GetRandom(m_rand, localAddresses));
+        }
+        else if (operation == 7 && endPoint)
+        {
+            endPoint->BindToNetDevice(GetRandom(m_rand, devices));
+        }
+        else if (operation == 8 && endPoint)
+        {
+            endPoint->SetRxEnabled(m_rand->GetInteger(0, 3) != 0);
+        }
+
+        typename Demux::EndPoints all(endPoints.begin(), endPoints.end());
+        for (uint32_t i = 0; i < N_LOOKUPS; i++)
+        {
+            Address daddr = GetRandom(m_rand, localAddresses);
+            uint16_t dport = GetRandom(m_rand, localPorts);
+            Address saddr = GetRandom(m_rand, peerAddresses);
+            uint16_t sport = GetRandom(m_rand, peerPorts);
+            Ptr<Interface> interface = GetRandom(m_rand, interfaces);
+
+            typename Demux::EndPoints expected =
+                LookupLinear(all, daddr, dport, saddr, sport, interface);
+            if (expected.size() <= 1)
+            {
+                typename Demux::EndPoints found =
+                    demux.Lookup(daddr, dport, saddr, sport, interface);
+                NS_TEST_EXPECT_MSG_EQ((found == expected),
+                                      true,
+                                      "Wrong endpoints for " << daddr << ":" << dport << " from "
+                                                             << saddr << ":" << sport
+                                                             << " at step " << step);
+                m_matches += found.size();
+            }
+
+            NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(daddr, dport, saddr, sport),
+                                  SimpleLookupLinear(all, daddr, dport, saddr, sport, any),
+                                  "Wrong endpoint of an ICMP error at step " << step);
+
+            Ptr<NetDevice> device = GetRandom(m_rand, devices);
+            bool local = std::any_of(all.begin(), all.end(), [&](EndPoint* endP) {
+                return endP->GetLocalPort() == dport && endP->GetLocalAddress() == daddr &&
+                       endP->GetBoundNetDevice() == device;
+            });
+            NS_TEST_EXPECT_MSG_EQ(demux.LookupLocal(device, daddr, dport),
+                                  local,
+                                  "Wrong local lookup at step " << step);
+        }
+        for (uint16_t port : localPorts)
+        {
+            bool used = std::any_of(all.begin(), all.end(), [port](EndPoint* endP) {
+                return endP->GetLocalPort() == port;
+            });
+            NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(port),
+                                  used,
+                                  "Wrong local port lookup at step " << step);
+        }
+    }
+}
+
+void
+EndPointDemuxTestCase::RunIpv4()
+{
+    std::vector<Ptr<NetDevice>> devices{nullptr,
+                                        CreateObject<SimpleNetDevice>(),
+                                        CreateObject<SimpleNetDevice>()};
+    std::vector<Ptr<Ipv4Interface>> interfaces;
+    for (uint32_t i = 1; i < devices.size(); i++)
+    {
+        interfaces.push_back(CreateObject<Ipv4Interface>());
+        interfaces.back()->SetDevice(devices[i]);
+    }
+    interfaces[0]->AddAddress(Ipv4InterfaceAddress("10.0.0.1", "255.255.255.0"));
+    interfaces[1]->AddAddress(Ipv4InterfaceAddress("10.0.1.1", "255.255.255.0"));
+    interfaces[1]->AddAddress(Ipv4InterfaceAddress("10.0.2.1", "255.255.0.0"));
+    // unicast, subnet-directed broadcast and network addresses
+    std::vector<Ipv4Address> localAddresses{Ipv4Address::GetAny(),
+                                            "10.0.0.1",
+                                            "10.0.1.1",
+                                            "10.0.2.1",
+                                            "10.0.0.0",
+                                            "10.0.1.0",
+                                            "10.0.0.255",
+                                            "10.0.1.255",
+                                            "10.0.255.255"};
+    std::vector<Ipv4Address> peerAddresses{Ipv4Address::GetAny(), "10.1.0.1", "10.1.0.2"};
+
+    Ipv4EndPointDemux demux;
+    std::vector<Ipv4EndPoint*> endPoints;
+    Run(demux,
+        endPoints,
+        devices,
+        localAddresses,
+        peerAddresses,
+        interfaces,
+        Ipv4Address::GetAny());
+    Ipv4EndPointDemux::EndPoints all = demux.GetAllEndPoints();
+    NS_TEST_EXPECT_MSG_EQ((std::vector<Ipv4EndPoint*>(all.begin(), all.end()) == endPoints),
+                          true,
+                          "Wrong list of endpoints");
+}
+
+void
+EndPointDemuxTestCase::RunIpv6()
+{
+    std::vector<Ptr<NetDevice>> devices{nullptr,
+                                        CreateObject<SimpleNetDevice>(),
+                                        CreateObject<SimpleNetDevice>()};
+    std::vector<Ptr<Ipv6Interface>> interfaces;
+    for (uint32_t i = 1; i < devices.size(); i++)
+    {
+        interfaces.push_back(CreateObject<Ipv6Interface>());
+        interfaces.back()->SetDevice(devices[i]);
+    }
+    std::vector<Ipv6Address> localAddresses{Ipv6Address::GetAny(),
+                                            "2001:1::1",
+                                            "2001:2::1",
+                                            Ipv6Address::GetAllRoutersMulticast()};
+    std::vector<Ipv6Address> peerAddresses{Ipv6Address::GetAny(), "2001:3::1", "2001:3::2"};
+
+    Ipv6EndPointDemux demux;
+    std::vector<Ipv6EndPoint*> endPoints;
+    Run(demux,
+        endPoints,
+        devices,
+        localAddresses,
+        peerAddresses,
+        interfaces,
+        Ipv6Address::GetAny());
+    Ipv6EndPointDemux::EndPoints all = demux.GetEndPoints();
+    NS_TEST_EXPECT_MSG_EQ((std::vector<Ipv6EndPoint*>(all.begin(), all.end()) == endPoints),
+                          true,
+                          "Wrong list of endpoints");
+}
+
+void
+EndPointDemuxTestCase::DoRun()
+{
+    m_rand = CreateObject<UniformRandomVariable>();
+    m_rand->SetStream(1);
+    if (m_ipv6)
+    {
+        RunIpv6();
+    }
+    else
+    {
+        RunIpv4();
+    }
+    NS_TEST_EXPECT_MSG_GT(m_matches, 0, "No lookup found an endpoint");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Endpoint demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite();
+};
+
+EndPointDemuxTestSuite::EndPointDemuxTestSuite()
+    : TestSuite("end-point-demux", UNIT)
+{
+    AddTestCase(new EndPointDemuxTestCase(false), TestCase::QUICK);
+    AddTestCase(new EndPointDemuxTestCase(true), TestCase::QUICK);
+}
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -570,6 +570,41 @@ Ipv4FragmentationTest::DoRun()
         NS_TEST_EXPECT_MSG_EQ(end, m_receivedPacketServer->GetSize(), "trivial");
     }
 
+    // Fifth test: normal channel, no errors, with and without delays.
+    // The payload of the packets is a zero area, which the reassembly appends without copying it.
+    // The packets should be received correctly whatever the order of the fragments.
+    delete[] m_data;
+    m_data = nullptr;
+    m_dataSize = 0;
+    for (int jumping = 0; jumping < 2; jumping++)
+    {
+        channel->SetJumpingMode(jumping);
+        for (int i = 0; i < 5; i++)
+        {
+            m_size = packetSizes[i];
+
+            m_receivedPacketServer = Create<Packet>();
+            Simulator::ScheduleWithContext(m_socketClient->GetNode()->GetId(),
+                                           Seconds(0),
+                                           &Ipv4FragmentationTest::SendClient,
+                                           this);
+            Simulator::Run();
+
+            uint8_t recvBuffer[65000];
+            uint8_t zeroBuffer[65000] = {0};
+
+            uint16_t recvSize = m_receivedPacketServer->GetSize();
+
+            NS_TEST_EXPECT_MSG_EQ(recvSize, packetSizes[i], "Packet size not correct");
+
+            m_receivedPacketServer->CopyData(recvBuffer, 65000);
+            NS_TEST_EXPECT_MSG_EQ(memcmp(zeroBuffer, recvBuffer, recvSize),
+                                  0,
+                                  "Packet content differs");
+        }
+    }
+    channel->SetJumpingMode(false);
+
     Simulator::Destroy();
 }
 
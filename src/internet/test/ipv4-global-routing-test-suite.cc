@@ -42,6 +42,8 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -181,19 +183,19 @@ LinkTest::DoRun()
     uint32_t nRoutes0 = globalRouting0->GetNRoutes();
     NS_LOG_DEBUG("LinkTest nRoutes0 " << nRoutes0);
     NS_TEST_ASSERT_MSG_EQ(nRoutes0, 1, "Error-- not one route");
-    Ipv4RoutingTableEntry* route = globalRouting0->GetRoute(0);
-    NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.1.2"), "Error-- wrong gateway");
+    Ipv4RoutingTableEntry route = globalRouting0->GetRoute(0);
+    NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.1.2"), "Error-- wrong gateway");
 
     // Test that the right number of routes found
     uint32_t nRoutes1 = globalRouting1->GetNRoutes();
     NS_TEST_ASSERT_MSG_EQ(nRoutes1, 1, "Error-- not one route");
     NS_LOG_DEBUG("LinkTest nRoutes1 " << nRoutes1);
     route = globalRouting1->GetRoute(0);
-    NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.1.1"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.1.1"), "Error-- wrong gateway");
 
     bool result = true;
 
@@ -267,8 +269,8 @@ LanTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(nRoutes0, 1, "Error-- more than one entry");
     for (uint32_t i = 0; i < globalRouting0->GetNRoutes(); i++)
     {
-        Ipv4RoutingTableEntry* route = globalRouting0->GetRoute(i);
-        NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        Ipv4RoutingTableEntry route = globalRouting0->GetRoute(i);
+        NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
     }
 
     // Test that the right number of routes found
@@ -277,8 +279,8 @@ LanTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(nRoutes1, 1, "Error-- more than one entry");
     for (uint32_t i = 0; i < globalRouting0->GetNRoutes(); i++)
     {
-        Ipv4RoutingTableEntry* route = globalRouting1->GetRoute(i);
-        NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        Ipv4RoutingTableEntry route = globalRouting1->GetRoute(i);
+        NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
     }
 
     Simulator::Destroy();
@@ -364,31 +366,31 @@ TwoLinkTest::DoRun()
     NS_LOG_DEBUG("TwoLinkTest nRoutes0 " << nRoutes0);
     NS_TEST_ASSERT_MSG_EQ(nRoutes0, 1, "Error-- wrong number of links");
 
-    Ipv4RoutingTableEntry* route = globalRouting0->GetRoute(0);
-    NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.1.2"), "Error-- wrong gateway");
+    Ipv4RoutingTableEntry route = globalRouting0->GetRoute(0);
+    NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.1.2"), "Error-- wrong gateway");
 
     // node n1
     // Test that the right number of routes found
     uint32_t nRoutes1 = globalRouting1->GetNRoutes();
     NS_LOG_DEBUG("TwoLinkTest nRoutes1 " << nRoutes1);
     route = globalRouting1->GetRoute(0);
-    NS_LOG_DEBUG("TwoLinkTest entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.1.1"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.1.1"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("TwoLinkTest entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.1.1"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.1.1"), "Error-- wrong gateway");
     route = globalRouting1->GetRoute(1);
-    NS_LOG_DEBUG("TwoLinkTest entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.2.2"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.2.2"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("TwoLinkTest entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.2.2"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.2.2"), "Error-- wrong gateway");
     route = globalRouting1->GetRoute(2);
-    NS_LOG_DEBUG("TwoLinkTest entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.1.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.1.1"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("TwoLinkTest entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.1.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.1.1"), "Error-- wrong gateway");
     route = globalRouting1->GetRoute(3);
-    NS_LOG_DEBUG("TwoLinkTest entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.2.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.2.2"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("TwoLinkTest entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.2.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.2.2"), "Error-- wrong gateway");
 
     // node n2
     // Test that the right number of routes found
@@ -397,9 +399,9 @@ TwoLinkTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(nRoutes2, 1, "Error-- wrong number of links");
 
     route = globalRouting2->GetRoute(0);
-    NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.2.1"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("0.0.0.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.2.1"), "Error-- wrong gateway");
 
     Simulator::Destroy();
 }
@@ -480,27 +482,27 @@ TwoLanTest::DoRun()
     uint32_t nRoutes0 = globalRouting0->GetNRoutes();
     NS_LOG_DEBUG("TwoLanTest nRoutes0 " << nRoutes0);
     NS_TEST_ASSERT_MSG_EQ(nRoutes0, 2, "Error-- not two entries");
-    Ipv4RoutingTableEntry* route = globalRouting0->GetRoute(0);
-    NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.1.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("0.0.0.0"), "Error-- wrong gateway");
+    Ipv4RoutingTableEntry route = globalRouting0->GetRoute(0);
+    NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.1.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("0.0.0.0"), "Error-- wrong gateway");
     route = globalRouting0->GetRoute(1);
-    NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.2.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.1.2"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.2.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("10.1.1.2"), "Error-- wrong gateway");
 
     // Test that the right number of routes found
     uint32_t nRoutes1 = globalRouting1->GetNRoutes();
     NS_LOG_DEBUG("TwoLanTest nRoutes1 " << nRoutes1);
     NS_TEST_ASSERT_MSG_EQ(nRoutes1, 2, "Error-- not two entries");
     route = globalRouting1->GetRoute(0);
-    NS_LOG_DEBUG("TwoLanTest entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.1.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("0.0.0.0"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("TwoLanTest entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.1.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("0.0.0.0"), "Error-- wrong gateway");
     route = globalRouting1->GetRoute(1);
-    NS_LOG_DEBUG("TwoLanTest entry dest " << route->GetDest() << " gw " << route->GetGateway());
-    NS_TEST_ASSERT_MSG_EQ(route->GetDest(), Ipv4Address("10.1.2.0"), "Error-- wrong destination");
-    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(), Ipv4Address("0.0.0.0"), "Error-- wrong gateway");
+    NS_LOG_DEBUG("TwoLanTest entry dest " << route.GetDest() << " gw " << route.GetGateway());
+    NS_TEST_ASSERT_MSG_EQ(route.GetDest(), Ipv4Address("10.1.2.0"), "Error-- wrong destination");
+    NS_TEST_ASSERT_MSG_EQ(route.GetGateway(), Ipv4Address("0.0.0.0"), "Error-- wrong gateway");
 
     Simulator::Destroy();
 }
@@ -617,7 +619,7 @@ BridgeTest::DoRun()
     Ptr<Ipv4GlobalRouting> globalRouting4 = routing4->GetObject<Ipv4GlobalRouting>();
     NS_TEST_ASSERT_MSG_NE(globalRouting4, nullptr, "Error-- no Ipv4GlobalRouting object");
 
-    Ipv4RoutingTableEntry* route = nullptr;
+    Ipv4RoutingTableEntry route;
     // n0
     // Test that the right number of routes found
     uint32_t nRoutes0 = globalRouting0->GetNRoutes();
@@ -626,37 +628,36 @@ BridgeTest::DoRun()
     for (uint32_t i = 0; i < globalRouting0->GetNRoutes(); i++)
     {
         route = globalRouting0->GetRoute(i);
-        NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
     }
     // Spot check the last route
-    if (route)
+    if (globalRouting0->GetNRoutes() > 0)
     {
-        NS_TEST_ASSERT_MSG_EQ(route->GetDest(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetDest(),
                               Ipv4Address("10.1.3.0"),
                               "Error-- wrong destination");
-        NS_TEST_ASSERT_MSG_EQ(route->GetGateway(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetGateway(),
                               Ipv4Address("10.1.1.2"),
                               "Error-- wrong gateway");
     }
 
     // n1
     // Test that the right number of routes found
-    route = nullptr;
     uint32_t nRoutes1 = globalRouting1->GetNRoutes();
     NS_LOG_DEBUG("BridgeTest nRoutes1 " << nRoutes1);
     NS_TEST_ASSERT_MSG_EQ(nRoutes1, 3, "Error-- not three entries");
     for (uint32_t i = 0; i < globalRouting1->GetNRoutes(); i++)
     {
         route = globalRouting1->GetRoute(i);
-        NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
     }
     // Spot check the last route
-    if (route)
+    if (globalRouting1->GetNRoutes() > 0)
     {
-        NS_TEST_ASSERT_MSG_EQ(route->GetDest(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetDest(),
                               Ipv4Address("10.1.3.0"),
                               "Error-- wrong destination");
-        NS_TEST_ASSERT_MSG_EQ(route->GetGateway(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetGateway(),
                               Ipv4Address("10.1.2.2"),
                               "Error-- wrong gateway");
     }
@@ -665,7 +666,6 @@ BridgeTest::DoRun()
     NS_LOG_DEBUG("BridgeTest skip print out of n2 and n3, go next to node n4");
 
     // n4
-    route = nullptr;
     // Test that the right number of routes found
     uint32_t nRoutes4 = globalRouting4->GetNRoutes();
     NS_LOG_DEBUG("BridgeTest nRoutes4 " << nRoutes4);
@@ -673,15 +673,15 @@ BridgeTest::DoRun()
     for (uint32_t i = 0; i < globalRouting4->GetNRoutes(); i++)
     {
         route = globalRouting4->GetRoute(i);
-        NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
     }
     // Spot check the last route
-    if (route)
+    if (globalRouting4->GetNRoutes() > 0)
     {
-        NS_TEST_ASSERT_MSG_EQ(route->GetDest(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetDest(),
                               Ipv4Address("10.1.1.0"),
                               "Error-- wrong destination");
-        NS_TEST_ASSERT_MSG_EQ(route->GetGateway(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetGateway(),
                               Ipv4Address("10.1.3.1"),
                               "Error-- wrong gateway");
     }
@@ -798,7 +798,7 @@ TwoBridgeTest::DoRun()
     Ptr<Ipv4GlobalRouting> globalRouting4 = routing4->GetObject<Ipv4GlobalRouting>();
     NS_TEST_ASSERT_MSG_NE(globalRouting4, nullptr, "Error-- no Ipv4GlobalRouting object");
 
-    Ipv4RoutingTableEntry* route = nullptr;
+    Ipv4RoutingTableEntry route;
     // n0
     // Test that the right number of routes found
     uint32_t nRoutes0 = globalRouting0->GetNRoutes();
@@ -807,15 +807,15 @@ TwoBridgeTest::DoRun()
     for (uint32_t i = 0; i < globalRouting0->GetNRoutes(); i++)
     {
         route = globalRouting0->GetRoute(i);
-        NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
     }
     // Spot check the last route
-    if (route)
+    if (globalRouting0->GetNRoutes() > 0)
     {
-        NS_TEST_ASSERT_MSG_EQ(route->GetDest(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetDest(),
                               Ipv4Address("10.1.2.0"),
                               "Error-- wrong destination");
-        NS_TEST_ASSERT_MSG_EQ(route->GetGateway(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetGateway(),
                               Ipv4Address("10.1.1.2"),
                               "Error-- wrong gateway");
     }
@@ -824,22 +824,21 @@ TwoBridgeTest::DoRun()
 
     // n4
     // Test that the right number of routes found
-    route = nullptr;
     uint32_t nRoutes4 = globalRouting4->GetNRoutes();
     NS_LOG_DEBUG("BridgeTest nRoutes4 " << nRoutes4);
     NS_TEST_ASSERT_MSG_EQ(nRoutes4, 2, "Error-- not two entries");
     for (uint32_t i = 0; i < globalRouting4->GetNRoutes(); i++)
     {
         route = globalRouting4->GetRoute(i);
-        NS_LOG_DEBUG("entry dest " << route->GetDest() << " gw " << route->GetGateway());
+        NS_LOG_DEBUG("entry dest " << route.GetDest() << " gw " << route.GetGateway());
     }
     // Spot check the last route
-    if (route)
+    if (globalRouting4->GetNRoutes() > 0)
     {
-        NS_TEST_ASSERT_MSG_EQ(route->GetDest(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetDest(),
                               Ipv4Address("10.1.1.0"),
                               "Error-- wrong destination");
-        NS_TEST_ASSERT_MSG_EQ(route->GetGateway(),
+        NS_TEST_ASSERT_MSG_EQ(route.GetGateway(),
                               Ipv4Address("10.1.2.1"),
                               "Error-- wrong gateway");
     }
@@ -1326,6 +1325,200 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting parallel and incremental SPF test
+ *
+ * The routes of a grid of routers connected by point-to-point links, with a
+ * stub router attached to a corner and a costly link between two corners, must
+ * be the same, in the same order, when the SPF calculations are run by several
+ * threads.  After links go down or up and a metric changes, the routes updated
+ * incrementally must be the same as those recomputed from scratch, in any order.
+ * The test is run with the routes stored in lists and in compact tables.
+ */
+class Ipv4GlobalRoutingSpfTestCase : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param compact whether the routers use compact routing tables
+     */
+    Ipv4GlobalRoutingSpfTestCase(bool compact);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Get the routes of the nodes.
+     * \param sorted whether the routes of each node are sorted
+     * \returns the routes of each node, printed
+     */
+    std::vector<std::vector<std::string>> GetRoutes(bool sorted) const;
+
+    /**
+     * \brief Recompute the routes incrementally and from scratch, and compare them.
+     * \param change the description of the change of the topology
+     */
+    void CheckIncrementalUpdate(std::string change);
+
+    NodeContainer m_nodes; //!< the nodes
+    bool m_compact;        //!< whether the routers use compact routing tables
+};
+
+Ipv4GlobalRoutingSpfTestCase::Ipv4GlobalRoutingSpfTestCase(bool compact)
+    : TestCase(std::string("Parallel and incremental global routing SPF calculations") +
+               (compact ? " with compact routing tables" : "")),
+      m_compact(compact)
+{
+}
+
+std::vector<std::vector<std::string>>
+Ipv4GlobalRoutingSpfTestCase::GetRoutes(bool sorted) const
+{
+    std::vector<std::vector<std::string>> routes;
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        Ptr<Ipv4GlobalRouting> globalRouting = m_nodes.Get(i)
+                                                   ->GetObject<Ipv4L3Protocol>()
+                                                   ->GetRoutingProtocol()
+                                                   ->GetObject<Ipv4GlobalRouting>();
+        routes.emplace_back();
+        for (uint32_t j = 0; j < globalRouting->GetNRoutes(); j++)
+        {
+            std::ostringstream route;
+            route << globalRouting->GetRoute(j);
+            routes.back().push_back(route.str());
+        }
+        if (sorted)
+        {
+            std::sort(routes.back().begin(), routes.back().end());
+        }
+    }
+    return routes;
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::CheckIncrementalUpdate(std::string change)
+{
+    Config::SetGlobal("GlobalRoutingIncrementalUpdate", BooleanValue(true));
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    std::vector<std::vector<std::string>> incremental = GetRoutes(true);
+    Config::SetGlobal("GlobalRoutingIncrementalUpdate", BooleanValue(false));
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    std::vector<std::vector<std::string>> full = GetRoutes(true);
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(incremental[i].size(),
+                              full[i].size(),
+                              "Wrong number of routes of node " << i << " after " << change);
+        NS_TEST_EXPECT_MSG_EQ((incremental[i] == full[i]),
+                              true,
+                              "Wrong routes of node " << i << " after " << change);
+    }
+}
+
+void
+Ipv4GlobalRoutingSpfTestCase::DoRun()
+{
+    // 4x4 grid, a stub router attached to node 0, and a link between two corners
+    const uint32_t side = 4;
+    m_nodes.Create(side * side + 1);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    ipv4RoutingHelper.Set("CompactRoutingTable", BooleanValue(m_compact));
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.0.0", "255.255.255.252");
+    std::vector<NetDeviceContainer> links;
+    auto link = [&](uint32_t a, uint32_t b) {
+        links.push_back(simpleHelper.Install(NodeContainer(m_nodes.Get(a), m_nodes.Get(b)),
+                                             CreateObject<SimpleChannel>()));
+        ipv4.Assign(links.back());
+        ipv4.NewNetwork();
+    };
+    for (uint32_t row = 0; row < side; row++)
+    {
+        for (uint32_t col = 0; col < side; col++)
+        {
+            uint32_t n = row * side + col;
+            if (col + 1 < side)
+            {
+                link(n, n + 1);
+            }
+            if (row + 1 < side)
+            {
+                link(n, n + side);
+            }
+        }
+    }
+    link(0, side * side);
+    Ptr<NetDevice> stubDevice = links.back().Get(1);
+    // a link between two corners, never on the shortest paths
+    link(side - 1, side * (side - 1));
+    NetDeviceContainer longLink = links.back();
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<Ipv4> ipv4 = longLink.Get(i)->GetNode()->GetObject<Ipv4>();
+        ipv4->SetMetric(ipv4->GetInterfaceForDevice(longLink.Get(i)), 100);
+    }
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    std::vector<std::vector<std::string>> serial = GetRoutes(false);
+    Config::SetGlobal("GlobalRoutingSpfThreads", UintegerValue(4));
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    std::vector<std::vector<std::string>> parallel = GetRoutes(false);
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((serial[i] == parallel[i]),
+                              true,
+                              "The routes of node " << i << " depend on the number of threads");
+    }
+
+    // take down the two interfaces of a link in the middle of the grid, and
+    // one interface of a link on the border, then the link between the corners
+    auto setUp = [](Ptr<NetDevice> device, bool up) {
+        Ptr<Ipv4> ipv4 = device->GetNode()->GetObject<Ipv4>();
+        int32_t interface = ipv4->GetInterfaceForDevice(device);
+        if (up)
+        {
+            ipv4->SetUp(interface);
+        }
+        else
+        {
+            ipv4->SetDown(interface);
+        }
+    };
+    setUp(links[9].Get(0), false);
+    setUp(links[9].Get(1), false);
+    CheckIncrementalUpdate("a link going down");
+    setUp(links[1].Get(1), false);
+    CheckIncrementalUpdate("an interface going down");
+    setUp(links[9].Get(0), true);
+    setUp(links[9].Get(1), true);
+    setUp(links[1].Get(1), true);
+    CheckIncrementalUpdate("links going up");
+    setUp(longLink.Get(0), false);
+    setUp(longLink.Get(1), false);
+    CheckIncrementalUpdate("a link off the shortest paths going down");
+    setUp(longLink.Get(0), true);
+    setUp(longLink.Get(1), true);
+    CheckIncrementalUpdate("a link off the shortest paths going up");
+    Ptr<Ipv4> ipv4Node5 = m_nodes.Get(5)->GetObject<Ipv4>();
+    ipv4Node5->SetMetric(ipv4Node5->GetInterfaceForDevice(links[10].Get(0)), 5);
+    CheckIncrementalUpdate("a metric change");
+    setUp(stubDevice, false);
+    CheckIncrementalUpdate("the stub router going down");
+
+    Config::SetGlobal("GlobalRoutingSpfThreads", UintegerValue(1));
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1349,6 +1542,8 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new TwoBridgeTest, TestCase::QUICK);
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingSpfTestCase(false), TestCase::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingSpfTestCase(true), TestCase::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
@@ -0,0 +1,565 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/ipv4-global-routing.h"
+#include "ns3/ipv4-prefix-trie.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/log.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("Ipv4PrefixTrieTestSuite");
+
+/**
+ * \param rand the random variable
+ * \return a random mask, which is not contiguous once in ten times
+ */
+static Ipv4Mask
+GetRandomMask(Ptr<UniformRandomVariable> rand)
+{
+    if (rand->GetInteger(0, 9) == 0)
+    {
+        return Ipv4Mask(rand->GetInteger(0, 0xffffffff));
+    }
+    uint32_t length = rand->GetInteger(0, 4) == 0 ? rand->GetInteger(0, 32)
+                                                  : rand->GetInteger(14, 32);
+    return Ipv4Mask(length == 0 ? 0 : 0xffffffff << (32 - length));
+}
+
+/**
+ * \param rand the random variable
+ * \return a random address of 10.0.0.0/14, so that the random prefixes overlap
+ */
+static Ipv4Address
+GetRandomAddress(Ptr<UniformRandomVariable> rand)
+{
+    return Ipv4Address(0x0a000000 | rand->GetInteger(0, 0x3ffff));
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Test the Ipv4PrefixTrie against a list of prefixes.
+ *
+ * Overlapping prefixes of any length, and with non-contiguous masks, are
+ * randomly inserted and removed.  The values returned by Lookup and Find must
+ * be the ones found by scanning the list, in the same order.
+ */
+class Ipv4PrefixTrieTestCase : public TestCase
+{
+  public:
+    Ipv4PrefixTrieTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// A prefix in the list
+    struct Prefix
+    {
+        Ipv4Address m_network; //!< the network
+        Ipv4Mask m_mask;       //!< the mask
+        uint32_t m_value;      //!< the value
+    };
+
+    /**
+     * \brief Check the trie against the list.
+     * \param trie the trie
+     * \param prefixes the list
+     * \param rand the random variable
+     */
+    void Check(const Ipv4PrefixTrie<uint32_t>& trie,
+               const std::vector<Prefix>& prefixes,
+               Ptr<UniformRandomVariable> rand);
+};
+
+Ipv4PrefixTrieTestCase::Ipv4PrefixTrieTestCase()
+    : TestCase("Check the Ipv4PrefixTrie against a list of prefixes")
+{
+}
+
+void
+Ipv4PrefixTrieTestCase::Check(const Ipv4PrefixTrie<uint32_t>& trie,
+                              const std::vector<Prefix>& prefixes,
+                              Ptr<UniformRandomVariable> rand)
+{
+    NS_TEST_ASSERT_MSG_EQ(trie.GetSize(), prefixes.size(), "Unexpected number of values");
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        Ipv4Address dest = GetRandomAddress(rand);
+        std::vector<uint32_t> expected;
+        for (const auto& prefix : prefixes)
+        {
+            if (prefix.m_mask.IsMatch(dest, prefix.m_network))
+            {
+                expected.push_back(prefix.m_value);
+            }
+        }
+        std::vector<Ipv4PrefixTrie<uint32_t>::Entry> matches;
+        trie.Lookup(dest, matches);
+        NS_TEST_ASSERT_MSG_EQ(matches.size(), expected.size(), "Wrong matches of " << dest);
+        for (std::size_t j = 0; j < matches.size(); j++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(matches[j].second, expected[j], "Wrong match of " << dest);
+        }
+    }
+    if (prefixes.empty())
+    {
+        return;
+    }
+    const Prefix& prefix = prefixes[rand->GetInteger(0, prefixes.size() - 1)];
+    std::vector<uint32_t> expected;
+    for (const auto& other : prefixes)
+    {
+        if (other.m_mask == prefix.m_mask && other.m_network.CombineMask(other.m_mask) ==
+                                                 prefix.m_network.CombineMask(prefix.m_mask))
+        {
+            expected.push_back(other.m_value);
+        }
+    }
+    std::vector<Ipv4PrefixTrie<uint32_t>::Entry> values;
+    trie.Find(prefix.m_network, prefix.m_mask, values);
+    NS_TEST_ASSERT_MSG_EQ(values.size(), expected.size(), "Wrong values of a prefix");
+    for (std::size_t j = 0; j < values.size(); j++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(values[j].second, expected[j], "Wrong value of a prefix");
+    }
+}
+
+void
+Ipv4PrefixTrieTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(1);
+
+    Ipv4PrefixTrie<uint32_t> trie;
+    std::vector<Prefix> prefixes;
+    for (uint32_t value = 0; value < 1000; value++)
+    {
+        if (!prefixes.empty() && rand->GetInteger(0, 2) == 0)
+        {
+            std::size_t index = rand->GetInteger(0, prefixes.size() - 1);
+            const Prefix& prefix = prefixes[index];
+            NS_TEST_ASSERT_MSG_EQ(trie.Remove(prefix.m_network, prefix.m_mask, prefix.m_value),
+                                  true,
+                                  "The value should be found");
+            NS_TEST_ASSERT_MSG_EQ(trie.Remove(prefix.m_network, prefix.m_mask, prefix.m_value),
+                                  false,
+                                  "The value should have been removed");
+            prefixes.erase(prefixes.begin() + index);
+        }
+        else
+        {
+            Prefix prefix{GetRandomAddress(rand), GetRandomMask(rand), value};
+            trie.Insert(prefix.m_network, prefix.m_mask, prefix.m_value);
+            prefixes.push_back(prefix);
+        }
+        Check(trie, prefixes, rand);
+    }
+    trie.Clear();
+    prefixes.clear();
+    Check(trie, prefixes, rand);
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Test the lookups of Ipv4GlobalRouting and Ipv4StaticRouting.
+ *
+ * Routes to overlapping prefixes are randomly added and removed.  The routes
+ * returned by RouteOutput must be the ones found by scanning the routing
+ * tables as the protocols did before indexing the routes with a trie: the
+ * first host route, network route or external route matching the destination
+ * for the global routing, the longest prefix with the smallest metric for the
+ * static routing.  The global routing with a compact routing table, created by
+ * Ipv4GlobalRoutingHelper, must hold and select the same routes, with less
+ * memory.
+ */
+class Ipv4RoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4RoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Find the expected global route by scanning the routes.
+     * \param routes the host, network and external routes
+     * \param ipv4 the IPv4 instance
+     * \param dest the destination
+     * \param oif the output interface, if any
+     * \return the expected route, or nullptr
+     */
+    const Ipv4RoutingTableEntry* GetGlobalRoute(
+        const std::vector<std::vector<Ipv4RoutingTableEntry>>& routes,
+        Ptr<Ipv4> ipv4,
+        Ipv4Address dest,
+        Ptr<NetDevice> oif);
+
+    /**
+     * \brief Find the expected static route by scanning the routes.
+     * \param routing the static routing
+     * \param ipv4 the IPv4 instance
+     * \param dest the destination
+     * \param oif the output interface, if any
+     * \param route the expected route (output)
+     * \return true if a route is expected
+     */
+    bool GetStaticRoute(Ptr<Ipv4StaticRouting> routing,
+                        Ptr<Ipv4> ipv4,
+                        Ipv4Address dest,
+                        Ptr<NetDevice> oif,
+                        Ipv4RoutingTableEntry& route);
+
+    /**
+     * \brief Check a route returned by RouteOutput.
+     * \param route the route
+     * \param expected the expected route, or nullptr
+     * \param ipv4 the IPv4 instance
+     * \param dest the destination
+     */
+    void CheckRoute(Ptr<Ipv4Route> route,
+                    const Ipv4RoutingTableEntry* expected,
+                    Ptr<Ipv4> ipv4,
+                    Ipv4Address dest);
+};
+
+Ipv4RoutingLookupTestCase::Ipv4RoutingLookupTestCase()
+    : TestCase("Check the lookups of the global and static routing against a scan of the tables")
+{
+}
+
+const Ipv4RoutingTableEntry*
+Ipv4RoutingLookupTestCase::GetGlobalRoute(
+    const std::vector<std::vector<Ipv4RoutingTableEntry>>& routes,
+    Ptr<Ipv4> ipv4,
+    Ipv4Address dest,
+    Ptr<NetDevice> oif)
+{
+    for (const auto& table : routes)
+    {
+        for (const auto& route : table)
+        {
+            bool match = route.IsHost()
+                             ? route.GetDest() == dest
+                             : route.GetDestNetworkMask().IsMatch(dest, route.GetDestNetwork());
+            if (match && (!oif || oif == ipv4->GetNetDevice(route.GetInterface())))
+            {
+                return &route;
+            }
+        }
+    }
+    return nullptr;
+}
+
+bool
+Ipv4RoutingLookupTestCase::GetStaticRoute(Ptr<Ipv4StaticRouting> routing,
+                                          Ptr<Ipv4> ipv4,
+                                          Ipv4Address dest,
+                                          Ptr<NetDevice> oif,
+                                          Ipv4RoutingTableEntry& route)
+{
+    bool found = false;
+    uint16_t longestMask = 0;
+    uint32_t shortestMetric = 0xffffffff;
+    for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+    {
+        Ipv4RoutingTableEntry candidate = routing->GetRoute(i);
+        uint32_t metric = routing->GetMetric(i);
+        Ipv4Mask mask = candidate.GetDestNetworkMask();
+        uint16_t masklen = mask.GetPrefixLength();
+        if (!mask.IsMatch(dest, candidate.GetDestNetwork()) ||
+            (oif && oif != ipv4->GetNetDevice(candidate.GetInterface())) || masklen < longestMask)
+        {
+            continue;
+        }
+        if (masklen > longestMask)
+        {
+            shortestMetric = 0xffffffff;
+        }
+        longestMask = masklen;
+        if (metric > shortestMetric)
+        {
+            continue;
+        }
+        shortestMetric = metric;
+        route = candidate;
+        found = true;
+        if (masklen == 32)
+        {
+            break;
+        }
+    }
+    return found;
+}
+
+void
+Ipv4RoutingLookupTestCase::CheckRoute(Ptr<Ipv4Route> route,
+                                      const Ipv4RoutingTableEntry* expected,
+                                      Ptr<Ipv4> ipv4,
+                                      Ipv4Address dest)
+{
+    if (!expected)
+    {
+        NS_TEST_ASSERT_MSG_EQ(route, nullptr, "No route to " << dest << " was expected");
+        return;
+    }
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "A route to " << dest << " was expected");
+    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(),
+                          expected->GetGateway(),
+                          "Wrong gateway to " << dest);
+    NS_TEST_ASSERT_MSG_EQ(route->GetOutputDevice(),
+                          ipv4->GetNetDevice(expected->GetInterface()),
+                          "Wrong output device to " << dest);
+}
+
+void
+Ipv4RoutingLookupTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(2);
+
+    Ptr<Node> node = CreateObject<Node>();
+    SimpleNetDeviceHelper deviceHelper;
+    NetDeviceContainer devices;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        devices.Add(deviceHelper.Install(node));
+    }
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.255.0");
+    for (uint32_t i = 0; i < devices.GetN(); i++)
+    {
+        addresses.Assign(devices.Get(i));
+        addresses.NewNetwork();
+    }
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+
+    Ptr<Ipv4StaticRouting> staticRouting = Ipv4StaticRoutingHelper().GetStaticRouting(ipv4);
+    Ptr<Ipv4GlobalRouting> globalRouting = CreateObject<Ipv4GlobalRouting>();
+    globalRouting->SetIpv4(ipv4);
+    Ipv4GlobalRoutingHelper compactHelper;
+    compactHelper.Set("CompactRoutingTable", BooleanValue(true));
+    Ptr<Ipv4GlobalRouting> compactRouting =
+        DynamicCast<Ipv4GlobalRouting>(compactHelper.Create(CreateObject<Node>()));
+    compactRouting->SetIpv4(ipv4);
+    std::vector<Ptr<Ipv4GlobalRouting>> globalRoutings{globalRouting, compactRouting};
+    // the host, network and external routes of the global routing, in order
+    std::vector<std::vector<Ipv4RoutingTableEntry>> globalRoutes(3);
+
+    for (uint32_t step = 0; step < 400; step++)
+    {
+        uint32_t interface = rand->GetInteger(1, devices.GetN());
+        Ipv4Address gateway(0x0a000002 | (interface - 1) << 8);
+        Ipv4Address network = GetRandomAddress(rand);
+        Ipv4Mask mask = GetRandomMask(rand);
+
+        // global routing
+        uint32_t nRoutes = globalRouting->GetNRoutes();
+        if (nRoutes > 0 && rand->GetInteger(0, 3) == 0)
+        {
+            uint32_t globalIndex = rand->GetInteger(0, nRoutes - 1);
+            bool byIndex = rand->GetInteger(0, 1) == 0;
+            uint32_t index = globalIndex;
+            std::size_t kind = 0;
+            while (index >= globalRoutes[kind].size())
+            {
+                index -= globalRoutes[kind].size();
+                kind++;
+            }
+            std::vector<Ipv4RoutingTableEntry>& table = globalRoutes[kind];
+            Ipv4RoutingTableEntry route = table[index];
+            // the external routes can only be removed by index
+            if (byIndex || kind == 2)
+            {
+                for (auto routing : globalRoutings)
+                {
+                    routing->RemoveRoute(globalIndex);
+                }
+                table.erase(table.begin() + index);
+            }
+            else
+            {
+                // the first route with the same destination and next hop is removed
+                for (auto routing : globalRoutings)
+                {
+                    bool removed;
+                    if (kind == 0)
+                    {
+                        removed = routing->RemoveHostRouteTo(route.GetDest(),
+                                                             route.GetGateway(),
+                                                             route.GetInterface());
+                    }
+                    else
+                    {
+                        removed = routing->RemoveNetworkRouteTo(route.GetDestNetwork(),
+                                                                route.GetDestNetworkMask(),
+                                                                route.GetGateway(),
+                                                                route.GetInterface());
+                    }
+                    NS_TEST_ASSERT_MSG_EQ(removed, true, "The route should have been found");
+                }
+                table.erase(std::find(table.begin(), table.end(), route));
+            }
+        }
+        else
+        {
+            uint32_t kind = rand->GetInteger(0, 2);
+            for (auto routing : globalRoutings)
+            {
+                switch (kind)
+                {
+                case 0:
+                    routing->AddHostRouteTo(network, gateway, interface);
+                    break;
+                case 1:
+                    routing->AddNetworkRouteTo(network, mask, gateway, interface);
+                    break;
+                default:
+                    routing->AddASExternalRouteTo(network, mask, gateway, interface);
+                    break;
+                }
+            }
+            if (kind == 0)
+            {
+                globalRoutes[kind].push_back(
+                    Ipv4RoutingTableEntry::CreateHostRouteTo(network, gateway, interface));
+            }
+            else
+            {
+                globalRoutes[kind].push_back(
+                    Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, mask, gateway, interface));
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(compactRouting->GetNRoutes(),
+                              globalRouting->GetNRoutes(),
+                              "Both global routing tables should have the same number of routes");
+        if (step % 50 == 0)
+        {
+            for (uint32_t i = 0; i < globalRouting->GetNRoutes(); i++)
+            {
+                NS_TEST_ASSERT_MSG_EQ(compactRouting->GetRoute(i),
+                                      globalRouting->GetRoute(i),
+                                      "Both global routing tables should have the same routes");
+            }
+        }
+
+        // static routing
+        nRoutes = staticRouting->GetNRoutes();
+        if (nRoutes > 0 && rand->GetInteger(0, 3) == 0)
+        {
+            staticRouting->RemoveRoute(rand->GetInteger(0, nRoutes - 1));
+        }
+        else if (nRoutes > 0 && rand->GetInteger(0, 3) == 0)
+        {
+            // adding a route already in the table must not change the table
+            uint32_t index = rand->GetInteger(0, nRoutes - 1);
+            Ipv4RoutingTableEntry route = staticRouting->GetRoute(index);
+            staticRouting->AddNetworkRouteTo(route.GetDestNetwork(),
+                                             route.GetDestNetworkMask(),
+                                             route.GetGateway(),
+                                             route.GetInterface(),
+                                             staticRouting->GetMetric(index));
+            NS_TEST_ASSERT_MSG_EQ(staticRouting->GetNRoutes(),
+                                  nRoutes,
+                                  "A duplicate route should not be added");
+        }
+        else
+        {
+            staticRouting->AddNetworkRouteTo(network,
+                                             mask,
+                                             gateway,
+                                             interface,
+                                             rand->GetInteger(0, 3));
+        }
+
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            Ipv4Header header;
+            header.SetDestination(GetRandomAddress(rand));
+            uint32_t oifIndex = rand->GetInteger(0, devices.GetN());
+            Ptr<NetDevice> oif = oifIndex == 0 ? nullptr : devices.Get(oifIndex - 1);
+            Socket::SocketErrno sockerr;
+
+            const Ipv4RoutingTableEntry* expectedGlobal =
+                GetGlobalRoute(globalRoutes, ipv4, header.GetDestination(), oif);
+            Ptr<Ipv4Route> route;
+            for (auto routing : globalRoutings)
+            {
+                route = routing->RouteOutput(Create<Packet>(), header, oif, sockerr);
+                CheckRoute(route, expectedGlobal, ipv4, header.GetDestination());
+            }
+
+            route = staticRouting->RouteOutput(Create<Packet>(), header, oif, sockerr);
+            Ipv4RoutingTableEntry expected;
+            bool found =
+                GetStaticRoute(staticRouting, ipv4, header.GetDestination(), oif, expected);
+            CheckRoute(route, found ? &expected : nullptr, ipv4, header.GetDestination());
+        }
+    }
+
+    NS_TEST_ASSERT_MSG_GT(globalRouting->GetMemoryUsage(),
+                          compactRouting->GetMemoryUsage(),
+                          "The compact routing table should use less memory");
+    NS_TEST_ASSERT_MSG_GT(Ipv4GlobalRouting::GetSharedMemoryUsage(),
+                          0,
+                          "The compact routing table should use the shared destinations");
+    globalRouting->Dispose();
+    compactRouting->Dispose();
+    NS_TEST_ASSERT_MSG_EQ(Ipv4GlobalRouting::GetSharedMemoryUsage(),
+                          0,
+                          "The shared destinations should be released with the last user");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief IPv4 prefix trie TestSuite
+ */
+class Ipv4PrefixTrieTestSuite : public TestSuite
+{
+  public:
+    Ipv4PrefixTrieTestSuite();
+};
+
+Ipv4PrefixTrieTestSuite::Ipv4PrefixTrieTestSuite()
+    : TestSuite("ipv4-prefix-trie", UNIT)
+{
+    AddTestCase(new Ipv4PrefixTrieTestCase, TestCase::QUICK);
+    AddTestCase(new Ipv4RoutingLookupTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static Ipv4PrefixTrieTestSuite g_ipv4PrefixTrieTestSuite;
@@ -18,6 +18,7 @@
  * Author: Zhiheng Dong <dzh2077@gmail.com>
  */
 
+#include "ns3/arp-cache.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -27,6 +28,8 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-routing-helper.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ndisc-cache.h"
 #include "ns3/neighbor-cache-helper.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
@@ -1230,6 +1233,207 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief NDISC Cache NUD Timer Test
+ */
+class NudTimerTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    NudTimerTest();
+
+  private:
+    /**
+     * \brief Add a REACHABLE entry and start its reachable timer.
+     * \param address The IPv6 address of the entry.
+     * \param mac The MAC address of the entry.
+     */
+    void StartReachable(Ipv6Address address, Mac48Address mac);
+
+    /**
+     * \brief Update the reachable timer of an entry.
+     * \param address The IPv6 address of the entry.
+     */
+    void UpdateReachable(Ipv6Address address);
+
+    /**
+     * \brief Mark an entry PERMANENT.
+     * \param address The IPv6 address of the entry.
+     */
+    void MarkPermanent(Ipv6Address address);
+
+    /**
+     * \brief Remove an entry from the cache.
+     * \param address The IPv6 address of the entry.
+     */
+    void Remove(Ipv6Address address);
+
+    /**
+     * \brief Check the state of an entry.
+     * \param address The IPv6 address of the entry.
+     * \param state The expected state.
+     */
+    void CheckState(Ipv6Address address, NdiscCache::Entry::NdiscCacheEntryState_e state);
+
+    Ptr<NdiscCache> m_cache; //!< The cache used in the test.
+};
+
+NudTimerTest::NudTimerTest()
+    : TestCase("The NudTimerTest checks that the NUD timers of the NDISC cache entries expire "
+               "at the right time when they are started, restarted, stopped or removed.")
+{
+}
+
+void
+NudTimerTest::StartReachable(Ipv6Address address, Mac48Address mac)
+{
+    NdiscCache::Entry* entry = m_cache->Add(address);
+    entry->MarkReachable(mac);
+    entry->StartReachableTimer();
+}
+
+void
+NudTimerTest::UpdateReachable(Ipv6Address address)
+{
+    m_cache->Lookup(address)->UpdateReachableTimer();
+}
+
+void
+NudTimerTest::MarkPermanent(Ipv6Address address)
+{
+    m_cache->Lookup(address)->MarkPermanent();
+}
+
+void
+NudTimerTest::Remove(Ipv6Address address)
+{
+    m_cache->Remove(m_cache->Lookup(address));
+}
+
+void
+NudTimerTest::CheckState(Ipv6Address address, NdiscCache::Entry::NdiscCacheEntryState_e state)
+{
+    NdiscCache::Entry* entry = m_cache->Lookup(address);
+    NS_TEST_ASSERT_MSG_NE(entry, nullptr, "Entry " << address << " not found");
+    NS_TEST_EXPECT_MSG_EQ(entry->GetEntryState(),
+                          state,
+                          "Entry " << address << " in the wrong state at " << Simulator::Now());
+}
+
+void
+NudTimerTest::DoRun()
+{
+    Ptr<Icmpv6L4Protocol> icmpv6 = CreateObject<Icmpv6L4Protocol>();
+    icmpv6->SetAttribute("ReachableTime", TimeValue(Seconds(10)));
+    m_cache = CreateObject<NdiscCache>();
+    m_cache->SetDevice(nullptr, nullptr, icmpv6);
+
+    Ipv6Address a("2001::1");
+    Ipv6Address b("2001::3");
+    Ipv6Address c("2001::2");
+    Ipv6Address d("2001::4");
+    Mac48Address mac1("00:00:00:00:00:01");
+    Mac48Address mac2("00:00:00:00:00:02");
+
+    Simulator::Schedule(Seconds(0), &NudTimerTest::StartReachable, this, a, mac1);
+    Simulator::Schedule(Seconds(0), &NudTimerTest::StartReachable, this, d, mac1);
+    Simulator::Schedule(Seconds(1), &NudTimerTest::StartReachable, this, b, mac2);
+    Simulator::Schedule(Seconds(2), &NudTimerTest::StartReachable, this, c, mac2);
+    Simulator::Schedule(Seconds(3), &NudTimerTest::MarkPermanent, this, c);
+    Simulator::Schedule(Seconds(3), &NudTimerTest::Remove, this, d);
+    Simulator::Schedule(Seconds(5), &NudTimerTest::UpdateReachable, this, a);
+
+    using Entry = NdiscCache::Entry;
+
+    Simulator::Schedule(Seconds(10.5), &NudTimerTest::CheckState, this, a, Entry::REACHABLE);
+    Simulator::Schedule(Seconds(10.5), &NudTimerTest::CheckState, this, b, Entry::REACHABLE);
+    Simulator::Schedule(Seconds(11.5), &NudTimerTest::CheckState, this, a, Entry::REACHABLE);
+    Simulator::Schedule(Seconds(11.5), &NudTimerTest::CheckState, this, b, Entry::STALE);
+    Simulator::Schedule(Seconds(11.5), &NudTimerTest::CheckState, this, c, Entry::PERMANENT);
+    Simulator::Schedule(Seconds(15.5), &NudTimerTest::CheckState, this, a, Entry::STALE);
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_cache->Lookup(d), nullptr, "Removed entry found");
+
+    // the reverse lookups return the entries in the order of their addresses
+    std::list<NdiscCache::Entry*> entries = m_cache->LookupInverse(mac2);
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 2, "Wrong number of entries");
+    NS_TEST_EXPECT_MSG_EQ(entries.front()->GetIpv6Address(), c, "Wrong entry");
+    NS_TEST_EXPECT_MSG_EQ(entries.back()->GetIpv6Address(), b, "Wrong entry");
+    m_cache->Lookup(a)->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ(m_cache->LookupInverse(mac1).size(), 0, "Entry found by its old MAC");
+    entries = m_cache->LookupInverse(mac2);
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 3, "Wrong number of entries");
+    NS_TEST_EXPECT_MSG_EQ(entries.front()->GetIpv6Address(), a, "Wrong entry");
+
+    m_cache->Dispose();
+    m_cache = nullptr;
+    icmpv6->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief ARP Cache Reverse Lookup Test
+ */
+class ArpLookupInverseTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    ArpLookupInverseTest();
+};
+
+ArpLookupInverseTest::ArpLookupInverseTest()
+    : TestCase("The ArpLookupInverseTest checks that the ARP cache finds its entries by MAC "
+               "address when they are added, changed or removed.")
+{
+}
+
+void
+ArpLookupInverseTest::DoRun()
+{
+    Ptr<ArpCache> cache = CreateObject<ArpCache>();
+    Mac48Address mac1("00:00:00:00:00:01");
+    Mac48Address mac2("00:00:00:00:00:02");
+
+    Ipv4Address addresses[] = {"10.0.0.3", "10.0.0.1", "10.0.0.2"};
+    for (const auto& address : addresses)
+    {
+        ArpCache::Entry* entry = cache->Add(address);
+        entry->SetMacAddress(mac1);
+        entry->MarkPermanent();
+    }
+
+    std::list<ArpCache::Entry*> entries = cache->LookupInverse(mac1);
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 3, "Wrong number of entries");
+    Ipv4Address expected = "10.0.0.1";
+    for (ArpCache::Entry* entry : entries)
+    {
+        NS_TEST_EXPECT_MSG_EQ(entry->GetIpv4Address(), expected, "Wrong entry");
+        expected.Set(expected.Get() + 1);
+    }
+
+    cache->Lookup("10.0.0.1")->SetMacAddress(mac2);
+    cache->Remove(cache->Lookup("10.0.0.3"));
+    entries = cache->LookupInverse(mac1);
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 1, "Wrong number of entries");
+    NS_TEST_EXPECT_MSG_EQ(entries.front()->GetIpv4Address(),
+                          Ipv4Address("10.0.0.2"),
+                          "Wrong entry");
+    entries = cache->LookupInverse(mac2);
+    NS_TEST_ASSERT_MSG_EQ(entries.size(), 1, "Wrong number of entries");
+    NS_TEST_EXPECT_MSG_EQ(entries.front()->GetIpv4Address(),
+                          Ipv4Address("10.0.0.1"),
+                          "Wrong entry");
+
+    cache->Dispose();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1249,6 +1453,8 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::QUICK);
         AddTestCase(new DuplicateTest, TestCase::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::QUICK);
+        AddTestCase(new NudTimerTest, TestCase::QUICK);
+        AddTestCase(new ArpLookupInverseTest, TestCase::QUICK);
     }
 };
 
@@ -0,0 +1,292 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tcp-error-model.h"
+#include "tcp-general-test.h"
+
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/tcp-header.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpAckBatchingTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Test the batching of the ACKs of the segments received at once
+ *
+ * The devices of TcpGeneralTest have no data rate, hence the segments sent
+ * in a burst by the sender are received at the same time. With the
+ * AckBatching attribute of the receiver set, each burst is acknowledged by a
+ * single ACK; otherwise, an ACK is sent every DelAckCount segments. The
+ * receiver uses a smaller SegmentSize than the sender, which must not change
+ * the number of segments acknowledged by an ACK.
+ */
+class TcpAckBatchingTestCase : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param desc Test description
+     * \param ackBatching Enable the ACK batching of the receiver
+     */
+    TcpAckBatchingTestCase(const std::string& desc, bool ackBatching);
+
+  protected:
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    bool m_ackBatching;                //!< ACK batching of the receiver enabled
+    uint32_t m_rxBytes{0};             //!< Data received by the receiver
+    std::map<Time, uint32_t> m_acks{}; //!< Number of ACKs sent by the receiver at each time
+};
+
+TcpAckBatchingTestCase::TcpAckBatchingTestCase(const std::string& desc, bool ackBatching)
+    : TcpGeneralTest(desc),
+      m_ackBatching(ackBatching)
+{
+}
+
+void
+TcpAckBatchingTestCase::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(100);
+    SetAppPktInterval(Seconds(0));
+}
+
+void
+TcpAckBatchingTestCase::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 10);
+    SetSegmentSize(RECEIVER, GetSegSize(SENDER) / 2);
+    GetReceiverSocket()->SetAttribute("AckBatching", BooleanValue(m_ackBatching));
+}
+
+void
+TcpAckBatchingTestCase::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER && p->GetSize() == 0 && h.GetFlags() == TcpHeader::ACK)
+    {
+        m_acks[Simulator::Now()]++;
+    }
+}
+
+void
+TcpAckBatchingTestCase::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER)
+    {
+        m_rxBytes += p->GetSize();
+    }
+}
+
+void
+TcpAckBatchingTestCase::FinalChecks()
+{
+    NS_TEST_ASSERT_MSG_EQ(m_rxBytes, GetPktSize() * GetPktCount(), "Receiver missed data");
+
+    uint32_t maxAcks = 0;
+    uint32_t totalAcks = 0;
+    for (const auto& acks : m_acks)
+    {
+        maxAcks = std::max(maxAcks, acks.second);
+        totalAcks += acks.second;
+    }
+    NS_LOG_INFO("ACKs sent: " << totalAcks << ", at most " << maxAcks << " at the same time");
+    if (m_ackBatching)
+    {
+        NS_TEST_ASSERT_MSG_EQ(maxAcks, 1, "Segments received at once acknowledged twice");
+    }
+    else
+    {
+        NS_TEST_ASSERT_MSG_GT(maxAcks, 1, "No burst of segments acknowledged");
+        // at most an ACK every DelAckCount segments, plus an ACK upon the
+        // expiration of the delayed ACK timer at each time an ACK is sent
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(totalAcks,
+                                    GetPktCount() / GetDelAckCount(RECEIVER) + m_acks.size(),
+                                    "Less than DelAckCount segments acknowledged by an ACK");
+    }
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Test that the duplicate ACKs are not batched
+ *
+ * A segment of the first burst is lost, and SACK is disabled. The segments
+ * received after the lost one, at the same time, must each trigger a duplicate
+ * ACK, so that the sender enters the fast recovery as soon as they are received,
+ * rather than after several bursts or the retransmission timeout.
+ */
+class TcpAckBatchingLossTestCase : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param desc Test description
+     */
+    TcpAckBatchingLossTestCase(const std::string& desc);
+
+  protected:
+    void ConfigureEnvironment() override;
+    void ConfigureProperties() override;
+    Ptr<ErrorModel> CreateReceiverErrorModel() override;
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void CongStateTrace(const TcpSocketState::TcpCongState_t oldValue,
+                        const TcpSocketState::TcpCongState_t newValue) override;
+    void AfterRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    uint32_t m_rxBytes{0};                //!< Data received by the receiver
+    std::map<Time, uint32_t> m_dupAcks{}; //!< Number of duplicate ACKs sent at each time
+    SequenceNumber32 m_lastAck{};         //!< Last ACK number sent by the receiver
+    Time m_fastRecoveryTime{};            //!< Time the sender entered the fast recovery
+};
+
+TcpAckBatchingLossTestCase::TcpAckBatchingLossTestCase(const std::string& desc)
+    : TcpGeneralTest(desc)
+{
+}
+
+void
+TcpAckBatchingLossTestCase::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(100);
+    SetAppPktInterval(Seconds(0));
+}
+
+void
+TcpAckBatchingLossTestCase::ConfigureProperties()
+{
+    TcpGeneralTest::ConfigureProperties();
+    SetInitialCwnd(SENDER, 10);
+    GetSenderSocket()->SetAttribute("Sack", BooleanValue(false));
+    GetReceiverSocket()->SetAttribute("Sack", BooleanValue(false));
+    GetReceiverSocket()->SetAttribute("AckBatching", BooleanValue(true));
+}
+
+Ptr<ErrorModel>
+TcpAckBatchingLossTestCase::CreateReceiverErrorModel()
+{
+    // drop the third segment of the first burst
+    Ptr<TcpSeqErrorModel> errorModel = CreateObject<TcpSeqErrorModel>();
+    errorModel->AddSeqToKill(SequenceNumber32(1 + 2 * GetPktSize()));
+    return errorModel;
+}
+
+Ptr<TcpSocketMsgBase>
+TcpAckBatchingLossTestCase::CreateSenderSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket(node);
+    socket->SetAttribute("MinRto", TimeValue(Seconds(10.0)));
+    return socket;
+}
+
+void
+TcpAckBatchingLossTestCase::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER && p->GetSize() == 0 && h.GetFlags() == TcpHeader::ACK)
+    {
+        if (h.GetAckNumber() == m_lastAck)
+        {
+            m_dupAcks[Simulator::Now()]++;
+        }
+        m_lastAck = h.GetAckNumber();
+    }
+}
+
+void
+TcpAckBatchingLossTestCase::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER)
+    {
+        m_rxBytes += p->GetSize();
+    }
+}
+
+void
+TcpAckBatchingLossTestCase::CongStateTrace(const TcpSocketState::TcpCongState_t oldValue,
+                                           const TcpSocketState::TcpCongState_t newValue)
+{
+    if (newValue == TcpSocketState::CA_RECOVERY && m_fastRecoveryTime.IsZero())
+    {
+        m_fastRecoveryTime = Simulator::Now();
+    }
+}
+
+void
+TcpAckBatchingLossTestCase::AfterRTOExpired(const Ptr<const TcpSocketState> tcb, SocketWho who)
+{
+    NS_TEST_ASSERT_MSG_EQ(true, false, "The lost segment should be recovered before the RTO");
+}
+
+void
+TcpAckBatchingLossTestCase::FinalChecks()
+{
+    NS_TEST_ASSERT_MSG_EQ(m_rxBytes, GetPktSize() * GetPktCount(), "Receiver missed data");
+    NS_TEST_ASSERT_MSG_EQ(m_dupAcks.empty(), false, "No duplicate ACK sent");
+    // the first duplicate ACKs are those of the segments following the lost one
+    const auto& [firstDupAckTime, firstDupAcks] = *m_dupAcks.begin();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(firstDupAcks,
+                                GetReTxThreshold(SENDER),
+                                "Duplicate ACKs sent at the same time have been batched");
+    NS_TEST_ASSERT_MSG_EQ(m_fastRecoveryTime,
+                          firstDupAckTime + GetPropagationDelay(),
+                          "The sender did not enter the fast recovery upon the duplicate ACKs");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for the batching of the ACKs
+ */
+class TcpAckBatchingTestSuite : public TestSuite
+{
+  public:
+    TcpAckBatchingTestSuite()
+        : TestSuite("tcp-ack-batching", UNIT)
+    {
+        AddTestCase(new TcpAckBatchingTestCase("An ACK every DelAckCount segments", false),
+                    TestCase::QUICK);
+        AddTestCase(new TcpAckBatchingTestCase("An ACK for the segments received at once", true),
+                    TestCase::QUICK);
+        AddTestCase(new TcpAckBatchingLossTestCase("Duplicate ACKs are not batched"),
+                    TestCase::QUICK);
+    }
+};
+
+static TcpAckBatchingTestSuite
+    g_tcpAckBatchingTestSuite; //!< Static variable for test initialization
@@ -20,6 +20,9 @@
 #include "ns3/tcp-rx-buffer.h"
 #include "ns3/test.h"
 
+#include <cstring>
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("TcpRxBufferTestSuite");
@@ -43,6 +46,11 @@ class TcpRxBufferTestCase : public TestCase
      * \brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * \brief Test the reassembly and the extraction of overlapping segments.
+     */
+    void TestExtract();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -54,6 +62,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestExtract();
 }
 
 void
@@ -290,6 +299,81 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestExtract()
+{
+    // The byte at sequence number s has value s % 251
+    uint8_t data[1000];
+    for (uint32_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = i % 251;
+    }
+    TcpRxBuffer rxBuf;
+    rxBuf.SetMaxBufferSize(1000);
+    TcpHeader h;
+
+    // Segments added as (start, end): an out-of-order segment, one overlapping
+    // its head, one embedded in a larger one, and an in-order one overlapping
+    // the second one. The stored chunks are [0, 250), [250, 300), [300, 400)
+    // and [500, 600)
+    std::vector<std::pair<uint32_t, uint32_t>> segments =
+        {{300, 400}, {250, 350}, {520, 560}, {500, 600}, {0, 260}};
+    for (const auto& segment : segments)
+    {
+        h.SetSequenceNumber(SequenceNumber32(segment.first));
+        rxBuf.Add(Create<Packet>(data + segment.first, segment.second - segment.first), h);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(400),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 400, "Available data differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 500, "Buffer occupancy differs from expected");
+
+    // The chain holds the stored chunks, the last one being split
+    std::vector<Ptr<Packet>> chain;
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.ExtractChain(280, chain), 280, "Extracted size differs");
+    NS_TEST_ASSERT_MSG_EQ(chain.size(), 2, "Chain should hold two chunks");
+    NS_TEST_ASSERT_MSG_EQ(chain[0]->GetSize(), 250, "First chunk differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(chain[1]->GetSize(), 30, "Second chunk differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetCopiedBytes(), 0, "ExtractChain should not copy data");
+
+    // A single chunk is returned as is
+    Ptr<Packet> p = rxBuf.Extract(20);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 20, "Extracted size differs");
+    chain.push_back(p);
+    p = rxBuf.Extract(1000);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 100, "Extracted size differs");
+    chain.push_back(p);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetCopiedBytes(), 0, "Extract should not copy a single chunk");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetExtractedBytes(), 400, "Extracted bytes differ");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(1000), nullptr, "No data should be available");
+
+    uint32_t seq = 0;
+    for (const auto& chunk : chain)
+    {
+        uint8_t buf[1000];
+        chunk->CopyData(buf, chunk->GetSize());
+        NS_TEST_ASSERT_MSG_EQ(memcmp(buf, data + seq, chunk->GetSize()),
+                              0,
+                              "Data differs from expected at sequence " << seq);
+        seq += chunk->GetSize();
+    }
+
+    // Filling the hole makes the rest of the data available, as two chunks
+    // which are concatenated
+    h.SetSequenceNumber(SequenceNumber32(350));
+    rxBuf.Add(Create<Packet>(data + 350, 200), h);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(600),
+                          "Sequence number differs from expected");
+    p = rxBuf.Extract(1000);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 200, "Extracted size differs");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetCopiedBytes(), 200, "Extract should concatenate two chunks");
+    uint8_t buf[200];
+    p->CopyData(buf, p->GetSize());
+    NS_TEST_ASSERT_MSG_EQ(memcmp(buf, data + 400, 200), 0, "Data differs from expected");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
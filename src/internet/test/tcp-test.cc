@@ -21,6 +21,7 @@
  */
 
 #include "ns3/arp-l3-protocol.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
@@ -39,12 +40,14 @@
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/tcp-l4-protocol.h"
+#include "ns3/tcp-socket-base.h"
 #include "ns3/tcp-socket-factory.h"
 #include "ns3/test.h"
 #include "ns3/traffic-control-layer.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <string>
 
 using namespace ns3;
@@ -68,13 +71,17 @@ class TcpTestCase : public TestCase
      * \param serverWriteSize Server data size when sending.
      * \param serverReadSize Server data size when receiving.
      * \param useIpv6 Use IPv6 instead of IPv4.
+     * \param useOffload Use the TCP segmentation and receive offloads.
+     * \param mtu MTU of the devices when using the offloads.
      */
     TcpTestCase(uint32_t totalStreamSize,
                 uint32_t sourceWriteSize,
                 uint32_t sourceReadSize,
                 uint32_t serverWriteSize,
                 uint32_t serverReadSize,
-                bool useIpv6);
+                bool useIpv6,
+                bool useOffload,
+                uint16_t mtu = 1500);
 
   private:
     void DoRun() override;
@@ -147,6 +154,34 @@ class TcpTestCase : public TestCase
      * \param sock The socket.
      */
     void SourceHandleRecv(Ptr<Socket> sock);
+    /**
+     * \brief Client: Packet sent to IP.
+     * \param p The packet.
+     * \param header The TCP header.
+     * \param socket The socket.
+     */
+    void SourceTx(Ptr<const Packet> p, const TcpHeader& header, Ptr<const TcpSocketBase> socket);
+    /**
+     * \brief Server: Packet received from IP.
+     * \param p The packet.
+     * \param header The TCP header.
+     * \param socket The socket.
+     */
+    void ServerRx(Ptr<const Packet> p, const TcpHeader& header, Ptr<const TcpSocketBase> socket);
+    /**
+     * \brief Server: IPv4 packet received from a device.
+     * \param p The packet.
+     * \param ipv4 The IPv4 protocol.
+     * \param interface The interface index.
+     */
+    void ServerIpv4Rx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
+    /**
+     * \brief Client: IPv4 packet sent to a device.
+     * \param p The packet.
+     * \param ipv4 The IPv4 protocol.
+     * \param interface The interface index.
+     */
+    void SourceIpv4Tx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface);
 
     uint32_t m_totalBytes;           //!< Total stream size (in bytes).
     uint32_t m_sourceWriteSize;      //!< Client data size when sending.
@@ -161,7 +196,14 @@ class TcpTestCase : public TestCase
     uint8_t* m_sourceRxPayload;      //!< Client Rx payload.
     uint8_t* m_serverRxPayload;      //!< Server Rx payload.
 
-    bool m_useIpv6; //!< Use IPv6 instead of IPv4.
+    bool m_useIpv6;    //!< Use IPv6 instead of IPv4.
+    bool m_useOffload; //!< Use the TCP segmentation and receive offloads.
+    uint16_t m_mtu;    //!< MTU of the devices when using the offloads.
+
+    uint32_t m_maxSourceTxSize{0}; //!< Largest packet sent by the client TCP to IP.
+    uint32_t m_maxSourceIpv4TxSize{0}; //!< Largest packet sent by the client IP to a device.
+    uint32_t m_maxServerRxSize{0}; //!< Largest packet received by the server TCP from IP.
+    uint32_t m_serverRxFragments{0}; //!< IPv4 fragments received by the server.
 };
 
 static std::string
@@ -171,12 +213,19 @@ Name(std::string str,
      uint32_t serverReadSize,
      uint32_t serverWriteSize,
      uint32_t sourceReadSize,
-     bool useIpv6)
+     bool useIpv6,
+     bool useOffload,
+     uint16_t mtu)
 {
     std::ostringstream oss;
     oss << str << " total=" << totalStreamSize << " sourceWrite=" << sourceWriteSize
         << " sourceRead=" << sourceReadSize << " serverRead=" << serverReadSize
-        << " serverWrite=" << serverWriteSize << " useIpv6=" << useIpv6;
+        << " serverWrite=" << serverWriteSize << " useIpv6=" << useIpv6
+        << " useOffload=" << useOffload;
+    if (useOffload)
+    {
+        oss << " mtu=" << mtu;
+    }
     return oss.str();
 }
 
@@ -193,20 +242,26 @@ TcpTestCase::TcpTestCase(uint32_t totalStreamSize,
                          uint32_t sourceReadSize,
                          uint32_t serverWriteSize,
                          uint32_t serverReadSize,
-                         bool useIpv6)
+                         bool useIpv6,
+                         bool useOffload,
+                         uint16_t mtu)
     : TestCase(Name("Send string data from client to server and back",
                     totalStreamSize,
                     sourceWriteSize,
                     serverReadSize,
                     serverWriteSize,
                     sourceReadSize,
-                    useIpv6)),
+                    useIpv6,
+                    useOffload,
+                    mtu)),
       m_totalBytes(totalStreamSize),
       m_sourceWriteSize(sourceWriteSize),
       m_sourceReadSize(sourceReadSize),
       m_serverWriteSize(serverWriteSize),
       m_serverReadSize(serverReadSize),
-      m_useIpv6(useIpv6)
+      m_useIpv6(useIpv6),
+      m_useOffload(useOffload),
+      m_mtu(mtu)
 {
 }
 
@@ -248,6 +303,28 @@ TcpTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(memcmp(m_sourceTxPayload, m_sourceRxPayload, m_totalBytes),
                           0,
                           "Source received back expected data buffers");
+
+    if (m_useOffload && m_mtu >= 1448 + 40)
+    {
+        // The super-segments are larger than the MTU of the devices, and are
+        // split into segments by the traffic control layer instead of being
+        // fragmented
+        NS_TEST_EXPECT_MSG_GT(m_maxSourceTxSize, m_mtu, "Source sent no super-segment");
+        NS_TEST_EXPECT_MSG_GT(m_maxSourceIpv4TxSize, m_mtu, "Source IP split super-segments");
+        NS_TEST_EXPECT_MSG_GT(m_maxServerRxSize, m_mtu, "Server coalesced no segment");
+        NS_TEST_EXPECT_MSG_EQ(m_serverRxFragments, 0, "Server received IPv4 fragments");
+    }
+    else if (m_useOffload)
+    {
+        // The segments are larger than the MTU of the devices, hence the
+        // super-segments are split into segments by the IP layer, which
+        // fragments them as without the offloads
+        NS_TEST_EXPECT_MSG_GT(m_maxSourceTxSize, m_mtu, "Source sent no super-segment");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(m_maxSourceIpv4TxSize,
+                                    m_mtu,
+                                    "Source IP sent a packet larger than the MTU");
+        NS_TEST_EXPECT_MSG_GT(m_serverRxFragments, 0, "Server received no IPv4 fragment");
+    }
 }
 
 void
@@ -264,6 +341,7 @@ TcpTestCase::ServerHandleConnectionCreated(Ptr<Socket> s, const Address& addr)
 {
     s->SetRecvCallback(MakeCallback(&TcpTestCase::ServerHandleRecv, this));
     s->SetSendCallback(MakeCallback(&TcpTestCase::ServerHandleSend, this));
+    s->TraceConnectWithoutContext("Rx", MakeCallback(&TcpTestCase::ServerRx, this));
 }
 
 void
@@ -323,6 +401,35 @@ TcpTestCase::SourceHandleSend(Ptr<Socket> sock, uint32_t available)
     }
 }
 
+void
+TcpTestCase::SourceTx(Ptr<const Packet> p, const TcpHeader& header, Ptr<const TcpSocketBase> socket)
+{
+    m_maxSourceTxSize = std::max(m_maxSourceTxSize, p->GetSize());
+}
+
+void
+TcpTestCase::ServerRx(Ptr<const Packet> p, const TcpHeader& header, Ptr<const TcpSocketBase> socket)
+{
+    m_maxServerRxSize = std::max(m_maxServerRxSize, p->GetSize());
+}
+
+void
+TcpTestCase::SourceIpv4Tx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    m_maxSourceIpv4TxSize = std::max(m_maxSourceIpv4TxSize, p->GetSize());
+}
+
+void
+TcpTestCase::ServerIpv4Rx(Ptr<const Packet> p, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+    Ipv4Header header;
+    p->PeekHeader(header);
+    if (!header.IsLastFragment() || header.GetFragmentOffset() != 0)
+    {
+        m_serverRxFragments++;
+    }
+}
+
 void
 TcpTestCase::SourceHandleRecv(Ptr<Socket> sock)
 {
@@ -413,6 +520,34 @@ TcpTestCase::SetupDefaultSim()
     Ptr<Socket> server = sockFactory0->CreateSocket();
     Ptr<Socket> source = sockFactory1->CreateSocket();
 
+    if (m_useOffload)
+    {
+        // The devices have no data rate, hence the segments of a super-segment
+        // are received within the flush timeout and coalesced
+        for (const auto& dev : {dev0, dev1})
+        {
+            dev->SetMtu(m_mtu);
+        }
+        for (const auto& node : {node0, node1})
+        {
+            Ptr<TcpL4Protocol> tcp = node->GetObject<TcpL4Protocol>();
+            tcp->SetAttribute("Gro", BooleanValue(true));
+            tcp->SetAttribute("GroFlushTimeout", TimeValue(MicroSeconds(100)));
+        }
+        for (const auto& socket : {server, source})
+        {
+            socket->SetAttribute("SegmentSize", UintegerValue(1448));
+            socket->SetAttribute("Tso", BooleanValue(true));
+        }
+        source->TraceConnectWithoutContext("Tx", MakeCallback(&TcpTestCase::SourceTx, this));
+        node0->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext(
+            "Rx",
+            MakeCallback(&TcpTestCase::ServerIpv4Rx, this));
+        node1->GetObject<Ipv4L3Protocol>()->TraceConnectWithoutContext(
+            "Tx",
+            MakeCallback(&TcpTestCase::SourceIpv4Tx, this));
+    }
+
     uint16_t port = 50000;
     InetSocketAddress serverlocaladdr(Ipv4Address::GetAny(), port);
     InetSocketAddress serverremoteaddr(Ipv4Address(ipaddr0), port);
@@ -551,14 +686,22 @@ class TcpTestSuite : public TestSuite
         // Arguments to these test cases are 1) totalStreamSize,
         // 2) source write size, 3) source read size
         // 4) server write size, and 5) server read size
-        // with units of bytes
-        AddTestCase(new TcpTestCase(13, 200, 200, 200, 200, false), TestCase::QUICK);
-        AddTestCase(new TcpTestCase(13, 1, 1, 1, 1, false), TestCase::QUICK);
-        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, false), TestCase::QUICK);
-
-        AddTestCase(new TcpTestCase(13, 200, 200, 200, 200, true), TestCase::QUICK);
-        AddTestCase(new TcpTestCase(13, 1, 1, 1, 1, true), TestCase::QUICK);
-        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, true), TestCase::QUICK);
+        // with units of bytes, 6) whether to use IPv6, 7) whether to
+        // use the TCP segmentation and receive offloads and 8) the MTU of
+        // the devices when using them
+        AddTestCase(new TcpTestCase(13, 200, 200, 200, 200, false, false), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(13, 1, 1, 1, 1, false, false), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, false, false), TestCase::QUICK);
+
+        AddTestCase(new TcpTestCase(13, 200, 200, 200, 200, true, false), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(13, 1, 1, 1, 1, true, false), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, true, false), TestCase::QUICK);
+
+        AddTestCase(new TcpTestCase(100000, 100, 50, 100, 20, false, true), TestCase::QUICK);
+        AddTestCase(new TcpTestCase(1000000, 5000, 5000, 5000, 5000, false, true),
+                    TestCase::QUICK);
+        AddTestCase(new TcpTestCase(1000000, 5000, 5000, 5000, 5000, false, true, 1000),
+                    TestCase::QUICK);
     }
 };
 
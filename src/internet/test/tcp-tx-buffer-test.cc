@@ -17,11 +17,13 @@
 
 #include "ns3/log.h"
 #include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
 #include "ns3/tcp-tx-buffer.h"
 #include "ns3/test.h"
 
 #include <limits>
+#include <vector>
 
 using namespace ns3;
 
@@ -54,6 +56,8 @@ class TcpTxBufferTestCase : public TestCase
     /** \brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** \brief Test the scoreboard against a model of the segment flags, with random SACKs */
+    void TestScoreboard();
     /**
      * \brief Callback to provide a value of receiver window
      * \returns the receiver window size
@@ -101,6 +105,12 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Random SACK blocks, retransmissions and cumulative ACKs over many
+     * segments in flight, checked against the expected flags of each segment.
+     */
+    Simulator::Schedule(Seconds(0.0), &TcpTxBufferTestCase::TestScoreboard, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -421,6 +431,175 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestScoreboard()
+{
+    const uint32_t numSegments = 500;
+    const uint32_t segmentSize = 100;
+    const uint32_t dupThresh = 3;
+    const SequenceNumber32 head(1);
+
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(head);
+    txBuf->SetSegmentSize(segmentSize);
+    txBuf->SetDupAckThresh(dupThresh);
+    txBuf->SetMaxBufferSize(numSegments * segmentSize);
+    txBuf->Add(Create<Packet>(numSegments * segmentSize));
+    for (uint32_t i = 0; i < numSegments; ++i)
+    {
+        txBuf->CopyFromSequence(segmentSize, head + i * segmentSize);
+    }
+
+    // Expected flags of the segments; the segments before first are acked
+    std::vector<bool> sacked(numSegments, false);
+    std::vector<bool> lost(numSegments, false);
+    std::vector<bool> retrans(numSegments, false);
+    uint32_t first = 0;
+    uint32_t highestSack = 0; // index of the highest sacked segment, if any
+    bool hasHighestSack = false;
+
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(1);
+
+    for (uint32_t round = 0; round < 400 && first < numSegments; ++round)
+    {
+        // SACK up to three random blocks of segments
+        TcpOptionSack::SackList list;
+        uint32_t numBlocks = rand->GetInteger(1, 3);
+        bool newlySacked = false;
+        for (uint32_t b = 0; b < numBlocks; ++b)
+        {
+            uint32_t start = rand->GetInteger(first + 1, numSegments);
+            uint32_t end = std::min(start + rand->GetInteger(1, 4), numSegments);
+            if (start >= end)
+            {
+                continue;
+            }
+            list.emplace_back(head + start * segmentSize, head + end * segmentSize);
+            for (uint32_t i = start; i < end; ++i)
+            {
+                if (!sacked[i])
+                {
+                    sacked[i] = true;
+                    lost[i] = false;
+                    newlySacked = true;
+                    if (!hasHighestSack || i >= highestSack)
+                    {
+                        highestSack = i;
+                        hasHighestSack = true;
+                    }
+                }
+            }
+        }
+        txBuf->Update(list);
+
+        if (newlySacked)
+        {
+            // the segments below the dupThresh-th highest sacked one are lost
+            uint32_t count = 0;
+            for (uint32_t i = highestSack; i > first && count < dupThresh; --i)
+            {
+                if (sacked[i] && ++count == dupThresh)
+                {
+                    for (uint32_t j = first; j < i; ++j)
+                    {
+                        lost[j] = lost[j] || !sacked[j];
+                    }
+                }
+            }
+        }
+
+        // Retransmit the first lost segment
+        uint32_t nextLost = numSegments;
+        for (uint32_t i = first; i < numSegments && nextLost == numSegments; ++i)
+        {
+            if (lost[i] && !retrans[i] && !sacked[i])
+            {
+                nextLost = i;
+            }
+        }
+        SequenceNumber32 seq;
+        SequenceNumber32 seqHigh;
+        bool found = txBuf->NextSeg(&seq, &seqHigh, false);
+        NS_TEST_ASSERT_MSG_EQ(found, (nextLost < numSegments), "Wrong NextSeg in round " << round);
+        if (found)
+        {
+            NS_TEST_ASSERT_MSG_EQ(seq, head + nextLost * segmentSize, "Wrong NextSeg");
+            if (rand->GetValue() < 0.5)
+            {
+                txBuf->CopyFromSequence(segmentSize, seq);
+                retrans[nextLost] = true;
+            }
+        }
+
+        // Sometimes, ACK the head and the sacked segments that follow it
+        if (round % 10 == 9)
+        {
+            uint32_t ack = first + 1;
+            while (ack < numSegments && sacked[ack])
+            {
+                ++ack;
+            }
+            first = ack;
+            txBuf->DiscardUpTo(head + first * segmentSize);
+            if (hasHighestSack && highestSack < first)
+            {
+                hasHighestSack = false;
+            }
+        }
+
+        // Check the counters and the flags of each segment
+        uint32_t sackedOut = 0;
+        uint32_t lostOut = 0;
+        uint32_t retransOut = 0;
+        for (uint32_t i = first; i < numSegments; ++i)
+        {
+            sackedOut += sacked[i] ? segmentSize : 0;
+            lostOut += lost[i] ? segmentSize : 0;
+            retransOut += retrans[i] ? segmentSize : 0;
+
+            bool isLost = false;
+            if (hasHighestSack && i < highestSack)
+            {
+                uint32_t j = i;
+                while (j < numSegments && !lost[j] && !sacked[j])
+                {
+                    ++j;
+                }
+                isLost = j < numSegments && lost[j];
+            }
+            NS_TEST_ASSERT_MSG_EQ(txBuf->IsLost(head + i * segmentSize),
+                                  isLost,
+                                  "Wrong IsLost for segment " << i << " in round " << round);
+        }
+        NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), sackedOut, "Wrong sacked bytes");
+        NS_TEST_ASSERT_MSG_EQ(txBuf->GetLost(), lostOut, "Wrong lost bytes");
+        NS_TEST_ASSERT_MSG_EQ(txBuf->GetRetransmitsCount(),
+                              retransOut,
+                              "Wrong retransmitted bytes");
+        NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(),
+                              (numSegments - first) * segmentSize - sackedOut - lostOut +
+                                  retransOut,
+                              "Wrong bytes in flight");
+    }
+
+    // In recovery, NextSeg returns the first segment neither marked nor retransmitted
+    // when no segment is lost
+    txBuf->SetSentListLost();
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    while (txBuf->NextSeg(&seq, &seqHigh, true))
+    {
+        txBuf->CopyFromSequence(segmentSize, seq);
+    }
+    NS_TEST_ASSERT_MSG_EQ(txBuf->BytesInFlight(),
+                          txBuf->GetRetransmitsCount(),
+                          "Wrong bytes in flight after retransmitting everything");
+    txBuf->ResetRenoSack();
+    NS_TEST_ASSERT_MSG_EQ(txBuf->GetSacked(), 0, "Sacked bytes after resetting the SACKs");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
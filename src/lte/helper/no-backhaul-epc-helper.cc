@@ -37,6 +37,7 @@
 #include "ns3/lte-ue-net-device.h"
 #include "ns3/packet-socket-address.h"
 #include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
 #include "ns3/string.h"
 
 namespace ns3
@@ -198,23 +198,25 @@ LteInterference::ConditionallyEvaluateChunk()
         NS_LOG_LOGIC(this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals
                           << " noise = " << *m_noise);
 
-        SpectrumValue interf = (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-
-        SpectrumValue sinr = (*m_rxSignal) / interf;
+        // interf = allSignals - rxSignal + noise and sinr = rxSignal / interf are
+        // computed in the buffers of the previous chunk to avoid temporary objects
+        m_interf = *m_noise;
+        m_interf.AddDifference(*m_allSignals, *m_rxSignal);
+        m_sinr.SetRatio(*m_rxSignal, m_interf);
         Time duration = Now() - m_lastChangeTime;
         for (std::list<Ptr<LteChunkProcessor>>::const_iterator it =
                  m_sinrChunkProcessorList.begin();
              it != m_sinrChunkProcessorList.end();
              ++it)
         {
-            (*it)->EvaluateChunk(sinr, duration);
+            (*it)->EvaluateChunk(m_sinr, duration);
         }
         for (std::list<Ptr<LteChunkProcessor>>::const_iterator it =
                  m_interfChunkProcessorList.begin();
              it != m_interfChunkProcessorList.end();
              ++it)
         {
-            (*it)->EvaluateChunk(interf, duration);
+            (*it)->EvaluateChunk(m_interf, duration);
         }
         for (std::list<Ptr<LteChunkProcessor>>::const_iterator it =
                  m_rsPowerChunkProcessorList.begin();
@@ -147,4 +147,10 @@ QueueDiscItem::Hash(uint32_t perturbation) const
     return 0;
 }
 
+bool
+QueueDiscItem::Segment(std::vector<Ptr<QueueDiscItem>>& segments) const
+{
+    return false;
+}
+
 } // namespace ns3
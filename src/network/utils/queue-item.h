@@ -25,6 +25,8 @@
 #include "ns3/simple-ref-count.h"
 #include <ns3/address.h>
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -218,6 +220,18 @@ class QueueDiscItem : public QueueItem
      */
     virtual uint32_t Hash(uint32_t perturbation = 0) const;
 
+    /**
+     * \brief Split a super-segment built by a segmentation offload into packets
+     *
+     * This method just returns false, as the item holds a single packet. Subclasses
+     * holding super-segments, such as the TCP super-segments built when the TCP
+     * segmentation offload is enabled, create an item per packet to transmit.
+     *
+     * \param segments the vector to which the items of the packets are appended
+     * \return true if the item has been split, false otherwise
+     */
+    virtual bool Segment(std::vector<Ptr<QueueDiscItem>>& segments) const;
+
   private:
     Address m_address;   //!< MAC destination address
     uint16_t m_protocol; //!< L3 Protocol number
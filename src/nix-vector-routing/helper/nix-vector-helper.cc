@@ -27,6 +27,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/nix-vector-routing.h"
+#include "ns3/simulator.h"
 
 namespace ns3
 {
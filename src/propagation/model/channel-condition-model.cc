@@ -26,6 +26,7 @@
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <cmath>
 
@@ -333,7 +334,22 @@ ThreeGppChannelConditionModel::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(
                               &ThreeGppChannelConditionModel::m_linkO2iConditionToAntennaHeight),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("CacheMaxSize",
+                          "The maximum number of channel conditions kept in the cache (0 for no "
+                          "limit). When the limit is reached, the least recently used channel "
+                          "condition is evicted and it is computed again if needed.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelConditionModel::SetCacheMaxSize,
+                                               &ThreeGppChannelConditionModel::GetCacheMaxSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheMaxAge",
+                          "The maximum time a channel condition is kept in the cache without "
+                          "being used (zero for no limit).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ThreeGppChannelConditionModel::SetCacheMaxAge,
+                                           &ThreeGppChannelConditionModel::GetCacheMaxAge),
+                          MakeTimeChecker());
     return tid;
 }
 
@@ -355,7 +371,7 @@ ThreeGppChannelConditionModel::~ThreeGppChannelConditionModel()
 void
 ThreeGppChannelConditionModel::DoDispose()
 {
-    m_channelConditionMap.clear();
+    m_channelConditionMap.Clear();
     m_updatePeriod = Seconds(0.0);
 }
 
@@ -372,15 +388,15 @@ ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
     bool update = false;   // indicates if the channel condition has to be updated
 
     // look for the channel condition in m_channelConditionMap
-    auto mapItem = m_channelConditionMap.find(key);
-    if (mapItem != m_channelConditionMap.end())
+    Item* mapItem = m_channelConditionMap.Find(key);
+    if (mapItem)
     {
         NS_LOG_DEBUG("found the channel condition in the map");
-        cond = mapItem->second.m_condition;
+        cond = mapItem->m_condition;
 
         // check if it has to be updated
         if (!m_updatePeriod.IsZero() &&
-            Simulator::Now() - mapItem->second.m_generatedTime > m_updatePeriod)
+            Simulator::Now() - mapItem->m_generatedTime > m_updatePeriod)
         {
             NS_LOG_DEBUG("it has to be updated");
             update = true;
@@ -397,12 +413,18 @@ ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
     if (notFound || update)
     {
         cond = ComputeChannelCondition(a, b);
-        // store the channel condition in m_channelConditionMap, used as cache.
-        // For this reason you see a const_cast.
-        Item mapItem;
-        mapItem.m_condition = cond;
-        mapItem.m_generatedTime = Simulator::Now();
-        const_cast<ThreeGppChannelConditionModel*>(this)->m_channelConditionMap[key] = mapItem;
+        // store the channel condition in m_channelConditionMap, used as cache
+        Item newItem;
+        newItem.m_condition = cond;
+        newItem.m_generatedTime = Simulator::Now();
+        if (update)
+        {
+            *mapItem = newItem;
+        }
+        else
+        {
+            m_channelConditionMap.Insert(key, newItem);
+        }
     }
 
     return cond;
@@ -526,6 +548,38 @@ ThreeGppChannelConditionModel::Calculate2dDistance(const Vector& a, const Vector
     return distance2D;
 }
 
+void
+ThreeGppChannelConditionModel::SetCacheMaxSize(uint32_t maxSize)
+{
+    NS_LOG_FUNCTION(this << maxSize);
+    m_channelConditionMap.SetMaxSize(maxSize);
+}
+
+uint32_t
+ThreeGppChannelConditionModel::GetCacheMaxSize() const
+{
+    return m_channelConditionMap.GetMaxSize();
+}
+
+void
+ThreeGppChannelConditionModel::SetCacheMaxAge(Time maxAge)
+{
+    NS_LOG_FUNCTION(this << maxAge);
+    m_channelConditionMap.SetMaxAge(maxAge);
+}
+
+Time
+ThreeGppChannelConditionModel::GetCacheMaxAge() const
+{
+    return m_channelConditionMap.GetMaxAge();
+}
+
+const PropagationCacheStatistics&
+ThreeGppChannelConditionModel::GetCacheStatistics() const
+{
+    return m_channelConditionMap.GetStatistics();
+}
+
 uint32_t
 ThreeGppChannelConditionModel::GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
 {
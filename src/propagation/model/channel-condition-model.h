@@ -22,10 +22,10 @@
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/propagation-cache.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/vector.h"
 
-#include <unordered_map>
 
 namespace ns3
 {
@@ -484,6 +484,11 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
      */
     int64_t AssignStreams(int64_t stream) override;
 
+    /**
+     * \return the statistics about the accesses to the cache of the channel conditions
+     */
+    const PropagationCacheStatistics& GetCacheStatistics() const;
+
   protected:
     void DoDispose() override;
 
@@ -565,8 +570,30 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
         Time m_generatedTime;              //!< the time when the condition was generated
     };
 
-    std::unordered_map<uint32_t, Item>
-        m_channelConditionMap; //!< map to store the channel conditions
+    /**
+     * Set the maximum number of channel conditions in the cache
+     * \param maxSize the maximum number of channel conditions (0 for no limit)
+     */
+    void SetCacheMaxSize(uint32_t maxSize);
+
+    /**
+     * \return the maximum number of channel conditions in the cache (0 for no limit)
+     */
+    uint32_t GetCacheMaxSize() const;
+
+    /**
+     * Set the maximum time a channel condition is kept in the cache without being used
+     * \param maxAge the maximum age (zero for no limit)
+     */
+    void SetCacheMaxAge(Time maxAge);
+
+    /**
+     * \return the maximum time a channel condition is kept in the cache without being used
+     */
+    Time GetCacheMaxAge() const;
+
+    mutable PropagationLruCache<uint32_t, Item>
+        m_channelConditionMap; //!< cache storing the channel conditions
     Time m_updatePeriod;       //!< the update period for the channel condition
 
     double m_o2iThreshold{
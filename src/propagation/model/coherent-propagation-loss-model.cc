@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "coherent-propagation-loss-model.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CoherentPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CoherentPropagationLossModel);
+
+TypeId
+CoherentPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CoherentPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CoherentPropagationLossModel>()
+            .AddAttribute("PropagationLossModel",
+                          "The wrapped propagation loss model, which may be a chain of models.",
+                          PointerValue(),
+                          MakePointerAccessor(
+                              &CoherentPropagationLossModel::SetPropagationLossModel,
+                              &CoherentPropagationLossModel::GetPropagationLossModel),
+                          MakePointerChecker<PropagationLossModel>())
+            .AddAttribute("DistanceThreshold",
+                          "The loss of a path is computed again when the source or the "
+                          "destination has moved by more than this distance (m) from the "
+                          "position where the stored loss was computed.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&CoherentPropagationLossModel::m_distanceThreshold),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("CoherenceTime",
+                          "The loss of a path is computed again when this time has elapsed "
+                          "since the stored loss was computed (zero for no limit).",
+                          TimeValue(MilliSeconds(10)),
+                          MakeTimeAccessor(&CoherentPropagationLossModel::SetCoherenceTime,
+                                           &CoherentPropagationLossModel::GetCoherenceTime),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("CacheMaxSize",
+                          "The maximum number of paths whose loss is stored (0 for no limit). "
+                          "When the limit is reached, the least recently used loss is evicted.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&CoherentPropagationLossModel::SetCacheMaxSize,
+                                               &CoherentPropagationLossModel::GetCacheMaxSize),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+CoherentPropagationLossModel::CoherentPropagationLossModel()
+    : m_distanceThreshold(0.0),
+      m_nCalculations(0),
+      m_nReuses(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CoherentPropagationLossModel::~CoherentPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CoherentPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_cache.Clear();
+    if (m_model)
+    {
+        m_model->Dispose();
+        m_model = nullptr;
+    }
+    PropagationLossModel::DoDispose();
+}
+
+void
+CoherentPropagationLossModel::SetPropagationLossModel(Ptr<PropagationLossModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_model = model;
+    m_cache.Clear();
+}
+
+Ptr<PropagationLossModel>
+CoherentPropagationLossModel::GetPropagationLossModel() const
+{
+    return m_model;
+}
+
+void
+CoherentPropagationLossModel::SetCoherenceTime(Time coherenceTime)
+{
+    NS_LOG_FUNCTION(this << coherenceTime);
+    m_coherenceTime = coherenceTime;
+    // a loss not used for longer than the coherence time cannot be reused
+    m_cache.SetMaxAge(coherenceTime);
+}
+
+Time
+CoherentPropagationLossModel::GetCoherenceTime() const
+{
+    return m_coherenceTime;
+}
+
+void
+CoherentPropagationLossModel::SetCacheMaxSize(uint32_t maxSize)
+{
+    m_cache.SetMaxSize(maxSize);
+}
+
+uint32_t
+CoherentPropagationLossModel::GetCacheMaxSize() const
+{
+    return m_cache.GetMaxSize();
+}
+
+uint64_t
+CoherentPropagationLossModel::GetNCalculations() const
+{
+    return m_nCalculations;
+}
+
+uint64_t
+CoherentPropagationLossModel::GetNReuses() const
+{
+    return m_nReuses;
+}
+
+bool
+CoherentPropagationLossModel::IsCoherent(const PathLoss& pathLoss) const
+{
+    if (m_coherenceTime.IsStrictlyPositive() &&
+        Simulator::Now() - pathLoss.m_calculationTime >= m_coherenceTime)
+    {
+        return false;
+    }
+    // compare the squared distances to avoid computing the square roots
+    double threshold2 = m_distanceThreshold * m_distanceThreshold;
+    Vector aDelta = pathLoss.m_a->GetPosition() - pathLoss.m_aPosition;
+    Vector bDelta = pathLoss.m_b->GetPosition() - pathLoss.m_bPosition;
+    return (aDelta.x * aDelta.x + aDelta.y * aDelta.y + aDelta.z * aDelta.z <= threshold2) &&
+           (bDelta.x * bDelta.x + bDelta.y * bDelta.y + bDelta.z * bDelta.z <= threshold2);
+}
+
+double
+CoherentPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                            Ptr<MobilityModel> a,
+                                            Ptr<MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << a << b);
+    NS_ASSERT_MSG(m_model, "No propagation loss model has been wrapped");
+
+    PathKey key(PeekPointer(a), PeekPointer(b));
+    PathLoss* pathLoss = m_cache.Find(key);
+    if (pathLoss && IsCoherent(*pathLoss))
+    {
+        m_nReuses++;
+        NS_LOG_DEBUG("Reusing the loss computed at " << pathLoss->m_calculationTime.As(Time::S)
+                                                     << ": " << pathLoss->m_lossDb << " dB");
+        return txPowerDbm - pathLoss->m_lossDb;
+    }
+
+    if (!pathLoss)
+    {
+        // the stored mobility models keep the addresses used as key valid
+        PathLoss newPathLoss;
+        newPathLoss.m_a = a;
+        newPathLoss.m_b = b;
+        pathLoss = &m_cache.Insert(key, newPathLoss);
+    }
+    m_nCalculations++;
+    pathLoss->m_aPosition = a->GetPosition();
+    pathLoss->m_bPosition = b->GetPosition();
+    pathLoss->m_calculationTime = Simulator::Now();
+    pathLoss->m_lossDb = txPowerDbm - m_model->CalcRxPower(txPowerDbm, a, b);
+    NS_LOG_DEBUG("Computed a loss of " << pathLoss->m_lossDb << " dB");
+    return txPowerDbm - pathLoss->m_lossDb;
+}
+
+int64_t
+CoherentPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COHERENT_PROPAGATION_LOSS_MODEL_H
+#define COHERENT_PROPAGATION_LOSS_MODEL_H
+
+#include "ns3/propagation-cache.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/vector.h"
+
+#include <utility>
+
+namespace ns3
+{
+
+/**
+ * \ingroup propagation
+ *
+ * \brief A wrapper reusing the loss computed by another propagation loss model
+ * while the nodes move slowly.
+ *
+ * The loss computed by the wrapped model (which may be a chain of models) for
+ * a pair of nodes is stored and reused for that pair until the transmitter or
+ * the receiver has moved by more than the DistanceThreshold from the position
+ * where the loss was computed, or until the CoherenceTime has elapsed since the
+ * loss was computed, whichever comes first. This avoids computing distances,
+ * logarithms and random fading gains again for every packet exchanged by nodes
+ * that moved only a few millimetres. The loss of the path a-->b is stored
+ * separately from the loss of the path b-->a.
+ *
+ * The loss is taken as the difference between the transmission power and the
+ * power returned by the wrapped model, hence the wrapped model must not depend
+ * on the transmission power (see PropagationLossModel::SetNext). Models chained
+ * after this one (with SetNext) are evaluated for every call.
+ *
+ * Random models wrapped by this model (e.g., NakagamiPropagationLossModel) draw
+ * a new value only when the loss is computed again, hence the values drawn for
+ * a given call differ from the values that the same model would draw if it was
+ * not wrapped. The draws only depend on the sequence of calls, though, and
+ * AssignStreams forwards the stream indices to the wrapped model, hence the
+ * results are reproducible across runs with the same seed, run number and
+ * stream assignment.
+ */
+class CoherentPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CoherentPropagationLossModel();
+    ~CoherentPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CoherentPropagationLossModel(const CoherentPropagationLossModel&) = delete;
+    CoherentPropagationLossModel& operator=(const CoherentPropagationLossModel&) = delete;
+
+    /**
+     * Set the wrapped propagation loss model and discard the stored losses.
+     *
+     * \param model the wrapped propagation loss model
+     */
+    void SetPropagationLossModel(Ptr<PropagationLossModel> model);
+
+    /**
+     * \return the wrapped propagation loss model
+     */
+    Ptr<PropagationLossModel> GetPropagationLossModel() const;
+
+    /**
+     * \return the number of times the loss has been computed by the wrapped model
+     */
+    uint64_t GetNCalculations() const;
+
+    /**
+     * \return the number of times a stored loss has been reused
+     */
+    uint64_t GetNReuses() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /**
+     * Set the coherence time, which also bounds the time a loss is kept in the
+     * cache without being used.
+     *
+     * \param coherenceTime the coherence time (zero for no limit)
+     */
+    void SetCoherenceTime(Time coherenceTime);
+
+    /**
+     * \return the coherence time (zero for no limit)
+     */
+    Time GetCoherenceTime() const;
+
+    /**
+     * Set the maximum number of paths whose loss is stored.
+     * \param maxSize the maximum number of paths (0 for no limit)
+     */
+    void SetCacheMaxSize(uint32_t maxSize);
+
+    /**
+     * \return the maximum number of paths whose loss is stored (0 for no limit)
+     */
+    uint32_t GetCacheMaxSize() const;
+
+    /// The loss stored for a path
+    struct PathLoss
+    {
+        Ptr<MobilityModel> m_a;    //!< the mobility model of the source
+        Ptr<MobilityModel> m_b;    //!< the mobility model of the destination
+        Vector m_aPosition;        //!< the position of the source when the loss was computed
+        Vector m_bPosition;        //!< the position of the destination when the loss was computed
+        Time m_calculationTime;    //!< the time when the loss was computed
+        double m_lossDb;           //!< the loss (dB)
+    };
+
+    /// A path, identified by the mobility models of its source and destination
+    using PathKey = std::pair<const MobilityModel*, const MobilityModel*>;
+
+    /// Hash function for PathKey
+    struct PathKeyHash
+    {
+        /**
+         * \param key the path
+         * \return the hash of the path
+         */
+        std::size_t operator()(const PathKey& key) const
+        {
+            std::hash<const MobilityModel*> hasher;
+            std::size_t h = hasher(key.first);
+            return h ^ (hasher(key.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+        }
+    };
+
+    /**
+     * \param pathLoss the loss stored for a path
+     * \return whether the stored loss can still be used
+     */
+    bool IsCoherent(const PathLoss& pathLoss) const;
+
+    Ptr<PropagationLossModel> m_model; //!< the wrapped propagation loss model
+    double m_distanceThreshold;        //!< maximum displacement of the nodes (m)
+    Time m_coherenceTime;              //!< maximum time a loss is reused
+    mutable PropagationLruCache<PathKey, PathLoss, PathKeyHash> m_cache; //!< stored losses
+    mutable uint64_t m_nCalculations; //!< number of losses computed by the wrapped model
+    mutable uint64_t m_nReuses;       //!< number of stored losses reused
+};
+
+} // namespace ns3
+
+#endif /* COHERENT_PROPAGATION_LOSS_MODEL_H */
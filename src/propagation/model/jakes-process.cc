@@ -23,34 +23,32 @@
 #include "jakes-propagation-loss-model.h"
 #include "propagation-loss-model.h"
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("JakesProcess");
 
-/// Represents a single oscillator
-JakesProcess::Oscillator::Oscillator(std::complex<double> amplitude,
-                                     double initialPhase,
-                                     double omega)
-    : m_amplitude(amplitude),
-      m_phase(initialPhase),
-      m_omega(omega)
-{
-}
+NS_OBJECT_ENSURE_REGISTERED(JakesProcess);
 
-std::complex<double>
-JakesProcess::Oscillator::GetValueAt(Time at) const
+/**
+ * \param complexGain the channel complex gain
+ * \return the channel gain [dB]
+ */
+static double
+GetGainDb(std::complex<double> complexGain)
 {
-    return (m_amplitude * std::cos(at.GetSeconds() * m_omega + m_phase));
+    return (10 *
+            std::log10((std::pow(complexGain.real(), 2) + std::pow(complexGain.imag(), 2)) / 2));
 }
 
-NS_OBJECT_ENSURE_REGISTERED(JakesProcess);
-
 TypeId
 JakesProcess::GetTypeId()
 {
@@ -67,7 +65,14 @@ JakesProcess::GetTypeId()
                                           "The number of oscillators",
                                           UintegerValue(20),
                                           MakeUintegerAccessor(&JakesProcess::SetNOscillators),
-                                          MakeUintegerChecker<unsigned int>(4, 1000));
+                                          MakeUintegerChecker<unsigned int>(4, 1000))
+                            .AddAttribute("IncrementalUpdate",
+                                          "If true, the phases of the oscillators are rotated by "
+                                          "the time elapsed since the last evaluation rather "
+                                          "than computed from scratch at every evaluation.",
+                                          BooleanValue(false),
+                                          MakeBooleanAccessor(&JakesProcess::m_incremental),
+                                          MakeBooleanChecker());
     return tid;
 }
 
@@ -102,7 +107,7 @@ JakesProcess::ConstructOscillators()
 {
     NS_ASSERT(m_jakes);
     // Initial phase is common for all oscillators:
-    double phi = m_jakes->GetUniformRandomVariable()->GetValue();
+    m_phase = m_jakes->GetUniformRandomVariable()->GetValue();
     // Theta is common for all oscillators:
     double theta = m_jakes->GetUniformRandomVariable()->GetValue();
     for (unsigned int i = 0; i < m_nOscillators; i++)
@@ -119,19 +124,25 @@ JakesProcess::ConstructOscillators()
         std::complex<double> amplitude =
             std::complex<double>(std::cos(psi), std::sin(psi)) * 2.0 / std::sqrt(m_nOscillators);
         /// 3. Construct oscillator:
-        m_oscillators.emplace_back(amplitude, phi, omega);
+        m_amplitudesRe.push_back(amplitude.real());
+        m_amplitudesIm.push_back(amplitude.imag());
+        m_omegas.push_back(omega);
     }
+    m_evaluated = false;
 }
 
 JakesProcess::JakesProcess()
-    : m_omegaDopplerMax(0),
-      m_nOscillators(0)
+    : m_phase(0),
+      m_omegaDopplerMax(0),
+      m_nOscillators(0),
+      m_incremental(false),
+      m_evaluated(false),
+      m_nRotations(0)
 {
 }
 
 JakesProcess::~JakesProcess()
 {
-    m_oscillators.clear();
 }
 
 void
@@ -141,23 +152,184 @@ JakesProcess::DoDispose()
     m_jakes = nullptr;
 }
 
+std::complex<double>
+JakesProcess::ComputeGain(double t, bool storePhases) const
+{
+    std::size_t nOscillators = m_omegas.size();
+    const double* amplitudesRe = m_amplitudesRe.data();
+    const double* amplitudesIm = m_amplitudesIm.data();
+    const double* omegas = m_omegas.data();
+    double sumRe = 0;
+    double sumIm = 0;
+    if (!storePhases)
+    {
+        for (std::size_t n = 0; n < nOscillators; n++)
+        {
+            double c = std::cos(t * omegas[n] + m_phase);
+            sumRe += amplitudesRe[n] * c;
+            sumIm += amplitudesIm[n] * c;
+        }
+        return std::complex<double>(sumRe, sumIm);
+    }
+
+    m_cosPhases.resize(nOscillators);
+    m_sinPhases.resize(nOscillators);
+    for (std::size_t n = 0; n < nOscillators; n++)
+    {
+        double phase = t * omegas[n] + m_phase;
+        m_cosPhases[n] = std::cos(phase);
+        m_sinPhases[n] = std::sin(phase);
+        sumRe += amplitudesRe[n] * m_cosPhases[n];
+        sumIm += amplitudesIm[n] * m_cosPhases[n];
+    }
+    return std::complex<double>(sumRe, sumIm);
+}
+
+std::complex<double>
+JakesProcess::RotateGain(Time delta) const
+{
+    std::size_t nOscillators = m_omegas.size();
+    if (delta != m_lastDelta || m_cosRotations.size() != nOscillators)
+    {
+        // the rotation factors are reused as long as the elapsed time does not change
+        double d = delta.GetSeconds();
+        m_cosRotations.resize(nOscillators);
+        m_sinRotations.resize(nOscillators);
+        for (std::size_t n = 0; n < nOscillators; n++)
+        {
+            m_cosRotations[n] = std::cos(m_omegas[n] * d);
+            m_sinRotations[n] = std::sin(m_omegas[n] * d);
+        }
+        m_lastDelta = delta;
+    }
+
+    const double* amplitudesRe = m_amplitudesRe.data();
+    const double* amplitudesIm = m_amplitudesIm.data();
+    const double* cosRotations = m_cosRotations.data();
+    const double* sinRotations = m_sinRotations.data();
+    double* cosPhases = m_cosPhases.data();
+    double* sinPhases = m_sinPhases.data();
+    double sumRe = 0;
+    double sumIm = 0;
+    for (std::size_t n = 0; n < nOscillators; n++)
+    {
+        double c = cosPhases[n] * cosRotations[n] - sinPhases[n] * sinRotations[n];
+        double s = sinPhases[n] * cosRotations[n] + cosPhases[n] * sinRotations[n];
+        cosPhases[n] = c;
+        sinPhases[n] = s;
+        sumRe += amplitudesRe[n] * c;
+        sumIm += amplitudesIm[n] * c;
+    }
+    return std::complex<double>(sumRe, sumIm);
+}
+
 std::complex<double>
 JakesProcess::GetComplexGain() const
 {
-    std::complex<double> sumAplitude = std::complex<double>(0, 0);
-    for (unsigned int i = 0; i < m_oscillators.size(); i++)
+    Time now = Now();
+    if (m_evaluated && now == m_lastTime)
+    {
+        // e.g., both directions of a path are evaluated at the same time
+        return m_lastGain;
+    }
+
+    if (!m_incremental)
+    {
+        m_lastGain = ComputeGain(now.GetSeconds(), false);
+    }
+    else if (!m_evaluated || now < m_lastTime || m_nRotations >= RESYNC_INTERVAL)
+    {
+        m_lastGain = ComputeGain(now.GetSeconds(), true);
+        m_nRotations = 0;
+    }
+    else
     {
-        sumAplitude += m_oscillators[i].GetValueAt(Now());
+        m_lastGain = RotateGain(now - m_lastTime);
+        m_nRotations++;
     }
-    return sumAplitude;
+    m_evaluated = true;
+    m_lastTime = now;
+    return m_lastGain;
 }
 
 double
 JakesProcess::GetChannelGainDb() const
 {
-    std::complex<double> complexGain = GetComplexGain();
-    return (10 *
-            std::log10((std::pow(complexGain.real(), 2) + std::pow(complexGain.imag(), 2)) / 2));
+    return GetGainDb(GetComplexGain());
+}
+
+std::vector<double>
+JakesProcess::GetChannelGainsDb(const std::vector<Ptr<JakesProcess>>& processes)
+{
+    Time now = Now();
+    std::vector<double> gainsDb(processes.size());
+
+    // the processes whose phases are computed from scratch are evaluated
+    // together, the others are evaluated one by one
+    std::vector<std::size_t> batch;
+    std::size_t maxOscillators = 0;
+    for (std::size_t i = 0; i < processes.size(); i++)
+    {
+        const JakesProcess* process = PeekPointer(processes[i]);
+        if (!process->m_incremental && !(process->m_evaluated && now == process->m_lastTime))
+        {
+            batch.push_back(i);
+            maxOscillators = std::max(maxOscillators, process->m_omegas.size());
+        }
+        else
+        {
+            gainsDb[i] = process->GetChannelGainDb();
+        }
+    }
+    if (batch.empty())
+    {
+        return gainsDb;
+    }
+
+    // oscillator n of process j is stored at n * nProcesses + j; the processes
+    // with fewer oscillators are padded with null amplitudes
+    std::size_t nProcesses = batch.size();
+    std::vector<double> amplitudesRe(maxOscillators * nProcesses, 0.0);
+    std::vector<double> amplitudesIm(maxOscillators * nProcesses, 0.0);
+    std::vector<double> omegas(maxOscillators * nProcesses, 0.0);
+    std::vector<double> phases(nProcesses);
+    for (std::size_t j = 0; j < nProcesses; j++)
+    {
+        const JakesProcess* process = PeekPointer(processes[batch[j]]);
+        for (std::size_t n = 0; n < process->m_omegas.size(); n++)
+        {
+            amplitudesRe[n * nProcesses + j] = process->m_amplitudesRe[n];
+            amplitudesIm[n * nProcesses + j] = process->m_amplitudesIm[n];
+            omegas[n * nProcesses + j] = process->m_omegas[n];
+        }
+        phases[j] = process->m_phase;
+    }
+
+    double t = now.GetSeconds();
+    std::vector<double> sumsRe(nProcesses, 0.0);
+    std::vector<double> sumsIm(nProcesses, 0.0);
+    for (std::size_t n = 0; n < maxOscillators; n++)
+    {
+        const double* oscillatorRe = amplitudesRe.data() + n * nProcesses;
+        const double* oscillatorIm = amplitudesIm.data() + n * nProcesses;
+        const double* oscillatorOmegas = omegas.data() + n * nProcesses;
+        for (std::size_t j = 0; j < nProcesses; j++)
+        {
+            double c = std::cos(t * oscillatorOmegas[j] + phases[j]);
+            sumsRe[j] += oscillatorRe[j] * c;
+            sumsIm[j] += oscillatorIm[j] * c;
+        }
+    }
+
+    for (std::size_t j = 0; j < nProcesses; j++)
+    {
+        const JakesProcess* process = PeekPointer(processes[batch[j]]);
+        process->m_lastGain = std::complex<double>(sumsRe[j], sumsIm[j]);
+        process->m_evaluated = true;
+        process->m_lastTime = now;
+        gainsDb[batch[j]] = GetGainDb(process->m_lastGain);
+    }
+    return gainsDb;
 }
 
 } // namespace ns3
@@ -25,6 +25,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <complex>
+#include <vector>
 
 namespace ns3
 {
@@ -54,6 +55,25 @@ class JakesPropagationLossModel;
  * [1] Y. R. Zheng and C. Xiao, "Simulation Models With Correct
  * Statistical Properties for Rayleigh Fading Channel", IEEE
  * Trans. on Communications, Vol. 51, pp 920-928, June 2003
+ *
+ * The parameters of the oscillators are stored in contiguous arrays, so that
+ * the sums over the oscillators can be vectorized by the compiler, and the gain
+ * is only computed once per time instant. If the IncrementalUpdate attribute is
+ * true, the phases of the oscillators are rotated by the time elapsed since the
+ * last evaluation by means of the recurrence
+ * \f[ \cos(\theta + \omega\Delta) = \cos\theta\cos(\omega\Delta) -
+ *     \sin\theta\sin(\omega\Delta) \f]
+ * (and the analogous one for the sine), where the rotation factors are only
+ * computed when the elapsed time changes. Hence, when the gain is evaluated at
+ * regular intervals, no trigonometric function is computed for most of the
+ * evaluations. The phases are computed directly every RESYNC_INTERVAL
+ * evaluations, to prevent the accumulation of rounding errors.
+ *
+ * The gains of several processes can be evaluated at once by
+ * GetChannelGainsDb: the oscillators of the processes whose phases are
+ * computed from scratch are laid out by oscillator index, and their sums are
+ * computed in a single loop over the oscillator index, whose inner loop over
+ * the processes can be vectorized.
  */
 class JakesProcess : public Object
 {
@@ -77,6 +97,15 @@ class JakesProcess : public Object
      */
     double GetChannelGainDb() const;
 
+    /**
+     * Get the channel gains of several processes at the current simulation
+     * time. The result is the same as calling GetChannelGainDb on each process.
+     *
+     * \param processes the processes
+     * \return the channel gain [dB] of each process, in the order of the processes
+     */
+    static std::vector<double> GetChannelGainsDb(const std::vector<Ptr<JakesProcess>>& processes);
+
     /**
      * Set the propagation model using this class
      * \param model the propagation model using this class
@@ -86,32 +115,6 @@ class JakesProcess : public Object
   protected:
     void DoDispose() override;
 
-  private:
-    /**
-     * This class Represents a single oscillator
-     */
-    struct Oscillator
-    {
-        /**
-         * Initiate oscillator with complex amplitude, initial phase and rotation speed
-         * \param amplitude initial complex amplitude
-         * \param initialPhase initial phase
-         * \param omega rotation speed
-         */
-        Oscillator(std::complex<double> amplitude, double initialPhase, double omega);
-        /**
-         * Get the complex amplitude at a given moment
-         * \param t time instant
-         * \returns the complex amplitude
-         */
-        std::complex<double> GetValueAt(Time t) const;
-
-        std::complex<double>
-            m_amplitude; //!< Complex number \f$Re=\cos(\psi_n), Im = i\sin(\psi_n)]\f$
-        double m_phase;  //!< Phase \f$\phi_n\f$ of the oscillator
-        double m_omega;  //!< Rotation speed of the oscillator \f$\omega_d \cos(\alpha_n)\f$
-    };
-
   private:
     /**
      * Set the number of Oscillators to use
@@ -130,12 +133,52 @@ class JakesProcess : public Object
      */
     void ConstructOscillators();
 
+    /**
+     * Compute the phases of the oscillators at the given time and the sum of
+     * their complex amplitudes.
+     *
+     * \param t the time [s]
+     * \param storePhases whether the cosine and sine of the phases must be
+     *        stored for the incremental updates
+     * \return the channel complex gain
+     */
+    std::complex<double> ComputeGain(double t, bool storePhases) const;
+
+    /**
+     * Rotate the phases of the oscillators by the given elapsed time and
+     * compute the sum of their complex amplitudes.
+     *
+     * \param delta the time elapsed since the last evaluation
+     * \return the channel complex gain
+     */
+    std::complex<double> RotateGain(Time delta) const;
+
+    /// Number of incremental updates after which the phases are computed directly
+    static const uint32_t RESYNC_INTERVAL = 1000;
+
   private:
-    std::vector<Oscillator> m_oscillators;        //!< Vector of oscillators
+    // Oscillator n has the complex amplitude (m_amplitudesRe[n], m_amplitudesIm[n]),
+    // i.e., (cos(psi_n), sin(psi_n)) times 2 / sqrt(M), the rotation speed
+    // m_omegas[n] = omega_d cos(alpha_n) and the initial phase m_phase
+    std::vector<double> m_amplitudesRe;           //!< real parts of the amplitudes
+    std::vector<double> m_amplitudesIm;           //!< imaginary parts of the amplitudes
+    std::vector<double> m_omegas;                 //!< rotation speeds of the oscillators
+    double m_phase;                               //!< initial phase of the oscillators
     double m_omegaDopplerMax;                     //!< max rotation speed Doppler frequency
     unsigned int m_nOscillators;                  //!< number of oscillators
+    bool m_incremental;                           //!< whether the phases are rotated
     Ptr<UniformRandomVariable> m_uniformVariable; //!< random stream
     Ptr<const JakesPropagationLossModel> m_jakes; //!< pointer to the propagation loss model
+
+    mutable bool m_evaluated;                   //!< whether the gain has been computed
+    mutable Time m_lastTime;                    //!< time of the last evaluation
+    mutable std::complex<double> m_lastGain;    //!< gain computed at the last evaluation
+    mutable std::vector<double> m_cosPhases;    //!< cosines of the last phases
+    mutable std::vector<double> m_sinPhases;    //!< sines of the last phases
+    mutable Time m_lastDelta;                   //!< elapsed time of the rotation factors
+    mutable std::vector<double> m_cosRotations; //!< cosines of the rotation angles
+    mutable std::vector<double> m_sinRotations; //!< sines of the rotation angles
+    mutable uint32_t m_nRotations;              //!< incremental updates since the last resync
 };
 } // namespace ns3
 #endif // DOPPLER_PROCESS_H
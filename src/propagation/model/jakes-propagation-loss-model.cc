@@ -22,6 +22,8 @@
 
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -47,7 +49,25 @@ JakesPropagationLossModel::GetTypeId()
     static TypeId tid = TypeId("ns3::JakesPropagationLossModel")
                             .SetParent<PropagationLossModel>()
                             .SetGroupName("Propagation")
-                            .AddConstructor<JakesPropagationLossModel>();
+                            .AddConstructor<JakesPropagationLossModel>()
+                            .AddAttribute("CacheMaxSize",
+                                          "The maximum number of paths whose Jakes process is "
+                                          "kept in the cache (0 for no limit). When the limit is "
+                                          "reached, the least recently used process is evicted "
+                                          "and a new process is created if the path is used again.",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &JakesPropagationLossModel::SetCacheMaxSize,
+                                              &JakesPropagationLossModel::GetCacheMaxSize),
+                                          MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("CacheMaxAge",
+                                          "The maximum time the Jakes process of a path is kept "
+                                          "in the cache without being used (zero for no limit).",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(
+                                              &JakesPropagationLossModel::SetCacheMaxAge,
+                                              &JakesPropagationLossModel::GetCacheMaxAge),
+                                          MakeTimeChecker());
     return tid;
 }
 
@@ -58,10 +78,8 @@ JakesPropagationLossModel::DoDispose()
     m_propagationCache.Cleanup();
 }
 
-double
-JakesPropagationLossModel::DoCalcRxPower(double txPowerDbm,
-                                         Ptr<MobilityModel> a,
-                                         Ptr<MobilityModel> b) const
+Ptr<JakesProcess>
+JakesPropagationLossModel::GetProcess(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const
 {
     Ptr<JakesProcess> pathData = m_propagationCache.GetPathData(
         a,
@@ -77,7 +95,30 @@ JakesPropagationLossModel::DoCalcRxPower(double txPowerDbm,
             b,
             0 /**Spectrum model uid is not used in PropagationLossModel*/);
     }
-    return txPowerDbm + pathData->GetChannelGainDb();
+    return pathData;
+}
+
+double
+JakesPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                         Ptr<MobilityModel> a,
+                                         Ptr<MobilityModel> b) const
+{
+    return txPowerDbm + GetProcess(a, b)->GetChannelGainDb();
+}
+
+std::vector<double>
+JakesPropagationLossModel::GetChannelGainsDb(
+    const std::vector<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>>& paths) const
+{
+    NS_LOG_FUNCTION(this << paths.size());
+    // first resolve all the processes, then sum their oscillators in a single pass
+    std::vector<Ptr<JakesProcess>> processes;
+    processes.reserve(paths.size());
+    for (const auto& [a, b] : paths)
+    {
+        processes.push_back(GetProcess(a, b));
+    }
+    return JakesProcess::GetChannelGainsDb(processes);
 }
 
 Ptr<UniformRandomVariable>
@@ -86,6 +127,36 @@ JakesPropagationLossModel::GetUniformRandomVariable() const
     return m_uniformVariable;
 }
 
+void
+JakesPropagationLossModel::SetCacheMaxSize(uint32_t maxSize)
+{
+    m_propagationCache.SetMaxSize(maxSize);
+}
+
+uint32_t
+JakesPropagationLossModel::GetCacheMaxSize() const
+{
+    return m_propagationCache.GetMaxSize();
+}
+
+void
+JakesPropagationLossModel::SetCacheMaxAge(Time maxAge)
+{
+    m_propagationCache.SetMaxAge(maxAge);
+}
+
+Time
+JakesPropagationLossModel::GetCacheMaxAge() const
+{
+    return m_propagationCache.GetMaxAge();
+}
+
+const PropagationCacheStatistics&
+JakesPropagationLossModel::GetCacheStatistics() const
+{
+    return m_propagationCache.GetStatistics();
+}
+
 int64_t
 JakesPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -24,6 +24,9 @@
 #include "ns3/propagation-cache.h"
 #include "ns3/propagation-loss-model.h"
 
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 /**
@@ -48,6 +51,24 @@ class JakesPropagationLossModel : public PropagationLossModel
     JakesPropagationLossModel(const JakesPropagationLossModel&) = delete;
     JakesPropagationLossModel& operator=(const JakesPropagationLossModel&) = delete;
 
+    /**
+     * \return the statistics about the accesses to the cache of the Jakes processes
+     */
+    const PropagationCacheStatistics& GetCacheStatistics() const;
+
+    /**
+     * Compute the channel gain of several paths at the current simulation time
+     * in a single pass (see JakesProcess::GetChannelGainsDb), creating the Jakes
+     * processes of the paths that are not in the cache yet. The gain of each path is the one that CalcRxPower would
+     * add to the transmit power, except that the models chained to this one are
+     * not applied.
+     *
+     * \param paths the (transmitter, receiver) mobility models of the paths
+     * \return the channel gain (dB) of each path, in the order of the paths
+     */
+    std::vector<double> GetChannelGainsDb(
+        const std::vector<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>>& paths) const;
+
   protected:
     void DoDispose() override;
 
@@ -60,12 +81,42 @@ class JakesPropagationLossModel : public PropagationLossModel
 
     int64_t DoAssignStreams(int64_t stream) override;
 
+    /**
+     * Get the Jakes process of a path, creating it if it is not in the cache
+     * \param a the mobility model of the transmitter
+     * \param b the mobility model of the receiver
+     * \return the Jakes process of the path
+     */
+    Ptr<JakesProcess> GetProcess(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b) const;
+
     /**
      * Get the underlying RNG stream
      * \return the RNG stream
      */
     Ptr<UniformRandomVariable> GetUniformRandomVariable() const;
 
+    /**
+     * Set the maximum number of Jakes processes in the cache
+     * \param maxSize the maximum number of Jakes processes (0 for no limit)
+     */
+    void SetCacheMaxSize(uint32_t maxSize);
+
+    /**
+     * \return the maximum number of Jakes processes in the cache (0 for no limit)
+     */
+    uint32_t GetCacheMaxSize() const;
+
+    /**
+     * Set the maximum time a Jakes process is kept in the cache without being used
+     * \param maxAge the maximum age (zero for no limit)
+     */
+    void SetCacheMaxAge(Time maxAge);
+
+    /**
+     * \return the maximum time a Jakes process is kept in the cache without being used
+     */
+    Time GetCacheMaxAge() const;
+
     Ptr<UniformRandomVariable> m_uniformVariable;              //!< random stream
     mutable PropagationCache<JakesProcess> m_propagationCache; //!< Propagation cache
 };
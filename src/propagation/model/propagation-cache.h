@@ -21,16 +21,223 @@
 #define PROPAGATION_CACHE_H_
 
 #include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
 
-#include <map>
+#include <functional>
+#include <list>
+#include <unordered_map>
 
 namespace ns3
 {
+
+/**
+ * \ingroup propagation
+ * \brief Statistics about the accesses to a propagation cache
+ */
+struct PropagationCacheStatistics
+{
+    uint64_t m_hits{0};      //!< number of lookups that found the entry
+    uint64_t m_misses{0};    //!< number of lookups that did not find the entry
+    uint64_t m_evictions{0}; //!< number of entries removed because of the size or age limit
+};
+
+/**
+ * \ingroup propagation
+ * \brief A hashed cache with an optional limit on the number of entries and on
+ * the time elapsed since the last access to an entry.
+ *
+ * Entries are kept in least recently used (LRU) order. When an entry is added
+ * to a cache that has reached its maximum size, the least recently used entry
+ * is evicted. Entries that have not been accessed for longer than the maximum
+ * age are evicted when they are looked up and when new entries are added.
+ * Both limits are disabled by default, in which case the cache behaves as an
+ * unbounded hash map. The models using the cache must be able to regenerate an
+ * evicted entry, which in general yields a new realization of the random
+ * quantities it stored.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class PropagationLruCache
+{
+  public:
+    /**
+     * Set the maximum number of entries of the cache. If the cache holds more
+     * entries, the least recently used ones are evicted.
+     *
+     * \param maxSize the maximum number of entries (0 for no limit)
+     */
+    void SetMaxSize(std::size_t maxSize)
+    {
+        m_maxSize = maxSize;
+        while (m_maxSize > 0 && m_entries.size() > m_maxSize)
+        {
+            EvictLast();
+        }
+    }
+
+    /**
+     * \return the maximum number of entries of the cache (0 for no limit)
+     */
+    std::size_t GetMaxSize() const
+    {
+        return m_maxSize;
+    }
+
+    /**
+     * Set the maximum time an entry is kept in the cache without being accessed.
+     *
+     * \param maxAge the maximum age of the entries (zero for no limit)
+     */
+    void SetMaxAge(Time maxAge)
+    {
+        m_maxAge = maxAge;
+    }
+
+    /**
+     * \return the maximum age of the entries (zero for no limit)
+     */
+    Time GetMaxAge() const
+    {
+        return m_maxAge;
+    }
+
+    /**
+     * Look up an entry and mark it as the most recently used one.
+     *
+     * \param key the key of the entry
+     * \return a pointer to the value of the entry, or a null pointer if the
+     *         entry is not in the cache (or has expired)
+     */
+    Value* Find(const Key& key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            m_stats.m_misses++;
+            return nullptr;
+        }
+        auto entry = it->second;
+        if (IsExpired(*entry))
+        {
+            m_index.erase(it);
+            m_entries.erase(entry);
+            m_stats.m_evictions++;
+            m_stats.m_misses++;
+            return nullptr;
+        }
+        m_stats.m_hits++;
+        entry->m_lastAccess = Simulator::Now();
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        return &entry->m_value;
+    }
+
+    /**
+     * Add an entry, which must not be in the cache, as the most recently used
+     * one, evicting the expired entries and, if the cache is full, the least
+     * recently used entry.
+     *
+     * \param key the key of the entry
+     * \param value the value of the entry
+     * \return a reference to the value stored in the cache, which remains valid
+     *         until the entry is evicted
+     */
+    Value& Insert(const Key& key, Value value)
+    {
+        NS_ASSERT(m_index.find(key) == m_index.end());
+        while (!m_entries.empty() &&
+               (IsExpired(m_entries.back()) || (m_maxSize > 0 && m_entries.size() >= m_maxSize)))
+        {
+            EvictLast();
+        }
+        m_entries.push_front({key, std::move(value), Simulator::Now()});
+        m_index.emplace(key, m_entries.begin());
+        return m_entries.front().m_value;
+    }
+
+    /**
+     * Call the given function on the value of every entry of the cache.
+     *
+     * \tparam F the type of the function
+     * \param f the function
+     */
+    template <class F>
+    void ForEach(F f)
+    {
+        for (auto& entry : m_entries)
+        {
+            f(entry.m_value);
+        }
+    }
+
+    /**
+     * Remove all the entries of the cache. Statistics are not reset.
+     */
+    void Clear()
+    {
+        m_index.clear();
+        m_entries.clear();
+    }
+
+    /**
+     * \return the number of entries of the cache
+     */
+    std::size_t GetSize() const
+    {
+        return m_entries.size();
+    }
+
+    /**
+     * \return the statistics about the accesses to the cache
+     */
+    const PropagationCacheStatistics& GetStatistics() const
+    {
+        return m_stats;
+    }
+
+  private:
+    /// An entry of the cache
+    struct Entry
+    {
+        Key m_key;         //!< the key
+        Value m_value;     //!< the value
+        Time m_lastAccess; //!< the time of the last access
+    };
+
+    /// List of entries, from the most to the least recently used one
+    using EntryList = std::list<Entry>;
+
+    /**
+     * \param entry an entry of the cache
+     * \return whether the entry has not been accessed for longer than the maximum age
+     */
+    bool IsExpired(const Entry& entry) const
+    {
+        return m_maxAge.IsStrictlyPositive() && Simulator::Now() - entry.m_lastAccess > m_maxAge;
+    }
+
+    /**
+     * Evict the least recently used entry.
+     */
+    void EvictLast()
+    {
+        m_index.erase(m_entries.back().m_key);
+        m_entries.pop_back();
+        m_stats.m_evictions++;
+    }
+
+    EntryList m_entries;                                                //!< the entries
+    std::unordered_map<Key, typename EntryList::iterator, Hash> m_index; //!< index of the entries
+    std::size_t m_maxSize{0};                                           //!< maximum size
+    Time m_maxAge;                                                      //!< maximum age
+    PropagationCacheStatistics m_stats;                                 //!< statistics
+};
+
 /**
  * \ingroup propagation
  * \brief Constructs a cache of objects, where each object is responsible for a single propagation
  * path loss calculations. Propagation path a-->b and b-->a is the same thing. Propagation path is
- * identified by a couple of MobilityModels and a spectrum model UID
+ * identified by a couple of MobilityModels and a spectrum model UID. The size of the cache and
+ * the age of its entries can be bounded (see PropagationLruCache).
  */
 template <class T>
 class PropagationCache
@@ -48,13 +255,12 @@ class PropagationCache
      */
     Ptr<T> GetPathData(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
     {
-        PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid);
-        typename PathCache::iterator it = m_pathCache.find(key);
-        if (it == m_pathCache.end())
+        Ptr<T>* data = m_pathCache.Find(PropagationPathIdentifier(a, b, modelUid));
+        if (!data)
         {
             return nullptr;
         }
-        return it->second;
+        return *data;
     };
 
     /**
@@ -69,21 +275,66 @@ class PropagationCache
                      Ptr<const MobilityModel> b,
                      uint32_t modelUid)
     {
-        PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid);
-        NS_ASSERT(m_pathCache.find(key) == m_pathCache.end());
-        m_pathCache.insert(std::make_pair(key, data));
+        m_pathCache.Insert(PropagationPathIdentifier(a, b, modelUid), data);
     };
 
+    /**
+     * Set the maximum number of paths in the cache
+     * \param maxSize the maximum number of paths (0 for no limit)
+     */
+    void SetMaxSize(std::size_t maxSize)
+    {
+        m_pathCache.SetMaxSize(maxSize);
+    }
+
+    /**
+     * \return the maximum number of paths in the cache (0 for no limit)
+     */
+    std::size_t GetMaxSize() const
+    {
+        return m_pathCache.GetMaxSize();
+    }
+
+    /**
+     * Set the maximum time a path is kept in the cache without being accessed
+     * \param maxAge the maximum age (zero for no limit)
+     */
+    void SetMaxAge(Time maxAge)
+    {
+        m_pathCache.SetMaxAge(maxAge);
+    }
+
+    /**
+     * \return the maximum time a path is kept in the cache without being accessed
+     */
+    Time GetMaxAge() const
+    {
+        return m_pathCache.GetMaxAge();
+    }
+
+    /**
+     * \return the number of paths in the cache
+     */
+    std::size_t GetSize() const
+    {
+        return m_pathCache.GetSize();
+    }
+
+    /**
+     * \return the statistics about the accesses to the cache
+     */
+    const PropagationCacheStatistics& GetStatistics() const
+    {
+        return m_pathCache.GetStatistics();
+    }
+
     /**
      * Clean the cache
      */
     void Cleanup()
     {
-        for (auto i : m_pathCache)
-        {
-            i.second->Dispose();
-        }
-        m_pathCache.clear();
+        m_pathCache.ForEach([](Ptr<T>& data) { data->Dispose(); });
+        m_pathCache.Clear();
     }
 
   private:
@@ -107,42 +358,44 @@ class PropagationCache
         uint32_t m_spectrumModelUid;            //!< model UID
 
         /**
-         * Less-than operator.
+         * Equality operator.
          *
-         * The goal of this operator is just to provide a stable comparison
-         * to be used in containers requiring a order (of any kind).
-         *
-         * If the models are different, the comparison is based on their Uid.
-         * Otherwise, the comparison is based on the pointers of the Mobility models.
+         * Links are supposed to be symmetrical, hence the paths a-->b and b-->a
+         * are equal.
          *
          * \param other Right value of the operator.
-         * \returns True if the Left value is less than the Right value.
+         * \returns True if the paths are the same.
          */
-        bool operator<(const PropagationPathIdentifier& other) const
+        bool operator==(const PropagationPathIdentifier& other) const
         {
-            if (m_spectrumModelUid != other.m_spectrumModelUid)
-            {
-                return m_spectrumModelUid < other.m_spectrumModelUid;
-            }
-            /// Links are supposed to be symmetrical!
-            if (std::min(m_dstMobility, m_srcMobility) !=
-                std::min(other.m_dstMobility, other.m_srcMobility))
-            {
-                return std::min(m_dstMobility, m_srcMobility) <
-                       std::min(other.m_dstMobility, other.m_srcMobility);
-            }
-            if (std::max(m_dstMobility, m_srcMobility) !=
-                std::max(other.m_dstMobility, other.m_srcMobility))
-            {
-                return std::max(m_dstMobility, m_srcMobility) <
+            return m_spectrumModelUid == other.m_spectrumModelUid &&
+                   std::min(m_dstMobility, m_srcMobility) ==
+                       std::min(other.m_dstMobility, other.m_srcMobility) &&
+                   std::max(m_dstMobility, m_srcMobility) ==
                        std::max(other.m_dstMobility, other.m_srcMobility);
-            }
-            return false;
+        }
+    };
+
+    /// Hash function for PropagationPathIdentifier, invariant to the order of the mobility models
+    struct PropagationPathIdentifierHash
+    {
+        /**
+         * \param path the path identifier
+         * \return the hash of the path identifier
+         */
+        std::size_t operator()(const PropagationPathIdentifier& path) const
+        {
+            std::hash<const MobilityModel*> hasher;
+            std::size_t h1 = hasher(PeekPointer(std::min(path.m_srcMobility, path.m_dstMobility)));
+            std::size_t h2 = hasher(PeekPointer(std::max(path.m_srcMobility, path.m_dstMobility)));
+            std::size_t h = h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+            return h ^ (path.m_spectrumModelUid + 0x9e3779b9 + (h << 6) + (h >> 2));
         }
     };
 
     /// Typedef: PropagationPathIdentifier, Ptr<T>
-    typedef std::map<PropagationPathIdentifier, Ptr<T>> PathCache;
+    typedef PropagationLruCache<PropagationPathIdentifier, Ptr<T>, PropagationPathIdentifierHash>
+        PathCache;
 
   private:
     PathCache m_pathCache; //!< Path cache
@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "propagation-loss-trace.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifndef __WIN32__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PropagationLossTrace");
+
+/// The magic string at the beginning of the files
+static const char g_magic[8] = "NS3LOSS";
+
+PropagationLossTrace::PropagationLossTrace(const std::string& fileName)
+    : m_header(nullptr),
+      m_lossDb(nullptr),
+      m_mapping(nullptr),
+      m_mappingSize(0)
+{
+    NS_LOG_FUNCTION(this << fileName);
+
+    const char* content = nullptr;
+    std::size_t size = 0;
+#ifndef __WIN32__
+    int fd = open(fileName.c_str(), O_RDONLY);
+    NS_ABORT_MSG_IF(fd < 0, "Could not open the loss trace " << fileName);
+    struct stat st;
+    NS_ABORT_MSG_IF(fstat(fd, &st) < 0, "Could not get the size of the loss trace " << fileName);
+    size = st.st_size;
+    if (size > 0)
+    {
+        m_mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        NS_ABORT_MSG_IF(m_mapping == MAP_FAILED, "Could not map the loss trace " << fileName);
+        m_mappingSize = size;
+        content = static_cast<const char*>(m_mapping);
+    }
+    close(fd);
+#else
+    // memory mapping is not supported, load the whole file
+    std::ifstream file(fileName, std::ios::binary);
+    NS_ABORT_MSG_IF(!file.is_open(), "Could not open the loss trace " << fileName);
+    m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    size = m_data.size();
+    content = m_data.data();
+#endif
+
+    NS_ABORT_MSG_IF(size < sizeof(Header), "The loss trace " << fileName << " is too short");
+    m_header = reinterpret_cast<const Header*>(content);
+    NS_ABORT_MSG_IF(std::memcmp(m_header->magic, g_magic, sizeof(g_magic)) != 0,
+                    fileName << " is not a loss trace");
+    NS_ABORT_MSG_IF(m_header->version != VERSION,
+                    "Unsupported version " << m_header->version << " of the loss trace "
+                                           << fileName << " (wrong byte order?)");
+    NS_ABORT_MSG_IF(m_header->numNodes == 0 || m_header->numBands == 0 ||
+                        m_header->numSamples == 0,
+                    "The loss trace " << fileName << " is empty");
+    NS_ABORT_MSG_IF(!(m_header->samplePeriod > 0),
+                    "Invalid sample period in the loss trace " << fileName);
+    uint64_t numValues = static_cast<uint64_t>(m_header->numNodes) * m_header->numNodes *
+                         m_header->numSamples * m_header->numBands;
+    NS_ABORT_MSG_IF(size != sizeof(Header) + numValues * sizeof(float),
+                    "The size of the loss trace " << fileName << " does not match its header");
+    m_lossDb = reinterpret_cast<const float*>(content + sizeof(Header));
+
+    NS_LOG_DEBUG("Loss trace " << fileName << ": " << m_header->numNodes << " nodes, "
+                               << m_header->numBands << " bands, " << m_header->numSamples
+                               << " samples every " << m_header->samplePeriod << " s");
+}
+
+PropagationLossTrace::~PropagationLossTrace()
+{
+    NS_LOG_FUNCTION(this);
+#ifndef __WIN32__
+    if (m_mapping)
+    {
+        munmap(m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+void
+PropagationLossTrace::Write(const std::string& fileName,
+                            uint32_t numNodes,
+                            uint32_t numBands,
+                            uint32_t numSamples,
+                            Time startTime,
+                            Time samplePeriod,
+                            const std::vector<float>& lossDb)
+{
+    NS_LOG_FUNCTION(fileName << numNodes << numBands << numSamples << startTime << samplePeriod);
+    NS_ABORT_MSG_IF(lossDb.size() !=
+                        static_cast<uint64_t>(numNodes) * numNodes * numSamples * numBands,
+                    "The number of losses does not match the size of the table");
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, g_magic, sizeof(g_magic));
+    header.version = VERSION;
+    header.numNodes = numNodes;
+    header.numBands = numBands;
+    header.numSamples = numSamples;
+    header.startTime = startTime.GetSeconds();
+    header.samplePeriod = samplePeriod.GetSeconds();
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!file.is_open(), "Could not create the loss trace " << fileName);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(lossDb.data()), lossDb.size() * sizeof(float));
+    NS_ABORT_MSG_IF(!file, "Could not write the loss trace " << fileName);
+}
+
+uint32_t
+PropagationLossTrace::GetNumNodes() const
+{
+    return m_header->numNodes;
+}
+
+uint32_t
+PropagationLossTrace::GetNumBands() const
+{
+    return m_header->numBands;
+}
+
+uint32_t
+PropagationLossTrace::GetNumSamples() const
+{
+    return m_header->numSamples;
+}
+
+double
+PropagationLossTrace::GetLossDb(uint32_t txId,
+                                uint32_t rxId,
+                                uint32_t band,
+                                Time time,
+                                bool loop) const
+{
+    NS_LOG_FUNCTION(this << txId << rxId << band << time << loop);
+    NS_ABORT_MSG_IF(txId >= m_header->numNodes || rxId >= m_header->numNodes,
+                    "The loss trace has no samples for the nodes " << txId << " and " << rxId);
+    NS_ASSERT(band < m_header->numBands);
+
+    uint32_t numSamples = m_header->numSamples;
+    double position = (time.GetSeconds() - m_header->startTime) / m_header->samplePeriod;
+    if (loop)
+    {
+        position = std::fmod(position, numSamples);
+        if (position < 0)
+        {
+            position += numSamples;
+        }
+    }
+    else
+    {
+        position = std::min(std::max(position, 0.0), numSamples - 1.0);
+    }
+    auto sample = static_cast<uint32_t>(position);
+    sample = std::min(sample, numSamples - 1); // in case of rounding errors
+    double weight = position - sample;
+    uint32_t nextSample = (sample + 1 < numSamples ? sample + 1 : (loop ? 0 : sample));
+
+    std::size_t numBands = m_header->numBands;
+    const float* pairLossDb =
+        m_lossDb + (static_cast<std::size_t>(txId) * m_header->numNodes + rxId) * numSamples *
+                       numBands;
+    double lossDb = pairLossDb[sample * numBands + band];
+    double nextLossDb = pairLossDb[nextSample * numBands + band];
+    return lossDb + weight * (nextLossDb - lossDb);
+}
+
+uint32_t
+PropagationLossTrace::GetNodeId(Ptr<const MobilityModel> mobility)
+{
+    Ptr<Node> node = mobility->GetObject<Node>();
+    NS_ABORT_MSG_IF(!node, "The mobility models must be aggregated to nodes to use a loss trace");
+    return node->GetId();
+}
+
+} // namespace ns3
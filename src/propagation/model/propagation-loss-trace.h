@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PROPAGATION_LOSS_TRACE_H
+#define PROPAGATION_LOSS_TRACE_H
+
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup propagation
+ *
+ * \brief A table of precomputed losses between pairs of nodes, read from a
+ * memory-mapped binary file.
+ *
+ * The table stores, for each (transmitter, receiver) pair of nodes, the loss
+ * in dB over a number of frequency bands, sampled at regular time intervals.
+ * Nodes are identified by their ID. The file is made of a header, whose fields
+ * are stored in the byte order of the host:
+ *
+ * | Offset | Type     | Field                                  |
+ * |--------|----------|----------------------------------------|
+ * | 0      | char[8]  | "NS3LOSS" followed by a null character |
+ * | 8      | uint32_t | version (1)                            |
+ * | 12     | uint32_t | number of nodes N                      |
+ * | 16     | uint32_t | number of bands B                      |
+ * | 20     | uint32_t | number of samples S                    |
+ * | 24     | double   | time of the first sample (s)           |
+ * | 32     | double   | time between two samples (s)           |
+ *
+ * followed by N x N x S x B losses stored as float (dB), with the band index
+ * varying fastest, then the sample index, then the receiver ID and finally the
+ * transmitter ID. The samples of a pair of nodes are thus contiguous, and only
+ * the pages of the file holding the samples of the pairs that are actually
+ * used are loaded in memory by the operating system. Write creates a file in
+ * this format, e.g., from the output of a ray tracer.
+ *
+ * The loss at a given time is linearly interpolated (in dB) between the two
+ * closest samples. Before the first sample and after the last sample, the loss
+ * is either that of the first and the last sample, respectively, or the trace
+ * is repeated periodically, with a period of S samples.
+ */
+class PropagationLossTrace : public SimpleRefCount<PropagationLossTrace>
+{
+  public:
+    /**
+     * Map a file in memory. The program is aborted if the file cannot be
+     * opened or if its content is not valid.
+     *
+     * \param fileName the name of the file
+     */
+    PropagationLossTrace(const std::string& fileName);
+    ~PropagationLossTrace();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PropagationLossTrace(const PropagationLossTrace&) = delete;
+    PropagationLossTrace& operator=(const PropagationLossTrace&) = delete;
+
+    /**
+     * Write a table of losses to a file.
+     *
+     * \param fileName the name of the file
+     * \param numNodes the number of nodes
+     * \param numBands the number of bands
+     * \param numSamples the number of samples
+     * \param startTime the time of the first sample
+     * \param samplePeriod the time between two samples
+     * \param lossDb the N x N x S x B losses (dB), in the order of the file
+     */
+    static void Write(const std::string& fileName,
+                      uint32_t numNodes,
+                      uint32_t numBands,
+                      uint32_t numSamples,
+                      Time startTime,
+                      Time samplePeriod,
+                      const std::vector<float>& lossDb);
+
+    /**
+     * \return the number of nodes
+     */
+    uint32_t GetNumNodes() const;
+
+    /**
+     * \return the number of bands
+     */
+    uint32_t GetNumBands() const;
+
+    /**
+     * \return the number of samples
+     */
+    uint32_t GetNumSamples() const;
+
+    /**
+     * Get the loss between two nodes in a given band at a given time.
+     *
+     * \param txId the ID of the transmitting node
+     * \param rxId the ID of the receiving node
+     * \param band the index of the band
+     * \param time the time
+     * \param loop whether the trace is repeated periodically
+     * \return the loss (dB)
+     */
+    double GetLossDb(uint32_t txId, uint32_t rxId, uint32_t band, Time time, bool loop) const;
+
+    /**
+     * Get the ID identifying a node in the traces, i.e., the ID of the Node a
+     * mobility model is aggregated to. The program is aborted if the mobility
+     * model is not aggregated to a Node.
+     *
+     * \param mobility the mobility model
+     * \return the ID of the node
+     */
+    static uint32_t GetNodeId(Ptr<const MobilityModel> mobility);
+
+  private:
+    /// The header of the file
+    struct Header
+    {
+        char magic[8];       //!< "NS3LOSS"
+        uint32_t version;    //!< the version of the format
+        uint32_t numNodes;   //!< the number of nodes
+        uint32_t numBands;   //!< the number of bands
+        uint32_t numSamples; //!< the number of samples
+        double startTime;    //!< the time of the first sample (s)
+        double samplePeriod; //!< the time between two samples (s)
+    };
+
+    static const uint32_t VERSION = 1; //!< the version of the format
+
+    const Header* m_header;    //!< the header of the mapped file
+    const float* m_lossDb;     //!< the losses of the mapped file
+    void* m_mapping;           //!< the start of the mapped memory
+    std::size_t m_mappingSize; //!< the size of the mapped memory
+    std::vector<char> m_data;  //!< the content of the file, if it cannot be mapped
+};
+
+} // namespace ns3
+
+#endif /* PROPAGATION_LOSS_TRACE_H */
@@ -27,6 +27,7 @@
 #include "ns3/node.h"
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <cmath>
 
@@ -76,7 +77,23 @@ ThreeGppPropagationLossModel::GetTypeId()
                 "Enable/disable Building Penetration Losses.",
                 BooleanValue(true),
                 MakeBooleanAccessor(&ThreeGppPropagationLossModel::m_buildingPenLossesEnabled),
-                MakeBooleanChecker());
+                MakeBooleanChecker())
+            .AddAttribute("CacheMaxSize",
+                          "The maximum number of channels whose shadowing value and o2i loss are "
+                          "kept in the caches (0 for no limit). When the limit is reached, the "
+                          "least recently used entry is evicted and a new independent realization "
+                          "is generated if the channel is used again.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppPropagationLossModel::SetCacheMaxSize,
+                                               &ThreeGppPropagationLossModel::GetCacheMaxSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheMaxAge",
+                          "The maximum time the shadowing value and the o2i loss of a channel "
+                          "are kept in the caches without being used (zero for no limit).",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&ThreeGppPropagationLossModel::SetCacheMaxAge,
+                                           &ThreeGppPropagationLossModel::GetCacheMaxAge),
+                          MakeTimeChecker());
     return tid;
 }
 
@@ -112,7 +129,8 @@ ThreeGppPropagationLossModel::DoDispose()
 {
     m_channelConditionModel->Dispose();
     m_channelConditionModel = nullptr;
-    m_shadowingMap.clear();
+    m_shadowingMap.Clear();
+    m_o2iLossMap.Clear();
 }
 
 void
@@ -145,6 +163,46 @@ ThreeGppPropagationLossModel::GetFrequency() const
     return m_frequency;
 }
 
+void
+ThreeGppPropagationLossModel::SetCacheMaxSize(uint32_t maxSize)
+{
+    NS_LOG_FUNCTION(this << maxSize);
+    m_shadowingMap.SetMaxSize(maxSize);
+    m_o2iLossMap.SetMaxSize(maxSize);
+}
+
+uint32_t
+ThreeGppPropagationLossModel::GetCacheMaxSize() const
+{
+    return m_shadowingMap.GetMaxSize();
+}
+
+void
+ThreeGppPropagationLossModel::SetCacheMaxAge(Time maxAge)
+{
+    NS_LOG_FUNCTION(this << maxAge);
+    m_shadowingMap.SetMaxAge(maxAge);
+    m_o2iLossMap.SetMaxAge(maxAge);
+}
+
+Time
+ThreeGppPropagationLossModel::GetCacheMaxAge() const
+{
+    return m_shadowingMap.GetMaxAge();
+}
+
+const PropagationCacheStatistics&
+ThreeGppPropagationLossModel::GetShadowingCacheStatistics() const
+{
+    return m_shadowingMap.GetStatistics();
+}
+
+const PropagationCacheStatistics&
+ThreeGppPropagationLossModel::GetO2iLossCacheStatistics() const
+{
+    return m_o2iLossMap.GetStatistics();
+}
+
 double
 ThreeGppPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                             Ptr<MobilityModel> a,
@@ -248,19 +306,17 @@ ThreeGppPropagationLossModel::GetO2iLowPenetrationLoss(
     bool notFound = false;     // indicates if the o2iLoss value has not been computed yet
     bool newCondition = false; // indicates if the channel condition has changed
 
-    auto it = m_o2iLossMap.end(); // the o2iLoss map iterator
-    if (m_o2iLossMap.find(key) != m_o2iLossMap.end())
+    O2iLossMapItem* item = m_o2iLossMap.Find(key); // the o2iLoss map entry
+    if (item)
     {
         // found the o2iLoss value in the map
-        it = m_o2iLossMap.find(key);
-        newCondition = (it->second.m_condition != cond); // true if the condition changed
+        newCondition = (item->m_condition != cond); // true if the condition changed
     }
     else
     {
         notFound = true;
-        // add a new entry in the map and update the iterator
-        O2iLossMapItem newItem;
-        it = m_o2iLossMap.insert(it, std::make_pair(key, newItem));
+        // add a new entry in the map
+        item = &m_o2iLossMap.Insert(key, O2iLossMapItem());
     }
 
     if (notFound || newCondition)
@@ -287,12 +343,12 @@ ThreeGppPropagationLossModel::GetO2iLowPenetrationLoss(
     }
     else
     {
-        o2iLossValue = it->second.m_o2iLoss;
+        o2iLossValue = item->m_o2iLoss;
     }
 
     // update the entry in the map
-    it->second.m_o2iLoss = o2iLossValue;
-    it->second.m_condition = cond;
+    item->m_o2iLoss = o2iLossValue;
+    item->m_condition = cond;
 
     return o2iLossValue;
 }
@@ -318,19 +374,17 @@ ThreeGppPropagationLossModel::GetO2iHighPenetrationLoss(
     bool notFound = false;     // indicates if the o2iLoss value has not been computed yet
     bool newCondition = false; // indicates if the channel condition has changed
 
-    auto it = m_o2iLossMap.end(); // the o2iLoss map iterator
-    if (m_o2iLossMap.find(key) != m_o2iLossMap.end())
+    O2iLossMapItem* item = m_o2iLossMap.Find(key); // the o2iLoss map entry
+    if (item)
     {
         // found the o2iLoss value in the map
-        it = m_o2iLossMap.find(key);
-        newCondition = (it->second.m_condition != cond); // true if the condition changed
+        newCondition = (item->m_condition != cond); // true if the condition changed
     }
     else
     {
         notFound = true;
-        // add a new entry in the map and update the iterator
-        O2iLossMapItem newItem;
-        it = m_o2iLossMap.insert(it, std::make_pair(key, newItem));
+        // add a new entry in the map
+        item = &m_o2iLossMap.Insert(key, O2iLossMapItem());
     }
 
     if (notFound || newCondition)
@@ -359,12 +413,12 @@ ThreeGppPropagationLossModel::GetO2iHighPenetrationLoss(
     }
     else
     {
-        o2iLossValue = it->second.m_o2iLoss;
+        o2iLossValue = item->m_o2iLoss;
     }
 
     // update the entry in the map
-    it->second.m_o2iLoss = o2iLossValue;
-    it->second.m_condition = cond;
+    item->m_o2iLoss = o2iLossValue;
+    item->m_condition = cond;
 
     return o2iLossValue;
 }
@@ -395,21 +449,19 @@ ThreeGppPropagationLossModel::GetShadowing(Ptr<MobilityModel> a,
     bool notFound = false;          // indicates if the shadowing value has not been computed yet
     bool newCondition = false;      // indicates if the channel condition has changed
     Vector newDistance;             // the distance vector, that is not a distance but a difference
-    auto it = m_shadowingMap.end(); // the shadowing map iterator
-    if (m_shadowingMap.find(key) != m_shadowingMap.end())
+    ShadowingMapItem* item = m_shadowingMap.Find(key); // the shadowing map entry
+    if (item)
     {
         // found the shadowing value in the map
-        it = m_shadowingMap.find(key);
         newDistance = GetVectorDifference(a, b);
-        newCondition = (it->second.m_condition != cond); // true if the condition changed
+        newCondition = (item->m_condition != cond); // true if the condition changed
     }
     else
     {
         notFound = true;
 
-        // add a new entry in the map and update the iterator
-        ShadowingMapItem newItem;
-        it = m_shadowingMap.insert(it, std::make_pair(key, newItem));
+        // add a new entry in the map
+        item = &m_shadowingMap.Insert(key, ShadowingMapItem());
     }
 
     if (notFound || newCondition)
@@ -420,19 +472,19 @@ ThreeGppPropagationLossModel::GetShadowing(Ptr<MobilityModel> a,
     else
     {
         // compute a new correlated shadowing loss
-        Vector2D displacement(newDistance.x - it->second.m_distance.x,
-                              newDistance.y - it->second.m_distance.y);
+        Vector2D displacement(newDistance.x - item->m_distance.x,
+                              newDistance.y - item->m_distance.y);
         double R = exp(-1 * displacement.GetLength() / GetShadowingCorrelationDistance(cond));
-        shadowingValue = R * it->second.m_shadowing + sqrt(1 - R * R) *
+        shadowingValue = R * item->m_shadowing + sqrt(1 - R * R) *
                                                           m_normRandomVariable->GetValue() *
                                                           GetShadowingStd(a, b, cond);
     }
 
     // update the entry in the map
-    it->second.m_shadowing = shadowingValue;
-    it->second.m_distance = newDistance; // Save the (0,0,0) vector in case it's the first time we
-                                         // are calculating this value
-    it->second.m_condition = cond;
+    item->m_shadowing = shadowingValue;
+    item->m_distance = newDistance; // Save the (0,0,0) vector in case it's the first time we
+                                    // are calculating this value
+    item->m_condition = cond;
 
     return shadowingValue;
 }
@@ -79,6 +79,16 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
      */
     double GetFrequency() const;
 
+    /**
+     * \return the statistics about the accesses to the cache of the shadowing values
+     */
+    const PropagationCacheStatistics& GetShadowingCacheStatistics() const;
+
+    /**
+     * \return the statistics about the accesses to the cache of the o2i losses
+     */
+    const PropagationCacheStatistics& GetO2iLossCacheStatistics() const;
+
   private:
     /**
      * Computes the received power by applying the pathloss model described in
@@ -269,6 +279,30 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
      */
     static Vector GetVectorDifference(Ptr<MobilityModel> a, Ptr<MobilityModel> b);
 
+    /**
+     * Set the maximum number of channels in the caches of the shadowing values
+     * and of the o2i losses
+     * \param maxSize the maximum number of channels (0 for no limit)
+     */
+    void SetCacheMaxSize(uint32_t maxSize);
+
+    /**
+     * \return the maximum number of channels in the caches (0 for no limit)
+     */
+    uint32_t GetCacheMaxSize() const;
+
+    /**
+     * Set the maximum time the shadowing value and the o2i loss of a channel
+     * are kept in the caches without being used
+     * \param maxAge the maximum age (zero for no limit)
+     */
+    void SetCacheMaxAge(Time maxAge);
+
+    /**
+     * \return the maximum time an entry is kept in the caches without being used
+     */
+    Time GetCacheMaxAge() const;
+
   protected:
     void DoDispose() override;
 
@@ -295,8 +329,8 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
         Vector m_distance;                               //!< the vector AB
     };
 
-    mutable std::unordered_map<uint32_t, ShadowingMapItem>
-        m_shadowingMap; //!< map to store the shadowing values
+    mutable PropagationLruCache<uint32_t, ShadowingMapItem>
+        m_shadowingMap; //!< cache storing the shadowing values
 
     /** Define a struct for the m_o2iLossMap entries */
     struct O2iLossMapItem
@@ -305,8 +339,8 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
         ChannelCondition::LosConditionValue m_condition; //!< the LOS/NLOS condition
     };
 
-    mutable std::unordered_map<uint32_t, O2iLossMapItem>
-        m_o2iLossMap; //!< map to store the o2i Loss values
+    mutable PropagationLruCache<uint32_t, O2iLossMapItem>
+        m_o2iLossMap; //!< cache storing the o2i Loss values
 
     Ptr<UniformRandomVariable> m_randomO2iVar1; //!< a uniform random variable for the calculation
                                                 //!< of the indoor loss, see TR38.901 Table 7.4.3-2
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "trace-propagation-loss-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TracePropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(TracePropagationLossModel);
+
+TypeId
+TracePropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TracePropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<TracePropagationLossModel>()
+            .AddAttribute("TraceFileName",
+                          "The name of the binary trace file (see PropagationLossTrace), "
+                          "which must have a single band.",
+                          StringValue(""),
+                          MakeStringAccessor(&TracePropagationLossModel::SetTraceFileName),
+                          MakeStringChecker())
+            .AddAttribute("Loop",
+                          "If true, the trace is repeated periodically, otherwise the first "
+                          "and the last samples are used before and after the trace.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TracePropagationLossModel::m_loop),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+TracePropagationLossModel::TracePropagationLossModel()
+    : m_loop(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TracePropagationLossModel::~TracePropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TracePropagationLossModel::SetTraceFileName(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    if (fileName.empty())
+    {
+        m_trace = nullptr;
+        return;
+    }
+    m_trace = Create<const PropagationLossTrace>(fileName);
+    NS_ABORT_MSG_IF(m_trace->GetNumBands() != 1,
+                    "The trace " << fileName << " must have a single band");
+}
+
+double
+TracePropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                         Ptr<MobilityModel> a,
+                                         Ptr<MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << a << b);
+    NS_ABORT_MSG_IF(!m_trace, "No trace file has been set");
+    return txPowerDbm - m_trace->GetLossDb(PropagationLossTrace::GetNodeId(a),
+                                           PropagationLossTrace::GetNodeId(b),
+                                           0,
+                                           Simulator::Now(),
+                                           m_loop);
+}
+
+int64_t
+TracePropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return 0;
+}
+
+} // namespace ns3
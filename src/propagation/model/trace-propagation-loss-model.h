@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACE_PROPAGATION_LOSS_MODEL_H
+#define TRACE_PROPAGATION_LOSS_MODEL_H
+
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-loss-trace.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup propagation
+ *
+ * \brief A propagation loss model reading the loss between pairs of nodes
+ * from a precomputed trace (see PropagationLossTrace).
+ *
+ * The nodes are identified by the ID of the Node their mobility model is
+ * aggregated to. The trace must have a single band.
+ */
+class TracePropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    TracePropagationLossModel();
+    ~TracePropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    TracePropagationLossModel(const TracePropagationLossModel&) = delete;
+    TracePropagationLossModel& operator=(const TracePropagationLossModel&) = delete;
+
+    /**
+     * Map the given trace file in memory.
+     *
+     * \param fileName the name of the trace file
+     */
+    void SetTraceFileName(std::string fileName);
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    Ptr<const PropagationLossTrace> m_trace; //!< the trace
+    bool m_loop;                             //!< whether the trace is repeated periodically
+};
+
+} // namespace ns3
+
+#endif /* TRACE_PROPAGATION_LOSS_MODEL_H */
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/coherent-propagation-loss-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("CoherentPropagationLossModelTest");
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test the reuse of the loss by CoherentPropagationLossModel
+ *
+ * A LogDistancePropagationLossModel followed by a NakagamiPropagationLossModel
+ * is wrapped. The loss of a path must be reused while the nodes move by less
+ * than the distance threshold and within the coherence time, and computed
+ * again otherwise. Two wrappers with the same stream assignment must return the
+ * same sequence of received powers.
+ */
+class CoherentPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CoherentPropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \return a CoherentPropagationLossModel wrapping a LogDistancePropagationLossModel
+     *         followed by a NakagamiPropagationLossModel, with streams starting at 1
+     */
+    Ptr<CoherentPropagationLossModel> CreateLossModel();
+
+    /**
+     * Compute the received power with both loss models and check that they match.
+     *
+     * \param a the mobility model of the source
+     * \param b the mobility model of the destination
+     * \param reused whether the loss is expected to be reused
+     * \return the received power (dBm)
+     */
+    double CalcRxPower(Ptr<MobilityModel> a, Ptr<MobilityModel> b, bool reused);
+
+    Ptr<CoherentPropagationLossModel> m_lossModel;  //!< the loss model under test
+    Ptr<CoherentPropagationLossModel> m_otherModel; //!< an identical loss model
+};
+
+CoherentPropagationLossModelTestCase::CoherentPropagationLossModelTestCase()
+    : TestCase("Test the reuse of the loss by CoherentPropagationLossModel")
+{
+}
+
+Ptr<CoherentPropagationLossModel>
+CoherentPropagationLossModelTestCase::CreateLossModel()
+{
+    Ptr<PropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel>();
+    logDistance->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    Ptr<CoherentPropagationLossModel> lossModel = CreateObject<CoherentPropagationLossModel>();
+    lossModel->SetAttribute("PropagationLossModel", PointerValue(logDistance));
+    lossModel->SetAttribute("DistanceThreshold", DoubleValue(0.01));
+    lossModel->SetAttribute("CoherenceTime", TimeValue(MilliSeconds(10)));
+    NS_TEST_EXPECT_MSG_GT(lossModel->AssignStreams(1), 0, "The Nakagami model uses streams");
+    return lossModel;
+}
+
+double
+CoherentPropagationLossModelTestCase::CalcRxPower(Ptr<MobilityModel> a,
+                                                  Ptr<MobilityModel> b,
+                                                  bool reused)
+{
+    uint64_t nReuses = m_lossModel->GetNReuses();
+    uint64_t nCalculations = m_lossModel->GetNCalculations();
+    double rxPower = m_lossModel->CalcRxPower(20, a, b);
+    NS_TEST_EXPECT_MSG_EQ(m_lossModel->GetNReuses(),
+                          nReuses + (reused ? 1 : 0),
+                          "Unexpected number of reuses at " << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ(m_lossModel->GetNCalculations(),
+                          nCalculations + (reused ? 0 : 1),
+                          "Unexpected number of calculations at " << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ(m_otherModel->CalcRxPower(20, a, b),
+                          rxPower,
+                          "The results are not reproducible");
+    // a different transmission power is affected by the same loss
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_lossModel->CalcRxPower(10, a, b),
+                              rxPower - 10,
+                              1e-9,
+                              "The loss should not depend on the transmission power");
+    m_otherModel->CalcRxPower(10, a, b);
+    return rxPower;
+}
+
+void
+CoherentPropagationLossModelTestCase::DoRun()
+{
+    m_lossModel = CreateLossModel();
+    m_otherModel = CreateLossModel();
+
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(50, 0, 0));
+
+    double rxPower = CalcRxPower(a, b, false);
+    NS_TEST_EXPECT_MSG_EQ(CalcRxPower(a, b, true), rxPower, "The loss should be reused");
+
+    // the path b-->a is distinct from the path a-->b
+    CalcRxPower(b, a, false);
+
+    // moving by 5 mm does not change the loss, moving by further 10 mm does
+    b->SetPosition(Vector(50.005, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ(CalcRxPower(a, b, true), rxPower, "The loss should be reused");
+    a->SetPosition(Vector(0, 0.015, 0));
+    double newRxPower = CalcRxPower(a, b, false);
+    NS_TEST_EXPECT_MSG_NE(newRxPower, rxPower, "A new fading gain should have been drawn");
+
+    // the loss is computed again when the coherence time has elapsed
+    Simulator::Schedule(MilliSeconds(9), [this, a, b, newRxPower]() {
+        NS_TEST_EXPECT_MSG_EQ(CalcRxPower(a, b, true), newRxPower, "The loss should be reused");
+    });
+    Simulator::Schedule(MilliSeconds(10), [this, a, b, newRxPower]() {
+        NS_TEST_EXPECT_MSG_NE(CalcRxPower(a, b, false),
+                              newRxPower,
+                              "A new fading gain should have been drawn");
+        // the path b-->a has not been used for longer than the coherence time
+        CalcRxPower(b, a, false);
+    });
+    Simulator::Run();
+
+    m_lossModel->Dispose();
+    m_otherModel->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief CoherentPropagationLossModel TestSuite
+ */
+class CoherentPropagationLossModelTestSuite : public TestSuite
+{
+  public:
+    CoherentPropagationLossModelTestSuite();
+};
+
+CoherentPropagationLossModelTestSuite::CoherentPropagationLossModelTestSuite()
+    : TestSuite("coherent-propagation-loss-model", UNIT)
+{
+    AddTestCase(new CoherentPropagationLossModelTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static CoherentPropagationLossModelTestSuite g_coherentPropagationLossModelTestSuite;
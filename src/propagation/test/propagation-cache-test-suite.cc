@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/jakes-propagation-loss-model.h"
+#include "ns3/log.h"
+#include "ns3/propagation-cache.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("PropagationCacheTest");
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test the eviction policies and the statistics of PropagationLruCache
+ *
+ * The least recently used entry must be evicted when the maximum size is
+ * reached and entries not accessed for longer than the maximum age must be
+ * evicted when looked up or when a new entry is added.
+ */
+class PropagationLruCacheTestCase : public TestCase
+{
+  public:
+    PropagationLruCacheTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the statistics of the cache and then its content, by looking up
+     * (and thus marking as recently used) the given keys in order
+     *
+     * \param present the keys expected to be in the cache
+     * \param hits the expected number of hits before the check
+     * \param misses the expected number of misses
+     * \param evictions the expected number of evictions
+     */
+    void CheckCache(const std::vector<uint32_t>& present,
+                    uint64_t hits,
+                    uint64_t misses,
+                    uint64_t evictions);
+
+    /// Check the eviction of the entries that have not been used for too long
+    void CheckMaxAge();
+
+    PropagationLruCache<uint32_t, double> m_cache; //!< the cache under test
+};
+
+PropagationLruCacheTestCase::PropagationLruCacheTestCase()
+    : TestCase("Test the eviction policies and the statistics of PropagationLruCache")
+{
+}
+
+void
+PropagationLruCacheTestCase::CheckCache(const std::vector<uint32_t>& present,
+                                        uint64_t hits,
+                                        uint64_t misses,
+                                        uint64_t evictions)
+{
+    NS_TEST_EXPECT_MSG_EQ(m_cache.GetStatistics().m_hits, hits, "Unexpected hits");
+    NS_TEST_EXPECT_MSG_EQ(m_cache.GetStatistics().m_misses, misses, "Unexpected misses");
+    NS_TEST_EXPECT_MSG_EQ(m_cache.GetStatistics().m_evictions, evictions, "Unexpected evictions");
+    NS_TEST_ASSERT_MSG_EQ(m_cache.GetSize(), present.size(), "Unexpected cache size");
+    for (auto key : present)
+    {
+        double* value = m_cache.Find(key);
+        NS_TEST_ASSERT_MSG_NE(value, nullptr, "Key " << key << " not found");
+        NS_TEST_EXPECT_MSG_EQ(*value, key * 10.0, "Unexpected value for key " << key);
+    }
+}
+
+void
+PropagationLruCacheTestCase::CheckMaxAge()
+{
+    // key 1 has been used at 1 s, key 2 at 0 s and key 3 has been inserted at 1 s
+    NS_TEST_EXPECT_MSG_EQ(m_cache.Find(2), nullptr, "Key 2 should have expired");
+    NS_TEST_EXPECT_MSG_NE(m_cache.Find(1), nullptr, "Key 1 should not have expired");
+    NS_TEST_EXPECT_MSG_EQ(m_cache.GetSize(), 2U, "Key 2 should have been removed");
+
+    // inserting a new entry at 2.6 s evicts key 3, while key 1 has just been used
+    Simulator::Schedule(Seconds(0.6), [this]() {
+        m_cache.Insert(4, 40.0);
+        NS_TEST_EXPECT_MSG_EQ(m_cache.GetSize(), 2U, "Key 3 should have been evicted");
+        NS_TEST_EXPECT_MSG_NE(m_cache.Find(1), nullptr, "Key 1 should not have expired");
+        NS_TEST_EXPECT_MSG_NE(m_cache.Find(4), nullptr, "Key 4 should be in the cache");
+        NS_TEST_EXPECT_MSG_EQ(m_cache.GetStatistics().m_evictions, 2U, "Unexpected evictions");
+    });
+}
+
+void
+PropagationLruCacheTestCase::DoRun()
+{
+    // unbounded cache
+    for (uint32_t key = 1; key <= 3; key++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_cache.Find(key), nullptr, "The cache should be empty");
+        m_cache.Insert(key, key * 10.0);
+    }
+    CheckCache({1, 2, 3}, 0, 3, 0);
+
+    // reducing the size evicts the least recently used entries (1 and 2)
+    m_cache.Find(3);
+    m_cache.SetMaxSize(1);
+    CheckCache({3}, 4, 3, 2);
+
+    // key 4 has been used more recently than key 3, hence key 3 is evicted when inserting key 5
+    m_cache.SetMaxSize(2);
+    m_cache.Insert(4, 40.0);
+    m_cache.Find(4);
+    m_cache.Insert(5, 50.0);
+    NS_TEST_EXPECT_MSG_EQ(m_cache.Find(3), nullptr, "Key 3 should have been evicted");
+    CheckCache({4, 5}, 6, 4, 3);
+
+    m_cache.Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_cache.GetSize(), 0U, "The cache should be empty");
+
+    // time-based eviction
+    m_cache = PropagationLruCache<uint32_t, double>();
+    m_cache.SetMaxAge(Seconds(1.5));
+    m_cache.Insert(1, 10.0);
+    m_cache.Insert(2, 20.0);
+    Simulator::Schedule(Seconds(1), [this]() {
+        m_cache.Find(1);
+        m_cache.Insert(3, 30.0);
+    });
+    Simulator::Schedule(Seconds(2), &PropagationLruCacheTestCase::CheckMaxAge, this);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test the bounded cache of JakesPropagationLossModel
+ *
+ * The Jakes process of a path must be shared by both directions of the path
+ * and the least recently used process must be evicted when the maximum size
+ * of the cache is reached.
+ */
+class JakesPropagationCacheTestCase : public TestCase
+{
+  public:
+    JakesPropagationCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+JakesPropagationCacheTestCase::JakesPropagationCacheTestCase()
+    : TestCase("Test the bounded cache of JakesPropagationLossModel")
+{
+}
+
+void
+JakesPropagationCacheTestCase::DoRun()
+{
+    Ptr<JakesPropagationLossModel> lossModel = CreateObject<JakesPropagationLossModel>();
+    lossModel->SetAttribute("CacheMaxSize", UintegerValue(2));
+
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        mobilities.push_back(CreateObject<ConstantPositionMobilityModel>());
+    }
+
+    // both directions of a path share the same process
+    double rxPowerAb = lossModel->CalcRxPower(0, mobilities[0], mobilities[1]);
+    double rxPowerBa = lossModel->CalcRxPower(0, mobilities[1], mobilities[0]);
+    NS_TEST_EXPECT_MSG_EQ(rxPowerAb, rxPowerBa, "The paths a-->b and b-->a should be the same");
+    const PropagationCacheStatistics& stats = lossModel->GetCacheStatistics();
+    NS_TEST_EXPECT_MSG_EQ(stats.m_hits, 1U, "Unexpected hits");
+    NS_TEST_EXPECT_MSG_EQ(stats.m_misses, 1U, "Unexpected misses");
+
+    // the third path evicts the least recently used one (0-->2)
+    lossModel->CalcRxPower(0, mobilities[0], mobilities[2]);
+    lossModel->CalcRxPower(0, mobilities[0], mobilities[1]);
+    lossModel->CalcRxPower(0, mobilities[0], mobilities[3]);
+    NS_TEST_EXPECT_MSG_EQ(stats.m_evictions, 1U, "Unexpected evictions");
+    lossModel->CalcRxPower(0, mobilities[1], mobilities[0]);
+    NS_TEST_EXPECT_MSG_EQ(stats.m_hits, 3U, "The path 0-->1 should not have been evicted");
+    lossModel->CalcRxPower(0, mobilities[2], mobilities[0]);
+    NS_TEST_EXPECT_MSG_EQ(stats.m_misses, 4U, "The path 0-->2 should have been evicted");
+    NS_TEST_EXPECT_MSG_EQ(stats.m_evictions, 2U, "Unexpected evictions");
+
+    lossModel->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Propagation cache TestSuite
+ */
+class PropagationCacheTestSuite : public TestSuite
+{
+  public:
+    PropagationCacheTestSuite();
+};
+
+PropagationCacheTestSuite::PropagationCacheTestSuite()
+    : TestSuite("propagation-cache", UNIT)
+{
+    AddTestCase(new PropagationLruCacheTestCase, TestCase::QUICK);
+    AddTestCase(new JakesPropagationCacheTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static PropagationCacheTestSuite g_propagationCacheTestSuite;
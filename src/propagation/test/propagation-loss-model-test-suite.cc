@@ -17,13 +17,16 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/jakes-propagation-loss-model.h"
 #include "ns3/log.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 using namespace ns3;
 
@@ -490,6 +493,120 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test the incremental update and the batched evaluation of the Jakes processes
+ *
+ * Three JakesPropagationLossModel instances with the same streams are used on
+ * the same paths: one whose processes rotate the phases of the oscillators, one
+ * whose processes compute the phases from scratch and one evaluated through
+ * GetChannelGainsDb. The process of the last path has fewer oscillators than
+ * the others. The gains must match at regular and irregular time steps, also
+ * after the periodic resynchronization of the incremental processes.
+ */
+class JakesIncrementalUpdateTestCase : public TestCase
+{
+  public:
+    JakesIncrementalUpdateTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Compare the gains of the three loss models on all the paths.
+     */
+    void CheckGains();
+
+    Ptr<JakesPropagationLossModel> m_incrementalModel; //!< the model rotating the phases
+    Ptr<JakesPropagationLossModel> m_directModel;      //!< the model computing the phases
+    Ptr<JakesPropagationLossModel> m_batchModel;       //!< the model evaluated in batches
+    /// the paths
+    std::vector<std::pair<Ptr<MobilityModel>, Ptr<MobilityModel>>> m_paths;
+};
+
+JakesIncrementalUpdateTestCase::JakesIncrementalUpdateTestCase()
+    : TestCase("Test the incremental update and the batched evaluation of the Jakes processes")
+{
+}
+
+void
+JakesIncrementalUpdateTestCase::CheckGains()
+{
+    std::vector<double> batchGainsDb = m_batchModel->GetChannelGainsDb(m_paths);
+    NS_TEST_ASSERT_MSG_EQ(batchGainsDb.size(), m_paths.size(), "Unexpected number of gains");
+    for (std::size_t i = 0; i < m_paths.size(); i++)
+    {
+        const auto& [a, b] = m_paths[i];
+        double directGainDb = m_directModel->CalcRxPower(0, a, b);
+        NS_TEST_EXPECT_MSG_EQ(batchGainsDb[i],
+                              directGainDb,
+                              "Unexpected batched gain at " << Simulator::Now().As(Time::S));
+        NS_TEST_EXPECT_MSG_EQ_TOL(m_incrementalModel->CalcRxPower(0, a, b),
+                                  directGainDb,
+                                  1e-6,
+                                  "Unexpected incremental gain at "
+                                      << Simulator::Now().As(Time::S));
+    }
+}
+
+void
+JakesIncrementalUpdateTestCase::DoRun()
+{
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        mobilities.push_back(CreateObject<ConstantPositionMobilityModel>());
+    }
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        m_paths.emplace_back(mobilities[i], mobilities[(i + 1) % 4]);
+    }
+
+    m_incrementalModel = CreateObject<JakesPropagationLossModel>();
+    m_directModel = CreateObject<JakesPropagationLossModel>();
+    m_batchModel = CreateObject<JakesPropagationLossModel>();
+    m_incrementalModel->AssignStreams(1);
+    m_directModel->AssignStreams(1);
+    m_batchModel->AssignStreams(1);
+
+    // the processes are created by the first evaluation
+    for (std::size_t i = 0; i < m_paths.size(); i++)
+    {
+        const auto& [a, b] = m_paths[i];
+        Config::SetDefault("ns3::JakesProcess::NumberOfOscillators",
+                           UintegerValue(i + 1 < m_paths.size() ? 20 : 7));
+        Config::SetDefault("ns3::JakesProcess::IncrementalUpdate", BooleanValue(true));
+        m_incrementalModel->CalcRxPower(0, a, b);
+        Config::SetDefault("ns3::JakesProcess::IncrementalUpdate", BooleanValue(false));
+        m_directModel->CalcRxPower(0, a, b);
+        m_batchModel->GetChannelGainsDb({m_paths[i]});
+    }
+    Config::SetDefault("ns3::JakesProcess::NumberOfOscillators", UintegerValue(20));
+    CheckGains();
+
+    // regular steps, beyond the resynchronization interval of the processes
+    Time now;
+    for (uint32_t i = 0; i < 1200; i++)
+    {
+        now += MilliSeconds(1);
+        Simulator::Schedule(now, &JakesIncrementalUpdateTestCase::CheckGains, this);
+    }
+    // irregular steps
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        now += MicroSeconds(100 + (i * 7919) % 5000);
+        Simulator::Schedule(now, &JakesIncrementalUpdateTestCase::CheckGains, this);
+    }
+    Simulator::Run();
+
+    m_incrementalModel->Dispose();
+    m_directModel->Dispose();
+    m_batchModel->Dispose();
+    m_paths.clear();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -501,6 +618,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - JakesPropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -516,6 +634,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new JakesIncrementalUpdateTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
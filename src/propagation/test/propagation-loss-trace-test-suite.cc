@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/propagation-loss-trace.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/trace-propagation-loss-model.h"
+
+#include <tuple>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("PropagationLossTraceTest");
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test the interpolation of the losses read from a PropagationLossTrace
+ *
+ * A trace of 3 nodes, 2 bands and 4 samples, taken every 0.5 s from 1 s, is
+ * written and mapped. The loss of sample s in band f between nodes i and j is
+ * 100 i + 10 j + s + 0.5 f dB. The losses must be linearly interpolated between
+ * the samples, and either held or repeated outside of the trace.
+ */
+class PropagationLossTraceTestCase : public TestCase
+{
+  public:
+    PropagationLossTraceTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PropagationLossTraceTestCase::PropagationLossTraceTestCase()
+    : TestCase("Test the interpolation of the losses read from a PropagationLossTrace")
+{
+}
+
+void
+PropagationLossTraceTestCase::DoRun()
+{
+    const uint32_t numNodes = 3;
+    const uint32_t numBands = 2;
+    const uint32_t numSamples = 4;
+    std::vector<float> lossDb;
+    for (uint32_t i = 0; i < numNodes; i++)
+    {
+        for (uint32_t j = 0; j < numNodes; j++)
+        {
+            for (uint32_t s = 0; s < numSamples; s++)
+            {
+                for (uint32_t f = 0; f < numBands; f++)
+                {
+                    lossDb.push_back(100 * i + 10 * j + s + 0.5 * f);
+                }
+            }
+        }
+    }
+    std::string fileName = CreateTempDirFilename("loss-trace.bin");
+    PropagationLossTrace::Write(fileName,
+                                numNodes,
+                                numBands,
+                                numSamples,
+                                Seconds(1),
+                                MilliSeconds(500),
+                                lossDb);
+
+    Ptr<const PropagationLossTrace> trace = Create<const PropagationLossTrace>(fileName);
+    NS_TEST_ASSERT_MSG_EQ(trace->GetNumNodes(), numNodes, "Unexpected number of nodes");
+    NS_TEST_ASSERT_MSG_EQ(trace->GetNumBands(), numBands, "Unexpected number of bands");
+    NS_TEST_ASSERT_MSG_EQ(trace->GetNumSamples(), numSamples, "Unexpected number of samples");
+
+    // (time, expected sample position without and with loop)
+    std::vector<std::tuple<Time, double, double>> checks{
+        {Seconds(0.75), 0, 3.5},
+        {Seconds(1), 0, 0},
+        {Seconds(1.25), 0.5, 0.5},
+        {Seconds(2.2), 2.4, 2.4},
+        {Seconds(2.75), 3, 3.5},
+        {Seconds(3.25), 3, 0.5},
+    };
+    for (const auto& [time, position, loopPosition] : checks)
+    {
+        // between the last and the first sample, the loss goes from 3 back to 0
+        double loopOffset = (loopPosition > 3 ? -4 * (loopPosition - 3) : 0);
+        for (uint32_t f = 0; f < numBands; f++)
+        {
+            NS_TEST_EXPECT_MSG_EQ_TOL(trace->GetLossDb(2, 1, f, time, false),
+                                      210 + position + 0.5 * f,
+                                      1e-4,
+                                      "Unexpected loss at " << time.As(Time::S));
+            NS_TEST_EXPECT_MSG_EQ_TOL(trace->GetLossDb(2, 1, f, time, true),
+                                      210 + loopPosition + loopOffset + 0.5 * f,
+                                      1e-4,
+                                      "Unexpected loss at " << time.As(Time::S) << " with loop");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ_TOL(trace->GetLossDb(1, 2, 0, Seconds(1.5), false),
+                              121,
+                              1e-4,
+                              "The losses of the two directions of a path are distinct");
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Test the TracePropagationLossModel
+ *
+ * The loss between two nodes must be read from a single-band trace according
+ * to the IDs of the nodes and the current simulation time.
+ */
+class TracePropagationLossModelTestCase : public TestCase
+{
+  public:
+    TracePropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+TracePropagationLossModelTestCase::TracePropagationLossModelTestCase()
+    : TestCase("Test the TracePropagationLossModel")
+{
+}
+
+void
+TracePropagationLossModelTestCase::DoRun()
+{
+    // the loss between nodes i and j is 50 + 10 i + j dB, increasing by 20 dB per second
+    std::vector<float> lossDb;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        for (uint32_t j = 0; j < 2; j++)
+        {
+            lossDb.push_back(50 + 10 * i + j);
+            lossDb.push_back(70 + 10 * i + j);
+        }
+    }
+    std::string fileName = CreateTempDirFilename("loss-trace.bin");
+    PropagationLossTrace::Write(fileName, 2, 1, 2, Seconds(0), Seconds(1), lossDb);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        mobilities.push_back(CreateObject<ConstantPositionMobilityModel>());
+        nodes.Get(i)->AggregateObject(mobilities.back());
+    }
+
+    Ptr<TracePropagationLossModel> lossModel = CreateObject<TracePropagationLossModel>();
+    lossModel->SetAttribute("TraceFileName", StringValue(fileName));
+    lossModel->SetAttribute("Loop", BooleanValue(false));
+    NS_TEST_ASSERT_MSG_EQ(nodes.Get(0)->GetId(), 0, "The trace only has nodes 0 and 1");
+    NS_TEST_ASSERT_MSG_EQ(nodes.Get(1)->GetId(), 1, "The trace only has nodes 0 and 1");
+
+    Simulator::Schedule(MilliSeconds(250), [this, lossModel, mobilities]() {
+        NS_TEST_EXPECT_MSG_EQ_TOL(lossModel->CalcRxPower(20, mobilities[0], mobilities[1]),
+                                  20 - 56,
+                                  1e-4,
+                                  "Unexpected received power from node 0 to node 1");
+        NS_TEST_EXPECT_MSG_EQ_TOL(lossModel->CalcRxPower(20, mobilities[1], mobilities[0]),
+                                  20 - 65,
+                                  1e-4,
+                                  "Unexpected received power from node 1 to node 0");
+    });
+    Simulator::Schedule(Seconds(2), [this, lossModel, mobilities]() {
+        NS_TEST_EXPECT_MSG_EQ_TOL(lossModel->CalcRxPower(20, mobilities[0], mobilities[1]),
+                                  20 - 71,
+                                  1e-4,
+                                  "The last sample should be used after the trace");
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Propagation loss trace TestSuite
+ */
+class PropagationLossTraceTestSuite : public TestSuite
+{
+  public:
+    PropagationLossTraceTestSuite();
+};
+
+PropagationLossTraceTestSuite::PropagationLossTraceTestSuite()
+    : TestSuite("propagation-loss-trace", UNIT)
+{
+    AddTestCase(new PropagationLossTraceTestCase, TestCase::QUICK);
+    AddTestCase(new TracePropagationLossModelTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static PropagationLossTraceTestSuite g_propagationLossTraceTestSuite;
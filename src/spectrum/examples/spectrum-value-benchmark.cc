@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program benchmarks the SpectrumValue arithmetic performed for every
+// received signal by the spectrum-based PHY layers. Two pipelines are timed:
+//
+// - Wi-Fi: a PSD defined over the subcarriers of an 80 MHz channel is scaled by
+//   the path gain, added to the sum of all the signals being received and the
+//   SINR of the chunk, i.e., rx / (all - rx + noise), is computed
+// - LTE: a PSD defined over 100 resource blocks is added to the sum of all the
+//   signals, the interference and the SINR of the chunk are computed and the
+//   SINR is accumulated, weighted by the chunk duration, as done by the chunk
+//   processors
+//
+// Each pipeline is run both by chaining the arithmetic operators of SpectrumValue
+// (which create a temporary object for every operation) and by using the fused
+// in-place operations (AddScaled, AddDifference, SetRatio) on reused buffers.
+// The program reports the time per iteration of both versions and checks that
+// they produce the same result:
+//
+//   ./ns3 run "spectrum-value-benchmark --iterations=100000"
+//
+
+#include <ns3/command-line.h>
+#include <ns3/spectrum-model.h>
+#include <ns3/spectrum-value.h>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * Create a spectrum model made of contiguous bands of the same width.
+ *
+ * \param centerFrequency the center frequency (Hz) of the model
+ * \param nBands the number of bands
+ * \param bandWidth the width (Hz) of each band
+ * \return the spectrum model
+ */
+Ptr<SpectrumModel>
+CreateModel(double centerFrequency, uint32_t nBands, double bandWidth)
+{
+    Bands bands;
+    double fl = centerFrequency - nBands * bandWidth / 2;
+    for (uint32_t i = 0; i < nBands; i++)
+    {
+        BandInfo info;
+        info.fl = fl + i * bandWidth;
+        info.fc = info.fl + bandWidth / 2;
+        info.fh = info.fl + bandWidth;
+        bands.push_back(info);
+    }
+    return Create<SpectrumModel>(std::move(bands));
+}
+
+/**
+ * Fill the given SpectrumValue with a deterministic, positive PSD.
+ *
+ * \param value the SpectrumValue to fill
+ * \param level the average level of the PSD
+ */
+void
+FillPsd(SpectrumValue& value, double level)
+{
+    for (uint32_t i = 0; i < value.GetValuesN(); i++)
+    {
+        value[i] = level * (1.5 + std::sin(0.1 * i));
+    }
+}
+
+/**
+ * \param a the first SpectrumValue
+ * \param b the second SpectrumValue
+ * \return the largest relative difference between the components of a and b
+ */
+double
+MaxRelativeDifference(const SpectrumValue& a, const SpectrumValue& b)
+{
+    double maxDiff = 0;
+    for (uint32_t i = 0; i < a.GetValuesN(); i++)
+    {
+        maxDiff = std::max(maxDiff, std::abs(a[i] - b[i]) / std::abs(b[i]));
+    }
+    return maxDiff;
+}
+
+/**
+ * Run the given pipeline for the given number of iterations.
+ *
+ * \tparam F the type of the pipeline
+ * \param pipeline the pipeline
+ * \param iterations the number of iterations
+ * \return the time per iteration in nanoseconds
+ */
+template <class F>
+double
+MeasureTime(F pipeline, uint32_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        pipeline();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+}
+
+/**
+ * Print the results of a benchmark.
+ *
+ * \param name the name of the pipeline
+ * \param nBands the number of bands of the spectrum model
+ * \param operatorsNs the time per iteration (ns) of the version using the operators
+ * \param fusedNs the time per iteration (ns) of the version using the fused operations
+ * \param maxDiff the largest relative difference between the results of the two versions
+ */
+void
+PrintResults(std::string name,
+             uint32_t nBands,
+             double operatorsNs,
+             double fusedNs,
+             double maxDiff)
+{
+    std::cout << name << " (" << nBands << " bands)" << std::endl
+              << std::fixed << std::setprecision(1)
+              << "  operators: " << operatorsNs << " ns/iteration" << std::endl
+              << "  fused:     " << fusedNs << " ns/iteration" << std::endl
+              << "  speedup:   " << std::setprecision(2) << operatorsNs / fusedNs << std::endl
+              << "  max relative difference: " << std::scientific << maxDiff << std::defaultfloat
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t iterations = 20000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("iterations", "Number of iterations of each pipeline", iterations);
+    cmd.Parse(argc, argv);
+
+    // Wi-Fi: 80 MHz channel with 78.125 kHz subcarriers, plus guard bands
+    {
+        auto model = CreateModel(5210e6, 1024 + 2 * 64, 78125);
+        SpectrumValue txPsd(model);
+        SpectrumValue noise(model);
+        SpectrumValue others(model);
+        FillPsd(txPsd, 1e-9);
+        FillPsd(noise, 1e-20);
+        FillPsd(others, 1e-15);
+        double pathGain = 1e-7;
+
+        SpectrumValue sinrOperators;
+        double operatorsNs = MeasureTime(
+            [&]() {
+                SpectrumValue rxPsd = txPsd * pathGain;
+                SpectrumValue allSignals = others + rxPsd;
+                sinrOperators = rxPsd / (allSignals - rxPsd + noise);
+            },
+            iterations);
+
+        SpectrumValue rxPsd(model);
+        SpectrumValue allSignals(model);
+        SpectrumValue interf(model);
+        SpectrumValue sinrFused;
+        double fusedNs = MeasureTime(
+            [&]() {
+                rxPsd = 0.0;
+                rxPsd.AddScaled(txPsd, pathGain);
+                allSignals = others;
+                allSignals += rxPsd;
+                interf = noise;
+                interf.AddDifference(allSignals, rxPsd);
+                sinrFused.SetRatio(rxPsd, interf);
+            },
+            iterations);
+
+        PrintResults("Wi-Fi PSD pipeline",
+                     model->GetNumBands(),
+                     operatorsNs,
+                     fusedNs,
+                     MaxRelativeDifference(sinrFused, sinrOperators));
+    }
+
+    // LTE: 20 MHz channel made of 100 resource blocks
+    {
+        auto model = CreateModel(2120e6, 100, 180e3);
+        SpectrumValue rxSignal(model);
+        SpectrumValue noise(model);
+        SpectrumValue others(model);
+        FillPsd(rxSignal, 1e-16);
+        FillPsd(noise, 1e-20);
+        FillPsd(others, 1e-17);
+        double duration = 71.4e-6; // one OFDM symbol
+
+        SpectrumValue sumOperators(model);
+        double operatorsNs = MeasureTime(
+            [&]() {
+                SpectrumValue allSignals = others + rxSignal;
+                SpectrumValue interf = allSignals - rxSignal + noise;
+                SpectrumValue sinr = rxSignal / interf;
+                sumOperators += sinr * duration;
+            },
+            iterations);
+
+        SpectrumValue allSignals(model);
+        SpectrumValue interf(model);
+        SpectrumValue sinr(model);
+        SpectrumValue sumFused(model);
+        double fusedNs = MeasureTime(
+            [&]() {
+                allSignals = others;
+                allSignals += rxSignal;
+                interf = noise;
+                interf.AddDifference(allSignals, rxSignal);
+                sinr.SetRatio(rxSignal, interf);
+                sumFused.AddScaled(sinr, duration);
+            },
+            iterations);
+
+        PrintResults("LTE PSD pipeline",
+                     model->GetNumBands(),
+                     operatorsNs,
+                     fusedNs,
+                     MaxRelativeDifference(sumFused, sumOperators));
+    }
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program benchmarks the generation of the channel matrices by the
+// ThreeGppChannelModel in a 3GPP UMi-StreetCanyon scenario. A number of base
+// stations, each equipped with a uniform planar array, are placed along a street
+// and serve user terminals, equipped with smaller arrays, randomly dropped around
+// them. The channel matrices between all the base stations and all the user
+// terminals are generated at the beginning of each update period, for a number
+// of update periods, in two ways:
+//
+// - one by one, calling ThreeGppChannelModel::GetChannel for each pair of nodes
+// - in a batch, calling ThreeGppChannelModel::GetChannels for all the pairs, with
+//   the coefficients of the matrices computed by the given number of threads
+//
+// The program reports the time per channel matrix of both versions and checks
+// that they produce the same matrices:
+//
+//   ./ns3 run "three-gpp-channel-benchmark --numUt=40 --batchThreads=4"
+//
+
+#include <ns3/channel-condition-model.h>
+#include <ns3/command-line.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/isotropic-antenna-model.h>
+#include <ns3/node-container.h>
+#include <ns3/pointer.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/three-gpp-channel-model.h>
+#include <ns3/uinteger.h>
+#include <ns3/uniform-planar-array.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * Create a channel model for the UMi-StreetCanyon scenario, using fixed random streams.
+ *
+ * \param frequency the carrier frequency (Hz)
+ * \param updatePeriod the update period of the channel
+ * \param batchThreads the number of threads computing the channel matrices in a batch
+ * \return the channel model
+ */
+Ptr<ThreeGppChannelModel>
+CreateChannelModel(double frequency, Time updatePeriod, uint32_t batchThreads)
+{
+    Ptr<ChannelConditionModel> conditionModel =
+        CreateObject<ThreeGppUmiStreetCanyonChannelConditionModel>();
+    conditionModel->AssignStreams(100);
+
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(frequency));
+    channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    channelModel->SetAttribute("ChannelConditionModel", PointerValue(conditionModel));
+    channelModel->SetAttribute("UpdatePeriod", TimeValue(updatePeriod));
+    channelModel->SetAttribute("BatchThreads", UintegerValue(batchThreads));
+    channelModel->AssignStreams(1);
+    return channelModel;
+}
+
+/**
+ * Generate the channel matrices of all the requests at the beginning of each
+ * update period.
+ *
+ * \param channelModel the channel model
+ * \param requests the requests
+ * \param updatePeriod the update period of the channel
+ * \param periods the number of update periods
+ * \param batch whether GetChannels is used rather than GetChannel
+ * \param[out] matrices the generated channel matrices
+ * \return the time per channel matrix in microseconds
+ */
+double
+MeasureTime(Ptr<ThreeGppChannelModel> channelModel,
+            const std::vector<ThreeGppChannelModel::ChannelRequest>& requests,
+            Time updatePeriod,
+            uint32_t periods,
+            bool batch,
+            std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix>>& matrices)
+{
+    matrices.clear();
+    std::chrono::steady_clock::duration elapsed{0};
+    for (uint32_t period = 0; period < periods; period++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (batch)
+        {
+            auto batchMatrices = channelModel->GetChannels(requests);
+            matrices.insert(matrices.end(), batchMatrices.begin(), batchMatrices.end());
+        }
+        else
+        {
+            for (const auto& request : requests)
+            {
+                matrices.push_back(channelModel->GetChannel(request.aMob,
+                                                            request.bMob,
+                                                            request.aAntenna,
+                                                            request.bAntenna));
+            }
+        }
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        // move to the next update period
+        Simulator::Stop(updatePeriod + NanoSeconds(1));
+        Simulator::Run();
+    }
+    Simulator::Destroy();
+    return std::chrono::duration<double, std::micro>(elapsed).count() / matrices.size();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t numBs = 3;
+    uint32_t numUt = 20;
+    uint32_t bsArraySize = 8;
+    uint32_t utArraySize = 2;
+    uint32_t periods = 5;
+    uint32_t batchThreads = 1;
+    double frequency = 28e9;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("numBs", "Number of base stations", numBs);
+    cmd.AddValue("numUt", "Number of user terminals per base station", numUt);
+    cmd.AddValue("bsArraySize", "Number of rows and columns of the BS arrays", bsArraySize);
+    cmd.AddValue("utArraySize", "Number of rows and columns of the UT arrays", utArraySize);
+    cmd.AddValue("periods", "Number of update periods", periods);
+    cmd.AddValue("batchThreads", "Number of threads computing the matrices", batchThreads);
+    cmd.AddValue("frequency", "Carrier frequency (Hz)", frequency);
+    cmd.Parse(argc, argv);
+
+    Time updatePeriod = MilliSeconds(1);
+
+    // the base stations are placed every 200 m along a street, the user terminals
+    // are dropped within 100 m from their base station
+    Ptr<UniformRandomVariable> drop = CreateObject<UniformRandomVariable>();
+    drop->SetStream(1000);
+    NodeContainer nodes;
+    nodes.Create(numBs * (numUt + 1));
+    std::vector<Ptr<MobilityModel>> mobilities;
+    std::vector<Ptr<PhasedArrayModel>> antennas;
+    for (uint32_t i = 0; i < nodes.GetN(); i++)
+    {
+        uint32_t bsIndex = i / (numUt + 1);
+        bool isBs = (i % (numUt + 1) == 0);
+        Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel>();
+        if (isBs)
+        {
+            mobility->SetPosition(Vector(200.0 * bsIndex, 0.0, 10.0));
+        }
+        else
+        {
+            mobility->SetPosition(Vector(200.0 * bsIndex + drop->GetValue(-100, 100),
+                                         drop->GetValue(-100, 100),
+                                         1.5));
+        }
+        nodes.Get(i)->AggregateObject(mobility);
+        mobilities.push_back(mobility);
+
+        uint32_t arraySize = isBs ? bsArraySize : utArraySize;
+        antennas.push_back(CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(arraySize),
+            "NumRows",
+            UintegerValue(arraySize),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>())));
+    }
+
+    // the channels between each base station and all the user terminals
+    std::vector<ThreeGppChannelModel::ChannelRequest> requests;
+    for (uint32_t bs = 0; bs < nodes.GetN(); bs += numUt + 1)
+    {
+        for (uint32_t ut = 0; ut < nodes.GetN(); ut++)
+        {
+            if (ut % (numUt + 1) != 0)
+            {
+                requests.push_back({mobilities[bs], mobilities[ut], antennas[bs], antennas[ut]});
+            }
+        }
+    }
+
+    std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix>> sequentialMatrices;
+    double sequentialUs = MeasureTime(CreateChannelModel(frequency, updatePeriod, 0),
+                                      requests,
+                                      updatePeriod,
+                                      periods,
+                                      false,
+                                      sequentialMatrices);
+
+    std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix>> batchMatrices;
+    double batchUs = MeasureTime(CreateChannelModel(frequency, updatePeriod, batchThreads),
+                                 requests,
+                                 updatePeriod,
+                                 periods,
+                                 true,
+                                 batchMatrices);
+
+    uint64_t differences = 0;
+    for (std::size_t i = 0; i < sequentialMatrices.size(); i++)
+    {
+        const auto& h1 = sequentialMatrices[i]->m_channel;
+        const auto& h2 = batchMatrices[i]->m_channel;
+        for (std::size_t u = 0; u < h1.GetNumRows(); u++)
+        {
+            for (std::size_t s = 0; s < h1.GetNumCols(); s++)
+            {
+                for (std::size_t n = 0; n < h1.GetNumPages(); n++)
+                {
+                    differences += (h1(u, s, n) != h2(u, s, n));
+                }
+            }
+        }
+    }
+
+    std::cout << "UMi-StreetCanyon, " << numBs << " BSs (" << bsArraySize << "x" << bsArraySize
+              << " arrays), " << numBs * numUt << " UTs (" << utArraySize << "x" << utArraySize
+              << " arrays), " << requests.size() << " channels, " << periods << " update periods"
+              << std::endl
+              << std::fixed << std::setprecision(1)
+              << "  one by one: " << sequentialUs << " us/matrix" << std::endl
+              << "  batch:      " << batchUs << " us/matrix (" << batchThreads << " threads)"
+              << std::endl
+              << "  speedup:    " << std::setprecision(2) << sequentialUs / batchUs << std::endl
+              << "  differing coefficients: " << differences << std::endl;
+
+    return (differences == 0 ? 0 : 1);
+}
@@ -22,13 +22,15 @@
 #ifndef MATRIX_BASED_CHANNEL_H
 #define MATRIX_BASED_CHANNEL_H
 
-// #include <complex>
+#include <ns3/assert.h>
 #include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/phased-array-model.h>
 #include <ns3/vector.h>
 
+#include <complex>
 #include <tuple>
+#include <vector>
 
 namespace ns3
 {
@@ -56,8 +58,119 @@ class MatrixBasedChannelModel : public Object
         Double3DVector; //!< type definition for 3D matrices of doubles
     typedef std::vector<PhasedArrayModel::ComplexVector>
         Complex2DVector; //!< type definition for complex matrices
-    typedef std::vector<Complex2DVector>
-        Complex3DVector; //!< type definition for complex 3D matrices
+
+    /**
+     * A 3D matrix of complex values whose elements are stored contiguously in
+     * memory. The element (u, s, n) is stored at position
+     * (u * numCols + s) * numPages + n, hence the values of the third index of a
+     * given (u, s) pair (e.g., the clusters of a pair of antenna elements in the
+     * channel matrix H[u][s][n]) are contiguous and can be accessed through a
+     * pointer returned by GetValues.
+     */
+    class Complex3DVector
+    {
+      public:
+        /**
+         * Create an empty matrix
+         */
+        Complex3DVector() = default;
+
+        /**
+         * Create a matrix with all the elements set to zero
+         *
+         * \param numRows the size of the first dimension
+         * \param numCols the size of the second dimension
+         * \param numPages the size of the third dimension
+         */
+        Complex3DVector(std::size_t numRows, std::size_t numCols, std::size_t numPages)
+            : m_numRows(numRows),
+              m_numCols(numCols),
+              m_numPages(numPages),
+              m_values(numRows * numCols * numPages)
+        {
+        }
+
+        /**
+         * \return the size of the first dimension
+         */
+        std::size_t GetNumRows() const
+        {
+            return m_numRows;
+        }
+
+        /**
+         * \return the size of the second dimension
+         */
+        std::size_t GetNumCols() const
+        {
+            return m_numCols;
+        }
+
+        /**
+         * \return the size of the third dimension
+         */
+        std::size_t GetNumPages() const
+        {
+            return m_numPages;
+        }
+
+        /**
+         * \param rowIndex the index of the first dimension
+         * \param colIndex the index of the second dimension
+         * \param pageIndex the index of the third dimension
+         * \return a reference to the element (rowIndex, colIndex, pageIndex)
+         */
+        std::complex<double>& operator()(std::size_t rowIndex,
+                                         std::size_t colIndex,
+                                         std::size_t pageIndex)
+        {
+            NS_ASSERT(rowIndex < m_numRows && colIndex < m_numCols && pageIndex < m_numPages);
+            return m_values[(rowIndex * m_numCols + colIndex) * m_numPages + pageIndex];
+        }
+
+        /**
+         * \param rowIndex the index of the first dimension
+         * \param colIndex the index of the second dimension
+         * \param pageIndex the index of the third dimension
+         * \return a const reference to the element (rowIndex, colIndex, pageIndex)
+         */
+        const std::complex<double>& operator()(std::size_t rowIndex,
+                                               std::size_t colIndex,
+                                               std::size_t pageIndex) const
+        {
+            NS_ASSERT(rowIndex < m_numRows && colIndex < m_numCols && pageIndex < m_numPages);
+            return m_values[(rowIndex * m_numCols + colIndex) * m_numPages + pageIndex];
+        }
+
+        /**
+         * \param rowIndex the index of the first dimension
+         * \param colIndex the index of the second dimension
+         * \return a pointer to the GetNumPages () contiguous elements (rowIndex, colIndex, *)
+         */
+        std::complex<double>* GetValues(std::size_t rowIndex, std::size_t colIndex)
+        {
+            NS_ASSERT(rowIndex < m_numRows && colIndex < m_numCols);
+            return m_values.data() + (rowIndex * m_numCols + colIndex) * m_numPages;
+        }
+
+        /**
+         * \param rowIndex the index of the first dimension
+         * \param colIndex the index of the second dimension
+         * \return a const pointer to the GetNumPages () contiguous elements
+         *         (rowIndex, colIndex, *)
+         */
+        const std::complex<double>* GetValues(std::size_t rowIndex, std::size_t colIndex) const
+        {
+            NS_ASSERT(rowIndex < m_numRows && colIndex < m_numCols);
+            return m_values.data() + (rowIndex * m_numCols + colIndex) * m_numPages;
+        }
+
+      private:
+        std::size_t m_numRows{0};                   //!< the size of the first dimension
+        std::size_t m_numCols{0};                   //!< the size of the second dimension
+        std::size_t m_numPages{0};                  //!< the size of the third dimension
+        std::vector<std::complex<double>> m_values; //!< the elements of the matrix
+    };
 
     /**
      * Data structure that stores a channel realization
@@ -22,6 +22,7 @@
 
 #include <ns3/angles.h>
 #include <ns3/antenna-model.h>
+#include <ns3/constant-position-mobility-model.h>
 #include <ns3/double.h>
 #include <ns3/log.h>
 #include <ns3/mobility-model.h>
@@ -36,9 +37,12 @@
 #include <ns3/spectrum-converter.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/uinteger.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <utility>
 
 namespace ns3
@@ -81,7 +85,10 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_nDeliveries{0},
+      m_nCulledDeliveries{0},
+      m_parallelRxThreads{0}
 {
     NS_LOG_FUNCTION(this);
 }
@@ -92,6 +99,16 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_rxSpatialIndices.clear();
+    for (auto& mobility : m_trackedMobilities)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&MultiModelSpectrumChannel::NotifyRxCourseChange, this));
+    }
+    m_trackedMobilities.clear();
+    m_pendingRx.clear();
+    m_threadPool = nullptr;
     SpectrumChannel::DoDispose();
 }
 
@@ -102,8 +119,40 @@ MultiModelSpectrumChannel::GetTypeId()
                             .SetParent<SpectrumChannel>()
                             .SetGroupName("Spectrum")
                             .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+                            .AddAttribute("RxCullingDistance",
+                                          "Signals are not delivered to the receivers that "
+                                          "are farther than this distance (m) from the "
+                                          "transmitter, without computing the path loss. "
+                                          "Receivers with a constant position are stored in "
+                                          "a grid to avoid even considering the distant ones. "
+                                          "A value of zero disables distance-based culling.",
+                                          DoubleValue(0.0),
+                                          MakeDoubleAccessor(
+                                              &MultiModelSpectrumChannel::m_rxCullingDistance),
+                                          MakeDoubleChecker<double>(0.0))
+                            .AddAttribute("MinRxPowerDbm",
+                                          "Signals whose received power, computed as the "
+                                          "transmit power minus the single-frequency path "
+                                          "loss (including antenna gains), is below this "
+                                          "value are not delivered to the receiver. The "
+                                          "default value, minus infinity, disables this "
+                                          "check, and considers all signals for reception.",
+                                          DoubleValue(-std::numeric_limits<double>::infinity()),
+                                          MakeDoubleAccessor(
+                                              &MultiModelSpectrumChannel::m_minRxPowerDbm),
+                                          MakeDoubleChecker<double>(
+                                              -std::numeric_limits<double>::infinity()))
+                            .AddAttribute("ParallelRxThreads",
+                                          "If a PhasedArraySpectrumPropagationLossModel is "
+                                          "used and this value is not zero, the received "
+                                          "PSDs of all the receivers of a signal are computed "
+                                          "when the signal is transmitted, by using this "
+                                          "number of threads. Results do not depend on the "
+                                          "number of threads.",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &MultiModelSpectrumChannel::m_parallelRxThreads),
+                                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -127,6 +176,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            m_rxSpatialIndices.erase(rxInfoIterator->first);
             break; // there should be at most one entry
         }
     }
@@ -170,12 +220,18 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
             Ptr<const SpectrumModel> txSpectrumModel = txInfoIterator->second.m_txSpectrumModel;
             SpectrumModelUid_t txSpectrumModelUid = txSpectrumModel->GetUid();
 
-            if (rxSpectrumModelUid != txSpectrumModelUid &&
-                !txSpectrumModel->IsOrthogonal(*rxSpectrumModel))
+            if (rxSpectrumModelUid == txSpectrumModelUid)
+            {
+                continue;
+            }
+            // the converters are shared by all the channels and have no
+            // coefficients if the models are orthogonal
+            Ptr<const SpectrumConverter> converter =
+                SpectrumConverter::GetConverter(txSpectrumModel, rxSpectrumModel);
+            if (converter->GetNumCoefficients() > 0)
             {
-                NS_LOG_LOGIC("Creating converter between SpectrumModelUid "
+                NS_LOG_LOGIC("Adding converter between SpectrumModelUid "
                              << txSpectrumModel->GetUid() << " and " << rxSpectrumModelUid);
-                SpectrumConverter converter(txSpectrumModel, rxSpectrumModel);
                 std::pair<SpectrumConverterMap_t::iterator, bool> ret2;
                 ret2 = txInfoIterator->second.m_spectrumConverterMap.insert(
                     std::make_pair(rxSpectrumModelUid, converter));
@@ -187,6 +243,7 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     {
         // spectrum model is already known, just add the device to the corresponding list
         rxInfoIterator->second.m_rxPhys.push_back(phy);
+        m_rxSpatialIndices.erase(rxSpectrumModelUid);
     }
 }
 
@@ -218,13 +275,18 @@ MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel(
             Ptr<const SpectrumModel> rxSpectrumModel = rxInfoIterator->second.m_rxSpectrumModel;
             SpectrumModelUid_t rxSpectrumModelUid = rxSpectrumModel->GetUid();
 
-            if (rxSpectrumModelUid != txSpectrumModelUid &&
-                !txSpectrumModel->IsOrthogonal(*rxSpectrumModel))
+            if (rxSpectrumModelUid == txSpectrumModelUid)
+            {
+                continue;
+            }
+            // the converters are shared by all the channels and have no
+            // coefficients if the models are orthogonal
+            Ptr<const SpectrumConverter> converter =
+                SpectrumConverter::GetConverter(txSpectrumModel, rxSpectrumModel);
+            if (converter->GetNumCoefficients() > 0)
             {
-                NS_LOG_LOGIC("Creating converter between SpectrumModelUid "
+                NS_LOG_LOGIC("Adding converter between SpectrumModelUid "
                              << txSpectrumModelUid << " and " << rxSpectrumModelUid);
-
-                SpectrumConverter converter(txSpectrumModel, rxSpectrumModel);
                 std::pair<SpectrumConverterMap_t::iterator, bool> ret2;
                 ret2 = txInfoIterator->second.m_spectrumConverterMap.insert(
                     std::make_pair(rxSpectrumModelUid, converter));
@@ -266,6 +328,14 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIteratorerator->second.m_spectrumConverterMap.begin()->first);
 
+    // the transmit power is only computed if the minimum RX power is checked
+    std::optional<double> txPowerDbm;
+
+    // whether the received PSDs are computed in parallel before scheduling the deliveries
+    bool parallelRx = m_parallelRxThreads > 0 && !m_spectrumPropagationLoss &&
+                      m_phasedArraySpectrumPropagationLoss && txMobility;
+    NS_ASSERT(m_pendingRx.empty());
+
     for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -273,7 +343,9 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
+        // the PSD is converted when the first receiver that is not culled is found
         Ptr<SpectrumValue> convertedTxPowerSpectrum;
+        const SpectrumConverter* converter = nullptr;
         if (txSpectrumModelUid == rxSpectrumModelUid)
         {
             NS_LOG_LOGIC("no spectrum conversion needed");
@@ -290,20 +362,23 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
                 continue;
             }
-            convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
+            converter = PeekPointer(rxConverterIterator->second);
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        const auto& rxPhys = rxInfoIterator->second.m_rxPhys;
+        SelectRxCandidates(rxSpectrumModelUid, rxInfoIterator->second, txMobility);
+        m_nCulledDeliveries += rxPhys.size() - m_rxCandidates.size();
+
+        for (auto rxIndex : m_rxCandidates)
         {
-            NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
+            const Ptr<SpectrumPhy>& rxPhy = rxPhys[rxIndex];
+            NS_ASSERT_MSG(rxPhy->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
                           "(i.e., AddRx should be called again after model is changed)");
 
-            if ((*rxPhyIterator) != txParams->txPhy)
+            if (rxPhy != txParams->txPhy)
             {
-                Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
+                Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
                 Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
                 if (rxNetDevice && txNetDevice)
@@ -318,28 +393,33 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
                 Time delay = MicroSeconds(0);
+                double pathGainLinear = 1;
 
-                Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
+                Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
 
                 if (txMobility && receiverMobility)
                 {
+                    if (m_rxCullingDistance > 0 &&
+                        txMobility->GetDistanceFrom(receiverMobility) > m_rxCullingDistance)
+                    {
+                        NS_LOG_LOGIC("receiver beyond the culling distance");
+                        m_nCulledDeliveries++;
+                        continue;
+                    }
+
                     double txAntennaGain = 0;
                     double rxAntennaGain = 0;
                     double propagationGainDb = 0;
                     double pathLossDb = 0;
-                    if (rxParams->txAntenna)
+                    if (txParams->txAntenna)
                     {
                         Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                        txAntennaGain = txParams->txAntenna->GetGainDb(txAngles);
                         NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
                         pathLossDb -= txAntennaGain;
                     }
-                    Ptr<AntennaModel> rxAntenna =
-                        DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
+                    Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
                     if (rxAntenna)
                     {
                         Angles rxAngles(txMobility->GetPosition(), receiverMobility->GetPosition());
@@ -363,14 +443,27 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                                 propagationGainDb,
                                 pathLossDb);
                     // Pathloss trace
-                    m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
+                    m_pathLossTrace(txParams->txPhy, rxPhy, pathLossDb);
                     if (pathLossDb > m_maxLossDb)
                     {
                         // beyond range
+                        m_nCulledDeliveries++;
                         continue;
                     }
-                    double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                    *(rxParams->psd) *= pathGainLinear;
+                    if (m_minRxPowerDbm > -std::numeric_limits<double>::infinity())
+                    {
+                        if (!txPowerDbm)
+                        {
+                            txPowerDbm = 10 * std::log10(Integral(*txParams->psd)) + 30;
+                        }
+                        if (*txPowerDbm - pathLossDb < m_minRxPowerDbm)
+                        {
+                            NS_LOG_LOGIC("received power below the minimum RX power");
+                            m_nCulledDeliveries++;
+                            continue;
+                        }
+                    }
+                    pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
 
                     if (m_propagationDelay)
                     {
@@ -378,30 +471,218 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
-                if (rxNetDevice)
+                if (!convertedTxPowerSpectrum)
+                {
+                    convertedTxPowerSpectrum = converter->Convert(txParams->psd);
+                }
+
+                NS_LOG_LOGIC("copying signal parameters " << txParams);
+                Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
+                if (txMobility && receiverMobility)
+                {
+                    *(rxParams->psd) *= pathGainLinear;
+                }
+                m_nDeliveries++;
+
+                if (parallelRx && receiverMobility)
                 {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxParams,
-                                                   *rxPhyIterator);
+                    m_pendingRx.push_back({rxParams, rxPhy, delay});
                 }
                 else
                 {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        rxParams,
-                                        *rxPhyIterator);
+                    ScheduleRx(rxParams, rxPhy, delay, false);
                 }
             }
         }
     }
+
+    if (!m_pendingRx.empty())
+    {
+        ComputeAndSchedulePendingRx();
+    }
+}
+
+void
+MultiModelSpectrumChannel::ScheduleRx(Ptr<SpectrumSignalParameters> params,
+                                      Ptr<SpectrumPhy> receiver,
+                                      Time delay,
+                                      bool computed)
+{
+    NS_LOG_FUNCTION(this << params << receiver << delay << computed);
+    auto startRx = computed ? &MultiModelSpectrumChannel::DeliverRx
+                            : &MultiModelSpectrumChannel::StartRx;
+    Ptr<NetDevice> rxNetDevice = receiver->GetDevice();
+
+    if (rxNetDevice)
+    {
+        // the receiver has a NetDevice, so we expect that it is attached to a Node
+        uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+        Simulator::ScheduleWithContext(dstNode, delay, startRx, this, params, receiver);
+    }
+    else
+    {
+        // the receiver is not attached to a NetDevice, so we cannot assume that it is
+        // attached to a node
+        Simulator::Schedule(delay, startRx, this, params, receiver);
+    }
+}
+
+void
+MultiModelSpectrumChannel::ComputeAndSchedulePendingRx()
+{
+    NS_LOG_FUNCTION(this << m_pendingRx.size());
+
+    if (!m_threadPool || m_threadPool->GetNThreads() != m_parallelRxThreads)
+    {
+        m_threadPool = Create<SpectrumThreadPool>(m_parallelRxThreads);
+    }
+
+    // the channels to all the receivers are prepared at once (e.g., the channel
+    // matrices whose update is due are generated in a batch)
+    std::vector<PhasedArraySpectrumPropagationLossModel::Receiver> receivers;
+    receivers.reserve(m_pendingRx.size());
+    for (const auto& pending : m_pendingRx)
+    {
+        receivers.emplace_back(pending.receiver->GetMobility(),
+                               DynamicCast<PhasedArrayModel>(pending.receiver->GetAntenna()));
+    }
+    const auto& txPhy = m_pendingRx.front().params->txPhy;
+    m_phasedArraySpectrumPropagationLoss->PrepareChannels(
+        txPhy->GetMobility(),
+        DynamicCast<PhasedArrayModel>(txPhy->GetAntenna()),
+        receivers);
+
+    // the state of the loss model is accessed sequentially, receiver by receiver
+    std::vector<SpectrumThreadPool::Job> jobs;
+    jobs.reserve(m_pendingRx.size());
+    for (auto& pending : m_pendingRx)
+    {
+        Ptr<const PhasedArrayModel> txPhasedArrayModel =
+            DynamicCast<PhasedArrayModel>(pending.params->txPhy->GetAntenna());
+        Ptr<const PhasedArrayModel> rxPhasedArrayModel =
+            DynamicCast<PhasedArrayModel>(pending.receiver->GetAntenna());
+
+        NS_ASSERT_MSG(txPhasedArrayModel && rxPhasedArrayModel,
+                      "PhasedArrayModel instances should be installed at both TX and RX "
+                      "SpectrumPhy in order to use PhasedArraySpectrumPropagationLoss.");
+
+        auto job = m_phasedArraySpectrumPropagationLoss->PrepareRxPowerSpectralDensity(
+            pending.params,
+            pending.params->txPhy->GetMobility(),
+            pending.receiver->GetMobility(),
+            txPhasedArrayModel,
+            rxPhasedArrayModel);
+        if (job)
+        {
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    // the remaining computations are independent of each other
+    m_threadPool->Run(jobs);
+    jobs.clear();
+
+    // the deliveries are scheduled in the same order as in the sequential mode
+    for (auto& pending : m_pendingRx)
+    {
+        ScheduleRx(pending.params, pending.receiver, pending.delay, true);
+    }
+    m_pendingRx.clear();
+}
+
+void
+MultiModelSpectrumChannel::DeliverRx(Ptr<SpectrumSignalParameters> params,
+                                     Ptr<SpectrumPhy> receiver)
+{
+    NS_LOG_FUNCTION(this << params << receiver);
+    receiver->StartRx(params);
+}
+
+MultiModelSpectrumChannel::RxSpatialIndex::Cell
+MultiModelSpectrumChannel::GetCell(const Vector& position) const
+{
+    return {static_cast<int64_t>(std::floor(position.x / m_rxCullingDistance)),
+            static_cast<int64_t>(std::floor(position.y / m_rxCullingDistance))};
+}
+
+MultiModelSpectrumChannel::RxSpatialIndex
+MultiModelSpectrumChannel::BuildRxSpatialIndex(const RxSpectrumModelInfo& rxInfo)
+{
+    NS_LOG_FUNCTION(this);
+    RxSpatialIndex index;
+
+    for (std::size_t i = 0; i < rxInfo.m_rxPhys.size(); i++)
+    {
+        Ptr<MobilityModel> mobility = rxInfo.m_rxPhys[i]->GetMobility();
+        if (!DynamicCast<ConstantPositionMobilityModel>(mobility))
+        {
+            // receivers that may move (or have no position) are always considered
+            index.others.push_back(i);
+            continue;
+        }
+        index.cells[GetCell(mobility->GetPosition())].push_back(i);
+        if (m_trackedMobilities.insert(mobility).second)
+        {
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&MultiModelSpectrumChannel::NotifyRxCourseChange, this));
+        }
+    }
+    return index;
+}
+
+void
+MultiModelSpectrumChannel::SelectRxCandidates(SpectrumModelUid_t rxSpectrumModelUid,
+                                              const RxSpectrumModelInfo& rxInfo,
+                                              Ptr<MobilityModel> txMobility)
+{
+    NS_LOG_FUNCTION(this << rxSpectrumModelUid << txMobility);
+    m_rxCandidates.clear();
+
+    if (m_rxCullingDistance <= 0 || !txMobility)
+    {
+        for (std::size_t i = 0; i < rxInfo.m_rxPhys.size(); i++)
+        {
+            m_rxCandidates.push_back(i);
+        }
+        return;
+    }
+
+    auto indexIt = m_rxSpatialIndices.find(rxSpectrumModelUid);
+    if (indexIt == m_rxSpatialIndices.end())
+    {
+        indexIt =
+            m_rxSpatialIndices.emplace(rxSpectrumModelUid, BuildRxSpatialIndex(rxInfo)).first;
+    }
+    const auto& index = indexIt->second;
+
+    // receivers within the culling distance can only be in the cells adjacent to the
+    // cell of the transmitter, since cells are as large as the culling distance
+    auto [cx, cy] = GetCell(txMobility->GetPosition());
+    for (int64_t x = cx - 1; x <= cx + 1; x++)
+    {
+        for (int64_t y = cy - 1; y <= cy + 1; y++)
+        {
+            if (auto cellIt = index.cells.find({x, y}); cellIt != index.cells.end())
+            {
+                m_rxCandidates.insert(m_rxCandidates.end(),
+                                      cellIt->second.begin(),
+                                      cellIt->second.end());
+            }
+        }
+    }
+    m_rxCandidates.insert(m_rxCandidates.end(), index.others.begin(), index.others.end());
+
+    // deliver signals in the same order as when culling is disabled
+    std::sort(m_rxCandidates.begin(), m_rxCandidates.end());
+}
+
+void
+MultiModelSpectrumChannel::NotifyRxCourseChange(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    m_rxSpatialIndices.clear();
 }
 
 void
@@ -436,6 +717,18 @@ MultiModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<Spe
     receiver->StartRx(params);
 }
 
+uint64_t
+MultiModelSpectrumChannel::GetNDeliveries() const
+{
+    return m_nDeliveries;
+}
+
+uint64_t
+MultiModelSpectrumChannel::GetNCulledDeliveries() const
+{
+    return m_nCulledDeliveries;
+}
+
 std::size_t
 MultiModelSpectrumChannel::GetNDevices() const
 {
@@ -21,14 +21,19 @@
 #ifndef MULTI_MODEL_SPECTRUM_CHANNEL_H
 #define MULTI_MODEL_SPECTRUM_CHANNEL_H
 
+#include <ns3/mobility-model.h>
 #include <ns3/propagation-delay-model.h>
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-converter.h>
 #include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/spectrum-thread-pool.h>
 #include <ns3/spectrum-value.h>
 
 #include <map>
+#include <optional>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -37,7 +42,7 @@ namespace ns3
  * \ingroup spectrum
  * Container: SpectrumModelUid_t, SpectrumConverter
  */
-typedef std::map<SpectrumModelUid_t, SpectrumConverter> SpectrumConverterMap_t;
+typedef std::map<SpectrumModelUid_t, Ptr<const SpectrumConverter>> SpectrumConverterMap_t;
 
 /**
  * \ingroup spectrum
@@ -99,6 +104,34 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * In dense scenarios, most of the receivers are typically too far from a
+ * transmitter for its signal to matter. Signals are not delivered to the
+ * receivers whose single-frequency path loss exceeds the MaxLossDb attribute
+ * or whose received power (transmit power minus path loss) is below the
+ * MinRxPowerDbm attribute; these checks are performed before copying the
+ * signal parameters and the PSD and before the evaluation of the
+ * SpectrumPropagationLossModel, if any. Additionally, if the RxCullingDistance
+ * attribute is set, the receivers farther than the given distance from the
+ * transmitter are culled without even computing the path loss: the receivers
+ * with a constant position are stored in a grid whose cells are as large as
+ * the culling distance, so that only the receivers in the cells surrounding
+ * the transmitter are considered. Signals are delivered to the remaining
+ * receivers in the same order as when culling is disabled. The number of
+ * culled deliveries is returned by GetNCulledDeliveries().
+ *
+ * If a PhasedArraySpectrumPropagationLossModel is used, the received PSDs are
+ * normally computed when each receiver starts receiving the signal. If the
+ * ParallelRxThreads attribute is set, instead, the received PSDs of all the
+ * receivers of a signal are computed when the signal is transmitted: the part
+ * of the computation that accesses the state of the loss model is performed
+ * sequentially, receiver by receiver, while the rest (e.g., the beamforming gain
+ * over each sub-band) is spread over the given number of threads. The StartRx
+ * events are then scheduled sequentially, in the same order as in the default
+ * mode, hence results do not depend on the number of threads. Note that the
+ * received PSD is evaluated at the transmission time instead of at the time the
+ * signal reaches the receiver, which only makes a difference with a
+ * PropagationDelayModel and mobile nodes.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -120,6 +153,19 @@ class MultiModelSpectrumChannel : public SpectrumChannel
     std::size_t GetNDevices() const override;
     Ptr<NetDevice> GetDevice(std::size_t i) const override;
 
+    /**
+     * \return the number of signal deliveries (i.e., the StartRx events) scheduled
+     *         by this channel
+     */
+    uint64_t GetNDeliveries() const;
+
+    /**
+     * \return the number of signal deliveries that have not been scheduled because
+     *         the receiver was beyond the culling distance, the path loss exceeded
+     *         the maximum loss or the received power was below the minimum power
+     */
+    uint64_t GetNCulledDeliveries() const;
+
   protected:
     void DoDispose() override;
 
@@ -145,6 +191,90 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      */
     virtual void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+    /**
+     * Used internally to deliver a signal whose received PSD has already been
+     * computed (see the ParallelRxThreads attribute).
+     *
+     * \param params The signal parameters.
+     * \param receiver A pointer to the receiver SpectrumPhy.
+     */
+    void DeliverRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+
+    /**
+     * Schedule the delivery of a signal to a receiver.
+     *
+     * \param params The signal parameters.
+     * \param receiver A pointer to the receiver SpectrumPhy.
+     * \param delay The propagation delay.
+     * \param computed Whether the received PSD has already been computed.
+     */
+    void ScheduleRx(Ptr<SpectrumSignalParameters> params,
+                    Ptr<SpectrumPhy> receiver,
+                    Time delay,
+                    bool computed);
+
+    /**
+     * Compute, in parallel, the received PSDs of the signals in m_pendingRx and
+     * schedule their delivery.
+     */
+    void ComputeAndSchedulePendingRx();
+
+    /// A signal whose received PSD has to be computed before scheduling its delivery
+    struct PendingRx
+    {
+        Ptr<SpectrumSignalParameters> params; //!< the signal parameters
+        Ptr<SpectrumPhy> receiver;            //!< the receiver
+        Time delay;                           //!< the propagation delay
+    };
+
+    /**
+     * Spatial index of the receivers sharing a RX spectrum model. Indices refer
+     * to the vector of SpectrumPhy instances of the corresponding RxSpectrumModelInfo.
+     */
+    struct RxSpatialIndex
+    {
+        /// grid cell coordinates
+        using Cell = std::pair<int64_t, int64_t>;
+
+        std::map<Cell, std::vector<std::size_t>> cells; //!< receivers with a constant position
+        std::vector<std::size_t> others;                //!< receivers that may move
+    };
+
+    /**
+     * \param position a position
+     * \return the coordinates of the cell of the grid containing the given position
+     */
+    RxSpatialIndex::Cell GetCell(const Vector& position) const;
+
+    /**
+     * Build the spatial index of the receivers in the given RxSpectrumModelInfo.
+     *
+     * \param rxInfo the RxSpectrumModelInfo
+     * \return the spatial index
+     */
+    RxSpatialIndex BuildRxSpatialIndex(const RxSpectrumModelInfo& rxInfo);
+
+    /**
+     * Store in m_rxCandidates the indices, in increasing order, of the receivers
+     * in the given RxSpectrumModelInfo that may be within the culling distance
+     * from the transmitter.
+     *
+     * \param rxSpectrumModelUid the UID of the RX spectrum model
+     * \param rxInfo the RxSpectrumModelInfo
+     * \param txMobility the mobility model of the transmitter (possibly null)
+     */
+    void SelectRxCandidates(SpectrumModelUid_t rxSpectrumModelUid,
+                            const RxSpectrumModelInfo& rxInfo,
+                            Ptr<MobilityModel> txMobility);
+
+    /**
+     * Invalidate the spatial indices of the receivers because the position of a
+     * receiver changed.
+     *
+     * \param mobility the mobility model of the receiver
+     */
+    void NotifyRxCourseChange(Ptr<const MobilityModel> mobility);
+
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
      * converters to any RX SpectrumModel, and all the corresponding
@@ -163,6 +293,17 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    double m_rxCullingDistance; //!< distance (m) beyond which receivers are culled (0 to disable)
+    double m_minRxPowerDbm;     //!< RX power (dBm) below which signals are not delivered
+    std::map<SpectrumModelUid_t, RxSpatialIndex> m_rxSpatialIndices; //!< receivers spatial indices
+    std::set<Ptr<MobilityModel>> m_trackedMobilities; //!< mobility models invalidating the indices
+    std::vector<std::size_t> m_rxCandidates;          //!< receivers considered by StartTx
+    uint64_t m_nDeliveries;                           //!< number of scheduled deliveries
+    uint64_t m_nCulledDeliveries;                     //!< number of culled deliveries
+    uint32_t m_parallelRxThreads;       //!< threads computing the received PSDs (0 to disable)
+    Ptr<SpectrumThreadPool> m_threadPool; //!< the pool of threads computing the received PSDs
+    std::vector<PendingRx> m_pendingRx;   //!< signals whose received PSD has to be computed
 };
 
 } // namespace ns3
@@ -81,4 +81,56 @@ PhasedArraySpectrumPropagationLossModel::CalcRxPowerSpectralDensity(
     return rxPsd;
 }
 
+std::function<void()>
+PhasedArraySpectrumPropagationLossModel::PrepareRxPowerSpectralDensity(
+    Ptr<SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    Ptr<const PhasedArrayModel> bPhasedArrayModel) const
+{
+    if (m_next)
+    {
+        // chained models are evaluated sequentially
+        params->psd =
+            CalcRxPowerSpectralDensity(params, a, b, aPhasedArrayModel, bPhasedArrayModel);
+        return {};
+    }
+    return DoPrepareRxPowerSpectralDensity(params, a, b, aPhasedArrayModel, bPhasedArrayModel);
+}
+
+std::function<void()>
+PhasedArraySpectrumPropagationLossModel::DoPrepareRxPowerSpectralDensity(
+    Ptr<SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    Ptr<const PhasedArrayModel> bPhasedArrayModel) const
+{
+    params->psd = DoCalcRxPowerSpectralDensity(params, a, b, aPhasedArrayModel, bPhasedArrayModel);
+    return {};
+}
+
+void
+PhasedArraySpectrumPropagationLossModel::PrepareChannels(
+    Ptr<const MobilityModel> a,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    const std::vector<Receiver>& receivers) const
+{
+    if (m_next)
+    {
+        // chained models are evaluated sequentially
+        return;
+    }
+    DoPrepareChannels(a, aPhasedArrayModel, receivers);
+}
+
+void
+PhasedArraySpectrumPropagationLossModel::DoPrepareChannels(
+    Ptr<const MobilityModel> a,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    const std::vector<Receiver>& receivers) const
+{
+}
+
 } // namespace ns3
@@ -25,6 +25,10 @@
 #include <ns3/phased-array-model.h>
 #include <ns3/spectrum-value.h>
 
+#include <functional>
+#include <utility>
+#include <vector>
+
 namespace ns3
 {
 
@@ -80,6 +84,47 @@ class PhasedArraySpectrumPropagationLossModel : public Object
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const;
 
+    /**
+     * Start the computation of the received PSD, which is eventually stored in
+     * params->psd. The part of the computation that accesses the state of the
+     * model (e.g., caches or random variables) is carried out by this method,
+     * which must be called by the simulator thread. The returned job, if not
+     * empty, completes the computation and can be run by any thread, concurrently
+     * with the jobs returned for other receivers of the same signal. The received
+     * PSD must not be used before the job has been run.
+     *
+     * @param params the spectrum signal parameters, whose PSD is replaced by the received PSD
+     * @param a sender mobility
+     * @param b receiver mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param bPhasedArrayModel the instance of the phased antenna array of the receiver
+     *
+     * @return the job completing the computation of the received PSD (possibly empty)
+     */
+    std::function<void()> PrepareRxPowerSpectralDensity(
+        Ptr<SpectrumSignalParameters> params,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        Ptr<const PhasedArrayModel> bPhasedArrayModel) const;
+
+    /// A receiver of a signal, given by its mobility model and its phased antenna array
+    using Receiver = std::pair<Ptr<const MobilityModel>, Ptr<const PhasedArrayModel>>;
+
+    /**
+     * Prepare the state needed to compute the received PSDs of a signal for the
+     * given receivers (e.g., generate the channel matrices whose update is due
+     * in a batch), before PrepareRxPowerSpectralDensity() is called for each of
+     * them, in the same order. This method must be called by the simulator thread.
+     *
+     * @param a sender mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param receivers the receivers of the signal
+     */
+    void PrepareChannels(Ptr<const MobilityModel> a,
+                         Ptr<const PhasedArrayModel> aPhasedArrayModel,
+                         const std::vector<Receiver>& receivers) const;
+
   protected:
     void DoDispose() override;
 
@@ -102,6 +147,38 @@ class PhasedArraySpectrumPropagationLossModel : public Object
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const = 0;
 
+    /**
+     * Start the computation of the received PSD (see PrepareRxPowerSpectralDensity()).
+     * The default implementation computes the received PSD by calling
+     * DoCalcRxPowerSpectralDensity() and returns an empty job.
+     *
+     * @param params the spectrum signal parameters, whose PSD is replaced by the received PSD
+     * @param a sender mobility
+     * @param b receiver mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param bPhasedArrayModel the instance of the phased antenna array of the receiver
+     *
+     * @return the job completing the computation of the received PSD (possibly empty)
+     */
+    virtual std::function<void()> DoPrepareRxPowerSpectralDensity(
+        Ptr<SpectrumSignalParameters> params,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        Ptr<const PhasedArrayModel> bPhasedArrayModel) const;
+
+    /**
+     * Prepare the state needed to compute the received PSDs of a signal (see
+     * PrepareChannels()). The default implementation does nothing.
+     *
+     * @param a sender mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param receivers the receivers of the signal
+     */
+    virtual void DoPrepareChannels(Ptr<const MobilityModel> a,
+                                   Ptr<const PhasedArrayModel> aPhasedArrayModel,
+                                   const std::vector<Receiver>& receivers) const;
+
     Ptr<PhasedArraySpectrumPropagationLossModel>
         m_next; //!< PhasedArraySpectrumPropagationLossModel chained to this one.
 };
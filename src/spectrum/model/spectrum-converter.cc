@@ -20,6 +20,7 @@
 
 #include <ns3/assert.h>
 #include <ns3/log.h>
+#include <ns3/simulator.h>
 #include <ns3/spectrum-converter.h>
 
 #include <algorithm>
@@ -40,14 +41,33 @@ SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
     m_fromSpectrumModel = fromSpectrumModel;
     m_toSpectrumModel = toSpectrumModel;
 
+    // if the bands to convert from are sorted, the bands overlapping a given
+    // band are contiguous and can be found with a binary search
+    Bands::const_iterator fromBegin = fromSpectrumModel->Begin();
+    bool sorted = std::adjacent_find(fromBegin,
+                                     fromSpectrumModel->End(),
+                                     [](const BandInfo& a, const BandInfo& b) {
+                                         return a.fl > b.fl || a.fh > b.fh;
+                                     }) == fromSpectrumModel->End();
+    NS_LOG_LOGIC("bands to convert from are " << (sorted ? "" : "not ") << "sorted");
+
     size_t rowPtr = 0;
     for (Bands::const_iterator toit = toSpectrumModel->Begin(); toit != toSpectrumModel->End();
          ++toit)
     {
-        size_t colInd = 0;
-        for (Bands::const_iterator fromit = fromSpectrumModel->Begin();
-             fromit != fromSpectrumModel->End();
-             ++fromit)
+        Bands::const_iterator fromit = fromBegin;
+        Bands::const_iterator fromEnd = fromSpectrumModel->End();
+        if (sorted)
+        {
+            // skip the bands below and stop at the first band above the current one
+            fromit = std::partition_point(fromit, fromEnd, [toit](const BandInfo& band) {
+                return band.fh <= toit->fl;
+            });
+            fromEnd = std::partition_point(fromit, fromEnd, [toit](const BandInfo& band) {
+                return band.fl < toit->fh;
+            });
+        }
+        for (; fromit != fromEnd; ++fromit)
         {
             double c = GetCoefficient(*fromit, *toit);
             NS_LOG_LOGIC("(" << fromit->fl << "," << fromit->fh << ")"
@@ -57,10 +77,9 @@ SpectrumConverter::SpectrumConverter(Ptr<const SpectrumModel> fromSpectrumModel,
             if (c > 0)
             {
                 m_conversionMatrix.push_back(c);
-                m_conversionColInd.push_back(colInd);
+                m_conversionColInd.push_back(fromit - fromBegin);
                 rowPtr++;
             }
-            colInd++;
         }
         m_conversionRowPtr.push_back(rowPtr);
     }
@@ -84,17 +103,15 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
     Ptr<SpectrumValue> tvvf = Create<SpectrumValue>(m_toSpectrumModel);
 
     Values::iterator tvit = tvvf->ValuesBegin();
+    Values::const_iterator fvit = fvvf->ConstValuesBegin();
     size_t i = 0; // Index of conversion coefficient
 
-    for (std::vector<size_t>::const_iterator convIt = m_conversionRowPtr.begin();
-         convIt != m_conversionRowPtr.end();
-         ++convIt)
+    for (size_t rowEnd : m_conversionRowPtr)
     {
         double sum = 0;
-        while (i < *convIt)
+        for (; i < rowEnd; i++)
         {
-            sum += (*fvvf)[m_conversionColInd.at(i)] * m_conversionMatrix.at(i);
-            i++;
+            sum += fvit[m_conversionColInd[i]] * m_conversionMatrix[i];
         }
         *tvit = sum;
         ++tvit;
@@ -103,4 +120,37 @@ SpectrumConverter::Convert(Ptr<const SpectrumValue> fvvf) const
     return tvvf;
 }
 
+std::size_t
+SpectrumConverter::GetNumCoefficients() const
+{
+    return m_conversionMatrix.size();
+}
+
+Ptr<const SpectrumConverter>
+SpectrumConverter::GetConverter(Ptr<const SpectrumModel> fromSpectrumModel,
+                                Ptr<const SpectrumModel> toSpectrumModel)
+{
+    NS_LOG_FUNCTION(fromSpectrumModel << toSpectrumModel);
+    static std::map<std::pair<SpectrumModelUid_t, SpectrumModelUid_t>,
+                    Ptr<const SpectrumConverter>>
+        converters;
+
+    auto key = std::make_pair(fromSpectrumModel->GetUid(), toSpectrumModel->GetUid());
+    auto it = converters.find(key);
+    if (it == converters.end())
+    {
+        NS_LOG_LOGIC("Creating converter between SpectrumModelUid " << key.first << " and "
+                                                                    << key.second);
+        if (converters.empty())
+        {
+            // release the converters, and the SpectrumModels they hold, with the simulator
+            Simulator::ScheduleDestroy([]() { converters.clear(); });
+        }
+        it = converters
+                 .emplace(key, Create<const SpectrumConverter>(fromSpectrumModel, toSpectrumModel))
+                 .first;
+    }
+    return it->second;
+}
+
 } // namespace ns3
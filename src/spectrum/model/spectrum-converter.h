@@ -23,6 +23,9 @@
 
 #include <ns3/spectrum-value.h>
 
+#include <map>
+#include <utility>
+
 namespace ns3
 {
 
@@ -38,6 +41,13 @@ namespace ns3
  * and devices using a finer representation (e.g., one frequency for
  * each OFDM subcarrier).
  *
+ * The conversion coefficients are stored in Compressed Row Storage (CSR)
+ * format, i.e., only the coefficients between overlapping bands are stored
+ * and used by Convert. When the bands of the SpectrumModel to convert from are
+ * sorted by frequency, which is the case of all the models used in ns-3, only
+ * the overlapping bands are visited to compute the coefficients. Since the
+ * conversion between two SpectrumModels never changes, the converters can be
+ * shared by all the users (e.g., all the channels) through GetConverter.
  */
 class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
 {
@@ -64,6 +74,26 @@ class SpectrumConverter : public SimpleRefCount<SpectrumConverter>
      */
     Ptr<SpectrumValue> Convert(Ptr<const SpectrumValue> vvf) const;
 
+    /**
+     * \return the number of non-zero conversion coefficients, which is zero
+     *         if the two SpectrumModels are orthogonal
+     */
+    std::size_t GetNumCoefficients() const;
+
+    /**
+     * Get the converter between two SpectrumModels from a cache shared by all
+     * the users, creating it if needed. The cache is keyed on the UIDs of the
+     * SpectrumModels and keeps the converters (and thus the SpectrumModels)
+     * until the simulator is destroyed.
+     *
+     * @param fromSpectrumModel the SpectrumModel to convert from
+     * @param toSpectrumModel the SpectrumModel to convert to
+     *
+     * @return the shared converter
+     */
+    static Ptr<const SpectrumConverter> GetConverter(Ptr<const SpectrumModel> fromSpectrumModel,
+                                                     Ptr<const SpectrumModel> toSpectrumModel);
+
   private:
     /**
      * Calculate the coefficient for value conversion between elements
@@ -127,10 +127,14 @@ SpectrumInterference::ConditionallyEvaluateChunk()
     NS_LOG_LOGIC("if condition: " << condition);
     if (condition)
     {
-        SpectrumValue sinr = (*m_rxSignal) / ((*m_allSignals) - (*m_rxSignal) + (*m_noise));
+        // sinr = rxSignal / (allSignals - rxSignal + noise), computed in the
+        // buffers of the previous chunk to avoid allocating temporary objects
+        m_interf = *m_noise;
+        m_interf.AddDifference(*m_allSignals, *m_rxSignal);
+        m_sinr.SetRatio(*m_rxSignal, m_interf);
         Time duration = Now() - m_lastChangeTime;
         NS_LOG_LOGIC("calling m_errorModel->EvaluateChunk (sinr, duration)");
-        m_errorModel->EvaluateChunk(sinr, duration);
+        m_errorModel->EvaluateChunk(m_sinr, duration);
     }
 }
 
@@ -135,6 +135,9 @@ class SpectrumInterference : public Object
 
     Ptr<const SpectrumValue> m_noise; //!< Noise spectral power density
 
+    SpectrumValue m_interf; //!< interference plus noise of the last chunk (reused buffer)
+    SpectrumValue m_sinr;   //!< SINR of the last chunk (reused buffer)
+
     Time m_lastChangeTime; //!< the time of the last change in m_TotalPower
 
     Ptr<SpectrumErrorModel> m_errorModel; //!< Error model
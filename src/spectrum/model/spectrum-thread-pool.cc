@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "spectrum-thread-pool.h"
+
+#include <ns3/assert.h>
+#include <ns3/log.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpectrumThreadPool");
+
+SpectrumThreadPool::SpectrumThreadPool(uint32_t nThreads)
+    : m_jobs(nullptr),
+      m_nextJob(0),
+      m_batch(0),
+      m_nBusyThreads(0),
+      m_stop(false)
+{
+    NS_LOG_FUNCTION(this << nThreads);
+    NS_ASSERT_MSG(nThreads > 0, "At least one thread is needed");
+    for (uint32_t i = 1; i < nThreads; i++)
+    {
+        m_threads.emplace_back(&SpectrumThreadPool::Work, this);
+    }
+}
+
+SpectrumThreadPool::~SpectrumThreadPool()
+{
+    NS_LOG_FUNCTION(this);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCv.notify_all();
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+uint32_t
+SpectrumThreadPool::GetNThreads() const
+{
+    return m_threads.size() + 1;
+}
+
+void
+SpectrumThreadPool::Run(const std::vector<Job>& jobs)
+{
+    NS_LOG_FUNCTION(this << jobs.size());
+
+    if (m_threads.empty() || jobs.size() < 2)
+    {
+        for (const auto& job : jobs)
+        {
+            job();
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs = &jobs;
+        m_nextJob = 0;
+        m_nBusyThreads = m_threads.size();
+        m_batch++;
+    }
+    m_startCv.notify_all();
+
+    RunJobs();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [this]() { return m_nBusyThreads == 0; });
+    m_jobs = nullptr;
+}
+
+void
+SpectrumThreadPool::Work()
+{
+    uint64_t lastBatch = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCv.wait(lock, [this, lastBatch]() { return m_stop || m_batch != lastBatch; });
+            if (m_stop)
+            {
+                return;
+            }
+            lastBatch = m_batch;
+        }
+
+        RunJobs();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_nBusyThreads--;
+        }
+        m_doneCv.notify_one();
+    }
+}
+
+void
+SpectrumThreadPool::RunJobs()
+{
+    const auto& jobs = *m_jobs;
+    for (std::size_t i = m_nextJob++; i < jobs.size(); i = m_nextJob++)
+    {
+        jobs[i]();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SPECTRUM_THREAD_POOL_H
+#define SPECTRUM_THREAD_POOL_H
+
+#include <ns3/simple-ref-count.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup spectrum
+ *
+ * A pool of threads running batches of independent jobs on behalf of the
+ * simulator thread, which is blocked until all the jobs of a batch are completed
+ * and also runs jobs in the meantime. Jobs must not access the simulator, log,
+ * schedule events or copy Ptr objects shared with other jobs (reference counts
+ * are not atomic); each job is expected to only write to memory that no other
+ * job of the same batch accesses. Under these conditions, the result of a batch
+ * does not depend on the number of threads nor on the order in which the jobs
+ * are run.
+ */
+class SpectrumThreadPool : public SimpleRefCount<SpectrumThreadPool>
+{
+  public:
+    /// A job
+    using Job = std::function<void()>;
+
+    /**
+     * Constructor.
+     *
+     * \param nThreads the number of threads running jobs, including the
+     *        simulator thread (hence nThreads - 1 threads are created)
+     */
+    SpectrumThreadPool(uint32_t nThreads);
+    ~SpectrumThreadPool();
+
+    // delete copy constructor and assignment operator to avoid misuse
+    SpectrumThreadPool(const SpectrumThreadPool&) = delete;
+    SpectrumThreadPool& operator=(const SpectrumThreadPool&) = delete;
+
+    /**
+     * \return the number of threads running jobs, including the simulator thread
+     */
+    uint32_t GetNThreads() const;
+
+    /**
+     * Run the given jobs and return when all of them have been completed.
+     *
+     * \param jobs the jobs to run
+     */
+    void Run(const std::vector<Job>& jobs);
+
+  private:
+    /**
+     * The function run by the threads of the pool.
+     */
+    void Work();
+
+    /**
+     * Run the jobs of the current batch that have not been taken by another thread.
+     */
+    void RunJobs();
+
+    std::vector<std::thread> m_threads;  //!< the threads of the pool
+    std::mutex m_mutex;                  //!< mutex protecting the state of the pool
+    std::condition_variable m_startCv;   //!< notified when a batch starts or the pool stops
+    std::condition_variable m_doneCv;    //!< notified when a thread completed its jobs
+    const std::vector<Job>* m_jobs;      //!< the jobs of the current batch
+    std::atomic<std::size_t> m_nextJob;  //!< the index of the next job to run
+    uint64_t m_batch;                    //!< the number of batches started so far
+    uint32_t m_nBusyThreads;             //!< the number of threads working on the batch
+    bool m_stop;                         //!< whether the threads have to terminate
+};
+
+} // namespace ns3
+
+#endif /* SPECTRUM_THREAD_POOL_H */
@@ -23,6 +23,8 @@
 #include <ns3/math.h>
 #include <ns3/spectrum-value.h>
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -98,49 +100,54 @@ SpectrumValue::ConstBandsEnd() const
     return m_spectrumModel->End();
 }
 
+// The element-wise kernels below are written as plain loops over the contiguous
+// arrays of values, indexed by a counter whose bound is computed once, so that the
+// compiler can vectorize them with whatever SIMD instructions the target offers.
+
 void
-SpectrumValue::Add(const SpectrumValue& x)
+SpectrumValue::AssertSameModel(const SpectrumValue& x) const
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
-
     NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
     NS_ASSERT(m_values.size() == x.m_values.size());
+}
 
-    while (it1 != m_values.end())
+void
+SpectrumValue::Add(const SpectrumValue& x)
+{
+    AssertSameModel(x);
+    double* v = m_values.data();
+    const double* xv = x.m_values.data();
+    const std::size_t n = m_values.size();
+
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 += *it2;
-        ++it1;
-        ++it2;
+        v[i] += xv[i];
     }
 }
 
 void
 SpectrumValue::Add(double s)
 {
-    Values::iterator it1 = m_values.begin();
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
 
-    while (it1 != m_values.end())
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 += s;
-        ++it1;
+        v[i] += s;
     }
 }
 
 void
 SpectrumValue::Subtract(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
+    AssertSameModel(x);
+    double* v = m_values.data();
+    const double* xv = x.m_values.data();
+    const std::size_t n = m_values.size();
 
-    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
-    NS_ASSERT(m_values.size() == x.m_values.size());
-
-    while (it1 != m_values.end())
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 -= *it2;
-        ++it1;
-        ++it2;
+        v[i] -= xv[i];
     }
 }
 
@@ -153,46 +160,40 @@ SpectrumValue::Subtract(double s)
 void
 SpectrumValue::Multiply(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
+    AssertSameModel(x);
+    double* v = m_values.data();
+    const double* xv = x.m_values.data();
+    const std::size_t n = m_values.size();
 
-    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
-    NS_ASSERT(m_values.size() == x.m_values.size());
-
-    while (it1 != m_values.end())
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 *= *it2;
-        ++it1;
-        ++it2;
+        v[i] *= xv[i];
     }
 }
 
 void
 SpectrumValue::Multiply(double s)
 {
-    Values::iterator it1 = m_values.begin();
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
 
-    while (it1 != m_values.end())
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 *= s;
-        ++it1;
+        v[i] *= s;
     }
 }
 
 void
 SpectrumValue::Divide(const SpectrumValue& x)
 {
-    Values::iterator it1 = m_values.begin();
-    Values::const_iterator it2 = x.m_values.begin();
+    AssertSameModel(x);
+    double* v = m_values.data();
+    const double* xv = x.m_values.data();
+    const std::size_t n = m_values.size();
 
-    NS_ASSERT(m_spectrumModel == x.m_spectrumModel);
-    NS_ASSERT(m_values.size() == x.m_values.size());
-
-    while (it1 != m_values.end())
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 /= *it2;
-        ++it1;
-        ++it2;
+        v[i] /= xv[i];
     }
 }
 
@@ -200,27 +201,94 @@ void
 SpectrumValue::Divide(double s)
 {
     NS_LOG_FUNCTION(this << s);
-    Values::iterator it1 = m_values.begin();
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
 
-    while (it1 != m_values.end())
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 /= s;
-        ++it1;
+        v[i] /= s;
     }
 }
 
 void
 SpectrumValue::ChangeSign()
 {
-    Values::iterator it1 = m_values.begin();
+    double* v = m_values.data();
+    const std::size_t n = m_values.size();
 
-    while (it1 != m_values.end())
+    for (std::size_t i = 0; i < n; ++i)
     {
-        *it1 = -(*it1);
-        ++it1;
+        v[i] = -v[i];
     }
 }
 
+SpectrumValue&
+SpectrumValue::AddScaled(const SpectrumValue& x, double s)
+{
+    AssertSameModel(x);
+    double* v = m_values.data();
+    const double* xv = x.m_values.data();
+    const std::size_t n = m_values.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] += s * xv[i];
+    }
+    return *this;
+}
+
+SpectrumValue&
+SpectrumValue::MultiplyAdd(const SpectrumValue& x, const SpectrumValue& y)
+{
+    AssertSameModel(x);
+    AssertSameModel(y);
+    double* v = m_values.data();
+    const double* xv = x.m_values.data();
+    const double* yv = y.m_values.data();
+    const std::size_t n = m_values.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] += xv[i] * yv[i];
+    }
+    return *this;
+}
+
+SpectrumValue&
+SpectrumValue::AddDifference(const SpectrumValue& x, const SpectrumValue& y)
+{
+    AssertSameModel(x);
+    AssertSameModel(y);
+    double* v = m_values.data();
+    const double* xv = x.m_values.data();
+    const double* yv = y.m_values.data();
+    const std::size_t n = m_values.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] += xv[i] - yv[i];
+    }
+    return *this;
+}
+
+SpectrumValue&
+SpectrumValue::SetRatio(const SpectrumValue& num, const SpectrumValue& den)
+{
+    num.AssertSameModel(den);
+    m_spectrumModel = num.m_spectrumModel;
+    m_values.resize(num.m_values.size());
+    double* v = m_values.data();
+    const double* nv = num.m_values.data();
+    const double* dv = den.m_values.data();
+    const std::size_t n = m_values.size();
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        v[i] = nv[i] / dv[i];
+    }
+    return *this;
+}
+
 void
 SpectrumValue::ShiftLeft(int n)
 {
@@ -430,9 +498,8 @@ operator+(double lhs, const SpectrumValue& rhs)
 SpectrumValue
 operator-(const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-    SpectrumValue res = rhs;
-    res.ChangeSign();
-    res.Add(lhs);
+    SpectrumValue res = lhs;
+    res.Subtract(rhs);
     return res;
 }
 
@@ -613,13 +680,7 @@ SpectrumValue::operator/=(double rhs)
 SpectrumValue&
 SpectrumValue::operator=(double rhs)
 {
-    Values::iterator it1 = m_values.begin();
-
-    while (it1 != m_values.end())
-    {
-        *it1 = rhs;
-        ++it1;
-    }
+    std::fill(m_values.begin(), m_values.end(), rhs);
     return *this;
 }
 
@@ -410,6 +410,53 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     SpectrumValue& operator=(double rhs);
 
+    /**
+     * Add each component of x, scaled by s, to the corresponding component
+     * of *this, i.e., *this += s * x, without creating temporary objects
+     *
+     * @param x the SpectrumValue to scale and add
+     * @param s the scale factor
+     *
+     * @return a reference to *this
+     */
+    SpectrumValue& AddScaled(const SpectrumValue& x, double s);
+
+    /**
+     * Add the component by component product of x and y to *this, i.e.,
+     * *this += x * y, without creating temporary objects
+     *
+     * @param x the first factor
+     * @param y the second factor
+     *
+     * @return a reference to *this
+     */
+    SpectrumValue& MultiplyAdd(const SpectrumValue& x, const SpectrumValue& y);
+
+    /**
+     * Add the component by component difference between x and y to *this, i.e.,
+     * *this += x - y, without creating temporary objects. This is typically
+     * used to compute the interference (plus noise) perceived by a signal y
+     * out of the sum x of all the signals being received.
+     *
+     * @param x the minuend
+     * @param y the subtrahend
+     *
+     * @return a reference to *this
+     */
+    SpectrumValue& AddDifference(const SpectrumValue& x, const SpectrumValue& y);
+
+    /**
+     * Set each component of *this to the ratio between the corresponding
+     * components of num and den, i.e., *this = num / den. The memory already
+     * allocated for *this is reused if it has the same spectrum model as num.
+     *
+     * @param num the numerator
+     * @param den the denominator
+     *
+     * @return a reference to *this
+     */
+    SpectrumValue& SetRatio(const SpectrumValue& num, const SpectrumValue& den);
+
     /**
      *
      * @param x the operand
@@ -588,6 +635,12 @@ class SpectrumValue : public SimpleRefCount<SpectrumValue>
      */
     void Log();
 
+    /**
+     * Check that x can be combined component by component with *this
+     * \param x SpectrumValue
+     */
+    void AssertSameModel(const SpectrumValue& x) const;
+
     Ptr<const SpectrumModel> m_spectrumModel; //!< The spectrum model
 
     /**
@@ -30,6 +30,7 @@
 #include "ns3/phased-array-model.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 #include <ns3/simulator.h>
 
 #include <algorithm>
@@ -245,6 +246,7 @@ static const double sqrtC_office_NLOS[6][6] = {
 };
 
 ThreeGppChannelModel::ThreeGppChannelModel()
+    : m_batchThreads(0)
 {
     NS_LOG_FUNCTION(this);
     m_uniformRv = CreateObject<UniformRandomVariable>();
@@ -272,6 +274,7 @@ ThreeGppChannelModel::DoDispose()
     m_channelMatrixMap.clear();
     m_channelParamsMap.clear();
     m_channelConditionModel = nullptr;
+    m_threadPool = nullptr;
 }
 
 TypeId
@@ -335,6 +338,13 @@ ThreeGppChannelModel::GetTypeId()
                           DoubleValue(0.0),
                           MakeDoubleAccessor(&ThreeGppChannelModel::m_vScatt),
                           MakeDoubleChecker<double>(0.0))
+            .AddAttribute("BatchThreads",
+                          "The number of threads computing the coefficients of the channel "
+                          "matrices generated by GetChannels. If this value is 0 or 1, the "
+                          "coefficients are computed by the simulator thread.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelModel::m_batchThreads),
+                          MakeUintegerChecker<uint32_t>())
 
         ;
     return tid;
@@ -1093,11 +1103,13 @@ ThreeGppChannelModel::ChannelMatrixNeedsUpdate(Ptr<const ThreeGppChannelParams>
     }
 }
 
-Ptr<const MatrixBasedChannelModel::ChannelMatrix>
-ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
-                                 Ptr<const MobilityModel> bMob,
-                                 Ptr<const PhasedArrayModel> aAntenna,
-                                 Ptr<const PhasedArrayModel> bAntenna)
+Ptr<MatrixBasedChannelModel::ChannelMatrix>
+ThreeGppChannelModel::LookupChannel(Ptr<const MobilityModel> aMob,
+                                    Ptr<const MobilityModel> bMob,
+                                    Ptr<const PhasedArrayModel> aAntenna,
+                                    Ptr<const PhasedArrayModel> bAntenna,
+                                    Ptr<ThreeGppChannelParams>& channelParams,
+                                    Ptr<const ParamsTable>& table3gpp)
 {
     NS_LOG_FUNCTION(this);
 
@@ -1118,7 +1130,6 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     bool notFoundParams = false;
     bool notFoundMatrix = false;
     Ptr<ChannelMatrix> channelMatrix;
-    Ptr<ThreeGppChannelParams> channelParams;
 
     if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
     {
@@ -1142,7 +1153,7 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     double hBs = std::max(aMob->GetPosition().z, bMob->GetPosition().z);
 
     // get the 3GPP parameters
-    Ptr<const ParamsTable> table3gpp = GetThreeGppTable(condition, hBs, hUt, distance2D);
+    table3gpp = GetThreeGppTable(condition, hBs, hUt, distance2D);
 
     if (notFoundParams || updateParams)
     {
@@ -1173,8 +1184,28 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     }
 
     // If the channel is not present in the map or if it has to be updated
-    // generate a new realization
+    // a new realization has to be generated
     if (notFoundMatrix || updateMatrix)
+    {
+        return nullptr;
+    }
+    return channelMatrix;
+}
+
+Ptr<const MatrixBasedChannelModel::ChannelMatrix>
+ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
+                                 Ptr<const MobilityModel> bMob,
+                                 Ptr<const PhasedArrayModel> aAntenna,
+                                 Ptr<const PhasedArrayModel> bAntenna)
+{
+    NS_LOG_FUNCTION(this);
+
+    Ptr<ThreeGppChannelParams> channelParams;
+    Ptr<const ParamsTable> table3gpp;
+    Ptr<ChannelMatrix> channelMatrix =
+        LookupChannel(aMob, bMob, aAntenna, bAntenna, channelParams, table3gpp);
+
+    if (!channelMatrix)
     {
         // channel matrix not found or has to be updated, generate a new one
         channelMatrix = GetNewChannel(channelParams, table3gpp, aMob, bMob, aAntenna, bAntenna);
@@ -1184,12 +1215,86 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
                                                // antennas at the moment of the channel generation
 
         // store or replace the channel matrix in the channel map
-        m_channelMatrixMap[channelMatrixKey] = channelMatrix;
+        m_channelMatrixMap[GetKey(aAntenna->GetId(), bAntenna->GetId())] = channelMatrix;
     }
 
     return channelMatrix;
 }
 
+std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix>>
+ThreeGppChannelModel::GetChannels(const std::vector<ChannelRequest>& requests)
+{
+    NS_LOG_FUNCTION(this << requests.size());
+
+    std::vector<Ptr<const ChannelMatrix>> channelMatrices;
+    channelMatrices.reserve(requests.size());
+    // the parameters of the coefficients to compute and the matrices to fill
+    std::vector<ChannelCoefficientsParams> coefficientsParams;
+    std::vector<ChannelMatrix*> newChannelMatrices;
+
+    // the new channel matrices are stored in the map before their coefficients
+    // are computed, so that subsequent requests for the same pair of antenna
+    // arrays are served as if GetChannel had been called for each request
+    for (const auto& request : requests)
+    {
+        Ptr<ThreeGppChannelParams> channelParams;
+        Ptr<const ParamsTable> table3gpp;
+        Ptr<ChannelMatrix> channelMatrix = LookupChannel(request.aMob,
+                                                         request.bMob,
+                                                         request.aAntenna,
+                                                         request.bAntenna,
+                                                         channelParams,
+                                                         table3gpp);
+        if (!channelMatrix)
+        {
+            coefficientsParams.emplace_back();
+            channelMatrix = PrepareNewChannel(channelParams,
+                                              table3gpp,
+                                              request.aMob,
+                                              request.bMob,
+                                              request.aAntenna,
+                                              request.bAntenna,
+                                              coefficientsParams.back());
+            channelMatrix->m_antennaPair =
+                std::make_pair(request.aAntenna->GetId(), request.bAntenna->GetId());
+            m_channelMatrixMap[GetKey(request.aAntenna->GetId(), request.bAntenna->GetId())] =
+                channelMatrix;
+            newChannelMatrices.push_back(PeekPointer(channelMatrix));
+        }
+        channelMatrices.push_back(channelMatrix);
+    }
+
+    NS_LOG_DEBUG("Generating " << newChannelMatrices.size() << " channel matrices for "
+                               << requests.size() << " requests");
+
+    std::vector<SpectrumThreadPool::Job> jobs;
+    jobs.reserve(newChannelMatrices.size());
+    for (std::size_t i = 0; i < newChannelMatrices.size(); i++)
+    {
+        jobs.emplace_back([params = &coefficientsParams[i], matrix = newChannelMatrices[i]]() {
+            ComputeChannelCoefficients(*params, matrix->m_channel);
+        });
+    }
+
+    if (m_batchThreads > 1)
+    {
+        if (!m_threadPool || m_threadPool->GetNThreads() != m_batchThreads)
+        {
+            m_threadPool = Create<SpectrumThreadPool>(m_batchThreads);
+        }
+        m_threadPool->Run(jobs);
+    }
+    else
+    {
+        for (const auto& job : jobs)
+        {
+            job();
+        }
+    }
+
+    return channelMatrices;
+}
+
 Ptr<const MatrixBasedChannelModel::ChannelParams>
 ThreeGppChannelModel::GetParams(Ptr<const MobilityModel> aMob, Ptr<const MobilityModel> bMob) const
 {
@@ -1837,6 +1942,44 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
 {
     NS_LOG_FUNCTION(this);
 
+    ChannelCoefficientsParams coefficientsParams;
+    Ptr<ChannelMatrix> channelMatrix = PrepareNewChannel(channelParams,
+                                                         table3gpp,
+                                                         sMob,
+                                                         uMob,
+                                                         sAntenna,
+                                                         uAntenna,
+                                                         coefficientsParams);
+    ComputeChannelCoefficients(coefficientsParams, channelMatrix->m_channel);
+
+    const Complex3DVector& hUsn = channelMatrix->m_channel;
+    NS_LOG_DEBUG("Husn (sAntenna, uAntenna):" << sAntenna->GetId() << ", " << uAntenna->GetId());
+    for (std::size_t uIndex = 0; uIndex < hUsn.GetNumRows(); uIndex++)
+    {
+        for (std::size_t sIndex = 0; sIndex < hUsn.GetNumCols(); sIndex++)
+        {
+            for (std::size_t nIndex = 0; nIndex < hUsn.GetNumPages(); nIndex++)
+            {
+                NS_LOG_DEBUG(" " << hUsn(uIndex, sIndex, nIndex) << ",");
+            }
+        }
+    }
+    NS_LOG_INFO("size of coefficient matrix =[" << hUsn.GetNumRows() << "][" << hUsn.GetNumCols()
+                                                << "][" << hUsn.GetNumPages() << "]");
+    return channelMatrix;
+}
+
+Ptr<MatrixBasedChannelModel::ChannelMatrix>
+ThreeGppChannelModel::PrepareNewChannel(Ptr<const ThreeGppChannelParams> channelParams,
+                                        Ptr<const ParamsTable> table3gpp,
+                                        const Ptr<const MobilityModel> sMob,
+                                        const Ptr<const MobilityModel> uMob,
+                                        Ptr<const PhasedArrayModel> sAntenna,
+                                        Ptr<const PhasedArrayModel> uAntenna,
+                                        ChannelCoefficientsParams& coefficientsParams) const
+{
+    NS_LOG_FUNCTION(this);
+
     NS_ASSERT_MSG(m_frequency > 0.0, "Set the operating frequency first!");
 
     // create a channel matrix instance
@@ -1848,194 +1991,270 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     // check if channelParams structure is generated in direction s-to-u or u-to-s
     bool isSameDirection = (channelParams->m_nodeIds == channelMatrix->m_nodeIds);
 
-    MatrixBasedChannelModel::Double2DVector rayAodRadian;
-    MatrixBasedChannelModel::Double2DVector rayAoaRadian;
-    MatrixBasedChannelModel::Double2DVector rayZodRadian;
-    MatrixBasedChannelModel::Double2DVector rayZoaRadian;
-
     // if channel params is generated in the same direction in which we
     // generate the channel matrix, angles and zenit od departure and arrival are ok,
-    // just set them to corresponding variable that will be used for the generation
-    // of channel matrix, otherwise we need to flip angles and zenits of departure and arrival
-    if (isSameDirection)
-    {
-        rayAodRadian = channelParams->m_rayAodRadian;
-        rayAoaRadian = channelParams->m_rayAoaRadian;
-        rayZodRadian = channelParams->m_rayZodRadian;
-        rayZoaRadian = channelParams->m_rayZoaRadian;
-    }
-    else
-    {
-        rayAodRadian = channelParams->m_rayAoaRadian;
-        rayAoaRadian = channelParams->m_rayAodRadian;
-        rayZodRadian = channelParams->m_rayZoaRadian;
-        rayZoaRadian = channelParams->m_rayZodRadian;
-    }
+    // just use them for the generation of channel matrix, otherwise we need to
+    // flip angles and zenits of departure and arrival
+    const Double2DVector& rayAodRadian =
+        isSameDirection ? channelParams->m_rayAodRadian : channelParams->m_rayAoaRadian;
+    const Double2DVector& rayAoaRadian =
+        isSameDirection ? channelParams->m_rayAoaRadian : channelParams->m_rayAodRadian;
+    const Double2DVector& rayZodRadian =
+        isSameDirection ? channelParams->m_rayZodRadian : channelParams->m_rayZoaRadian;
+    const Double2DVector& rayZoaRadian =
+        isSameDirection ? channelParams->m_rayZoaRadian : channelParams->m_rayZodRadian;
 
     // Step 11: Generate channel coefficients for each cluster n and each receiver
     //  and transmitter element pair u,s.
-    Complex3DVector hUsn; // channel coffecient hUsn[u][s][n];
-    // where u and s are receive and transmit antenna element, n is cluster index.
     // NOTE Since each of the strongest 2 clusters are divided into 3 sub-clusters,
     // the total cluster will be numReducedCLuster + 4.
-    uint64_t uSize = uAntenna->GetNumberOfElements();
-    uint64_t sSize = sAntenna->GetNumberOfElements();
-
-    hUsn.resize(uSize);
-    for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+    // The terms of each ray that do not depend on the antenna elements are computed
+    // here, while the coefficients are computed by ComputeChannelCoefficients
+    uint8_t numClusters = channelParams->m_reducedClusterNumber;
+    uint8_t raysPerCluster = table3gpp->m_raysPerCluster;
+
+    NS_ASSERT(numClusters <= channelParams->m_clusterPhase.size());
+    NS_ASSERT(numClusters <= channelParams->m_clusterPower.size());
+    NS_ASSERT(numClusters <= channelParams->m_crossPolarizationPowerRatios.size());
+    NS_ASSERT(numClusters <= rayZoaRadian.size());
+    NS_ASSERT(numClusters <= rayZodRadian.size());
+    NS_ASSERT(numClusters <= rayAoaRadian.size());
+    NS_ASSERT(numClusters <= rayAodRadian.size());
+    NS_ASSERT(raysPerCluster <= channelParams->m_clusterPhase[0].size());
+    NS_ASSERT(raysPerCluster <= channelParams->m_crossPolarizationPowerRatios[0].size());
+    NS_ASSERT(raysPerCluster <= rayZoaRadian[0].size());
+    NS_ASSERT(raysPerCluster <= rayZodRadian[0].size());
+    NS_ASSERT(raysPerCluster <= rayAoaRadian[0].size());
+    NS_ASSERT(raysPerCluster <= rayAodRadian[0].size());
+
+    coefficientsParams.m_numClusters = numClusters;
+    coefficientsParams.m_raysPerCluster = raysPerCluster;
+    coefficientsParams.m_subClusterIndex.assign(numClusters, 0);
+    coefficientsParams.m_clusterScale.resize(numClusters);
+    coefficientsParams.m_rxWaveVectors.resize(numClusters * raysPerCluster);
+    coefficientsParams.m_txWaveVectors.resize(numClusters * raysPerCluster);
+    coefficientsParams.m_rayTerms.resize(numClusters * raysPerCluster);
+
+    // the sub-clusters of the strongest clusters are appended after the other
+    // clusters, in the order of the clusters
+    uint8_t numTotClusters = numClusters;
+    for (uint8_t nIndex = 0; nIndex < numClusters; nIndex++)
     {
-        hUsn[uIndex].resize(sSize);
-        for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+        bool isStrongest =
+            (nIndex == channelParams->m_cluster1st || nIndex == channelParams->m_cluster2nd);
+        if (isStrongest)
         {
-            hUsn[uIndex][sIndex].resize(channelParams->m_reducedClusterNumber);
+            coefficientsParams.m_subClusterIndex[nIndex] = numTotClusters;
+            numTotClusters += 2;
+        }
+        coefficientsParams.m_clusterScale[nIndex] =
+            sqrt(channelParams->m_clusterPower[nIndex] / raysPerCluster);
+
+        for (uint8_t mIndex = 0; mIndex < raysPerCluster; mIndex++)
+        {
+            std::size_t rayIndex = nIndex * raysPerCluster + mIndex;
+            const DoubleVector& initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
+            NS_ASSERT(4 <= initialPhase.size());
+            double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
+
+            // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
+            coefficientsParams.m_rxWaveVectors[rayIndex] =
+                Vector(sin(rayZoaRadian[nIndex][mIndex]) * cos(rayAoaRadian[nIndex][mIndex]),
+                       sin(rayZoaRadian[nIndex][mIndex]) * sin(rayAoaRadian[nIndex][mIndex]),
+                       cos(rayZoaRadian[nIndex][mIndex]));
+            coefficientsParams.m_txWaveVectors[rayIndex] =
+                Vector(sin(rayZodRadian[nIndex][mIndex]) * cos(rayAodRadian[nIndex][mIndex]),
+                       sin(rayZodRadian[nIndex][mIndex]) * sin(rayAodRadian[nIndex][mIndex]),
+                       cos(rayZodRadian[nIndex][mIndex]));
+            // NOTE Doppler is computed in the CalcBeamformingGain function and is
+            // simplified to only account for the center angle of each cluster.
+
+            // the field patterns of the N-2 weakest clusters, which assume 0 slant
+            // angle and a polarization slant angle configured in the array (7.5-22),
+            // are computed with the angles of the channel params, those of the two
+            // strongest clusters (7.5-28) with the angles in the direction of the
+            // channel matrix
+            double rxFieldPatternPhi;
+            double rxFieldPatternTheta;
+            double txFieldPatternPhi;
+            double txFieldPatternTheta;
+            if (!isStrongest)
+            {
+                std::tie(rxFieldPatternPhi, rxFieldPatternTheta) =
+                    uAntenna->GetElementFieldPattern(
+                        Angles(channelParams->m_rayAoaRadian[nIndex][mIndex],
+                               channelParams->m_rayZoaRadian[nIndex][mIndex]));
+                std::tie(txFieldPatternPhi, txFieldPatternTheta) =
+                    sAntenna->GetElementFieldPattern(
+                        Angles(channelParams->m_rayAodRadian[nIndex][mIndex],
+                               channelParams->m_rayZodRadian[nIndex][mIndex]));
+            }
+            else
+            {
+                std::tie(rxFieldPatternPhi, rxFieldPatternTheta) =
+                    uAntenna->GetElementFieldPattern(
+                        Angles(rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]));
+                std::tie(txFieldPatternPhi, txFieldPatternTheta) =
+                    sAntenna->GetElementFieldPattern(
+                        Angles(rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]));
+            }
+
+            coefficientsParams.m_rayTerms[rayIndex] =
+                std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
+                    rxFieldPatternTheta * txFieldPatternTheta +
+                std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
+                    std::sqrt(1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
+                std::complex<double>(cos(initialPhase[2]), sin(initialPhase[2])) *
+                    std::sqrt(1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
+                std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
+                    rxFieldPatternPhi * txFieldPatternPhi;
         }
     }
+    coefficientsParams.m_numTotClusters = numTotClusters;
 
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= channelParams->m_clusterPhase.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= channelParams->m_clusterPower.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <=
-              channelParams->m_crossPolarizationPowerRatios.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayZoaRadian.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayZodRadian.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayAoaRadian.size());
-    NS_ASSERT(channelParams->m_reducedClusterNumber <= rayAodRadian.size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= channelParams->m_clusterPhase[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <=
-              channelParams->m_crossPolarizationPowerRatios[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayZoaRadian[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayZodRadian[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayAoaRadian[0].size());
-    NS_ASSERT(table3gpp->m_raysPerCluster <= rayAodRadian[0].size());
-
-    double x = sMob->GetPosition().x - uMob->GetPosition().x;
-    double y = sMob->GetPosition().y - uMob->GetPosition().y;
-    double distance2D = sqrt(x * x + y * y);
-    // NOTE we assume hUT = min (height(a), height(b)) and
-    // hBS = max (height (a), height (b))
-    double hUt = std::min(sMob->GetPosition().z, uMob->GetPosition().z);
-    double hBs = std::max(sMob->GetPosition().z, uMob->GetPosition().z);
-    // compute the 3D distance using eq. 7.4-1
-    double distance3D = std::sqrt(distance2D * distance2D + (hBs - hUt) * (hBs - hUt));
+    coefficientsParams.m_uLocations.resize(uAntenna->GetNumberOfElements());
+    for (uint64_t uIndex = 0; uIndex < coefficientsParams.m_uLocations.size(); uIndex++)
+    {
+        coefficientsParams.m_uLocations[uIndex] = uAntenna->GetElementLocation(uIndex);
+    }
+    coefficientsParams.m_sLocations.resize(sAntenna->GetNumberOfElements());
+    for (uint64_t sIndex = 0; sIndex < coefficientsParams.m_sLocations.size(); sIndex++)
+    {
+        coefficientsParams.m_sLocations[sIndex] = sAntenna->GetElementLocation(sIndex);
+    }
+
+    coefficientsParams.m_los = (channelParams->m_losCondition == ChannelCondition::LOS);
+    if (coefficientsParams.m_los) //(7.5-29) && (7.5-30)
+    {
+        double x = sMob->GetPosition().x - uMob->GetPosition().x;
+        double y = sMob->GetPosition().y - uMob->GetPosition().y;
+        double distance2D = sqrt(x * x + y * y);
+        // NOTE we assume hUT = min (height(a), height(b)) and
+        // hBS = max (height (a), height (b))
+        double hUt = std::min(sMob->GetPosition().z, uMob->GetPosition().z);
+        double hBs = std::max(sMob->GetPosition().z, uMob->GetPosition().z);
+        // compute the 3D distance using eq. 7.4-1
+        double distance3D = std::sqrt(distance2D * distance2D + (hBs - hUt) * (hBs - hUt));
+
+        Angles sAngle(uMob->GetPosition(), sMob->GetPosition());
+        Angles uAngle(sMob->GetPosition(), uMob->GetPosition());
+
+        coefficientsParams.m_rxLosWaveVector =
+            Vector(sin(uAngle.GetInclination()) * cos(uAngle.GetAzimuth()),
+                   sin(uAngle.GetInclination()) * sin(uAngle.GetAzimuth()),
+                   cos(uAngle.GetInclination()));
+        coefficientsParams.m_txLosWaveVector =
+            Vector(sin(sAngle.GetInclination()) * cos(sAngle.GetAzimuth()),
+                   sin(sAngle.GetInclination()) * sin(sAngle.GetAzimuth()),
+                   cos(sAngle.GetInclination()));
+
+        double rxFieldPatternPhi;
+        double rxFieldPatternTheta;
+        double txFieldPatternPhi;
+        double txFieldPatternTheta;
+        std::tie(rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern(
+            Angles(uAngle.GetAzimuth(), uAngle.GetInclination()));
+        std::tie(txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern(
+            Angles(sAngle.GetAzimuth(), sAngle.GetInclination()));
+
+        double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
+
+        coefficientsParams.m_losTerm =
+            (rxFieldPatternTheta * txFieldPatternTheta - rxFieldPatternPhi * txFieldPatternPhi) *
+            std::complex<double>(cos(-2 * M_PI * distance3D / lambda),
+                                 sin(-2 * M_PI * distance3D / lambda));
+
+        double kLinear = pow(10, channelParams->m_K_factor / 10);
+        coefficientsParams.m_nlosScale = sqrt(1 / (kLinear + 1));
+        coefficientsParams.m_losScale = sqrt(kLinear / (1 + kLinear));
+        // the LOS path should be attenuated if blockage is enabled.
+        coefficientsParams.m_losAttenuation = pow(10, channelParams->m_attenuation_dB[0] / 10);
+    }
+
+    return channelMatrix;
+}
 
-    Angles sAngle(uMob->GetPosition(), sMob->GetPosition());
-    Angles uAngle(sMob->GetPosition(), uMob->GetPosition());
+void
+ThreeGppChannelModel::ComputeChannelCoefficients(const ChannelCoefficientsParams& params,
+                                                 Complex3DVector& hUsn)
+{
+    const std::size_t uSize = params.m_uLocations.size();
+    const std::size_t sSize = params.m_sLocations.size();
+    const std::size_t numRays = params.m_numClusters * params.m_raysPerCluster;
+    // channel coefficient hUsn[u][s][n], where u and s are receive and transmit
+    // antenna element, n is cluster index.
+    hUsn = Complex3DVector(uSize, sSize, params.m_numTotClusters);
+
+    // the phase terms of the rays at each transmit antenna element, txRays[s][ray]
+    PhasedArrayModel::ComplexVector txRays(sSize * numRays);
+    PhasedArrayModel::ComplexVector txLos(sSize);
+    for (std::size_t sIndex = 0; sIndex < sSize; sIndex++)
+    {
+        const Vector& sLoc = params.m_sLocations[sIndex];
+        for (std::size_t rayIndex = 0; rayIndex < numRays; rayIndex++)
+        {
+            const Vector& w = params.m_txWaveVectors[rayIndex];
+            double txPhaseDiff = 2 * M_PI * (w.x * sLoc.x + w.y * sLoc.y + w.z * sLoc.z);
+            txRays[sIndex * numRays + rayIndex] =
+                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+        }
+        if (params.m_los)
+        {
+            const Vector& w = params.m_txLosWaveVector;
+            double txPhaseDiff = 2 * M_PI * (w.x * sLoc.x + w.y * sLoc.y + w.z * sLoc.z);
+            txLos[sIndex] = std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+        }
+    }
 
-    // The following for loops computes the channel coefficients
-    for (uint64_t uIndex = 0; uIndex < uSize; uIndex++)
+    // the ray terms multiplied by the phase terms at the current receive antenna element
+    PhasedArrayModel::ComplexVector rxRays(numRays);
+    for (std::size_t uIndex = 0; uIndex < uSize; uIndex++)
     {
-        Vector uLoc = uAntenna->GetElementLocation(uIndex);
+        const Vector& uLoc = params.m_uLocations[uIndex];
+        for (std::size_t rayIndex = 0; rayIndex < numRays; rayIndex++)
+        {
+            const Vector& w = params.m_rxWaveVectors[rayIndex];
+            double rxPhaseDiff = 2 * M_PI * (w.x * uLoc.x + w.y * uLoc.y + w.z * uLoc.z);
+            rxRays[rayIndex] = params.m_rayTerms[rayIndex] *
+                               std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff));
+        }
+        std::complex<double> rxLos;
+        if (params.m_los)
+        {
+            const Vector& w = params.m_rxLosWaveVector;
+            double rxPhaseDiff = 2 * M_PI * (w.x * uLoc.x + w.y * uLoc.y + w.z * uLoc.z);
+            rxLos = params.m_losTerm * std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff));
+        }
 
-        for (uint64_t sIndex = 0; sIndex < sSize; sIndex++)
+        for (std::size_t sIndex = 0; sIndex < sSize; sIndex++)
         {
-            Vector sLoc = sAntenna->GetElementLocation(sIndex);
+            std::complex<double>* h = hUsn.GetValues(uIndex, sIndex);
+            const std::complex<double>* tx = txRays.data() + sIndex * numRays;
 
-            for (uint8_t nIndex = 0; nIndex < channelParams->m_reducedClusterNumber; nIndex++)
+            for (uint8_t nIndex = 0; nIndex < params.m_numClusters; nIndex++)
             {
-                // Compute the N-2 weakest cluster, assuming 0 slant angle and a
-                // polarization slant angle configured in the array (7.5-22)
-                if (nIndex != channelParams->m_cluster1st && nIndex != channelParams->m_cluster2nd)
+                const std::complex<double>* rxCluster =
+                    rxRays.data() + nIndex * params.m_raysPerCluster;
+                const std::complex<double>* txCluster = tx + nIndex * params.m_raysPerCluster;
+
+                if (params.m_subClusterIndex[nIndex] == 0) // (7.5-22)
                 {
                     std::complex<double> rays(0, 0);
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    for (uint8_t mIndex = 0; mIndex < params.m_raysPerCluster; mIndex++)
                     {
-                        DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
-                        double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
-                        // lambda_0 is accounted in the antenna spacing uLoc and sLoc.
-                        double rxPhaseDiff = 2 * M_PI *
-                                             (sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  cos(rayAoaRadian[nIndex][mIndex]) * uLoc.x +
-                                              sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  sin(rayAoaRadian[nIndex][mIndex]) * uLoc.y +
-                                              cos(rayZoaRadian[nIndex][mIndex]) * uLoc.z);
-
-                        double txPhaseDiff = 2 * M_PI *
-                                             (sin(rayZodRadian[nIndex][mIndex]) *
-                                                  cos(rayAodRadian[nIndex][mIndex]) * sLoc.x +
-                                              sin(rayZodRadian[nIndex][mIndex]) *
-                                                  sin(rayAodRadian[nIndex][mIndex]) * sLoc.y +
-                                              cos(rayZodRadian[nIndex][mIndex]) * sLoc.z);
-                        // NOTE Doppler is computed in the CalcBeamformingGain function and is
-                        // simplified to only account for the center angle of each cluster.
-
-                        double rxFieldPatternPhi;
-                        double rxFieldPatternTheta;
-                        double txFieldPatternPhi;
-                        double txFieldPatternTheta;
-                        std::tie(rxFieldPatternPhi, rxFieldPatternTheta) =
-                            uAntenna->GetElementFieldPattern(
-                                Angles(channelParams->m_rayAoaRadian[nIndex][mIndex],
-                                       channelParams->m_rayZoaRadian[nIndex][mIndex]));
-                        std::tie(txFieldPatternPhi, txFieldPatternTheta) =
-                            sAntenna->GetElementFieldPattern(
-                                Angles(channelParams->m_rayAodRadian[nIndex][mIndex],
-                                       channelParams->m_rayZodRadian[nIndex][mIndex]));
-                        NS_ASSERT(4 <= initialPhase.size());
-                        rays += (std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
-                                     rxFieldPatternTheta * txFieldPatternTheta +
-                                 std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
-                                     std::sqrt(1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                                 std::complex<double>(cos(initialPhase[2]), sin(initialPhase[2])) *
-                                     std::sqrt(1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                                 std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
-                                     rxFieldPatternPhi * txFieldPatternPhi) *
-                                std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                                std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
+                        rays += rxCluster[mIndex] * txCluster[mIndex];
                     }
-                    rays *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn[uIndex][sIndex][nIndex] = rays;
+                    rays *= params.m_clusterScale[nIndex];
+                    h[nIndex] = rays;
                 }
                 else //(7.5-28)
                 {
                     std::complex<double> raysSub1(0, 0);
                     std::complex<double> raysSub2(0, 0);
                     std::complex<double> raysSub3(0, 0);
-
-                    for (uint8_t mIndex = 0; mIndex < table3gpp->m_raysPerCluster; mIndex++)
+                    for (uint8_t mIndex = 0; mIndex < params.m_raysPerCluster; mIndex++)
                     {
-                        double k = channelParams->m_crossPolarizationPowerRatios[nIndex][mIndex];
-
-                        // ZML:Just remind me that the angle offsets for the 3 subclusters were not
-                        // generated correctly.
-                        DoubleVector initialPhase = channelParams->m_clusterPhase[nIndex][mIndex];
-                        NS_ASSERT(4 <= initialPhase.size());
-
-                        double rxPhaseDiff = 2 * M_PI *
-                                             (sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  cos(rayAoaRadian[nIndex][mIndex]) * uLoc.x +
-                                              sin(rayZoaRadian[nIndex][mIndex]) *
-                                                  sin(rayAoaRadian[nIndex][mIndex]) * uLoc.y +
-                                              cos(rayZoaRadian[nIndex][mIndex]) * uLoc.z);
-                        double txPhaseDiff = 2 * M_PI *
-                                             (sin(rayZodRadian[nIndex][mIndex]) *
-                                                  cos(rayAodRadian[nIndex][mIndex]) * sLoc.x +
-                                              sin(rayZodRadian[nIndex][mIndex]) *
-                                                  sin(rayAodRadian[nIndex][mIndex]) * sLoc.y +
-                                              cos(rayZodRadian[nIndex][mIndex]) * sLoc.z);
-
-                        double rxFieldPatternPhi;
-                        double rxFieldPatternTheta;
-                        double txFieldPatternPhi;
-                        double txFieldPatternTheta;
-                        std::tie(rxFieldPatternPhi, rxFieldPatternTheta) =
-                            uAntenna->GetElementFieldPattern(
-                                Angles(rayAoaRadian[nIndex][mIndex], rayZoaRadian[nIndex][mIndex]));
-                        std::tie(txFieldPatternPhi, txFieldPatternTheta) =
-                            sAntenna->GetElementFieldPattern(
-                                Angles(rayAodRadian[nIndex][mIndex], rayZodRadian[nIndex][mIndex]));
-
-                        std::complex<double> raySub =
-                            (std::complex<double>(cos(initialPhase[0]), sin(initialPhase[0])) *
-                                 rxFieldPatternTheta * txFieldPatternTheta +
-                             std::complex<double>(cos(initialPhase[1]), sin(initialPhase[1])) *
-                                 sqrt(1 / k) * rxFieldPatternTheta * txFieldPatternPhi +
-                             std::complex<double>(cos(initialPhase[2]), sin(initialPhase[2])) *
-                                 sqrt(1 / k) * rxFieldPatternPhi * txFieldPatternTheta +
-                             std::complex<double>(cos(initialPhase[3]), sin(initialPhase[3])) *
-                                 rxFieldPatternPhi * txFieldPatternPhi) *
-                            std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                            std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
-
+                        std::complex<double> raySub = rxCluster[mIndex] * txCluster[mIndex];
                         switch (mIndex)
                         {
                         case 9:
@@ -2057,81 +2276,27 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
                             break;
                         }
                     }
-                    raysSub1 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub2 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    raysSub3 *=
-                        sqrt(channelParams->m_clusterPower[nIndex] / table3gpp->m_raysPerCluster);
-                    hUsn[uIndex][sIndex][nIndex] = raysSub1;
-                    hUsn[uIndex][sIndex].push_back(raysSub2);
-                    hUsn[uIndex][sIndex].push_back(raysSub3);
+                    raysSub1 *= params.m_clusterScale[nIndex];
+                    raysSub2 *= params.m_clusterScale[nIndex];
+                    raysSub3 *= params.m_clusterScale[nIndex];
+                    h[nIndex] = raysSub1;
+                    h[params.m_subClusterIndex[nIndex]] = raysSub2;
+                    h[params.m_subClusterIndex[nIndex] + 1] = raysSub3;
                 }
             }
 
-            if (channelParams->m_losCondition == ChannelCondition::LOS) //(7.5-29) && (7.5-30)
+            if (params.m_los) //(7.5-29) && (7.5-30)
             {
-                std::complex<double> ray(0, 0);
-                double rxPhaseDiff =
-                    2 * M_PI *
-                    (sin(uAngle.GetInclination()) * cos(uAngle.GetAzimuth()) * uLoc.x +
-                     sin(uAngle.GetInclination()) * sin(uAngle.GetAzimuth()) * uLoc.y +
-                     cos(uAngle.GetInclination()) * uLoc.z);
-                double txPhaseDiff =
-                    2 * M_PI *
-                    (sin(sAngle.GetInclination()) * cos(sAngle.GetAzimuth()) * sLoc.x +
-                     sin(sAngle.GetInclination()) * sin(sAngle.GetAzimuth()) * sLoc.y +
-                     cos(sAngle.GetInclination()) * sLoc.z);
-
-                double rxFieldPatternPhi;
-                double rxFieldPatternTheta;
-                double txFieldPatternPhi;
-                double txFieldPatternTheta;
-                std::tie(rxFieldPatternPhi, rxFieldPatternTheta) = uAntenna->GetElementFieldPattern(
-                    Angles(uAngle.GetAzimuth(), uAngle.GetInclination()));
-                std::tie(txFieldPatternPhi, txFieldPatternTheta) = sAntenna->GetElementFieldPattern(
-                    Angles(sAngle.GetAzimuth(), sAngle.GetInclination()));
-
-                double lambda = 3e8 / m_frequency; // the wavelength of the carrier frequency
-
-                ray = (rxFieldPatternTheta * txFieldPatternTheta -
-                       rxFieldPatternPhi * txFieldPatternPhi) *
-                      std::complex<double>(cos(-2 * M_PI * distance3D / lambda),
-                                           sin(-2 * M_PI * distance3D / lambda)) *
-                      std::complex<double>(cos(rxPhaseDiff), sin(rxPhaseDiff)) *
-                      std::complex<double>(cos(txPhaseDiff), sin(txPhaseDiff));
-
-                double kLinear = pow(10, channelParams->m_K_factor / 10);
-                // the LOS path should be attenuated if blockage is enabled.
-                hUsn[uIndex][sIndex][0] =
-                    sqrt(1 / (kLinear + 1)) * hUsn[uIndex][sIndex][0] +
-                    sqrt(kLinear / (1 + kLinear)) * ray /
-                        pow(10, channelParams->m_attenuation_dB[0] / 10); //(7.5-30) for tau = tau1
-                double tempSize = hUsn[uIndex][sIndex].size();
-                for (uint8_t nIndex = 1; nIndex < tempSize; nIndex++)
+                std::complex<double> ray = rxLos * txLos[sIndex];
+                h[0] = params.m_nlosScale * h[0] +
+                       params.m_losScale * ray / params.m_losAttenuation; //(7.5-30) for tau = tau1
+                for (uint8_t nIndex = 1; nIndex < params.m_numTotClusters; nIndex++)
                 {
-                    hUsn[uIndex][sIndex][nIndex] *=
-                        sqrt(1 / (kLinear + 1)); //(7.5-30) for tau = tau2...taunN
+                    h[nIndex] *= params.m_nlosScale; //(7.5-30) for tau = tau2...taunN
                 }
             }
         }
     }
-
-    NS_LOG_DEBUG("Husn (sAntenna, uAntenna):" << sAntenna->GetId() << ", " << uAntenna->GetId());
-    for (auto& i : hUsn)
-    {
-        for (auto& j : i)
-        {
-            for (auto& k : j)
-            {
-                NS_LOG_DEBUG(" " << k << ",");
-            }
-        }
-    }
-    NS_LOG_INFO("size of coefficient matrix =[" << hUsn.size() << "][" << hUsn[0].size() << "]["
-                                                << hUsn[0][0].size() << "]");
-    channelMatrix->m_channel = hUsn;
-    return channelMatrix;
 }
 
 std::pair<double, double>
@@ -29,9 +29,11 @@
 #include <ns3/nstime.h>
 #include <ns3/object.h>
 #include <ns3/random-variable-stream.h>
+#include <ns3/spectrum-thread-pool.h>
 
 #include <complex.h>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -121,6 +123,32 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
                                         Ptr<const PhasedArrayModel> aAntenna,
                                         Ptr<const PhasedArrayModel> bAntenna) override;
 
+    /**
+     * A request for the channel matrix between two nodes, see GetChannels
+     */
+    struct ChannelRequest
+    {
+        Ptr<const MobilityModel> aMob;        //!< mobility model of the a device
+        Ptr<const MobilityModel> bMob;        //!< mobility model of the b device
+        Ptr<const PhasedArrayModel> aAntenna; //!< antenna of the a device
+        Ptr<const PhasedArrayModel> bAntenna; //!< antenna of the b device
+    };
+
+    /**
+     * Get the channel matrices of a batch of node pairs, e.g., all the pairs whose
+     * channel has to be updated at the end of the same update period. The result
+     * is the same as calling GetChannel for each request, in order: the channel
+     * conditions and parameters are retrieved or generated in the order of the
+     * requests, so that the random variables are drawn in the same order, while
+     * the coefficients of the new channel matrices, which are the most expensive
+     * part of the generation, are then computed by the number of threads set by
+     * the BatchThreads attribute.
+     *
+     * \param requests the requests
+     * \return the channel matrices, in the order of the requests
+     */
+    std::vector<Ptr<const ChannelMatrix>> GetChannels(const std::vector<ChannelRequest>& requests);
+
     /**
      * Looks for the channel params associated to the aMob and bMob pair in
      * m_channelParamsMap. If not found it will return a nullptr.
@@ -303,6 +331,92 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
                                              const Ptr<const MobilityModel> uMob,
                                              Ptr<const PhasedArrayModel> sAntenna,
                                              Ptr<const PhasedArrayModel> uAntenna) const;
+
+    /**
+     * The quantities needed to compute the coefficients of a channel matrix (step
+     * 11 of 3GPP TR 38.901) that do not depend on the pair of antenna elements,
+     * i.e., the terms of each ray and the locations of the antenna elements. This
+     * structure does not hold any Ptr, hence the coefficients can be computed by
+     * a thread other than the simulator thread.
+     */
+    struct ChannelCoefficientsParams
+    {
+        uint8_t m_numClusters{0};    //!< number of clusters, without the sub-clusters
+        uint8_t m_raysPerCluster{0}; //!< number of rays per cluster
+        uint8_t m_numTotClusters{0}; //!< number of clusters, including the sub-clusters
+        std::vector<uint8_t>
+            m_subClusterIndex; //!< for each cluster, the index of its second sub-cluster in the
+                               //!< channel matrix if it is one of the two strongest clusters,
+                               //!< zero otherwise
+        DoubleVector m_clusterScale;                //!< amplitude scaling factor of each cluster
+        std::vector<Vector> m_rxWaveVectors;        //!< unit vector of arrival of each ray
+        std::vector<Vector> m_txWaveVectors;        //!< unit vector of departure of each ray
+        PhasedArrayModel::ComplexVector m_rayTerms; //!< polarization and field pattern terms
+        std::vector<Vector> m_uLocations;           //!< locations of the u antenna elements
+        std::vector<Vector> m_sLocations;           //!< locations of the s antenna elements
+        bool m_los{false};                          //!< whether the LOS ray has to be added
+        Vector m_rxLosWaveVector;                   //!< unit vector of arrival of the LOS ray
+        Vector m_txLosWaveVector;                   //!< unit vector of departure of the LOS ray
+        std::complex<double> m_losTerm;             //!< field pattern and phase of the LOS ray
+        double m_nlosScale{1};                      //!< scaling factor of the NLOS clusters
+        double m_losScale{0};                       //!< scaling factor of the LOS ray
+        double m_losAttenuation{1};                 //!< blockage attenuation of the LOS ray
+    };
+
+    /**
+     * Create a channel matrix between two nodes s and u, and their antenna arrays
+     * sAntenna and uAntenna, without computing its coefficients, and prepare the
+     * parameters needed to compute them with ComputeChannelCoefficients
+     *
+     * \param channelParams the channel parameters previously generated for the pair of nodes
+     * \param table3gpp the 3gpp parameters table
+     * \param sMob the mobility model of node s
+     * \param uMob the mobility model of node u
+     * \param sAntenna the antenna array of node s
+     * \param uAntenna the antenna array of node u
+     * \param coefficientsParams the parameters needed to compute the coefficients
+     * \return the channel matrix, whose coefficients are not computed
+     */
+    Ptr<ChannelMatrix> PrepareNewChannel(Ptr<const ThreeGppChannelParams> channelParams,
+                                         Ptr<const ParamsTable> table3gpp,
+                                         const Ptr<const MobilityModel> sMob,
+                                         const Ptr<const MobilityModel> uMob,
+                                         Ptr<const PhasedArrayModel> sAntenna,
+                                         Ptr<const PhasedArrayModel> uAntenna,
+                                         ChannelCoefficientsParams& coefficientsParams) const;
+
+    /**
+     * Compute the coefficients of a channel matrix (step 11 of 3GPP TR 38.901).
+     * The phase terms of the rays are computed once per antenna element, hence
+     * the sum of the rays of each cluster for each pair of antenna elements only
+     * involves complex multiplications and additions on contiguous memory.
+     *
+     * \param params the parameters prepared by PrepareNewChannel
+     * \param hUsn the channel matrix H[u][s][n] to fill
+     */
+    static void ComputeChannelCoefficients(const ChannelCoefficientsParams& params,
+                                           Complex3DVector& hUsn);
+
+    /**
+     * Look for the channel matrix between the a and b nodes in m_channelMatrixMap
+     * and check whether it has to be updated, generating new channel parameters
+     * if needed.
+     *
+     * \param aMob mobility model of the a device
+     * \param bMob mobility model of the b device
+     * \param aAntenna antenna of the a device
+     * \param bAntenna antenna of the b device
+     * \param channelParams the channel parameters of the pair of nodes
+     * \param table3gpp the 3gpp parameters table
+     * \return the channel matrix, or a null pointer if a new channel matrix has to be generated
+     */
+    Ptr<ChannelMatrix> LookupChannel(Ptr<const MobilityModel> aMob,
+                                     Ptr<const MobilityModel> bMob,
+                                     Ptr<const PhasedArrayModel> aAntenna,
+                                     Ptr<const PhasedArrayModel> bAntenna,
+                                     Ptr<ThreeGppChannelParams>& channelParams,
+                                     Ptr<const ParamsTable>& table3gpp);
+
     /**
      * Applies the blockage model A described in 3GPP TR 38.901
      * \param channelParams the channel parameters structure
@@ -363,6 +477,10 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
     bool m_portraitMode;           //!< true if potrait mode, false if landscape
     double m_blockerSpeed;         //!< the blocker speed
 
+    // parameters for the batch generation of the channel matrices
+    uint32_t m_batchThreads;              //!< the number of threads used by GetChannels
+    Ptr<SpectrumThreadPool> m_threadPool; //!< the pool of threads used by GetChannels
+
     static const uint8_t PHI_INDEX = 0; //!< index of the PHI value in the m_nonSelfBlocking array
     static const uint8_t X_INDEX = 1;   //!< index of the X value in the m_nonSelfBlocking array
     static const uint8_t THETA_INDEX =
@@ -33,6 +33,7 @@
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <map>
 
 namespace ns3
@@ -123,32 +124,34 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     uint16_t sAntenna = static_cast<uint16_t>(sW.size());
     uint16_t uAntenna = static_cast<uint16_t>(uW.size());
 
-    NS_ASSERT(uAntenna == params->m_channel.size());
-    NS_ASSERT(sAntenna == params->m_channel.at(0).size());
+    NS_ASSERT(uAntenna == params->m_channel.GetNumRows());
+    NS_ASSERT(sAntenna == params->m_channel.GetNumCols());
 
     NS_LOG_DEBUG("CalcLongTerm with sAntenna " << sAntenna << " uAntenna " << uAntenna);
     // store the long term part to reduce computation load
     // only the small scale fading needs to be updated if the large scale parameters and antenna
     // weights remain unchanged.
-    PhasedArrayModel::ComplexVector longTerm;
-    uint8_t numCluster = static_cast<uint8_t>(params->m_channel[0][0].size());
+    uint8_t numCluster = static_cast<uint8_t>(params->m_channel.GetNumPages());
+    PhasedArrayModel::ComplexVector longTerm(numCluster);
 
-    NS_ASSERT(uAntenna == params->m_channel.size());
-    NS_ASSERT(sAntenna == params->m_channel.at(0).size());
-
-    for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+    // the coefficients of the clusters of a pair of antenna elements are contiguous,
+    // hence the sums are computed for all the clusters at once
+    PhasedArrayModel::ComplexVector rxSum(numCluster);
+    for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
     {
-        std::complex<double> txSum(0, 0);
-        for (uint16_t sIndex = 0; sIndex < sAntenna; sIndex++)
+        std::fill(rxSum.begin(), rxSum.end(), std::complex<double>(0, 0));
+        for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
         {
-            std::complex<double> rxSum(0, 0);
-            for (uint16_t uIndex = 0; uIndex < uAntenna; uIndex++)
+            const std::complex<double>* h = params->m_channel.GetValues(uIndex, sIndex);
+            for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
-                rxSum = rxSum + uW[uIndex] * params->m_channel[uIndex][sIndex][cIndex];
+                rxSum[cIndex] = rxSum[cIndex] + uW[uIndex] * h[cIndex];
             }
-            txSum = txSum + sW[sIndex] * rxSum;
         }
-        longTerm.push_back(txSum);
+        for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+        {
+            longTerm[cIndex] = longTerm[cIndex] + sW[sIndex] * rxSum[cIndex];
+        }
     }
     return longTerm;
 }
@@ -166,8 +169,26 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
 
     Ptr<SpectrumValue> tempPsd = Copy<SpectrumValue>(txPsd);
 
+    PhasedArrayModel::ComplexVector doppler =
+        CalcDoppler(channelMatrix, channelParams, sSpeed, uSpeed);
+    NS_ASSERT(doppler.size() <= longTerm.size());
+    NS_ASSERT(doppler.size() <= channelParams->m_delay.size());
+
+    ApplyBeamformingGain(*tempPsd, longTerm, doppler, channelParams->m_delay);
+    return tempPsd;
+}
+
+PhasedArrayModel::ComplexVector
+ThreeGppSpectrumPropagationLossModel::CalcDoppler(
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+    const ns3::Vector& sSpeed,
+    const ns3::Vector& uSpeed) const
+{
+    NS_LOG_FUNCTION(this);
+
     // channel[rx][tx][cluster]
-    uint8_t numCluster = static_cast<uint8_t>(channelMatrix->m_channel[0][0].size());
+    uint8_t numCluster = static_cast<uint8_t>(channelMatrix->m_channel.GetNumPages());
 
     // compute the doppler term
     // NOTE the update of Doppler is simplified by only taking the center angle of
@@ -187,7 +208,6 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     NS_ASSERT(numCluster <= channelParams->m_angle[MatrixBasedChannelModel::ZOD_INDEX].size());
     NS_ASSERT(numCluster <= channelParams->m_angle[MatrixBasedChannelModel::AOA_INDEX].size());
     NS_ASSERT(numCluster <= channelParams->m_angle[MatrixBasedChannelModel::AOD_INDEX].size());
-    NS_ASSERT(numCluster <= longTerm.size());
 
     // check if channelParams structure is generated in direction s-to-u or u-to-s
     bool isSameDirection = (channelParams->m_nodeIds == channelMatrix->m_nodeIds);
@@ -245,20 +265,33 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
     }
 
     NS_ASSERT(numCluster <= doppler.size());
+    return doppler;
+}
+
+void
+ThreeGppSpectrumPropagationLossModel::ApplyBeamformingGain(
+    SpectrumValue& psd,
+    const PhasedArrayModel::ComplexVector& longTerm,
+    const PhasedArrayModel::ComplexVector& doppler,
+    const MatrixBasedChannelModel::DoubleVector& delays)
+{
+    // this function may be run by threads other than the simulator thread, hence
+    // it must not log nor copy Ptr objects
 
     // apply the doppler term and the propagation delay to the long term component
     // to obtain the beamforming gain
-    auto vit = tempPsd->ValuesBegin();      // psd iterator
-    auto sbit = tempPsd->ConstBandsBegin(); // band iterator
-    while (vit != tempPsd->ValuesEnd())
+    std::size_t numCluster = doppler.size();
+    auto vit = psd.ValuesBegin();      // psd iterator
+    auto sbit = psd.ConstBandsBegin(); // band iterator
+    while (vit != psd.ValuesEnd())
     {
         if ((*vit) != 0.00)
         {
             std::complex<double> subsbandGain(0.0, 0.0);
             double fsb = (*sbit).fc; // center frequency of the sub-band
-            for (uint8_t cIndex = 0; cIndex < numCluster; cIndex++)
+            for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
             {
-                double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
+                double delay = -2 * M_PI * fsb * (delays[cIndex]);
                 subsbandGain = subsbandGain + longTerm[cIndex] * doppler[cIndex] *
                                                   std::complex<double>(cos(delay), sin(delay));
             }
@@ -267,7 +300,6 @@ ThreeGppSpectrumPropagationLossModel::CalcBeamformingGain(
         vit++;
         sbit++;
     }
-    return tempPsd;
 }
 
 PhasedArrayModel::ComplexVector
@@ -385,4 +417,75 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
     return rxPsd;
 }
 
+std::function<void()>
+ThreeGppSpectrumPropagationLossModel::DoPrepareRxPowerSpectralDensity(
+    Ptr<SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    Ptr<const PhasedArrayModel> bPhasedArrayModel) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(a->GetObject<Node>()->GetId() != b->GetObject<Node>()->GetId());
+    NS_ASSERT_MSG(a->GetDistanceFrom(b) > 0.0,
+                  "The position of a and b devices cannot be the same");
+    NS_ASSERT_MSG(aPhasedArrayModel, "Antenna not found for node " << a->GetObject<Node>());
+    NS_ASSERT_MSG(bPhasedArrayModel, "Antenna not found for node " << b->GetObject<Node>());
+
+    // the channel matrix and the long term component are retrieved (and possibly
+    // generated and cached) by the simulator thread, in the same order as by
+    // DoCalcRxPowerSpectralDensity, so that the random variables are drawn in the
+    // same order
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix =
+        m_channelModel->GetChannel(a, b, aPhasedArrayModel, bPhasedArrayModel);
+    Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams =
+        m_channelModel->GetParams(a, b);
+    PhasedArrayModel::ComplexVector longTerm =
+        GetLongTerm(channelMatrix, aPhasedArrayModel, bPhasedArrayModel);
+    PhasedArrayModel::ComplexVector doppler =
+        CalcDoppler(channelMatrix, channelParams, a->GetVelocity(), b->GetVelocity());
+    NS_ASSERT(doppler.size() <= longTerm.size());
+    NS_ASSERT(doppler.size() <= channelParams->m_delay.size());
+
+    // the received PSD is allocated by the simulator thread, the job only
+    // modifies its values
+    Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
+    params->psd = rxPsd;
+
+    return [psd = PeekPointer(rxPsd),
+            longTerm = std::move(longTerm),
+            doppler = std::move(doppler),
+            delays = channelParams->m_delay]() {
+        ApplyBeamformingGain(*psd, longTerm, doppler, delays);
+    };
+}
+
+void
+ThreeGppSpectrumPropagationLossModel::DoPrepareChannels(
+    Ptr<const MobilityModel> a,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    const std::vector<Receiver>& receivers) const
+{
+    NS_LOG_FUNCTION(this << receivers.size());
+    Ptr<ThreeGppChannelModel> channelModel = DynamicCast<ThreeGppChannelModel>(m_channelModel);
+    if (!channelModel || !aPhasedArrayModel)
+    {
+        return;
+    }
+
+    // the channel matrices are requested in the order of the receivers, hence
+    // they are the same as if they were generated one by one by
+    // DoPrepareRxPowerSpectralDensity, which then finds them in the cache
+    std::vector<ThreeGppChannelModel::ChannelRequest> requests;
+    requests.reserve(receivers.size());
+    for (const auto& [b, bPhasedArrayModel] : receivers)
+    {
+        if (bPhasedArrayModel)
+        {
+            requests.push_back({a, b, aPhasedArrayModel, bPhasedArrayModel});
+        }
+    }
+    channelModel->GetChannels(requests);
+}
+
 } // namespace ns3
@@ -126,6 +126,40 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const override;
 
+    /**
+     * \brief Starts the computation of the received PSD.
+     *
+     * The channel matrix, the long term component and the Doppler term are
+     * computed (or retrieved from the caches) by this function, while the
+     * returned job applies the resulting beamforming gain to each sub-band of
+     * the received PSD, which is the most computationally intensive part.
+     *
+     * \param params tx parameters, whose PSD is replaced by the received PSD
+     * \param a first node mobility model
+     * \param b second node mobility model
+     * \param aPhasedArrayModel the antenna array of the first node
+     * \param bPhasedArrayModel the antenna array of the second node
+     * \return the job applying the beamforming gain to the received PSD
+     */
+    std::function<void()> DoPrepareRxPowerSpectralDensity(
+        Ptr<SpectrumSignalParameters> params,
+        Ptr<const MobilityModel> a,
+        Ptr<const MobilityModel> b,
+        Ptr<const PhasedArrayModel> aPhasedArrayModel,
+        Ptr<const PhasedArrayModel> bPhasedArrayModel) const override;
+
+    /**
+     * \brief Generates in a batch the channel matrices between the transmitter and
+     * the receivers whose update is due (see ThreeGppChannelModel::GetChannels).
+     *
+     * \param a the mobility model of the transmitter
+     * \param aPhasedArrayModel the antenna array of the transmitter
+     * \param receivers the receivers of the signal
+     */
+    void DoPrepareChannels(Ptr<const MobilityModel> a,
+                           Ptr<const PhasedArrayModel> aPhasedArrayModel,
+                           const std::vector<Receiver>& receivers) const override;
+
   private:
     /**
      * Data structure that stores the long term component for a tx-rx pair
@@ -191,6 +225,34 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         const Vector& sSpeed,
         const Vector& uSpeed) const;
 
+    /**
+     * Computes the Doppler term of each cluster at the current time
+     * \param channelMatrix The channel matrix structure
+     * \param channelParams The channel params structure
+     * \param sSpeed speed of the first node
+     * \param uSpeed speed of the second node
+     * \return the Doppler term of each cluster
+     */
+    PhasedArrayModel::ComplexVector CalcDoppler(
+        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
+        Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams,
+        const Vector& sSpeed,
+        const Vector& uSpeed) const;
+
+    /**
+     * Applies the beamforming gain obtained from the given long term component,
+     * Doppler terms and cluster delays to each sub-band of the given PSD. This
+     * function can be called by any thread.
+     * \param psd the PSD
+     * \param longTerm the long term component
+     * \param doppler the Doppler term of each cluster
+     * \param delays the delay of each cluster
+     */
+    static void ApplyBeamformingGain(SpectrumValue& psd,
+                                     const PhasedArrayModel::ComplexVector& longTerm,
+                                     const PhasedArrayModel::ComplexVector& doppler,
+                                     const MatrixBasedChannelModel::DoubleVector& delays);
+
     mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
         m_longTermMap;                           //!< map containing the long term components
     Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "trace-spectrum-propagation-loss-model.h"
+
+#include "spectrum-signal-parameters.h"
+
+#include <ns3/abort.h>
+#include <ns3/boolean.h>
+#include <ns3/log.h>
+#include <ns3/mobility-model.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TraceSpectrumPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(TraceSpectrumPropagationLossModel);
+
+TraceSpectrumPropagationLossModel::TraceSpectrumPropagationLossModel()
+    : m_loop(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TraceSpectrumPropagationLossModel::~TraceSpectrumPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TypeId
+TraceSpectrumPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TraceSpectrumPropagationLossModel")
+            .SetParent<SpectrumPropagationLossModel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<TraceSpectrumPropagationLossModel>()
+            .AddAttribute("TraceFileName",
+                          "The name of the binary trace file (see PropagationLossTrace).",
+                          StringValue(""),
+                          MakeStringAccessor(&TraceSpectrumPropagationLossModel::SetTraceFileName),
+                          MakeStringChecker())
+            .AddAttribute("Loop",
+                          "If true, the trace is repeated periodically, otherwise the first "
+                          "and the last samples are used before and after the trace.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TraceSpectrumPropagationLossModel::m_loop),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+void
+TraceSpectrumPropagationLossModel::SetTraceFileName(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    m_trace = fileName.empty() ? nullptr : Create<const PropagationLossTrace>(fileName);
+}
+
+Ptr<SpectrumValue>
+TraceSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << params << a << b);
+    NS_ABORT_MSG_IF(!m_trace, "No trace file has been set");
+
+    Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue>(params->psd);
+    uint32_t numBands = m_trace->GetNumBands();
+    NS_ABORT_MSG_IF(numBands != 1 && numBands != rxPsd->GetValuesN(),
+                    "The trace has " << numBands << " bands, while the PSD has "
+                                     << rxPsd->GetValuesN());
+
+    uint32_t txId = PropagationLossTrace::GetNodeId(a);
+    uint32_t rxId = PropagationLossTrace::GetNodeId(b);
+    Time now = Simulator::Now();
+    if (numBands == 1)
+    {
+        *rxPsd *= std::pow(10.0, -m_trace->GetLossDb(txId, rxId, 0, now, m_loop) / 10.0);
+        return rxPsd;
+    }
+    Values::iterator vit = rxPsd->ValuesBegin();
+    for (uint32_t band = 0; band < numBands; band++, ++vit)
+    {
+        *vit *= std::pow(10.0, -m_trace->GetLossDb(txId, rxId, band, now, m_loop) / 10.0);
+    }
+    return rxPsd;
+}
+
+} // namespace ns3
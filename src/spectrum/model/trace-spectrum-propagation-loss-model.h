@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACE_SPECTRUM_PROPAGATION_LOSS_MODEL_H
+#define TRACE_SPECTRUM_PROPAGATION_LOSS_MODEL_H
+
+#include <ns3/propagation-loss-trace.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief A spectrum propagation loss model reading the loss between pairs of
+ * nodes, in each band, from a precomputed trace (see PropagationLossTrace).
+ *
+ * The nodes are identified by the ID of the Node their mobility model is
+ * aggregated to. The bands of the trace are those of the PSDs the model is
+ * applied to, hence the PSDs must all have the number of bands of the trace.
+ * A trace with a single band applies the same loss to all the bands.
+ */
+class TraceSpectrumPropagationLossModel : public SpectrumPropagationLossModel
+{
+  public:
+    TraceSpectrumPropagationLossModel();
+    ~TraceSpectrumPropagationLossModel() override;
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * Map the given trace file in memory.
+     *
+     * \param fileName the name of the trace file
+     */
+    void SetTraceFileName(std::string fileName);
+
+  private:
+    Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity(Ptr<const SpectrumSignalParameters> params,
+                                                    Ptr<const MobilityModel> a,
+                                                    Ptr<const MobilityModel> b) const override;
+
+    Ptr<const PropagationLossTrace> m_trace; //!< the trace
+    bool m_loop;                             //!< whether the trace is repeated periodically
+};
+
+} // namespace ns3
+
+#endif /* TRACE_SPECTRUM_PROPAGATION_LOSS_MODEL_H */
@@ -0,0 +1,317 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/log.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/net-device.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/test.h>
+
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("SpectrumChannelCullingTest");
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief SpectrumPhy recording the power of the received signals
+ */
+class CullingTestSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     * \param rxSpectrumModel the RX spectrum model
+     */
+    CullingTestSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel);
+
+    // inherited from SpectrumPhy
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    std::vector<double> m_rxPowersW; //!< the power of the received signals (W)
+
+  private:
+    Ptr<MobilityModel> m_mobility;              //!< mobility model
+    Ptr<const SpectrumModel> m_rxSpectrumModel; //!< RX spectrum model
+};
+
+CullingTestSpectrumPhy::CullingTestSpectrumPhy(Ptr<const SpectrumModel> rxSpectrumModel)
+    : m_rxSpectrumModel(rxSpectrumModel)
+{
+}
+
+void
+CullingTestSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+CullingTestSpectrumPhy::GetDevice() const
+{
+    return nullptr;
+}
+
+void
+CullingTestSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+    m_mobility = m;
+}
+
+Ptr<MobilityModel>
+CullingTestSpectrumPhy::GetMobility() const
+{
+    return m_mobility;
+}
+
+void
+CullingTestSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+CullingTestSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_rxSpectrumModel;
+}
+
+Ptr<Object>
+CullingTestSpectrumPhy::GetAntenna() const
+{
+    return nullptr;
+}
+
+void
+CullingTestSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_rxPowersW.push_back(Integral(*params->psd));
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the culling of receivers by the MultiModelSpectrumChannel
+ *
+ * A transmitter at the origin sends a signal to receivers placed every 10 meters
+ * along the x axis, one of which moves along the y axis, using the
+ * LogDistancePropagationLossModel. The signal is transmitted with different
+ * culling criteria and the test checks that the signal is delivered to exactly
+ * the receivers satisfying the criteria, with the same power as when culling is
+ * disabled, and that the counters of delivered and culled signals are correct.
+ * Moving a receiver with a constant position must update the spatial index.
+ */
+class SpectrumChannelCullingTestCase : public TestCase
+{
+  public:
+    SpectrumChannelCullingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Transmit a signal over a channel configured with the given attributes and
+     * check that it is delivered to the expected receivers.
+     *
+     * \param attributes the attributes of the channel
+     * \param expected for each receiver, whether the signal is expected to be delivered
+     */
+    void Transmit(const std::map<std::string, double>& attributes,
+                  const std::vector<bool>& expected);
+
+    Ptr<SpectrumModel> m_model;                        //!< spectrum model
+    Ptr<CullingTestSpectrumPhy> m_txPhy;               //!< transmitter
+    std::vector<Ptr<CullingTestSpectrumPhy>> m_rxPhys; //!< receivers
+    std::vector<double> m_referencePowersW;            //!< power received without culling
+};
+
+SpectrumChannelCullingTestCase::SpectrumChannelCullingTestCase()
+    : TestCase("Check the culling of receivers in MultiModelSpectrumChannel")
+{
+}
+
+void
+SpectrumChannelCullingTestCase::Transmit(const std::map<std::string, double>& attributes,
+                                         const std::vector<bool>& expected)
+{
+    auto channel = CreateObject<MultiModelSpectrumChannel>();
+    for (const auto& [name, value] : attributes)
+    {
+        channel->SetAttribute(name, DoubleValue(value));
+    }
+    auto loss = CreateObject<LogDistancePropagationLossModel>();
+    channel->AddPropagationLossModel(loss);
+    channel->AddRx(m_txPhy);
+    for (auto& rxPhy : m_rxPhys)
+    {
+        rxPhy->m_rxPowersW.clear();
+        channel->AddRx(rxPhy);
+    }
+
+    auto params = Create<SpectrumSignalParameters>();
+    params->txPhy = m_txPhy;
+    params->duration = MicroSeconds(100);
+    params->psd = Create<SpectrumValue>(m_model);
+    (*params->psd) = 1e-8; // 0.1 W over 10 MHz
+    channel->StartTx(params);
+    Simulator::Run();
+
+    uint64_t nDelivered = 0;
+    for (std::size_t i = 0; i < m_rxPhys.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(m_rxPhys[i]->m_rxPowersW.size(),
+                              (expected[i] ? 1U : 0U),
+                              "Unexpected number of signals delivered to receiver " << i);
+        if (expected[i])
+        {
+            nDelivered++;
+            if (!m_referencePowersW.empty())
+            {
+                NS_TEST_EXPECT_MSG_EQ_TOL(m_rxPhys[i]->m_rxPowersW.front(),
+                                          m_referencePowersW[i],
+                                          m_referencePowersW[i] * 1e-9,
+                                          "Culling changed the power received by " << i);
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(channel->GetNDeliveries(), nDelivered, "Unexpected delivery count");
+    NS_TEST_EXPECT_MSG_EQ(channel->GetNCulledDeliveries(),
+                          m_rxPhys.size() - nDelivered,
+                          "Unexpected culled delivery count");
+
+    if (m_referencePowersW.empty())
+    {
+        for (auto& rxPhy : m_rxPhys)
+        {
+            m_referencePowersW.push_back(rxPhy->m_rxPowersW.front());
+        }
+    }
+    channel->Dispose();
+}
+
+void
+SpectrumChannelCullingTestCase::DoRun()
+{
+    Bands bands{{2407e6, 2412e6, 2417e6}};
+    m_model = Create<SpectrumModel>(bands);
+
+    m_txPhy = CreateObject<CullingTestSpectrumPhy>(m_model);
+    auto txMobility = CreateObject<ConstantPositionMobilityModel>();
+    txMobility->SetPosition(Vector(0, 0, 0));
+    m_txPhy->SetMobility(txMobility);
+
+    const std::size_t nRx = 10;
+    for (std::size_t i = 0; i < nRx; i++)
+    {
+        auto rxPhy = CreateObject<CullingTestSpectrumPhy>(m_model);
+        Ptr<MobilityModel> mobility;
+        if (i == 2)
+        {
+            // a receiver moving away at 10 m/s, which is 20 m far from the transmitter
+            // (the velocity is set after the position, which resets it)
+            auto velocityMobility = CreateObject<ConstantVelocityMobilityModel>();
+            velocityMobility->SetPosition(Vector(10.0 * i, 0, 0));
+            velocityMobility->SetVelocity(Vector(0, 10, 0));
+            mobility = velocityMobility;
+        }
+        else
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+            mobility->SetPosition(Vector(10.0 * i, 0, 0));
+        }
+        rxPhy->SetMobility(mobility);
+        m_rxPhys.push_back(rxPhy);
+    }
+
+    // the transmit power is 20 dBm and the loss at distance d (m) is
+    // 46.6777 + 30 log10 (d) dB, hence the first four receivers are within 35 m,
+    // have a loss below the loss at 35 m and a received power above that at 35 m
+    std::vector<bool> all(nRx, true);
+    Transmit({}, all);
+
+    std::vector<bool> within35m{true, true, true, true, false, false, false, false, false, false};
+    Transmit({{"RxCullingDistance", 35}}, within35m);
+    Transmit({{"MaxLossDb", 46.6777 + 30 * std::log10(35)}}, within35m);
+    Transmit({{"MinRxPowerDbm", 20 - 46.6777 - 30 * std::log10(35)}}, within35m);
+
+    // the moving receiver at x = 20 m moves beyond 35 m after 2.9 s
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+    within35m[2] = false;
+    Transmit({{"RxCullingDistance", 35}}, within35m);
+
+    // moving a receiver with a constant position invalidates the spatial index
+    auto channel = CreateObject<MultiModelSpectrumChannel>();
+    channel->SetAttribute("RxCullingDistance", DoubleValue(35));
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel>());
+    channel->AddRx(m_txPhy);
+    for (auto& rxPhy : m_rxPhys)
+    {
+        rxPhy->m_rxPowersW.clear();
+        channel->AddRx(rxPhy);
+    }
+    auto params = Create<SpectrumSignalParameters>();
+    params->txPhy = m_txPhy;
+    params->duration = MicroSeconds(100);
+    params->psd = Create<SpectrumValue>(m_model);
+    (*params->psd) = 1e-8;
+    channel->StartTx(params);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_rxPhys[9]->m_rxPowersW.size(), 0U, "Receiver 9 is beyond 35 m");
+
+    m_rxPhys[9]->GetMobility()->SetPosition(Vector(0, 30, 0));
+    channel->StartTx(params);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_rxPhys[9]->m_rxPowersW.size(), 1U, "Receiver 9 has been moved closer");
+    NS_TEST_EXPECT_MSG_EQ(m_rxPhys[1]->m_rxPowersW.size(), 2U, "Receiver 1 is within 35 m");
+    channel->Dispose();
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Spectrum channel culling TestSuite
+ */
+class SpectrumChannelCullingTestSuite : public TestSuite
+{
+  public:
+    SpectrumChannelCullingTestSuite();
+};
+
+SpectrumChannelCullingTestSuite::SpectrumChannelCullingTestSuite()
+    : TestSuite("spectrum-channel-culling", UNIT)
+{
+    AddTestCase(new SpectrumChannelCullingTestCase, TestCase::QUICK);
+}
+
+static SpectrumChannelCullingTestSuite
+    g_spectrumChannelCullingTestSuite; ///< the test suite
@@ -22,10 +22,12 @@
 
 #include <ns3/log.h>
 #include <ns3/object.h>
+#include <ns3/simulator.h>
 #include <ns3/spectrum-converter.h>
 #include <ns3/spectrum-value.h>
 #include <ns3/test.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -269,6 +271,170 @@ SpectrumValueTestSuite::SpectrumValueTestSuite()
     v1rs3[4] = v1[1];
     tv1rs3 = v1 >> 3;
     AddTestCase(new SpectrumValueTestCase(tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
+
+    // fused operations must match the corresponding chains of operators
+    SpectrumValue tv11(f);
+    SpectrumValue tv12(f);
+    SpectrumValue tv13(f);
+    SpectrumValue tv14;
+
+    tv11 = v3;
+    tv11.AddScaled(v1, doubleValue);
+    AddTestCase(new SpectrumValueTestCase(tv11,
+                                          v3 + v1 * doubleValue,
+                                          "tv11 = v3; tv11.AddScaled (v1, doubleValue)"),
+                TestCase::QUICK);
+
+    tv12 = v3;
+    tv12.MultiplyAdd(v1, v2);
+    AddTestCase(new SpectrumValueTestCase(tv12, v3 + v5, "tv12 = v3; tv12.MultiplyAdd (v1, v2)"),
+                TestCase::QUICK);
+
+    tv13 = v2;
+    tv13.AddDifference(v3, v2);
+    AddTestCase(new SpectrumValueTestCase(tv13, v3, "tv13 = v2; tv13.AddDifference (v3, v2)"),
+                TestCase::QUICK);
+
+    tv14.SetRatio(v1, v2);
+    AddTestCase(new SpectrumValueTestCase(tv14, v6, "tv14.SetRatio (v1, v2)"), TestCase::QUICK);
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the sparse conversion and the shared cache of SpectrumConverter
+ *
+ * PSDs are converted between a model with the subcarriers of a 20 MHz Wi-Fi
+ * channel, a wide ISM band model, the same model with the bands in reverse
+ * order and a model orthogonal to the Wi-Fi one. The converted values must
+ * match those computed by considering all the pairs of bands, only the
+ * coefficients between overlapping bands must be stored and the converters
+ * obtained from the shared cache must be reused until the simulator is
+ * destroyed.
+ */
+class SpectrumConverterSparseTestCase : public TestCase
+{
+  public:
+    SpectrumConverterSparseTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Convert a PSD with a converter obtained from the shared cache and check
+     * the converted values against those computed by considering all the pairs
+     * of bands.
+     *
+     * \param from the SpectrumModel to convert from
+     * \param to the SpectrumModel to convert to
+     * \param numCoefficients the expected number of non-zero coefficients
+     */
+    void CheckConversion(Ptr<const SpectrumModel> from,
+                         Ptr<const SpectrumModel> to,
+                         std::size_t numCoefficients);
+};
+
+SpectrumConverterSparseTestCase::SpectrumConverterSparseTestCase()
+    : TestCase("Test the sparse conversion and the shared cache of SpectrumConverter")
+{
+}
+
+void
+SpectrumConverterSparseTestCase::CheckConversion(Ptr<const SpectrumModel> from,
+                                                 Ptr<const SpectrumModel> to,
+                                                 std::size_t numCoefficients)
+{
+    Ptr<const SpectrumConverter> converter = SpectrumConverter::GetConverter(from, to);
+    NS_TEST_EXPECT_MSG_EQ(converter->GetNumCoefficients(),
+                          numCoefficients,
+                          "Unexpected number of coefficients from " << from->GetUid() << " to "
+                                                                    << to->GetUid());
+    NS_TEST_EXPECT_MSG_EQ(SpectrumConverter::GetConverter(from, to),
+                          converter,
+                          "The converter should have been reused");
+
+    Ptr<SpectrumValue> psd = Create<SpectrumValue>(from);
+    for (std::size_t i = 0; i < from->GetNumBands(); i++)
+    {
+        (*psd)[i] = 1.0 + i % 7;
+    }
+    Ptr<SpectrumValue> converted = converter->Convert(psd);
+
+    std::size_t toIndex = 0;
+    for (auto toit = to->Begin(); toit != to->End(); ++toit, ++toIndex)
+    {
+        double expected = 0;
+        std::size_t fromIndex = 0;
+        for (auto fromit = from->Begin(); fromit != from->End(); ++fromit, ++fromIndex)
+        {
+            double overlap = std::min(fromit->fh, toit->fh) - std::max(fromit->fl, toit->fl);
+            if (overlap > 0)
+            {
+                expected += (*psd)[fromIndex] * std::min(1.0, overlap / (toit->fh - toit->fl));
+            }
+        }
+        NS_TEST_EXPECT_MSG_EQ_TOL((*converted)[toIndex],
+                                  expected,
+                                  TOLERANCE,
+                                  "Unexpected value of band " << toIndex);
+    }
+}
+
+void
+SpectrumConverterSparseTestCase::DoRun()
+{
+    // 64 subcarriers of 312.5 kHz centered at 2412 MHz
+    std::vector<double> wifiFreqs;
+    for (int i = -32; i < 32; i++)
+    {
+        wifiFreqs.push_back(2412e6 + i * 312.5e3);
+    }
+    Ptr<SpectrumModel> wifiModel = Create<SpectrumModel>(wifiFreqs);
+
+    // 100 bands of 1 MHz from 2400 MHz to 2500 MHz, sorted and in reverse order
+    Bands ismBands;
+    for (int i = 0; i < 100; i++)
+    {
+        BandInfo band;
+        band.fl = 2400e6 + i * 1e6;
+        band.fc = band.fl + 0.5e6;
+        band.fh = band.fl + 1e6;
+        ismBands.push_back(band);
+    }
+    Ptr<SpectrumModel> ismModel = Create<SpectrumModel>(ismBands);
+    Bands reverseBands(ismBands.rbegin(), ismBands.rend());
+    Ptr<SpectrumModel> reverseModel = Create<SpectrumModel>(reverseBands);
+
+    // 5 GHz bands
+    std::vector<double> otherFreqs{5180e6, 5200e6, 5220e6};
+    Ptr<SpectrumModel> otherModel = Create<SpectrumModel>(otherFreqs);
+
+    // the subcarriers span 2401.84375-2421.84375 MHz, hence they overlap with
+    // 21 ISM bands; each ISM band overlaps with 4 or 5 subcarriers, for a total
+    // of 20 bands entirely covering 3 subcarriers plus the 21 boundaries
+    CheckConversion(wifiModel, ismModel, 64 + 20);
+    CheckConversion(ismModel, wifiModel, 64 + 20);
+    CheckConversion(wifiModel, reverseModel, 64 + 20);
+    CheckConversion(reverseModel, wifiModel, 64 + 20);
+    CheckConversion(ismModel, reverseModel, 100);
+    CheckConversion(wifiModel, otherModel, 0);
+
+    NS_TEST_EXPECT_MSG_NE(SpectrumConverter::GetConverter(wifiModel, ismModel),
+                          SpectrumConverter::GetConverter(ismModel, wifiModel),
+                          "The two directions need different converters");
+
+    Ptr<const SpectrumConverter> converter = SpectrumConverter::GetConverter(wifiModel, ismModel);
+    NS_TEST_EXPECT_MSG_EQ(converter->GetReferenceCount(),
+                          2,
+                          "The converter should be held by the cache");
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(converter->GetReferenceCount(),
+                          1,
+                          "The converter should have been released with the simulator");
+    NS_TEST_EXPECT_MSG_NE(SpectrumConverter::GetConverter(wifiModel, ismModel),
+                          converter,
+                          "A new converter should have been created");
+    Simulator::Destroy();
 }
 
 /**
@@ -347,6 +513,8 @@ SpectrumConverterTestSuite::SpectrumConverterTestSuite()
     //   NS_LOG_LOGIC(t21b);
     //   NS_LOG_LOGIC(*res);
     AddTestCase(new SpectrumValueTestCase(t21b, *res, ""), TestCase::QUICK);
+
+    AddTestCase(new SpectrumConverterSparseTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -24,11 +24,14 @@
 #include "ns3/double.h"
 #include "ns3/isotropic-antenna-model.h"
 #include "ns3/log.h"
+#include "ns3/multi-model-spectrum-channel.h"
 #include "ns3/node-container.h"
 #include "ns3/pointer.h"
 #include "ns3/simple-net-device.h"
 #include "ns3/simulator.h"
+#include "ns3/spectrum-phy.h"
 #include "ns3/spectrum-signal-parameters.h"
+#include "ns3/spectrum-thread-pool.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/three-gpp-channel-model.h"
@@ -107,7 +110,7 @@ ThreeGppChannelMatrixComputationTest::DoComputeNorm(Ptr<ThreeGppChannelModel> ch
         channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna);
 
     double channelNorm = 0;
-    uint8_t numTotClusters = channelMatrix->m_channel.at(0).at(0).size();
+    uint8_t numTotClusters = channelMatrix->m_channel.GetNumPages();
     for (uint8_t cIndex = 0; cIndex < numTotClusters; cIndex++)
     {
         double clusterNorm = 0;
@@ -116,8 +119,7 @@ ThreeGppChannelMatrixComputationTest::DoComputeNorm(Ptr<ThreeGppChannelModel> ch
             for (uint32_t uIndex = 0; uIndex < rxAntennaElements; uIndex++)
             {
                 clusterNorm +=
-                    std::pow(std::abs(channelMatrix->m_channel.at(uIndex).at(sIndex).at(cIndex)),
-                             2);
+                    std::pow(std::abs(channelMatrix->m_channel(uIndex, sIndex, cIndex)), 2);
             }
         }
         channelNorm += clusterNorm;
@@ -190,11 +192,11 @@ ThreeGppChannelMatrixComputationTest::DoRun()
 
     // check the channel matrix dimensions
     NS_TEST_ASSERT_MSG_EQ(
-        channelMatrix->m_channel.at(0).size(),
+        channelMatrix->m_channel.GetNumCols(),
         txAntennaElements[0] * txAntennaElements[1],
         "The second dimension of H should be equal to the number of tx antenna elements");
     NS_TEST_ASSERT_MSG_EQ(
-        channelMatrix->m_channel.size(),
+        channelMatrix->m_channel.GetNumRows(),
         rxAntennaElements[0] * rxAntennaElements[1],
         "The first dimension of H should be equal to the number of rx antenna elements");
 
@@ -684,6 +686,524 @@ ThreeGppSpectrumPropagationLossModelTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup spectrum-tests
+ *
+ * SpectrumPhy with a phased array, recording the PSD of the received signals
+ */
+class ParallelRxTestSpectrumPhy : public SpectrumPhy
+{
+  public:
+    /**
+     * Constructor
+     * \param device the device
+     * \param antenna the antenna
+     * \param rxSpectrumModel the RX spectrum model
+     */
+    ParallelRxTestSpectrumPhy(Ptr<NetDevice> device,
+                              Ptr<PhasedArrayModel> antenna,
+                              Ptr<const SpectrumModel> rxSpectrumModel);
+
+    // inherited from SpectrumPhy
+    void SetDevice(Ptr<NetDevice> d) override;
+    Ptr<NetDevice> GetDevice() const override;
+    void SetMobility(Ptr<MobilityModel> m) override;
+    Ptr<MobilityModel> GetMobility() const override;
+    void SetChannel(Ptr<SpectrumChannel> c) override;
+    Ptr<const SpectrumModel> GetRxSpectrumModel() const override;
+    Ptr<Object> GetAntenna() const override;
+    void StartRx(Ptr<SpectrumSignalParameters> params) override;
+
+    std::vector<Ptr<SpectrumValue>> m_rxPsds; //!< the PSD of the received signals
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    Ptr<NetDevice> m_device;                    //!< device
+    Ptr<PhasedArrayModel> m_antenna;            //!< antenna
+    Ptr<const SpectrumModel> m_rxSpectrumModel; //!< RX spectrum model
+};
+
+ParallelRxTestSpectrumPhy::ParallelRxTestSpectrumPhy(Ptr<NetDevice> device,
+                                                     Ptr<PhasedArrayModel> antenna,
+                                                     Ptr<const SpectrumModel> rxSpectrumModel)
+    : m_device(device),
+      m_antenna(antenna),
+      m_rxSpectrumModel(rxSpectrumModel)
+{
+}
+
+void
+ParallelRxTestSpectrumPhy::DoDispose()
+{
+    m_device = nullptr;
+    m_antenna = nullptr;
+    m_rxPsds.clear();
+    SpectrumPhy::DoDispose();
+}
+
+void
+ParallelRxTestSpectrumPhy::SetDevice(Ptr<NetDevice> d)
+{
+    m_device = d;
+}
+
+Ptr<NetDevice>
+ParallelRxTestSpectrumPhy::GetDevice() const
+{
+    return m_device;
+}
+
+void
+ParallelRxTestSpectrumPhy::SetMobility(Ptr<MobilityModel> m)
+{
+}
+
+Ptr<MobilityModel>
+ParallelRxTestSpectrumPhy::GetMobility() const
+{
+    return m_device->GetNode()->GetObject<MobilityModel>();
+}
+
+void
+ParallelRxTestSpectrumPhy::SetChannel(Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+ParallelRxTestSpectrumPhy::GetRxSpectrumModel() const
+{
+    return m_rxSpectrumModel;
+}
+
+Ptr<Object>
+ParallelRxTestSpectrumPhy::GetAntenna() const
+{
+    return m_antenna;
+}
+
+void
+ParallelRxTestSpectrumPhy::StartRx(Ptr<SpectrumSignalParameters> params)
+{
+    m_rxPsds.push_back(params->psd);
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the parallel computation of the received PSDs.
+ * 1) checks that the PSDs computed by running the jobs returned by
+ *    PrepareRxPowerSpectralDensity on a SpectrumThreadPool are bitwise equal
+ *    to those returned by DoCalcRxPowerSpectralDensity, for any number of threads
+ * 2) checks that the PSDs delivered by a MultiModelSpectrumChannel do not
+ *    depend on the value of the ParallelRxThreads attribute
+ * 3) checks that the same PSDs are delivered when the channel matrices are
+ *    generated while delivering the signal, one by one or in a batch (i.e.,
+ *    if the ParallelRxThreads attribute is set)
+ */
+class ThreeGppParallelRxPsdTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppParallelRxPsdTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+};
+
+ThreeGppParallelRxPsdTest::ThreeGppParallelRxPsdTest()
+    : TestCase("Test the parallel computation of the received PSDs")
+{
+}
+
+void
+ThreeGppParallelRxPsdTest::DoRun()
+{
+    const uint32_t nRx = 6;
+
+    Ptr<ThreeGppSpectrumPropagationLossModel> lossModel =
+        CreateObject<ThreeGppSpectrumPropagationLossModel>();
+    lossModel->SetChannelModelAttribute("Frequency", DoubleValue(2.4e9));
+    lossModel->SetChannelModelAttribute("Scenario", StringValue("UMa"));
+    lossModel->SetChannelModelAttribute(
+        "ChannelConditionModel",
+        PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+
+    // the transmitter is node 0, the receivers are placed around it
+    NodeContainer nodes;
+    nodes.Create(nRx + 1);
+    std::vector<Ptr<SimpleNetDevice>> devices;
+    std::vector<Ptr<MobilityModel>> mobilities;
+    std::vector<Ptr<PhasedArrayModel>> antennas;
+    for (uint32_t i = 0; i <= nRx; i++)
+    {
+        Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+        nodes.Get(i)->AddDevice(dev);
+        dev->SetNode(nodes.Get(i));
+        devices.push_back(dev);
+
+        Ptr<MobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        double angle = 2 * M_PI * i / nRx;
+        mob->SetPosition(i == 0 ? Vector(0.0, 0.0, 10.0)
+                                : Vector(20.0 * std::cos(angle), 20.0 * std::sin(angle), 1.5));
+        nodes.Get(i)->AggregateObject(mob);
+        mobilities.push_back(mob);
+
+        antennas.push_back(CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(2),
+            "NumRows",
+            UintegerValue(2),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>())));
+    }
+
+    // all the antennas point towards the transmitter, which points towards the first receiver
+    for (uint32_t i = 0; i <= nRx; i++)
+    {
+        Angles angles(mobilities[i == 0 ? 1 : 0]->GetPosition(), mobilities[i]->GetPosition());
+        antennas[i]->SetBeamformingVector(antennas[i]->GetBeamformingVector(angles));
+    }
+
+    WifiSpectrumValue5MhzFactory sf;
+    Ptr<SpectrumValue> txPsd = sf.CreateTxPowerSpectralDensity(0.1, 1);
+    Ptr<SpectrumSignalParameters> txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = txPsd->Copy();
+
+    auto arePsdEqual = [](Ptr<const SpectrumValue> first, Ptr<const SpectrumValue> second) {
+        for (uint32_t i = 0; i < first->GetValuesN(); i++)
+        {
+            if ((*first)[i] != (*second)[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // 1) compute the reference PSDs and compare them with those computed by the jobs
+    std::vector<Ptr<SpectrumValue>> rxPsds;
+    for (uint32_t i = 1; i <= nRx; i++)
+    {
+        rxPsds.push_back(lossModel->DoCalcRxPowerSpectralDensity(txParams,
+                                                                 mobilities[0],
+                                                                 mobilities[i],
+                                                                 antennas[0],
+                                                                 antennas[i]));
+    }
+
+    for (uint32_t nThreads : {1, 2, 4})
+    {
+        SpectrumThreadPool pool(nThreads);
+        std::vector<Ptr<SpectrumSignalParameters>> rxParams;
+        std::vector<SpectrumThreadPool::Job> jobs;
+        for (uint32_t i = 1; i <= nRx; i++)
+        {
+            rxParams.push_back(txParams->Copy());
+            auto job = lossModel->PrepareRxPowerSpectralDensity(rxParams.back(),
+                                                                mobilities[0],
+                                                                mobilities[i],
+                                                                antennas[0],
+                                                                antennas[i]);
+            NS_TEST_ASSERT_MSG_EQ(bool(job), true, "A job is expected for each receiver");
+            jobs.push_back(job);
+        }
+        pool.Run(jobs);
+
+        for (uint32_t i = 0; i < nRx; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(arePsdEqual(rxParams[i]->psd, rxPsds[i]),
+                                  true,
+                                  "PSD of receiver " << i + 1 << " differs with " << nThreads
+                                                     << " threads");
+        }
+        NS_TEST_EXPECT_MSG_EQ(arePsdEqual(txParams->psd, txPsd),
+                              true,
+                              "The PSD of the transmitted signal has been modified");
+    }
+
+    // 2) deliver a signal through channels with different numbers of threads
+    std::vector<Ptr<ParallelRxTestSpectrumPhy>> phys;
+    for (uint32_t i = 0; i <= nRx; i++)
+    {
+        phys.push_back(CreateObject<ParallelRxTestSpectrumPhy>(devices[i],
+                                                               antennas[i],
+                                                               txPsd->GetSpectrumModel()));
+    }
+    txParams->txPhy = phys[0];
+
+    for (uint32_t nThreads : {0, 1, 4})
+    {
+        Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel>();
+        channel->SetAttribute("ParallelRxThreads", UintegerValue(nThreads));
+        channel->AddPhasedArraySpectrumPropagationLossModel(lossModel);
+        for (const auto& phy : phys)
+        {
+            phy->m_rxPsds.clear();
+            channel->AddRx(phy);
+        }
+        channel->StartTx(txParams);
+        Simulator::Run();
+
+        for (uint32_t i = 1; i <= nRx; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(phys[i]->m_rxPsds.size(),
+                                  1U,
+                                  "Receiver " << i << " expected to receive one signal");
+            NS_TEST_EXPECT_MSG_EQ(arePsdEqual(phys[i]->m_rxPsds.front(), rxPsds[i - 1]),
+                                  true,
+                                  "PSD delivered to receiver " << i << " differs with " << nThreads
+                                                               << " threads");
+        }
+        channel->Dispose();
+    }
+
+    // 3) deliver a signal through new loss models, which generate the channel matrices
+    std::vector<Ptr<SpectrumValue>> firstRxPsds;
+    for (uint32_t nThreads : {0, 1, 4})
+    {
+        Ptr<ThreeGppSpectrumPropagationLossModel> newLossModel =
+            CreateObject<ThreeGppSpectrumPropagationLossModel>();
+        newLossModel->SetChannelModelAttribute("Frequency", DoubleValue(2.4e9));
+        newLossModel->SetChannelModelAttribute("Scenario", StringValue("UMa"));
+        newLossModel->SetChannelModelAttribute(
+            "ChannelConditionModel",
+            PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+        DynamicCast<ThreeGppChannelModel>(newLossModel->GetChannelModel())->AssignStreams(1);
+
+        Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel>();
+        channel->SetAttribute("ParallelRxThreads", UintegerValue(nThreads));
+        channel->AddPhasedArraySpectrumPropagationLossModel(newLossModel);
+        for (const auto& phy : phys)
+        {
+            phy->m_rxPsds.clear();
+            channel->AddRx(phy);
+        }
+        channel->StartTx(txParams);
+        Simulator::Run();
+
+        for (uint32_t i = 1; i <= nRx; i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ(phys[i]->m_rxPsds.size(),
+                                  1U,
+                                  "Receiver " << i << " expected to receive one signal");
+            if (firstRxPsds.size() < nRx)
+            {
+                firstRxPsds.push_back(phys[i]->m_rxPsds.front());
+                continue;
+            }
+            NS_TEST_EXPECT_MSG_EQ(arePsdEqual(phys[i]->m_rxPsds.front(), firstRxPsds[i - 1]),
+                                  true,
+                                  "PSD delivered to receiver "
+                                      << i << " differs with " << nThreads
+                                      << " threads when generating the channel matrices");
+        }
+        channel->Dispose();
+    }
+
+    for (auto& phy : phys)
+    {
+        phy->Dispose();
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Test case for the batch generation of channel matrices by ThreeGppChannelModel.
+ * The channel matrices between a base station and several user terminals in the
+ * UMi-StreetCanyon scenario, in both LOS and NLOS conditions, are generated by
+ * ThreeGppChannelModel::GetChannels and compared with those generated by calling
+ * ThreeGppChannelModel::GetChannel for each pair of nodes, in the same order.
+ * The test checks that:
+ * 1) the channel matrices are equal, regardless of the value of the BatchThreads attribute
+ * 2) the requests for the same pair of antenna arrays, in either direction, share the
+ *    same channel matrix
+ * 3) the channel matrices are generated again by GetChannels after the update period
+ */
+class ThreeGppBatchChannelTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppBatchChannelTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Create a channel model for the scenario of the test, using fixed random streams
+     * \param batchThreads the value of the BatchThreads attribute
+     * \return the channel model
+     */
+    Ptr<ThreeGppChannelModel> CreateChannelModel(uint32_t batchThreads) const;
+
+    /**
+     * Check that two channel matrices are equal
+     * \param first the first channel matrix
+     * \param second the second channel matrix
+     * \param description a description of the matrices for the error messages
+     */
+    void CheckEqual(Ptr<const MatrixBasedChannelModel::ChannelMatrix> first,
+                    Ptr<const MatrixBasedChannelModel::ChannelMatrix> second,
+                    const std::string& description);
+};
+
+ThreeGppBatchChannelTest::ThreeGppBatchChannelTest()
+    : TestCase("Test the batch generation of the channel matrices")
+{
+}
+
+Ptr<ThreeGppChannelModel>
+ThreeGppBatchChannelTest::CreateChannelModel(uint32_t batchThreads) const
+{
+    Ptr<ChannelConditionModel> channelConditionModel =
+        CreateObject<ThreeGppUmiStreetCanyonChannelConditionModel>();
+    channelConditionModel->AssignStreams(10);
+
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMi-StreetCanyon"));
+    channelModel->SetAttribute("ChannelConditionModel", PointerValue(channelConditionModel));
+    channelModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(10)));
+    channelModel->SetAttribute("BatchThreads", UintegerValue(batchThreads));
+    channelModel->AssignStreams(1);
+    return channelModel;
+}
+
+void
+ThreeGppBatchChannelTest::CheckEqual(Ptr<const MatrixBasedChannelModel::ChannelMatrix> first,
+                                     Ptr<const MatrixBasedChannelModel::ChannelMatrix> second,
+                                     const std::string& description)
+{
+    const auto& h1 = first->m_channel;
+    const auto& h2 = second->m_channel;
+    NS_TEST_ASSERT_MSG_EQ(h1.GetNumRows(), h2.GetNumRows(), "Different rows " << description);
+    NS_TEST_ASSERT_MSG_EQ(h1.GetNumCols(), h2.GetNumCols(), "Different columns " << description);
+    NS_TEST_ASSERT_MSG_EQ(h1.GetNumPages(), h2.GetNumPages(), "Different pages " << description);
+    NS_TEST_EXPECT_MSG_EQ(first->m_generatedTime, second->m_generatedTime, description);
+    NS_TEST_EXPECT_MSG_EQ((first->m_nodeIds == second->m_nodeIds), true, description);
+
+    bool equal = true;
+    for (std::size_t u = 0; u < h1.GetNumRows(); u++)
+    {
+        for (std::size_t s = 0; s < h1.GetNumCols(); s++)
+        {
+            for (std::size_t n = 0; n < h1.GetNumPages(); n++)
+            {
+                equal = equal && (h1(u, s, n) == h2(u, s, n));
+            }
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(equal, true, "Different coefficients " << description);
+}
+
+void
+ThreeGppBatchChannelTest::DoRun()
+{
+    const uint32_t nUt = 8;
+
+    // node 0 is the base station, the other nodes are user terminals placed
+    // at increasing distances, so that both LOS and NLOS conditions occur
+    NodeContainer nodes;
+    nodes.Create(nUt + 1);
+    std::vector<Ptr<MobilityModel>> mobilities;
+    std::vector<Ptr<PhasedArrayModel>> antennas;
+    for (uint32_t i = 0; i <= nUt; i++)
+    {
+        Ptr<MobilityModel> mob = CreateObject<ConstantPositionMobilityModel>();
+        double angle = 2 * M_PI * i / nUt;
+        double distance = 20.0 + 40.0 * i;
+        mob->SetPosition(i == 0 ? Vector(0.0, 0.0, 10.0)
+                                : Vector(distance * std::cos(angle),
+                                         distance * std::sin(angle),
+                                         1.5));
+        nodes.Get(i)->AggregateObject(mob);
+        mobilities.push_back(mob);
+
+        antennas.push_back(CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(i == 0 ? 4 : 2),
+            "NumRows",
+            UintegerValue(i == 0 ? 4 : 2),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>())));
+    }
+
+    // the downlink channels, then the uplink channels of half of the user terminals
+    std::vector<ThreeGppChannelModel::ChannelRequest> requests;
+    for (uint32_t i = 1; i <= nUt; i++)
+    {
+        requests.push_back({mobilities[0], mobilities[i], antennas[0], antennas[i]});
+    }
+    for (uint32_t i = 1; i <= nUt; i += 2)
+    {
+        requests.push_back({mobilities[i], mobilities[0], antennas[i], antennas[0]});
+    }
+
+    // the reference matrices are generated one by one, at the beginning and after
+    // the update period
+    Ptr<ThreeGppChannelModel> reference = CreateChannelModel(0);
+    std::vector<Ptr<const MatrixBasedChannelModel::ChannelMatrix>> referenceMatrices[2];
+    for (auto& matrices : referenceMatrices)
+    {
+        for (const auto& request : requests)
+        {
+            matrices.push_back(reference->GetChannel(request.aMob,
+                                                     request.bMob,
+                                                     request.aAntenna,
+                                                     request.bAntenna));
+        }
+        Simulator::Stop(MilliSeconds(20));
+        Simulator::Run();
+    }
+    Simulator::Destroy();
+
+    for (uint32_t batchThreads : {0, 1, 4})
+    {
+        Ptr<ThreeGppChannelModel> channelModel = CreateChannelModel(batchThreads);
+        for (const auto& matrices : referenceMatrices)
+        {
+            auto channelMatrices = channelModel->GetChannels(requests);
+            NS_TEST_ASSERT_MSG_EQ(channelMatrices.size(), requests.size(), "Unexpected size");
+            for (std::size_t i = 0; i < requests.size(); i++)
+            {
+                std::ostringstream description;
+                description << "for request " << i << " with " << batchThreads << " threads at "
+                            << Simulator::Now().As(Time::MS);
+                CheckEqual(channelMatrices[i], matrices[i], description.str());
+                NS_TEST_EXPECT_MSG_EQ(
+                    channelMatrices[i],
+                    channelModel->GetChannel(requests[i].aMob,
+                                             requests[i].bMob,
+                                             requests[i].aAntenna,
+                                             requests[i].bAntenna),
+                    "The channel matrix should have been stored " << description.str());
+            }
+            for (uint32_t i = nUt; i < requests.size(); i++)
+            {
+                NS_TEST_EXPECT_MSG_EQ(channelMatrices[i],
+                                      channelMatrices[(i - nUt) * 2],
+                                      "Both directions should share the same channel matrix");
+            }
+            Simulator::Stop(MilliSeconds(20));
+            Simulator::Run();
+        }
+        Simulator::Destroy();
+    }
+}
+
 /**
  * \ingroup spectrum-tests
  *
@@ -704,6 +1224,8 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppChannelMatrixComputationTest, TestCase::QUICK);
     AddTestCase(new ThreeGppChannelMatrixUpdateTest, TestCase::QUICK);
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest, TestCase::QUICK);
+    AddTestCase(new ThreeGppParallelRxPsdTest, TestCase::QUICK);
+    AddTestCase(new ThreeGppBatchChannelTest, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/log.h>
+#include <ns3/node-container.h>
+#include <ns3/propagation-loss-trace.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/string.h>
+#include <ns3/test.h>
+#include <ns3/trace-spectrum-propagation-loss-model.h>
+
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TraceSpectrumPropagationLossModelTest");
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Test the TraceSpectrumPropagationLossModel
+ *
+ * A PSD with three bands is transmitted between two nodes, whose losses are
+ * read from a trace with three bands and from a trace with a single band. The
+ * loss of each band must be applied to the corresponding value of the PSD, and
+ * the loss of the single band to all the values.
+ */
+class TraceSpectrumPropagationLossModelTestCase : public TestCase
+{
+  public:
+    TraceSpectrumPropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the received PSD at the current time.
+     *
+     * \param lossModel the loss model
+     * \param params the parameters of the transmitted signal
+     * \param a the mobility model of the transmitter
+     * \param b the mobility model of the receiver
+     * \param lossDb the expected loss of each band (dB)
+     */
+    void CheckRxPsd(Ptr<SpectrumPropagationLossModel> lossModel,
+                    Ptr<const SpectrumSignalParameters> params,
+                    Ptr<const MobilityModel> a,
+                    Ptr<const MobilityModel> b,
+                    std::vector<double> lossDb);
+};
+
+TraceSpectrumPropagationLossModelTestCase::TraceSpectrumPropagationLossModelTestCase()
+    : TestCase("Test the TraceSpectrumPropagationLossModel")
+{
+}
+
+void
+TraceSpectrumPropagationLossModelTestCase::CheckRxPsd(
+    Ptr<SpectrumPropagationLossModel> lossModel,
+    Ptr<const SpectrumSignalParameters> params,
+    Ptr<const MobilityModel> a,
+    Ptr<const MobilityModel> b,
+    std::vector<double> lossDb)
+{
+    Ptr<SpectrumValue> rxPsd = lossModel->CalcRxPowerSpectralDensity(params, a, b);
+    for (std::size_t i = 0; i < lossDb.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL((*rxPsd)[i],
+                                  (*params->psd)[i] * std::pow(10.0, -lossDb[i] / 10.0),
+                                  (*params->psd)[i] * 1e-6,
+                                  "Unexpected value of band " << i << " at "
+                                                              << Simulator::Now().As(Time::S));
+    }
+}
+
+void
+TraceSpectrumPropagationLossModelTestCase::DoRun()
+{
+    // the loss between nodes i and j in band f is 60 + 10 i + j + f dB at 0 s
+    // and 20 dB more at 1 s
+    std::vector<float> bandLossDb;
+    std::vector<float> lossDb;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        for (uint32_t j = 0; j < 2; j++)
+        {
+            for (uint32_t s = 0; s < 2; s++)
+            {
+                for (uint32_t f = 0; f < 3; f++)
+                {
+                    bandLossDb.push_back(60 + 10 * i + j + f + 20 * s);
+                }
+                lossDb.push_back(60 + 10 * i + j + 20 * s);
+            }
+        }
+    }
+    std::string bandFileName = CreateTempDirFilename("band-loss-trace.bin");
+    PropagationLossTrace::Write(bandFileName, 2, 3, 2, Seconds(0), Seconds(1), bandLossDb);
+    std::string fileName = CreateTempDirFilename("loss-trace.bin");
+    PropagationLossTrace::Write(fileName, 2, 1, 2, Seconds(0), Seconds(1), lossDb);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    NS_TEST_ASSERT_MSG_EQ(nodes.Get(1)->GetId(), 1, "The trace only has nodes 0 and 1");
+    std::vector<Ptr<MobilityModel>> mobilities;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        mobilities.push_back(CreateObject<ConstantPositionMobilityModel>());
+        nodes.Get(i)->AggregateObject(mobilities.back());
+    }
+
+    auto bandLossModel = CreateObject<TraceSpectrumPropagationLossModel>();
+    bandLossModel->SetAttribute("TraceFileName", StringValue(bandFileName));
+    auto lossModel = CreateObject<TraceSpectrumPropagationLossModel>();
+    lossModel->SetAttribute("TraceFileName", StringValue(fileName));
+
+    std::vector<double> centerFreqs{1e9, 2e9, 3e9};
+    auto params = Create<SpectrumSignalParameters>();
+    params->psd = Create<SpectrumValue>(Create<SpectrumModel>(centerFreqs));
+    (*params->psd)[0] = 1e-3;
+    (*params->psd)[1] = 2e-3;
+    (*params->psd)[2] = 4e-3;
+
+    Ptr<MobilityModel> a = mobilities[0];
+    Ptr<MobilityModel> b = mobilities[1];
+    Simulator::Schedule(MilliSeconds(500), [this, bandLossModel, lossModel, params, a, b]() {
+        CheckRxPsd(bandLossModel, params, a, b, {71, 72, 73});
+        CheckRxPsd(bandLossModel, params, b, a, {80, 81, 82});
+        CheckRxPsd(lossModel, params, b, a, {80, 80, 80});
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief TraceSpectrumPropagationLossModel TestSuite
+ */
+class TraceSpectrumPropagationLossModelTestSuite : public TestSuite
+{
+  public:
+    TraceSpectrumPropagationLossModelTestSuite();
+};
+
+TraceSpectrumPropagationLossModelTestSuite::TraceSpectrumPropagationLossModelTestSuite()
+    : TestSuite("trace-spectrum-propagation-loss-model", UNIT)
+{
+    AddTestCase(new TraceSpectrumPropagationLossModelTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static TraceSpectrumPropagationLossModelTestSuite
+    g_traceSpectrumPropagationLossModelTestSuite; ///< the test suite
@@ -364,6 +364,20 @@ TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
 
     NS_LOG_DEBUG("Send packet to device " << device << " protocol number " << item->GetProtocol());
 
+    // A super-segment built by a segmentation offload traversed the upper layers
+    // as a single packet. None of the devices can transmit it, hence it is split
+    // here, before being enqueued in the queue disc or sent to the device
+    std::vector<Ptr<QueueDiscItem>> segments;
+    if (item->Segment(segments))
+    {
+        NS_LOG_DEBUG("Split the super-segment into " << segments.size() << " packets");
+        for (const auto& segment : segments)
+        {
+            Send(device, segment);
+        }
+        return;
+    }
+
     Ptr<NetDeviceQueueInterface> devQueueIface;
     std::map<Ptr<NetDevice>, NetDeviceInfo>::iterator ndi = m_netDevices.find(device);
 
@@ -0,0 +1,233 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program benchmarks the wifi MAC layer of an 802.11ax AP serving a large
+// number of stations (500 by default). Once all the stations are associated, the
+// AP sends downlink traffic to every station at a rate that exceeds the capacity
+// of the channel, so that the AP holds one deep container queue per station and
+// MPDUs are frequently enqueued, dequeued and dropped because their lifetime
+// expired.
+//
+// The program reports the wall-clock time spent to run the simulation, the number
+// of events executed by the simulator and some statistics about the MPDUs handled
+// by the AP queue, so that the cost of the MAC queue operations can be compared
+// across versions:
+//
+//   ./ns3 run "wifi-ap-many-stas --nStations=500 --simulationTime=2"
+//
+
+#include "ns3/ap-wifi-mac.h"
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/qos-txop.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <chrono>
+#include <iomanip>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiApManyStas");
+
+uint64_t g_enqueued = 0;     ///< number of MPDUs enqueued by the AP
+uint64_t g_dequeued = 0;     ///< number of MPDUs dequeued by the AP
+uint64_t g_expired = 0;      ///< number of MPDUs dropped by the AP because their lifetime expired
+uint64_t g_rxBytes = 0;      ///< number of bytes received by the stations
+uint32_t g_maxQueueSize = 0; ///< peak number of MPDUs stored in the AP queue
+
+/**
+ * Callback connected to the Enqueue trace source of the AP queue.
+ *
+ * \param queue the AP queue
+ * \param mpdu the enqueued MPDU
+ */
+void
+NotifyEnqueue(Ptr<WifiMacQueue> queue, Ptr<const WifiMpdu> mpdu)
+{
+    g_enqueued++;
+    g_maxQueueSize = std::max(g_maxQueueSize, queue->GetNPackets());
+}
+
+/**
+ * Callback connected to the Dequeue trace source of the AP queue.
+ *
+ * \param mpdu the dequeued MPDU
+ */
+void
+NotifyDequeue(Ptr<const WifiMpdu> mpdu)
+{
+    g_dequeued++;
+}
+
+/**
+ * Callback connected to the Expired trace source of the AP queue.
+ *
+ * \param mpdu the MPDU whose lifetime expired
+ */
+void
+NotifyExpired(Ptr<const WifiMpdu> mpdu)
+{
+    g_expired++;
+}
+
+/**
+ * Callback connected to the Rx trace source of the packet socket servers.
+ *
+ * \param packet the received packet
+ * \param from the address of the sender
+ */
+void
+NotifyRx(Ptr<const Packet> packet, const Address& from)
+{
+    g_rxBytes += packet->GetSize();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nStations = 500;
+    double radius = 10;          // meters
+    double associationTime = 5;  // seconds
+    double simulationTime = 2;   // seconds
+    uint32_t payloadSize = 1000; // bytes
+    double interval = 0.01;      // seconds
+    std::string queueSize = "5000p";
+    std::string maxDelay = "50ms";
+    std::string wifiManager = "ns3::IdealWifiManager";
+    bool quiescentBeacons = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nStations", "Number of stations associated with the AP", nStations);
+    cmd.AddValue("radius", "Radius (m) of the disc around the AP where stations are", radius);
+    cmd.AddValue("associationTime",
+                 "Time (s) granted to the stations to associate before traffic starts",
+                 associationTime);
+    cmd.AddValue("simulationTime", "Duration (s) of the downlink traffic phase", simulationTime);
+    cmd.AddValue("payloadSize", "Payload size (bytes) of the packets", payloadSize);
+    cmd.AddValue("interval", "Inter-packet interval (s) of the flow to each station", interval);
+    cmd.AddValue("queueSize", "Maximum size of the AP queue", queueSize);
+    cmd.AddValue("maxDelay", "Lifetime of the MPDUs in the AP queue", maxDelay);
+    cmd.AddValue("wifiManager", "Rate control algorithm", wifiManager);
+    cmd.AddValue("quiescentBeacons",
+                 "Coalesce the beacons of the AP once all the stations are associated",
+                 quiescentBeacons);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::WifiMacQueue::MaxSize", StringValue(queueSize));
+    Config::SetDefault("ns3::WifiMacQueue::MaxDelay", StringValue(maxDelay));
+
+    NodeContainer apNode(1);
+    NodeContainer staNodes(nStations);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{42, 80, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager(wifiManager);
+
+    WifiMacHelper mac;
+    Ssid ssid("many-stas");
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes);
+    mac.SetType("ns3::ApWifiMac",
+                "Ssid",
+                SsidValue(ssid),
+                "EnableBeaconJitter",
+                BooleanValue(false),
+                "QuiescentBeacons",
+                BooleanValue(quiescentBeacons));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                  "rho",
+                                  DoubleValue(radius));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(apNode);
+    packetSocket.Install(staNodes);
+
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(staDevices.Get(i)->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        auto client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(payloadSize));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(Seconds(interval)));
+        client->SetStartTime(Seconds(associationTime));
+        apNode.Get(0)->AddApplication(client);
+
+        auto server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        server->TraceConnectWithoutContext("Rx", MakeCallback(&NotifyRx));
+        staNodes.Get(i)->AddApplication(server);
+    }
+
+    auto apMac = DynamicCast<WifiNetDevice>(apDevice.Get(0))->GetMac();
+    auto apQueue = apMac->GetQosTxop(AC_BE)->GetWifiMacQueue();
+    apQueue->TraceConnectWithoutContext("Enqueue", MakeBoundCallback(&NotifyEnqueue, apQueue));
+    apQueue->TraceConnectWithoutContext("Dequeue", MakeCallback(&NotifyDequeue));
+    apQueue->TraceConnectWithoutContext("Expired", MakeCallback(&NotifyExpired));
+
+    Simulator::Stop(Seconds(associationTime + simulationTime));
+
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    auto stop = std::chrono::steady_clock::now();
+
+    uint64_t nAssociated = DynamicCast<ApWifiMac>(apMac)->GetStaList().size();
+    double elapsed = std::chrono::duration<double>(stop - start).count();
+
+    std::cout << "Associated stations: " << nAssociated << "/" << nStations << std::endl
+              << "Wall-clock time (s): " << std::fixed << std::setprecision(3) << elapsed
+              << std::endl
+              << "Events executed: " << Simulator::GetEventCount() << std::endl
+              << "MPDUs enqueued/dequeued/expired at the AP: " << g_enqueued << "/"
+              << g_dequeued << "/" << g_expired << std::endl
+              << "Peak AP queue size (MPDUs): " << g_maxQueueSize << std::endl
+              << "Downlink throughput (Mbit/s): " << g_rxBytes * 8 / simulationTime / 1e6
+              << std::endl
+              << "Coalesced beacons: " << DynamicCast<ApWifiMac>(apMac)->GetNCoalescedBeacons()
+              << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
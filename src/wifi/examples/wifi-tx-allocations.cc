@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program counts the heap allocations performed by the simulator while an
+// 802.11ax AP sends saturated downlink traffic to a single station, and reports
+// the number of heap allocations per transmitted MPDU. The global operator new
+// is replaced by a version that counts the calls made during the measurement
+// phase, which starts after a warm-up period (so that association, Block Ack
+// agreement establishment and the growth of the memory pools are not counted).
+//
+// The program only relies on public APIs, hence it can be run on different
+// versions of the wifi module to compare the number of allocations per MPDU:
+//
+//   ./ns3 run "wifi-tx-allocations --ampdu=0"
+//   ./ns3 run "wifi-tx-allocations --ampdu=1"
+//
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet-socket-client.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/packet-socket-server.h"
+#include "ns3/simulator.h"
+#include "ns3/ssid.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <cstdlib>
+#include <new>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiTxAllocations");
+
+bool g_counting = false;  ///< whether heap allocations are being counted
+uint64_t g_nAllocs = 0;   ///< number of heap allocations counted
+uint64_t g_nMpdus = 0;    ///< number of MPDUs transmitted while counting
+uint64_t g_nPsdus = 0;    ///< number of PSDUs transmitted while counting
+uint64_t g_rxPackets = 0; ///< number of packets received while counting
+
+/**
+ * Replacement of the global operator new counting the heap allocations.
+ *
+ * \param size the size of the memory block
+ * \return a pointer to the allocated memory block
+ */
+void*
+operator new(std::size_t size)
+{
+    if (g_counting)
+    {
+        g_nAllocs++;
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+/**
+ * Replacement of the global operator delete matching the replaced operator new.
+ *
+ * \param ptr the memory block to release
+ */
+void
+operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * Replacement of the global sized operator delete matching the replaced operator new.
+ *
+ * \param ptr the memory block to release
+ * \param size the size of the memory block
+ */
+void
+operator delete(void* ptr, std::size_t size) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * Callback connected to the PhyTxPsduBegin trace source of the AP.
+ *
+ * \param psduMap the PSDU map
+ * \param txVector the TX vector
+ * \param txPowerW the TX power (W)
+ */
+void
+NotifyTxPsduBegin(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW)
+{
+    if (!g_counting)
+    {
+        return;
+    }
+    for (const auto& [staId, psdu] : psduMap)
+    {
+        if (psdu->GetHeader(0).IsQosData())
+        {
+            g_nPsdus++;
+            g_nMpdus += psdu->GetNMpdus();
+        }
+    }
+}
+
+/**
+ * Callback connected to the Rx trace source of the packet socket server.
+ *
+ * \param packet the received packet
+ * \param from the address of the sender
+ */
+void
+NotifyRx(Ptr<const Packet> packet, const Address& from)
+{
+    if (g_counting)
+    {
+        g_rxPackets++;
+    }
+}
+
+/**
+ * Start or stop counting heap allocations.
+ *
+ * \param enable whether to start (true) or stop (false) counting
+ */
+void
+SetCounting(bool enable)
+{
+    g_counting = enable;
+}
+
+int
+main(int argc, char* argv[])
+{
+    bool ampdu = true;
+    double warmupTime = 1;       // seconds
+    double simulationTime = 1;   // seconds
+    uint32_t payloadSize = 1000; // bytes
+    std::string mcs = "HeMcs7";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("ampdu", "Enable A-MPDU aggregation", ampdu);
+    cmd.AddValue("warmupTime", "Duration (s) of the warm-up phase", warmupTime);
+    cmd.AddValue("simulationTime", "Duration (s) of the measurement phase", simulationTime);
+    cmd.AddValue("payloadSize", "Payload size (bytes) of the packets", payloadSize);
+    cmd.AddValue("mcs", "The constant MCS used for data frames", mcs);
+    cmd.Parse(argc, argv);
+
+    NodeContainer apNode(1);
+    NodeContainer staNode(1);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{36, 20, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue(mcs),
+                                 "ControlMode",
+                                 StringValue("OfdmRate24Mbps"));
+
+    WifiMacHelper mac;
+    Ssid ssid("tx-allocations");
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer staDevice = wifi.Install(phy, mac, staNode);
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
+
+    if (!ampdu)
+    {
+        Config::Set("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/BE_MaxAmpduSize",
+                    UintegerValue(0));
+    }
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNode);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(apNode);
+    packetSocket.Install(staNode);
+
+    PacketSocketAddress socketAddr;
+    socketAddr.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+    socketAddr.SetPhysicalAddress(staDevice.Get(0)->GetAddress());
+    socketAddr.SetProtocol(1);
+
+    auto client = CreateObject<PacketSocketClient>();
+    client->SetRemote(socketAddr);
+    client->SetAttribute("PacketSize", UintegerValue(payloadSize));
+    client->SetAttribute("MaxPackets", UintegerValue(0));
+    client->SetAttribute("Interval", TimeValue(MicroSeconds(100)));
+    client->SetStartTime(Seconds(0.5));
+    apNode.Get(0)->AddApplication(client);
+
+    auto server = CreateObject<PacketSocketServer>();
+    server->SetLocal(socketAddr);
+    server->TraceConnectWithoutContext("Rx", MakeCallback(&NotifyRx));
+    staNode.Get(0)->AddApplication(server);
+
+    DynamicCast<WifiNetDevice>(apDevice.Get(0))
+        ->GetPhy()
+        ->TraceConnectWithoutContext("PhyTxPsduBegin", MakeCallback(&NotifyTxPsduBegin));
+
+    Simulator::Schedule(Seconds(warmupTime), &SetCounting, true);
+    Simulator::Schedule(Seconds(warmupTime + simulationTime), &SetCounting, false);
+    Simulator::Stop(Seconds(warmupTime + simulationTime));
+    Simulator::Run();
+
+    std::cout << "PSDUs transmitted: " << g_nPsdus << std::endl
+              << "MPDUs transmitted: " << g_nMpdus << std::endl
+              << "Packets received: " << g_rxPackets << std::endl
+              << "Heap allocations: " << g_nAllocs << std::endl;
+    if (g_nMpdus > 0)
+    {
+        std::cout << "Heap allocations per MPDU: " << static_cast<double>(g_nAllocs) / g_nMpdus
+                  << std::endl;
+    }
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -32,9 +32,11 @@
 #include "qos-txop.h"
 #include "reduced-neighbor-report.h"
 #include "wifi-mac-queue.h"
+#include "wifi-mac-trailer.h"
 #include "wifi-net-device.h"
 #include "wifi-phy.h"
 
+#include "ns3/channel.h"
 #include "ns3/he-configuration.h"
 #include "ns3/ht-configuration.h"
 #include "ns3/log.h"
@@ -50,8 +52,41 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("ApWifiMac");
 
+NS_OBJECT_ENSURE_REGISTERED(BeaconQuiescenceState);
 NS_OBJECT_ENSURE_REGISTERED(ApWifiMac);
 
+TypeId
+BeaconQuiescenceState::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::BeaconQuiescenceState")
+                            .SetParent<Object>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<BeaconQuiescenceState>();
+    return tid;
+}
+
+Ptr<BeaconQuiescenceState>
+BeaconQuiescenceState::Get(Ptr<Channel> channel)
+{
+    NS_ASSERT(channel);
+    auto state = channel->GetObject<BeaconQuiescenceState>();
+    if (!state)
+    {
+        state = CreateObject<BeaconQuiescenceState>();
+        channel->AggregateObject(state);
+    }
+    return state;
+}
+
+void
+BeaconQuiescenceState::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_nScanningStas = 0;
+    m_quiescentLinks.clear();
+    Object::DoDispose();
+}
+
 TypeId
 ApWifiMac::GetTypeId()
 {
@@ -83,6 +118,18 @@ ApWifiMac::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&ApWifiMac::SetBeaconGeneration),
                           MakeBooleanChecker())
+            .AddAttribute("QuiescentBeacons",
+                          "If true, Beacon frames are not transmitted as long as no station is "
+                          "scanning or associating and their content does not change. Coalesced "
+                          "beacons are accounted for analytically (see GetNCoalescedBeacons and "
+                          "GetCoalescedBeaconAirtime) and associated stations do not "
+                          "disassociate due to missed beacons. Beacon transmission is resumed "
+                          "at the next TBTT as soon as a station starts scanning or the channel "
+                          "is switched. This is a simulation speed-up for long runs in which "
+                          "management traffic carries no state changes.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApWifiMac::m_quiescentBeacons),
+                          MakeBooleanChecker())
             .AddAttribute("EnableNonErpProtection",
                           "Whether or not protection mechanism should be used when non-ERP STAs "
                           "are present within the BSS."
@@ -107,7 +154,8 @@ ApWifiMac::GetTypeId()
 }
 
 ApWifiMac::ApWifiMac()
-    : m_enableBeaconGeneration(false)
+    : m_enableBeaconGeneration(false),
+      m_quiescentBeacons(false)
 {
     NS_LOG_FUNCTION(this);
     m_beaconTxop = CreateObject<Txop>(CreateObject<WifiMacQueue>(AC_BEACON));
@@ -126,6 +174,15 @@ void
 ApWifiMac::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    for (uint8_t linkId = 0; linkId < GetNLinks(); ++linkId)
+    {
+        auto& link = GetLink(linkId);
+        if (link.quiescenceState)
+        {
+            link.quiescenceState->m_quiescentLinks.erase(link.feManager->GetAddress());
+            link.quiescenceState = nullptr;
+        }
+    }
     m_beaconTxop->Dispose();
     m_beaconTxop = nullptr;
     m_enableBeaconGeneration = false;
@@ -183,6 +240,7 @@ ApWifiMac::SetBeaconGeneration(bool enable)
     {
         if (!enable)
         {
+            ResumeBeacons(linkId);
             GetLink(linkId).beaconEvent.Cancel();
         }
         else if (!m_enableBeaconGeneration)
@@ -1303,10 +1361,13 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     }
     packet->AddHeader(beacon);
 
-    // The beacon has it's own special queue, so we load it in there
-    m_beaconTxop->Queue(packet, hdr);
-    link.beaconEvent =
-        Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
+    if (!m_quiescentBeacons || !StartBeaconQuiescence(packet, hdr, linkId))
+    {
+        // The beacon has it's own special queue, so we load it in there
+        m_beaconTxop->Queue(packet, hdr);
+        link.beaconEvent =
+            Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
+    }
 
     // If a STA that does not support Short Slot Time associates,
     // the AP shall use long slot time beginning at the first Beacon
@@ -1326,6 +1387,158 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     }
 }
 
+bool
+ApWifiMac::StartBeaconQuiescence(Ptr<const Packet> packet, const WifiMacHeader& hdr, uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << packet << +linkId);
+    auto& link = GetLink(linkId);
+
+    // the Beacon frame body, except the timestamp (first 8 octets)
+    std::vector<uint8_t> body(packet->GetSize());
+    packet->CopyData(body.data(), body.size());
+    body.erase(body.begin(), body.begin() + 8);
+
+    if (GetWifiPhy(linkId)->GetChannel() && !IsStaScanning(linkId) && body == link.lastBeacon)
+    {
+        NS_LOG_DEBUG("No station is scanning or associating and the Beacon frame did not "
+                     "change: beacons become quiescent on link "
+                     << +linkId);
+        link.quiescentSince = Simulator::Now();
+        link.quiescenceState = BeaconQuiescenceState::Get(GetWifiPhy(linkId)->GetChannel());
+        link.quiescenceState->m_quiescentLinks[link.feManager->GetAddress()] = {this, linkId};
+        return true;
+    }
+
+    link.lastBeacon = std::move(body);
+    auto phy = GetWifiPhy(linkId);
+    link.beaconTxDuration = WifiPhy::CalculateTxDuration(
+        packet->GetSize() + hdr.GetSize() + WIFI_MAC_FCS_LENGTH,
+        GetWifiRemoteStationManager(linkId)->GetDataTxVector(hdr, phy->GetChannelWidth()),
+        phy->GetPhyBand());
+    return false;
+}
+
+uint64_t
+ApWifiMac::GetNElapsedTbtts(uint8_t linkId) const
+{
+    const auto& link = GetLink(linkId);
+    if (!link.quiescentSince.has_value())
+    {
+        return 0;
+    }
+    return (Simulator::Now() - *link.quiescentSince).GetTimeStep() /
+               GetBeaconInterval().GetTimeStep() +
+           1;
+}
+
+void
+ApWifiMac::ResumeBeacons(uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << +linkId);
+    auto& link = GetLink(linkId);
+
+    if (!link.quiescentSince.has_value())
+    {
+        return;
+    }
+
+    auto nTbtts = GetNElapsedTbtts(linkId);
+    Time nextTbtt = *link.quiescentSince + GetBeaconInterval() * nTbtts;
+    NS_LOG_DEBUG("Resuming beacons on link " << +linkId << " after " << nTbtts
+                                             << " coalesced Beacon frames");
+
+    link.nCoalescedBeacons += nTbtts;
+    link.coalescedAirtime += link.beaconTxDuration * nTbtts;
+    link.quiescentSince.reset();
+    // make sure that a Beacon frame is transmitted at the end of the quiescent period
+    link.lastBeacon.clear();
+    if (link.quiescenceState)
+    {
+        link.quiescenceState->m_quiescentLinks.erase(link.feManager->GetAddress());
+        link.quiescenceState = nullptr;
+    }
+
+    if (m_enableBeaconGeneration)
+    {
+        link.beaconEvent.Cancel();
+        link.beaconEvent = Simulator::Schedule(nextTbtt - Simulator::Now(),
+                                               &ApWifiMac::SendOneBeacon,
+                                               this,
+                                               linkId);
+    }
+}
+
+uint64_t
+ApWifiMac::GetNCoalescedBeacons(uint8_t linkId) const
+{
+    return GetLink(linkId).nCoalescedBeacons + GetNElapsedTbtts(linkId);
+}
+
+Time
+ApWifiMac::GetCoalescedBeaconAirtime(uint8_t linkId) const
+{
+    const auto& link = GetLink(linkId);
+    return link.coalescedAirtime + link.beaconTxDuration * GetNElapsedTbtts(linkId);
+}
+
+bool
+ApWifiMac::IsStaScanning(uint8_t linkId) const
+{
+    auto channel = GetWifiPhy(linkId)->GetChannel();
+    auto state = channel ? channel->GetObject<BeaconQuiescenceState>() : nullptr;
+    return state && state->m_nScanningStas > 0;
+}
+
+void
+ApWifiMac::NotifyStaScanning(Ptr<Channel> channel, bool scanning)
+{
+    NS_LOG_FUNCTION(channel << scanning);
+    auto state = BeaconQuiescenceState::Get(channel);
+
+    if (!scanning)
+    {
+        // the state is reset if the channel is disposed of before the station
+        if (state->m_nScanningStas > 0)
+        {
+            state->m_nScanningStas--;
+        }
+        return;
+    }
+
+    if (state->m_nScanningStas++ == 0)
+    {
+        // copy the map, because resuming beacons removes entries from the map
+        auto quiescentLinks = state->m_quiescentLinks;
+        for (const auto& [bssid, apLink] : quiescentLinks)
+        {
+            apLink.first->ResumeBeacons(apLink.second);
+        }
+    }
+}
+
+Ptr<ApWifiMac>
+ApWifiMac::GetQuiescentAp(Ptr<Channel> channel, Mac48Address bssid)
+{
+    auto state = channel ? channel->GetObject<BeaconQuiescenceState>() : nullptr;
+    if (!state)
+    {
+        return nullptr;
+    }
+    if (auto it = state->m_quiescentLinks.find(bssid); it != state->m_quiescentLinks.end())
+    {
+        return it->second.first;
+    }
+    return nullptr;
+}
+
+void
+ApWifiMac::NotifyChannelSwitching(uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << +linkId);
+    WifiMac::NotifyChannelSwitching(linkId);
+    ResumeBeacons(linkId);
+}
+
 void
 ApWifiMac::TxOk(Ptr<const WifiMpdu> mpdu)
 {
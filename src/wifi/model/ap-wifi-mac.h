@@ -26,12 +26,16 @@
 #include "wifi-mac-header.h"
 #include "wifi-mac.h"
 
+#include <map>
+#include <optional>
 #include <unordered_map>
 #include <variant>
 
 namespace ns3
 {
 
+class ApWifiMac;
+class Channel;
 class SupportedRates;
 class CapabilityInformation;
 class DsssParameterSet;
@@ -53,6 +57,36 @@ class MgtAssocResponseHeader;
 using AssocReqRefVariant = std::variant<std::reference_wrapper<MgtAssocRequestHeader>,
                                         std::reference_wrapper<MgtReassocRequestHeader>>;
 
+/**
+ * \ingroup wifi
+ *
+ * The state shared by the APs having QuiescentBeacons enabled and the stations
+ * attached to a channel, which is aggregated to the channel.
+ */
+class BeaconQuiescenceState : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \param channel the given channel
+     * \return the state aggregated to the given channel, which is created and
+     *         aggregated if the channel has none yet
+     */
+    static Ptr<BeaconQuiescenceState> Get(Ptr<Channel> channel);
+
+    uint32_t m_nScanningStas{0}; //!< Number of stations scanning or associating on the channel
+    std::map<Mac48Address, std::pair<Ptr<ApWifiMac>, uint8_t>>
+        m_quiescentLinks; //!< Links on the channel whose beacons are quiescent, indexed by BSSID
+
+  protected:
+    void DoDispose() override;
+};
+
 /**
  * \brief Wi-Fi AP state machine
  * \ingroup wifi
@@ -79,6 +113,7 @@ class ApWifiMac : public WifiMac
     bool SupportsSendFrom() const override;
     Ptr<WifiMacQueue> GetTxopQueue(AcIndex ac) const override;
     void ConfigureStandard(WifiStandard standard) override;
+    void NotifyChannelSwitching(uint8_t linkId) override;
 
     /**
      * \param interval the interval between two beacon transmissions.
@@ -153,6 +188,44 @@ class ApWifiMac : public WifiMac
      */
     uint8_t GetMaxBufferStatus(Mac48Address address) const;
 
+    /**
+     * Get the number of Beacon frames that were not transmitted on the given link
+     * because beacons were quiescent (including the current quiescent period, if any).
+     *
+     * \param linkId the ID of the given link
+     * \return the number of coalesced Beacon frames
+     */
+    uint64_t GetNCoalescedBeacons(uint8_t linkId = SINGLE_LINK_OP_ID) const;
+    /**
+     * Get the airtime that the Beacon frames that were not transmitted on the given
+     * link because beacons were quiescent would have occupied.
+     *
+     * \param linkId the ID of the given link
+     * \return the airtime of the coalesced Beacon frames
+     */
+    Time GetCoalescedBeaconAirtime(uint8_t linkId = SINGLE_LINK_OP_ID) const;
+
+    /**
+     * Notify that a station attached to the given channel entered (or left) a state
+     * in which it is scanning or associating, i.e., any state other than associated.
+     * While there is at least one such station on a channel, the APs having
+     * QuiescentBeacons enabled transmit all their Beacon frames on that channel;
+     * when a station starts scanning, the quiescent APs on its channel resume
+     * beaconing at their next TBTT. The stations are counted by the
+     * BeaconQuiescenceState aggregated to the channel.
+     *
+     * \param channel the channel the station is attached to
+     * \param scanning whether the station entered (true) or left (false) such a state
+     */
+    static void NotifyStaScanning(Ptr<Channel> channel, bool scanning);
+    /**
+     * \param channel the channel of a link of an AP
+     * \param bssid the BSSID of the link
+     * \return the AP if its beacons on the link with the given BSSID are currently
+     *         quiescent, a null pointer otherwise
+     */
+    static Ptr<ApWifiMac> GetQuiescentAp(Ptr<Channel> channel, Mac48Address bssid);
+
   protected:
     /**
      * Structure holding information specific to a single link. Here, the meaning of
@@ -173,6 +246,18 @@ class ApWifiMac : public WifiMac
         bool shortSlotTimeEnabled{
             false}; //!< Flag whether short slot time is enabled within the BSS
         bool shortPreambleEnabled{false}; //!< Flag whether short preamble is enabled in the BSS
+        std::optional<Time> quiescentSince; //!< TBTT of the first Beacon frame not transmitted
+                                            //!< in the current quiescent period, if any
+        uint64_t nCoalescedBeacons{0};      //!< Number of Beacon frames not transmitted in
+                                            //!< previous quiescent periods
+        Time coalescedAirtime;              //!< Airtime of the Beacon frames not transmitted
+                                            //!< in previous quiescent periods
+        Time beaconTxDuration;              //!< TX duration of the last Beacon frame
+        std::vector<uint8_t> lastBeacon;    //!< Body of the last Beacon frame transmitted
+                                            //!< while beacons may be quiescent, except the
+                                            //!< timestamp
+        Ptr<BeaconQuiescenceState> quiescenceState; //!< State of the channel on which the
+                                                    //!< link is quiescent, if any
     };
 
     /**
@@ -308,6 +393,40 @@ class ApWifiMac : public WifiMac
      * \param linkId the ID of the given link
      */
     void SendOneBeacon(uint8_t linkId);
+    /**
+     * Check whether the given Beacon frame can be coalesced, i.e., no station is
+     * scanning or associating and the content of the Beacon frame (except the
+     * timestamp) did not change since the last Beacon frame transmitted on the given
+     * link. If so, start a quiescent period on the given link, during which Beacon
+     * frames are neither generated nor transmitted.
+     *
+     * \param packet the Beacon frame body
+     * \param hdr the MAC header of the Beacon frame
+     * \param linkId the ID of the given link
+     * \return true if a quiescent period started, false if the Beacon frame has to
+     *         be transmitted
+     */
+    bool StartBeaconQuiescence(Ptr<const Packet> packet, const WifiMacHeader& hdr, uint8_t linkId);
+    /**
+     * End the quiescent period on the given link, if any, by accounting for the
+     * Beacon frames that were not transmitted and scheduling the transmission of
+     * a Beacon frame at the next TBTT.
+     *
+     * \param linkId the ID of the given link
+     */
+    void ResumeBeacons(uint8_t linkId);
+    /**
+     * \param linkId the ID of the given link
+     * \return the number of TBTTs that elapsed in the current quiescent period of the
+     *         given link, including the TBTT at which the period started
+     */
+    uint64_t GetNElapsedTbtts(uint8_t linkId) const;
+    /**
+     * \param linkId the ID of the given link
+     * \return true if a station attached to the channel of the given link is
+     *         scanning or associating
+     */
+    bool IsStaScanning(uint8_t linkId) const;
 
     /**
      * Return the Capability information of the current AP for the given link.
@@ -444,6 +563,7 @@ class ApWifiMac : public WifiMac
     Ptr<UniformRandomVariable>
         m_beaconJitter; //!< UniformRandomVariable used to randomize the time of the first beacon
     bool m_enableBeaconJitter; //!< Flag whether the first beacon should be generated at random time
+    bool m_quiescentBeacons;   //!< Flag whether beacons are coalesced when nothing changes
     bool m_enableNonErpProtection; //!< Flag whether protection mechanism is used or not when
                                    //!< non-ERP STAs are present within the BSS
     Time m_bsrLifetime;            //!< Lifetime of Buffer Status Reports
@@ -25,6 +25,8 @@
 #include "ns3/enum.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -112,14 +114,7 @@ FcfsWifiQueueScheduler::DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu
 {
     NS_LOG_FUNCTION(this << +ac << mpdus.size());
 
-    std::set<WifiContainerQueueId> queueIds;
-
-    for (const auto& mpdu : mpdus)
-    {
-        queueIds.insert(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
-
-    for (const auto& queueId : queueIds)
+    for (const auto& queueId : GetSortedQueueIds(mpdus))
     {
         if (std::get<WifiContainerQueueType>(queueId) == WIFI_MGT_QUEUE)
         {
@@ -139,16 +134,9 @@ FcfsWifiQueueScheduler::DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>
 {
     NS_LOG_FUNCTION(this << +ac << mpdus.size());
 
-    std::set<WifiContainerQueueId> queueIds;
-
-    for (const auto& mpdu : mpdus)
-    {
-        queueIds.insert(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
-
-    for (const auto& queueId : queueIds)
+    for (const auto& queueId : GetSortedQueueIds(mpdus))
     {
-        if (std::get<0>(queueId) == WIFI_MGT_QUEUE)
+        if (std::get<WifiContainerQueueType>(queueId) == WIFI_MGT_QUEUE)
         {
             // the priority of management queues does not change
             continue;
@@ -161,4 +149,23 @@ FcfsWifiQueueScheduler::DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>
     }
 }
 
+std::vector<WifiContainerQueueId>
+FcfsWifiQueueScheduler::GetSortedQueueIds(const std::list<Ptr<WifiMpdu>>& mpdus)
+{
+    std::vector<WifiContainerQueueId> queueIds;
+    queueIds.reserve(mpdus.size());
+
+    for (const auto& mpdu : mpdus)
+    {
+        queueIds.push_back(WifiMacQueueContainer::GetQueueId(mpdu));
+    }
+
+    if (queueIds.size() > 1)
+    {
+        std::sort(queueIds.begin(), queueIds.end());
+        queueIds.erase(std::unique(queueIds.begin(), queueIds.end()), queueIds.end());
+    }
+    return queueIds;
+}
+
 } // namespace ns3
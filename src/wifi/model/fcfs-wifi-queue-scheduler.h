@@ -25,6 +25,8 @@
 
 #include "ns3/nstime.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -61,6 +63,16 @@ class FcfsWifiQueueScheduler : public WifiMacQueueSchedulerImpl<Time>
     void DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) override;
     void DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) override;
 
+    /**
+     * Get the sorted list of the (distinct) IDs of the container queues storing
+     * the given MPDUs.
+     *
+     * \param mpdus the given list of MPDUs
+     * \return the sorted list of container queue IDs
+     */
+    static std::vector<WifiContainerQueueId> GetSortedQueueIds(
+        const std::list<Ptr<WifiMpdu>>& mpdus);
+
     DropPolicy m_dropPolicy; //!< Drop behavior of queue
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
@@ -24,6 +24,7 @@
 #include "mu-snr-tag.h"
 
 #include "ns3/vht-frame-exchange-manager.h"
+#include "ns3/wifi-ppdu.h"
 
 #include <map>
 #include <unordered_map>
@@ -40,10 +41,6 @@ class CtrlTriggerHeader;
  * Map of PSDUs indexed by STA-ID
  */
 typedef std::unordered_map<uint16_t /* staId */, Ptr<WifiPsdu> /* PSDU */> WifiPsduMap;
-/**
- * Map of const PSDUs indexed by STA-ID
- */
-typedef std::unordered_map<uint16_t /* staId */, Ptr<const WifiPsdu> /* PSDU */> WifiConstPsduMap;
 
 /**
  * \ingroup wifi
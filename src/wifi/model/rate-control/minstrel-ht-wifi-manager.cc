@@ -43,6 +43,8 @@
 #include "ns3/wifi-mac.h"
 #include "ns3/wifi-phy.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 
 #define Min(a, b) ((a < b) ? a : b)
@@ -123,6 +125,14 @@ MinstrelHtWifiManager::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&MinstrelHtWifiManager::m_printStats),
                           MakeBooleanChecker())
+            .AddAttribute("BatchedStatsUpdate",
+                          "If true, the statistics of all the rates of a station are updated in "
+                          "batch (vectorizable loop over a structure of arrays). If false, the "
+                          "reference implementation processing one rate at a time is used. Both "
+                          "implementations produce identical results.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&MinstrelHtWifiManager::m_batchedStatsUpdate),
+                          MakeBooleanChecker())
             .AddTraceSource("Rate",
                             "Traced value for rate changes (b/s)",
                             MakeTraceSourceAccessor(&MinstrelHtWifiManager::m_currentRate),
@@ -133,6 +143,7 @@ MinstrelHtWifiManager::GetTypeId()
 MinstrelHtWifiManager::MinstrelHtWifiManager()
     : m_numGroups(0),
       m_numRates(0),
+      m_batchedStatsUpdate(true),
       m_currentRate(0)
 {
     NS_LOG_FUNCTION(this);
@@ -1424,8 +1435,6 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_numSamplesSlow = 0;
     station->m_sampleCount = 0;
 
-    double tempProb;
-
     if (station->m_ampduPacketCount > 0)
     {
         uint32_t newLen = station->m_ampduLen / station->m_ampduPacketCount;
@@ -1440,6 +1449,38 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_maxTpRate2 = GetLowestIndex(station);
     station->m_maxProbRate = GetLowestIndex(station);
 
+    if (m_batchedStatsUpdate)
+    {
+        UpdateRateStatsBatched(station);
+    }
+    else
+    {
+        UpdateRateStatsReference(station);
+    }
+
+    // Try to sample all available rates during each interval.
+    station->m_sampleCount *= 8;
+
+    // Recalculate retries for the rates selected.
+    CalculateRetransmits(station, station->m_maxTpRate);
+    CalculateRetransmits(station, station->m_maxTpRate2);
+    CalculateRetransmits(station, station->m_maxProbRate);
+
+    NS_LOG_DEBUG("max tp=" << station->m_maxTpRate << "\nmax tp2=" << station->m_maxTpRate2
+                           << "\nmax prob=" << station->m_maxProbRate);
+    if (m_printStats)
+    {
+        PrintTable(station);
+    }
+}
+
+void
+MinstrelHtWifiManager::UpdateRateStatsReference(MinstrelHtWifiRemoteStation* station)
+{
+    NS_LOG_FUNCTION(this << station);
+
+    double tempProb;
+
     /// Update throughput and EWMA for each rate inside each group.
     for (uint8_t j = 0; j < m_numGroups; j++)
     {
@@ -1531,20 +1572,138 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
             }
         }
     }
+}
 
-    // Try to sample all available rates during each interval.
-    station->m_sampleCount *= 8;
+void
+MinstrelHtWifiManager::UpdateRateStatsBatched(MinstrelHtWifiRemoteStation* station)
+{
+    NS_LOG_FUNCTION(this << station);
 
-    // Recalculate retries for the rates selected.
-    CalculateRetransmits(station, station->m_maxTpRate);
-    CalculateRetransmits(station, station->m_maxTpRate2);
-    CalculateRetransmits(station, station->m_maxProbRate);
+    StatsBatch& batch = m_statsBatch;
+    batch.index.clear();
+    batch.attempted.clear();
+    batch.first.clear();
+    batch.prob.clear();
+    batch.ewmaProb.clear();
+    batch.ewmsdProb.clear();
+    batch.txTime.clear();
+    batch.throughput.clear();
+
+    /// Gather the statistics of the supported rates.
+    for (uint8_t j = 0; j < m_numGroups; j++)
+    {
+        GroupInfo& group = station->m_groupsTable[j];
+        if (!group.m_supported)
+        {
+            continue;
+        }
+        station->m_sampleCount++;
 
-    NS_LOG_DEBUG("max tp=" << station->m_maxTpRate << "\nmax tp2=" << station->m_maxTpRate2
-                           << "\nmax prob=" << station->m_maxProbRate);
-    if (m_printStats)
+        /* (re)Initialize group rate indexes */
+        group.m_maxTpRate = GetLowestIndex(station, j);
+        group.m_maxTpRate2 = GetLowestIndex(station, j);
+        group.m_maxProbRate = GetLowestIndex(station, j);
+
+        for (uint8_t i = 0; i < m_numRates; i++)
+        {
+            MinstrelHtRateInfo& rate = group.m_ratesTable[i];
+            if (!rate.supported)
+            {
+                continue;
+            }
+            rate.retryUpdated = false;
+
+            NS_LOG_DEBUG(+i << " " << GetMcsSupported(station, rate.mcsIndex)
+                            << "\t attempt=" << rate.numRateAttempt
+                            << "\t success=" << rate.numRateSuccess);
+
+            batch.index.push_back(GetIndex(j, i));
+            batch.attempted.push_back(rate.numRateAttempt > 0);
+            batch.first.push_back(rate.successHist == 0);
+            // Probability of success, scaled from 0 to 100 (integer division as in
+            // the reference implementation)
+            batch.prob.push_back(rate.numRateAttempt > 0
+                                     ? (100 * rate.numRateSuccess) / rate.numRateAttempt
+                                     : 0);
+            batch.ewmaProb.push_back(rate.ewmaProb);
+            batch.ewmsdProb.push_back(rate.ewmsdProb);
+            batch.txTime.push_back(rate.perfectTxTime.GetSeconds());
+            batch.throughput.push_back(rate.throughput);
+        }
+    }
+
+    /**
+     * Update EWMA, EWMSD and throughput of all the rates. The loop has no
+     * function calls nor data dependent control flow, so that the compiler can
+     * vectorize it. The arithmetic is the same as in CalculateEwmsd() and
+     * CalculateThroughput(), hence the results are bit-identical.
+     */
+    const std::size_t n = batch.index.size();
+    const double weight = m_ewmaLevel;
+    const uint8_t* attempted = batch.attempted.data();
+    const uint8_t* first = batch.first.data();
+    const double* prob = batch.prob.data();
+    const double* txTime = batch.txTime.data();
+    double* ewmaProb = batch.ewmaProb.data();
+    double* ewmsdProb = batch.ewmsdProb.data();
+    double* throughput = batch.throughput.data();
+
+    for (std::size_t k = 0; k < n; k++)
     {
-        PrintTable(station);
+        double diff = prob[k] - ewmaProb[k];
+        double incr = (100 - weight) * diff / 100;
+        double var = weight * (ewmsdProb[k] * ewmsdProb[k] + diff * incr) / 100;
+        double ewma = (prob[k] * (100 - weight) + ewmaProb[k] * weight) / 100;
+
+        double newEwma = first[k] ? prob[k] : ewma;
+        double newEwmsd = first[k] ? ewmsdProb[k] : std::sqrt(var);
+        double th = newEwma < 10 ? 0 : std::min(newEwma, 90.0) / txTime[k];
+
+        ewmaProb[k] = attempted[k] ? newEwma : ewmaProb[k];
+        ewmsdProb[k] = attempted[k] ? newEwmsd : ewmsdProb[k];
+        throughput[k] = attempted[k] ? th : throughput[k];
+    }
+
+    /**
+     * Store the updated statistics and select the best rates. The rates are
+     * visited in the same order as in the reference implementation, so that ties
+     * are broken in the same way.
+     */
+    for (std::size_t k = 0; k < n; k++)
+    {
+        uint16_t index = batch.index[k];
+        MinstrelHtRateInfo& rate =
+            station->m_groupsTable[GetGroupId(index)].m_ratesTable[GetRateId(index)];
+
+        if (attempted[k])
+        {
+            rate.numSamplesSkipped = 0;
+            rate.prob = prob[k];
+            rate.ewmaProb = ewmaProb[k];
+            rate.ewmsdProb = ewmsdProb[k];
+            rate.throughput = throughput[k];
+            rate.successHist += rate.numRateSuccess;
+            rate.attemptHist += rate.numRateAttempt;
+        }
+        else
+        {
+            rate.numSamplesSkipped++;
+        }
+
+        /// Bookkeeping.
+        rate.prevNumRateSuccess = rate.numRateSuccess;
+        rate.prevNumRateAttempt = rate.numRateAttempt;
+        rate.numRateSuccess = 0;
+        rate.numRateAttempt = 0;
+    }
+
+    for (std::size_t k = 0; k < n; k++)
+    {
+        if (throughput[k] != 0)
+        {
+            SetBestStationThRates(station, batch.index[k]);
+            SetBestProbabilityRate(station, batch.index[k]);
+        }
     }
 }
 
@@ -401,6 +401,25 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
      */
     void UpdateStats(MinstrelHtWifiRemoteStation* station);
 
+    /**
+     * Update the statistics of all the supported rates of the given station by
+     * processing one rate at a time (reference implementation).
+     *
+     * \param station the Minstrel-HT wifi remote station
+     */
+    void UpdateRateStatsReference(MinstrelHtWifiRemoteStation* station);
+
+    /**
+     * Update the statistics of all the supported rates of the given station by
+     * first gathering the statistics in a structure of arrays, then updating the
+     * EWMA, the EWMSD and the throughput of all the rates in a single loop, and
+     * finally selecting the best rates. The results are identical to those
+     * produced by UpdateRateStatsReference().
+     *
+     * \param station the Minstrel-HT wifi remote station
+     */
+    void UpdateRateStatsBatched(MinstrelHtWifiRemoteStation* station);
+
     /**
      * Initialize Minstrel Table.
      *
@@ -667,6 +686,25 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
     bool m_useLatestAmendmentOnly; //!< Flag if only the latest supported amendment by both peers
                                    //!< should be used.
     bool m_printStats;             //!< If statistics table should be printed.
+    bool m_batchedStatsUpdate;     //!< Whether rate statistics are updated in batch.
+
+    /**
+     * Statistics of the supported rates of a station, stored as a structure of
+     * arrays so that the update of the statistics can be vectorized.
+     */
+    struct StatsBatch
+    {
+        std::vector<uint16_t> index;    //!< global index of the rate
+        std::vector<uint8_t> attempted; //!< whether transmissions were attempted
+        std::vector<uint8_t> first;     //!< whether the rate was never successful before
+        std::vector<double> prob;       //!< success probability in the last interval
+        std::vector<double> ewmaProb;   //!< EWMA of the success probability
+        std::vector<double> ewmsdProb;  //!< EWMSD of the success probability
+        std::vector<double> txTime;     //!< perfect TX time (seconds)
+        std::vector<double> throughput; //!< throughput of the rate
+    };
+
+    StatsBatch m_statsBatch; //!< scratch storage reused by batched stats updates
 
     MinstrelMcsGroups m_minstrelGroups; //!< Global array for groups information.
 
@@ -22,6 +22,7 @@
 
 #include "sta-wifi-mac.h"
 
+#include "ap-wifi-mac.h"
 #include "channel-access-manager.h"
 #include "frame-exchange-manager.h"
 #include "mgt-headers.h"
@@ -31,6 +32,7 @@
 #include "wifi-net-device.h"
 #include "wifi-phy.h"
 
+#include "ns3/channel.h"
 #include "ns3/he-configuration.h"
 #include "ns3/ht-configuration.h"
 #include "ns3/log.h"
@@ -40,6 +42,7 @@
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <numeric>
 
 namespace ns3
@@ -142,6 +145,7 @@ void
 StaWifiMac::DoInitialize()
 {
     NS_LOG_FUNCTION(this);
+    NotifyScanning(true);
     StartScanning();
 }
 
@@ -154,6 +158,7 @@ StaWifiMac::DoDispose()
         m_assocManager->Dispose();
     }
     m_assocManager = nullptr;
+    NotifyScanning(false);
     WifiMac::DoDispose();
 }
 
@@ -631,6 +636,15 @@ StaWifiMac::MissedBeacons(uint8_t linkId)
                                                   linkId);
         return;
     }
+    if (const auto& bssid = link.bssid; bssid.has_value())
+    {
+        if (auto ap = ApWifiMac::GetQuiescentAp(GetWifiPhy(linkId)->GetChannel(), *bssid))
+        {
+            NS_LOG_DEBUG("beacons of the associated AP are quiescent");
+            RestartBeaconWatchdog(ap->GetBeaconInterval() * m_maxMissedBeacons, linkId);
+            return;
+        }
+    }
     NS_LOG_DEBUG("beacon missed");
     // We need to switch to the UNASSOCIATED state. However, if we are receiving
     // a frame, wait until the RX is completed (otherwise, crashes may occur if
@@ -1364,9 +1378,49 @@ StaWifiMac::GetCapabilities(uint8_t linkId) const
 void
 StaWifiMac::SetState(MacState value)
 {
+    if (value == ASSOCIATED)
+    {
+        NotifyScanning(false);
+    }
+    else if (m_state == ASSOCIATED)
+    {
+        NotifyScanning(true);
+    }
     m_state = value;
 }
 
+void
+StaWifiMac::NotifyScanning(bool scanning)
+{
+    NS_LOG_FUNCTION(this << scanning);
+
+    if (!scanning)
+    {
+        for (const auto& channel : m_scanningChannels)
+        {
+            ApWifiMac::NotifyStaScanning(channel, false);
+        }
+        m_scanningChannels.clear();
+        return;
+    }
+
+    if (!m_scanningChannels.empty())
+    {
+        return;
+    }
+    for (uint8_t linkId = 0; linkId < GetNLinks(); linkId++)
+    {
+        auto channel = GetWifiPhy(linkId)->GetChannel();
+        if (channel && std::find(m_scanningChannels.cbegin(),
+                                 m_scanningChannels.cend(),
+                                 channel) == m_scanningChannels.cend())
+        {
+            m_scanningChannels.push_back(channel);
+            ApWifiMac::NotifyStaScanning(channel, true);
+        }
+    }
+}
+
 void
 StaWifiMac::SetEdcaParameters(AcIndex ac,
                               uint32_t cwMin,
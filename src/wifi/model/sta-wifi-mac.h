@@ -27,6 +27,7 @@
 #include "wifi-mac.h"
 
 #include <variant>
+#include <vector>
 
 class TwoLevelAggregationTest;
 class AmpduAggregationTest;
@@ -35,6 +36,7 @@ class HeAggregationTest;
 namespace ns3
 {
 
+class Channel;
 class SupportedRates;
 class CapabilityInformation;
 class RandomVariableStream;
@@ -418,6 +420,13 @@ class StaWifiMac : public WifiMac
      * \param value the new state
      */
     void SetState(MacState value);
+    /**
+     * Notify the APs that this station entered (or left) a state in which it is
+     * scanning or associating, on the channels its PHYs are attached to.
+     *
+     * \param scanning whether this station entered (true) or left (false) such a state
+     */
+    void NotifyScanning(bool scanning);
     /**
      * Set the EDCA parameters.
      *
@@ -482,6 +491,8 @@ class StaWifiMac : public WifiMac
     bool m_activeProbing;                   ///< active probing
     Ptr<RandomVariableStream> m_probeDelay; ///< RandomVariable used to randomize the time
                                             ///< of the first Probe Response on each channel
+    std::vector<Ptr<Channel>> m_scanningChannels; ///< Channels on which the APs have been
+                                                  ///< notified that this station is scanning
 
     TracedCallback<Mac48Address> m_assocLogger;             ///< association logger
     TracedCallback<uint8_t, Mac48Address> m_setupCompleted; ///< link setup completed logger
@@ -33,21 +33,19 @@ WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& entry = m_queues[queueId];
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == entry.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
-
-    return m_queues[queueId].emplace(pos, item);
+    entry.nBytes += item->GetSize();
+    return entry.queue.emplace(pos, item);
 }
 
 WifiMacQueueContainer::iterator
@@ -58,13 +56,12 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto it = m_queues.find(GetQueueId(pos->mpdu));
+    NS_ASSERT(it != m_queues.end());
+    NS_ASSERT(it->second.nBytes >= pos->mpdu->GetSize());
+    it->second.nBytes -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    return it->second.queue.erase(pos);
 }
 
 Ptr<WifiMpdu>
@@ -97,17 +94,18 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return m_queues[queueId].queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    auto it = m_queues.find(queueId);
+    if (it == m_queues.end() || it->second.queue.empty())
     {
         return 0;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return it->second.nBytes;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
@@ -117,8 +115,9 @@ WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId)
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueEntry& entry) const
 {
+    auto& queue = entry.queue;
     iterator firstExpiredIt = queue.begin();
     iterator lastExpiredIt = firstExpiredIt;
     Time now = Simulator::Now();
@@ -130,11 +129,8 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
         lastExpiredIt->ac = AC_UNDEF;
         lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-        WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-        auto it = m_nBytesPerQueue.find(queueId);
-        NS_ASSERT(it != m_nBytesPerQueue.end());
-        NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-        it->second -= lastExpiredIt->mpdu->GetSize();
+        NS_ASSERT(entry.nBytes >= lastExpiredIt->mpdu->GetSize());
+        entry.nBytes -= lastExpiredIt->mpdu->GetSize();
 
         ++lastExpiredIt;
     }
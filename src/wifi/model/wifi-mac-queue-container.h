@@ -25,7 +25,6 @@
 
 #include "ns3/mac48-address.h"
 
-#include <list>
 #include <tuple>
 #include <unordered_map>
 
@@ -93,12 +92,18 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ * Each entry of the hash table stores both the container queue and its size in
+ * bytes, so that a single lookup is needed when inserting or erasing an MPDU.
+ * The nodes of the container queues are recycled through a pool (see
+ * WifiMacQueueElemList) and container queues are kept in the hash table when
+ * they become empty, hence enqueuing and dequeuing MPDUs are constant-time
+ * operations that do not need heap allocations in steady state.
  */
 class WifiMacQueueContainer
 {
   public:
     /// Type of a queue held by the container
-    using ContainerQueue = std::list<WifiMacQueueElem>;
+    using ContainerQueue = WifiMacQueueElemList;
     /// iterator over elements in a container queue
     using iterator = ContainerQueue::iterator;
     /// const iterator over elements in a container queue
@@ -189,21 +194,26 @@ class WifiMacQueueContainer
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
   private:
+    /// A container queue along with its size in bytes
+    struct QueueEntry
+    {
+        ContainerQueue queue; //!< the container queue
+        uint32_t nBytes{0};   //!< the size in bytes of the MPDUs in the container queue
+    };
+
     /**
      * Transfer MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * \param queue the given container queue
+     * \param entry the entry storing the given container queue
      * \return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueEntry& entry) const;
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    mutable std::unordered_map<WifiContainerQueueId, QueueEntry>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
 };
 
 } // namespace ns3
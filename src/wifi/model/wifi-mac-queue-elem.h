@@ -22,10 +22,13 @@
 #define WIFI_MAC_QUEUE_ELEM_H
 
 #include "qos-utils.h"
+#include "wifi-pool-allocator.h"
 
 #include "ns3/callback.h"
 #include "ns3/nstime.h"
 
+#include <list>
+
 namespace ns3
 {
 
@@ -56,6 +59,14 @@ struct WifiMacQueueElem
     ~WifiMacQueueElem();
 };
 
+/**
+ * \ingroup wifi
+ * Type of the lists of WifiMacQueueElem objects used by a WifiMacQueue container.
+ * List nodes are obtained from a pool, hence enqueuing and dequeuing MPDUs do not
+ * require heap allocations once the pool has grown to the peak queue occupancy.
+ */
+using WifiMacQueueElemList = std::list<WifiMacQueueElem, WifiPoolAllocator<WifiMacQueueElem>>;
+
 } // namespace ns3
 
 #endif /* WIFI_MAC_QUEUE_ELEM_H */
@@ -33,6 +33,7 @@
 #include <vector>
 
 class WifiMacQueueDropOldestTest;
+class WifiMacQueueManyReceiversTest;
 
 namespace ns3
 {
@@ -53,6 +54,8 @@ class WifiMacQueueSchedulerImpl : public WifiMacQueueScheduler
   public:
     /// allow WifiMacQueueDropOldestTest class access
     friend class ::WifiMacQueueDropOldestTest;
+    /// allow WifiMacQueueManyReceiversTest class access
+    friend class ::WifiMacQueueManyReceiversTest;
 
     /**
      * \brief Get the type ID.
@@ -502,15 +505,10 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyDequeue(AcIndex ac,
 
     DoNotifyDequeue(ac, mpdus);
 
-    std::list<WifiContainerQueueId> queueIds;
-
     for (const auto& mpdu : mpdus)
     {
-        queueIds.push_back(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
+        const auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
 
-    for (const auto& queueId : queueIds)
-    {
         if (GetWifiMacQueue(ac)->GetNBytes(queueId) == 0)
         {
             // The queue has now become empty and needs to be removed from the sorted
@@ -536,15 +534,10 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyRemove(AcIndex ac,
 
     DoNotifyRemove(ac, mpdus);
 
-    std::list<WifiContainerQueueId> queueIds;
-
     for (const auto& mpdu : mpdus)
     {
-        queueIds.push_back(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
+        const auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
 
-    for (const auto& queueId : queueIds)
-    {
         if (GetWifiMacQueue(ac)->GetNBytes(queueId) == 0)
         {
             // The queue has now become empty and needs to be removed from the sorted
@@ -100,9 +100,15 @@ WifiMacQueue::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<Ptr<WifiMpdu>> mpdus;
     auto [first, last] = GetContainer().ExtractExpiredMpdus(queueId);
 
+    if (first == last)
+    {
+        // no MPDU with expired lifetime, nothing to notify
+        return;
+    }
+
+    std::list<Ptr<WifiMpdu>> mpdus;
     for (auto it = first; it != last; it++)
     {
         mpdus.push_back(it->mpdu);
@@ -118,9 +124,15 @@ WifiMacQueue::ExtractAllExpiredMpdus() const
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<Ptr<WifiMpdu>> mpdus;
     auto [first, last] = GetContainer().ExtractAllExpiredMpdus();
 
+    if (first == last)
+    {
+        // no MPDU with expired lifetime, nothing to notify
+        return;
+    }
+
+    std::list<Ptr<WifiMpdu>> mpdus;
     for (auto it = first; it != last; it++)
     {
         mpdus.push_back(it->mpdu);
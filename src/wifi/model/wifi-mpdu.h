@@ -54,7 +54,7 @@ class WmqIteratorTag
  * WifiMpdu stores (const) packets along with their Wifi MAC headers
  * and the time when they were enqueued.
  */
-class WifiMpdu : public SimpleRefCount<WifiMpdu>
+class WifiMpdu : public SimpleRefCount<WifiMpdu>, public WifiPoolAllocated
 {
   public:
     /**
@@ -141,7 +141,7 @@ class WifiMpdu : public SimpleRefCount<WifiMpdu>
     DeaggregatedMsdusCI end() const;
 
     /// Const iterator typedef
-    typedef std::list<WifiMacQueueElem>::iterator Iterator;
+    typedef WifiMacQueueElemList::iterator Iterator;
 
     /**
      * Set the queue iterator stored by this object.
@@ -0,0 +1,273 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_OPEN_HASH_MAP_H
+#define WIFI_OPEN_HASH_MAP_H
+
+#include "ns3/assert.h"
+#include "ns3/mac48-address.h"
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * Functor mapping a MAC address to the 48-bit integer having the same value.
+ * To be used as the key function of a WifiOpenHashMap.
+ */
+struct WifiMac48AddressKey
+{
+    /**
+     * \param address the MAC address
+     * \return the integer value of the given MAC address
+     */
+    uint64_t operator()(const Mac48Address& address) const
+    {
+        uint8_t buffer[6];
+        address.CopyTo(buffer);
+        uint64_t value = 0;
+        for (const auto byte : buffer)
+        {
+            value = (value << 8) | byte;
+        }
+        return value;
+    }
+};
+
+/**
+ * \ingroup wifi
+ * An associative container using open addressing with linear probing.
+ *
+ * Entries are stored in a single contiguous array whose size is a power of two,
+ * hence a lookup is usually resolved by a multiplication, a shift and the
+ * comparison of the keys stored in a couple of adjacent slots. The KeyToInt
+ * functor converts a key into an integer, which is scrambled by means of
+ * Fibonacci hashing to get the index of the first slot to probe.
+ *
+ * Entries cannot be removed individually (the whole map can be cleared) and
+ * inserting an entry may invalidate pointers to the values stored in the map.
+ *
+ * \tparam Key the type of the keys
+ * \tparam T the type of the values
+ * \tparam KeyToInt functor converting a key into an integer
+ */
+template <class Key, class T, class KeyToInt = std::hash<Key>>
+class WifiOpenHashMap
+{
+  public:
+    WifiOpenHashMap();
+
+    /**
+     * \param key the given key
+     * \return a pointer to the value associated with the given key, if any, or a null pointer
+     */
+    T* Find(const Key& key);
+    /**
+     * \param key the given key
+     * \return a pointer to the value associated with the given key, if any, or a null pointer
+     */
+    const T* Find(const Key& key) const;
+    /**
+     * Associate the given value with the given key. If the given key is already
+     * present in the map, the associated value is replaced.
+     *
+     * \param key the given key
+     * \param value the given value
+     * \return a reference to the value stored in the map
+     */
+    T& Insert(const Key& key, T value);
+    /**
+     * \return the number of entries stored in the map
+     */
+    std::size_t GetSize() const;
+    /**
+     * \return whether the map is empty
+     */
+    bool IsEmpty() const;
+    /**
+     * Remove all the entries from the map.
+     */
+    void Clear();
+    /**
+     * Call the given function on all the entries stored in the map.
+     *
+     * \tparam F the type of the given function
+     * \param f the function taking a key and a (reference to the) value as arguments
+     */
+    template <class F>
+    void ForEach(F&& f);
+
+  private:
+    /// A slot of the table
+    struct Slot
+    {
+        Key key{};        //!< the key
+        T value{};        //!< the value
+        bool used{false}; //!< whether this slot holds an entry
+    };
+
+    /**
+     * \param key the given key
+     * \return the index of the slot holding the given key or of the first free
+     *         slot found while probing for the given key
+     */
+    std::size_t Probe(const Key& key) const;
+    /**
+     * Double the number of slots and re-insert all the entries.
+     */
+    void Grow();
+
+    static constexpr uint8_t INITIAL_SIZE_LOG2 = 4; //!< log2 of the initial number of slots
+
+    std::vector<Slot> m_slots; //!< the slots
+    uint8_t m_shift;           //!< shift applied to the scrambled key to get the slot index
+    std::size_t m_size;        //!< number of entries stored in the map
+};
+
+} // namespace ns3
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+namespace ns3
+{
+
+template <class Key, class T, class KeyToInt>
+WifiOpenHashMap<Key, T, KeyToInt>::WifiOpenHashMap()
+    : m_slots(std::size_t{1} << INITIAL_SIZE_LOG2),
+      m_shift(64 - INITIAL_SIZE_LOG2),
+      m_size(0)
+{
+}
+
+template <class Key, class T, class KeyToInt>
+std::size_t
+WifiOpenHashMap<Key, T, KeyToInt>::Probe(const Key& key) const
+{
+    const std::size_t mask = m_slots.size() - 1;
+    // Fibonacci hashing: keep the most significant bits of the scrambled key
+    auto index = static_cast<std::size_t>(
+        (static_cast<uint64_t>(KeyToInt{}(key)) * 0x9E3779B97F4A7C15ULL) >> m_shift);
+
+    while (m_slots[index].used && !(m_slots[index].key == key))
+    {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+template <class Key, class T, class KeyToInt>
+T*
+WifiOpenHashMap<Key, T, KeyToInt>::Find(const Key& key)
+{
+    auto& slot = m_slots[Probe(key)];
+    return slot.used ? &slot.value : nullptr;
+}
+
+template <class Key, class T, class KeyToInt>
+const T*
+WifiOpenHashMap<Key, T, KeyToInt>::Find(const Key& key) const
+{
+    const auto& slot = m_slots[Probe(key)];
+    return slot.used ? &slot.value : nullptr;
+}
+
+template <class Key, class T, class KeyToInt>
+T&
+WifiOpenHashMap<Key, T, KeyToInt>::Insert(const Key& key, T value)
+{
+    auto index = Probe(key);
+
+    if (!m_slots[index].used)
+    {
+        // keep the load factor below 1/2, so that probe sequences stay short
+        if (2 * (m_size + 1) > m_slots.size())
+        {
+            Grow();
+            index = Probe(key);
+        }
+        m_slots[index].key = key;
+        m_slots[index].used = true;
+        m_size++;
+    }
+    m_slots[index].value = std::move(value);
+    return m_slots[index].value;
+}
+
+template <class Key, class T, class KeyToInt>
+void
+WifiOpenHashMap<Key, T, KeyToInt>::Grow()
+{
+    NS_ASSERT(m_shift > 1);
+    std::vector<Slot> slots(2 * m_slots.size());
+    m_slots.swap(slots);
+    m_shift--;
+
+    for (auto& slot : slots)
+    {
+        if (slot.used)
+        {
+            m_slots[Probe(slot.key)] = std::move(slot);
+        }
+    }
+}
+
+template <class Key, class T, class KeyToInt>
+std::size_t
+WifiOpenHashMap<Key, T, KeyToInt>::GetSize() const
+{
+    return m_size;
+}
+
+template <class Key, class T, class KeyToInt>
+bool
+WifiOpenHashMap<Key, T, KeyToInt>::IsEmpty() const
+{
+    return m_size == 0;
+}
+
+template <class Key, class T, class KeyToInt>
+void
+WifiOpenHashMap<Key, T, KeyToInt>::Clear()
+{
+    m_slots.assign(std::size_t{1} << INITIAL_SIZE_LOG2, Slot{});
+    m_shift = 64 - INITIAL_SIZE_LOG2;
+    m_size = 0;
+}
+
+template <class Key, class T, class KeyToInt>
+template <class F>
+void
+WifiOpenHashMap<Key, T, KeyToInt>::ForEach(F&& f)
+{
+    for (auto& slot : m_slots)
+    {
+        if (slot.used)
+        {
+            f(slot.key, slot.value);
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* WIFI_OPEN_HASH_MAP_H */
@@ -1725,8 +1725,11 @@ WifiPhy::Send(WifiConstPsduMap psdus, const WifiTxVector& txVector)
         ppdu->SetTruncatedTx();
     }
 
-    m_endTxEvent =
-        Simulator::Schedule(txDuration, &WifiPhy::NotifyTxEnd, this, psdus); // TODO: fix for MU
+    // the PPDU holds its own copy of the PSDU map, hence hand off ours to the end of TX event
+    m_endTxEvent = Simulator::Schedule(txDuration,
+                                       &WifiPhy::NotifyTxEnd,
+                                       this,
+                                       std::move(psdus)); // TODO: fix for MU
 
     StartTx(ppdu, txVector);
 
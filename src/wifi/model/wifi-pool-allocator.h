@@ -0,0 +1,321 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_POOL_ALLOCATOR_H
+#define WIFI_POOL_ALLOCATOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ * A pool of memory blocks of the given size.
+ *
+ * Released blocks are not returned to the system but they are kept in a free
+ * list and handed out again by subsequent allocations, so that objects that are
+ * frequently created and destroyed (e.g., the nodes of the lists storing the
+ * MPDUs queued by a WifiMacQueue) do not cause a heap allocation each time.
+ * Blocks are obtained from the system in chunks of CHUNK_SIZE blocks.
+ *
+ * A single pool exists for each block size. The state of a pool is never
+ * destroyed and its chunks are only released by the system when the program
+ * terminates, because static objects (e.g., test suites) may still own objects
+ * stored in those chunks when their destructors run. Pools are not
+ * thread-safe, hence they must only be used by objects that are created and
+ * destroyed by the simulator thread.
+ *
+ * \tparam BlockSize the size in bytes of the blocks
+ */
+template <std::size_t BlockSize>
+class WifiBlockPool
+{
+  public:
+    /**
+     * \return a pointer to a memory block of size BlockSize
+     */
+    static void* Allocate();
+    /**
+     * Give back the given memory block to the pool.
+     *
+     * \param block a memory block previously obtained by calling Allocate()
+     */
+    static void Deallocate(void* block);
+
+  private:
+    /// A free memory block, which stores the pointer to the next free block
+    struct FreeBlock
+    {
+        FreeBlock* next; //!< the next free block
+    };
+
+    /// The size of the blocks, rounded up to be a multiple of the maximum alignment
+    static constexpr std::size_t SIZE =
+        (std::max(BlockSize, sizeof(FreeBlock)) + alignof(std::max_align_t) - 1) /
+        alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    /// The number of blocks obtained from the system at once
+    static constexpr std::size_t CHUNK_SIZE = 64;
+
+    /// The state of the pool
+    struct State
+    {
+        FreeBlock* freeList{nullptr}; //!< the list of free blocks
+        std::vector<void*> chunks;    //!< the chunks of memory obtained from the system
+    };
+
+    /**
+     * \return the state of the pool
+     */
+    static State* GetState();
+};
+
+/**
+ * \ingroup wifi
+ * Allocate a memory block of (at least) the given size. Sizes up to
+ * WIFI_POOL_MAX_SIZE bytes are rounded up to a multiple of WIFI_POOL_GRANULARITY
+ * bytes and served by the WifiBlockPool of that size, while larger blocks are
+ * obtained from the global operator new.
+ *
+ * \param size the size in bytes of the memory block
+ * \return a pointer to the memory block
+ */
+inline void* WifiPoolAllocate(std::size_t size);
+
+/**
+ * \ingroup wifi
+ * Release a memory block obtained by calling WifiPoolAllocate().
+ *
+ * \param block the memory block
+ * \param size the size in bytes passed to WifiPoolAllocate()
+ */
+inline void WifiPoolDeallocate(void* block, std::size_t size);
+
+static constexpr std::size_t WIFI_POOL_GRANULARITY = 16; //!< size classes granularity (bytes)
+static constexpr std::size_t WIFI_POOL_MAX_SIZE = 1024;  //!< largest pooled size (bytes)
+
+/**
+ * \ingroup wifi
+ * Base class for objects that are allocated from the WifiBlockPools through
+ * WifiPoolAllocate() rather than from the heap. Classes whose instances are
+ * created for every transmitted frame (MPDUs, PSDUs, PPDUs, ...) derive from
+ * this class, so that creating and destroying them does not hit the heap in
+ * steady state. If a derived class is deleted through a pointer to a base
+ * class, the destructor of the base class must be virtual.
+ */
+class WifiPoolAllocated
+{
+  public:
+    /**
+     * \param size the size of the object
+     * \return a pointer to the memory where the object is constructed
+     */
+    static void* operator new(std::size_t size)
+    {
+        return WifiPoolAllocate(size);
+    }
+
+    /**
+     * \param block the memory where the object was constructed
+     * \param size the size of the object
+     */
+    static void operator delete(void* block, std::size_t size)
+    {
+        WifiPoolDeallocate(block, size);
+    }
+};
+
+/**
+ * \ingroup wifi
+ * A (stateless) allocator serving allocations from the WifiBlockPools (see
+ * WifiPoolAllocate()). All the instances compare equal, hence elements can be
+ * spliced between standard containers using this allocator.
+ *
+ * \tparam T the type of the allocated objects
+ */
+template <class T>
+class WifiPoolAllocator
+{
+  public:
+    /// the type of the allocated objects
+    using value_type = T;
+
+    WifiPoolAllocator() = default;
+
+    /**
+     * Converting constructor.
+     */
+    template <class U>
+    WifiPoolAllocator(const WifiPoolAllocator<U>& /* other */)
+    {
+    }
+
+    /**
+     * \param n the number of objects to allocate storage for
+     * \return a pointer to the allocated storage
+     */
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(WifiPoolAllocate(n * sizeof(T)));
+    }
+
+    /**
+     * \param p a pointer to storage obtained by calling allocate()
+     * \param n the number of objects passed to allocate()
+     */
+    void deallocate(T* p, std::size_t n)
+    {
+        WifiPoolDeallocate(p, n * sizeof(T));
+    }
+};
+
+/**
+ * \return true, as all WifiPoolAllocators are interchangeable
+ */
+template <class T, class U>
+bool
+operator==(const WifiPoolAllocator<T>& /* a */, const WifiPoolAllocator<U>& /* b */)
+{
+    return true;
+}
+
+/**
+ * \return false, as all WifiPoolAllocators are interchangeable
+ */
+template <class T, class U>
+bool
+operator!=(const WifiPoolAllocator<T>& /* a */, const WifiPoolAllocator<U>& /* b */)
+{
+    return false;
+}
+
+} // namespace ns3
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+namespace ns3
+{
+
+template <std::size_t BlockSize>
+typename WifiBlockPool<BlockSize>::State*
+WifiBlockPool<BlockSize>::GetState()
+{
+    // intentionally never deleted (see the class documentation)
+    static State* state = new State;
+    return state;
+}
+
+template <std::size_t BlockSize>
+void*
+WifiBlockPool<BlockSize>::Allocate()
+{
+    auto state = GetState();
+
+    if (state->freeList == nullptr)
+    {
+        auto chunk = static_cast<uint8_t*>(::operator new(SIZE * CHUNK_SIZE));
+        state->chunks.push_back(chunk);
+        for (std::size_t i = 0; i < CHUNK_SIZE; i++)
+        {
+            auto block = reinterpret_cast<FreeBlock*>(chunk + i * SIZE);
+            block->next = state->freeList;
+            state->freeList = block;
+        }
+    }
+
+    auto block = state->freeList;
+    state->freeList = block->next;
+    return block;
+}
+
+template <std::size_t BlockSize>
+void
+WifiBlockPool<BlockSize>::Deallocate(void* block)
+{
+    auto state = GetState();
+    auto freeBlock = static_cast<FreeBlock*>(block);
+    freeBlock->next = state->freeList;
+    state->freeList = freeBlock;
+}
+
+/**
+ * \ingroup wifi
+ * \tparam I the indices of the size classes
+ * \return the table of the functions allocating the blocks of each size class
+ */
+template <std::size_t... I>
+constexpr std::array<void* (*)(), sizeof...(I)>
+GetWifiPoolAllocators(std::index_sequence<I...>)
+{
+    return {&WifiBlockPool<(I + 1) * WIFI_POOL_GRANULARITY>::Allocate...};
+}
+
+/**
+ * \ingroup wifi
+ * \tparam I the indices of the size classes
+ * \return the table of the functions deallocating the blocks of each size class
+ */
+template <std::size_t... I>
+constexpr std::array<void (*)(void*), sizeof...(I)>
+GetWifiPoolDeallocators(std::index_sequence<I...>)
+{
+    return {&WifiBlockPool<(I + 1) * WIFI_POOL_GRANULARITY>::Deallocate...};
+}
+
+/// the number of size classes
+static constexpr std::size_t WIFI_POOL_N_CLASSES = WIFI_POOL_MAX_SIZE / WIFI_POOL_GRANULARITY;
+
+/// the function allocating the blocks of each size class
+inline constexpr auto WIFI_POOL_ALLOCATE =
+    GetWifiPoolAllocators(std::make_index_sequence<WIFI_POOL_N_CLASSES>{});
+
+/// the function deallocating the blocks of each size class
+inline constexpr auto WIFI_POOL_DEALLOCATE =
+    GetWifiPoolDeallocators(std::make_index_sequence<WIFI_POOL_N_CLASSES>{});
+
+inline void*
+WifiPoolAllocate(std::size_t size)
+{
+    if (size == 0 || size > WIFI_POOL_MAX_SIZE)
+    {
+        return ::operator new(size);
+    }
+    return WIFI_POOL_ALLOCATE[(size - 1) / WIFI_POOL_GRANULARITY]();
+}
+
+inline void
+WifiPoolDeallocate(void* block, std::size_t size)
+{
+    if (size == 0 || size > WIFI_POOL_MAX_SIZE)
+    {
+        ::operator delete(block);
+        return;
+    }
+    WIFI_POOL_DEALLOCATE[(size - 1) / WIFI_POOL_GRANULARITY](block);
+}
+
+} // namespace ns3
+
+#endif /* WIFI_POOL_ALLOCATOR_H */
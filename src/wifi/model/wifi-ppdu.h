@@ -21,6 +21,7 @@
 #ifndef WIFI_PPDU_H
 #define WIFI_PPDU_H
 
+#include "wifi-pool-allocator.h"
 #include "wifi-tx-vector.h"
 
 #include "ns3/nstime.h"
@@ -41,9 +42,15 @@ namespace ns3
 class WifiPsdu;
 
 /**
- * Map of const PSDUs indexed by STA-ID
+ * Map of const PSDUs indexed by STA-ID. The map is created for every transmitted
+ * PPDU, hence its nodes are allocated from the wifi memory pools.
  */
-typedef std::unordered_map<uint16_t /* STA-ID */, Ptr<const WifiPsdu> /* PSDU */> WifiConstPsduMap;
+typedef std::unordered_map<uint16_t /* STA-ID */,
+                           Ptr<const WifiPsdu> /* PSDU */,
+                           std::hash<uint16_t>,
+                           std::equal_to<uint16_t>,
+                           WifiPoolAllocator<std::pair<const uint16_t, Ptr<const WifiPsdu>>>>
+    WifiConstPsduMap;
 
 /**
  * \ingroup wifi
@@ -51,7 +58,7 @@ typedef std::unordered_map<uint16_t /* STA-ID */, Ptr<const WifiPsdu> /* PSDU */
  * WifiPpdu stores a preamble, a modulation class, PHY headers and a PSDU.
  * This class should be subclassed for each amendment.
  */
-class WifiPpdu : public SimpleRefCount<WifiPpdu>
+class WifiPpdu : public SimpleRefCount<WifiPpdu>, public WifiPoolAllocated
 {
   public:
     /**
@@ -561,7 +561,7 @@ WifiRemoteStationManager::SetMldAddress(const Mac48Address& address, const Mac48
     auto state = LookupState(address);
     state->m_mldAddress = mldAddress;
     // insert another entry in m_states indexed by the MLD address and pointing to the same state
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert({mldAddress, state});
+    const_cast<WifiRemoteStationManager*>(this)->m_states.Insert(mldAddress, state);
 }
 
 std::optional<Mac48Address>
@@ -573,17 +573,16 @@ WifiRemoteStationManager::GetMldAddress(const Mac48Address& address) const
 std::optional<Mac48Address>
 WifiRemoteStationManager::GetAffiliatedStaAddress(const Mac48Address& mldAddress) const
 {
-    auto stateIt = m_states.find(mldAddress);
+    auto statePtr = m_states.Find(mldAddress);
 
-    if (stateIt == m_states.end())
+    if (statePtr == nullptr)
     {
         // MLD address not found
         return std::optional<Mac48Address>();
     }
 
-    NS_ASSERT(stateIt->second->m_mldAddress.has_value() &&
-              *stateIt->second->m_mldAddress == mldAddress);
-    return stateIt->second->m_address;
+    NS_ASSERT((*statePtr)->m_mldAddress.has_value() && *(*statePtr)->m_mldAddress == mldAddress);
+    return (*statePtr)->m_address;
 }
 
 WifiTxVector
@@ -1343,9 +1342,9 @@ WifiRemoteStationManager::GetInfo(Mac48Address address)
 double
 WifiRemoteStationManager::GetMostRecentRssi(Mac48Address address) const
 {
-    auto stationIt = m_stations.find(address);
-    NS_ASSERT_MSG(stationIt != m_stations.end(), "Address: " << address << " not found");
-    auto station = stationIt->second;
+    auto stationPtr = m_stations.Find(address);
+    NS_ASSERT_MSG(stationPtr != nullptr, "Address: " << address << " not found");
+    auto station = *stationPtr;
     auto rssi = station->m_rssiAndUpdateTimePair.first;
     auto ts = station->m_rssiAndUpdateTimePair.second;
     NS_ASSERT_MSG(ts.IsStrictlyPositive(), "address: " << address << " ts:" << ts);
@@ -1356,12 +1355,12 @@ std::shared_ptr<WifiRemoteStationState>
 WifiRemoteStationManager::LookupState(Mac48Address address) const
 {
     NS_LOG_FUNCTION(this << address);
-    auto stateIt = m_states.find(address);
+    auto statePtr = m_states.Find(address);
 
-    if (stateIt != m_states.end())
+    if (statePtr != nullptr)
     {
         NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning existing state");
-        return stateIt->second;
+        return *statePtr;
     }
 
     auto state = std::make_shared<WifiRemoteStationState>();
@@ -1382,26 +1381,25 @@ WifiRemoteStationManager::LookupState(Mac48Address address) const
     state->m_ness = 0;
     state->m_aggregation = false;
     state->m_qosSupported = false;
-    const_cast<WifiRemoteStationManager*>(this)->m_states.insert({address, state});
     NS_LOG_DEBUG("WifiRemoteStationManager::LookupState returning new state");
-    return state;
+    return const_cast<WifiRemoteStationManager*>(this)->m_states.Insert(address, state);
 }
 
 WifiRemoteStation*
 WifiRemoteStationManager::Lookup(Mac48Address address) const
 {
     NS_LOG_FUNCTION(this << address);
-    auto stationIt = m_stations.find(address);
+    auto stationPtr = m_stations.Find(address);
 
-    if (stationIt != m_stations.end())
+    if (stationPtr != nullptr)
     {
-        return stationIt->second;
+        return *stationPtr;
     }
 
     WifiRemoteStation* station = DoCreateStation();
     station->m_state = LookupState(address).get();
     station->m_rssiAndUpdateTimePair = std::make_pair(0, Seconds(0));
-    const_cast<WifiRemoteStationManager*>(this)->m_stations.insert({address, station});
+    const_cast<WifiRemoteStationManager*>(this)->m_stations.Insert(address, station);
     return station;
 }
 
@@ -1565,9 +1563,10 @@ WifiRemoteStationManager::GetStationEhtCapabilities(Mac48Address from)
 bool
 WifiRemoteStationManager::GetLdpcSupported(Mac48Address address) const
 {
-    Ptr<const HtCapabilities> htCapabilities = LookupState(address)->m_htCapabilities;
-    Ptr<const VhtCapabilities> vhtCapabilities = LookupState(address)->m_vhtCapabilities;
-    Ptr<const HeCapabilities> heCapabilities = LookupState(address)->m_heCapabilities;
+    auto state = LookupState(address);
+    Ptr<const HtCapabilities> htCapabilities = state->m_htCapabilities;
+    Ptr<const VhtCapabilities> vhtCapabilities = state->m_vhtCapabilities;
+    Ptr<const HeCapabilities> heCapabilities = state->m_heCapabilities;
     bool supported = false;
     if (htCapabilities)
     {
@@ -1625,12 +1624,9 @@ void
 WifiRemoteStationManager::Reset()
 {
     NS_LOG_FUNCTION(this);
-    m_states.clear();
-    for (auto& state : m_stations)
-    {
-        delete (state.second);
-    }
-    m_stations.clear();
+    m_states.Clear();
+    m_stations.ForEach([](const Mac48Address&, WifiRemoteStation* station) { delete station; });
+    m_stations.Clear();
     m_bssBasicRateSet.clear();
     m_bssBasicMcsSet.clear();
     m_ssrc.fill(0);
@@ -23,6 +23,7 @@
 
 #include "qos-utils.h"
 #include "wifi-mode.h"
+#include "wifi-open-hash-map.h"
 #include "wifi-remote-station-info.h"
 #include "wifi-utils.h"
 
@@ -38,7 +39,6 @@
 #include <array>
 #include <memory>
 #include <optional>
-#include <unordered_map>
 
 namespace ns3
 {
@@ -153,12 +153,13 @@ class WifiRemoteStationManager : public Object
     /**
      * A map of WifiRemoteStations with Mac48Address as key
      */
-    using Stations = std::unordered_map<Mac48Address, WifiRemoteStation*, WifiAddressHash>;
+    using Stations = WifiOpenHashMap<Mac48Address, WifiRemoteStation*, WifiMac48AddressKey>;
     /**
      * A map of WifiRemoteStationStates with Mac48Address as key
      */
-    using StationStates =
-        std::unordered_map<Mac48Address, std::shared_ptr<WifiRemoteStationState>, WifiAddressHash>;
+    using StationStates = WifiOpenHashMap<Mac48Address,
+                                          std::shared_ptr<WifiRemoteStationState>,
+                                          WifiMac48AddressKey>;
 
     /**
      * Set up PHY associated with this device since it is the object that
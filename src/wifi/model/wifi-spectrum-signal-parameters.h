@@ -22,6 +22,8 @@
 #ifndef WIFI_SPECTRUM_SIGNAL_PARAMETERS_H
 #define WIFI_SPECTRUM_SIGNAL_PARAMETERS_H
 
+#include "wifi-pool-allocator.h"
+
 #include "ns3/spectrum-signal-parameters.h"
 
 namespace ns3
@@ -34,7 +36,7 @@ class WifiPpdu;
  *
  * Signal parameters for wifi
  */
-struct WifiSpectrumSignalParameters : public SpectrumSignalParameters
+struct WifiSpectrumSignalParameters : public SpectrumSignalParameters, public WifiPoolAllocated
 {
     Ptr<SpectrumSignalParameters> Copy() const override;
 
@@ -121,6 +121,157 @@ WifiMacQueueDropOldestTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the per-receiver container queues of a WifiMacQueue.
+ *
+ * MPDUs addressed to many receivers and belonging to distinct TIDs are enqueued.
+ * This test verifies that the number of packets and bytes of every container
+ * queue are correctly tracked when MPDUs are removed from the queue and when
+ * their lifetime expires, and that the queue can be reused afterwards.
+ */
+class WifiMacQueueManyReceiversTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor
+     */
+    WifiMacQueueManyReceiversTest();
+
+    void DoRun() override;
+
+  private:
+    /**
+     * Enqueue an MPDU of the given size, addressed to the given receiver and
+     * belonging to the given TID.
+     *
+     * \param receiver the receiver address
+     * \param tid the TID
+     * \param size the size of the packet
+     */
+    void Enqueue(Mac48Address receiver, uint8_t tid, uint32_t size);
+    /**
+     * Check the number of packets and bytes in all the container queues.
+     *
+     * \param nPackets the expected number of packets in every container queue
+     */
+    void CheckQueues(uint32_t nPackets);
+
+    static constexpr uint32_t N_RECEIVERS = 100; //!< number of receivers
+    static constexpr uint8_t N_TIDS = 2;         //!< number of TIDs per receiver
+    Ptr<WifiMacQueue> m_queue;                   //!< the queue
+    std::vector<Mac48Address> m_receivers;       //!< receiver addresses
+};
+
+WifiMacQueueManyReceiversTest::WifiMacQueueManyReceiversTest()
+    : TestCase("Test container queues of many receivers")
+{
+}
+
+void
+WifiMacQueueManyReceiversTest::Enqueue(Mac48Address receiver, uint8_t tid, uint32_t size)
+{
+    WifiMacHeader header;
+    header.SetType(WIFI_MAC_QOSDATA);
+    header.SetAddr1(receiver);
+    header.SetQosTid(tid);
+    NS_TEST_EXPECT_MSG_EQ(m_queue->Enqueue(Create<WifiMpdu>(Create<Packet>(size), header)),
+                          true,
+                          "MPDU not enqueued");
+}
+
+void
+WifiMacQueueManyReceiversTest::CheckQueues(uint32_t nPackets)
+{
+    for (uint32_t i = 0; i < N_RECEIVERS; i++)
+    {
+        for (uint8_t tid = 0; tid < N_TIDS; tid++)
+        {
+            WifiContainerQueueId queueId{WIFI_QOSDATA_UNICAST_QUEUE, m_receivers[i], tid};
+            auto mpdu = m_queue->PeekByQueueId(queueId);
+            uint32_t nBytes = 0;
+            while (mpdu != nullptr)
+            {
+                nBytes += mpdu->GetSize();
+                mpdu = m_queue->PeekByQueueId(queueId, mpdu);
+            }
+            NS_TEST_EXPECT_MSG_EQ(m_queue->GetNPackets(queueId),
+                                  nPackets,
+                                  "Unexpected number of packets for receiver "
+                                      << m_receivers[i] << " TID " << +tid);
+            NS_TEST_EXPECT_MSG_EQ(m_queue->GetNBytes(queueId),
+                                  nBytes,
+                                  "Unexpected number of bytes for receiver "
+                                      << m_receivers[i] << " TID " << +tid);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_queue->GetNPackets(),
+                          N_RECEIVERS * N_TIDS * nPackets,
+                          "Unexpected total number of packets");
+}
+
+void
+WifiMacQueueManyReceiversTest::DoRun()
+{
+    m_queue = CreateObject<WifiMacQueue>(AC_BE);
+    m_queue->SetMaxSize(QueueSize("10000p"));
+    m_queue->SetMaxDelay(MilliSeconds(10));
+    auto scheduler = CreateObject<FcfsWifiQueueScheduler>();
+    scheduler->m_perAcInfo[AC_BE].wifiMacQueue = m_queue;
+    m_queue->SetScheduler(scheduler);
+
+    for (uint32_t i = 0; i < N_RECEIVERS; i++)
+    {
+        m_receivers.push_back(Mac48Address::Allocate());
+    }
+
+    // enqueue three MPDUs of different sizes per (receiver, TID) pair
+    for (uint32_t n = 0; n < 3; n++)
+    {
+        for (uint32_t i = 0; i < N_RECEIVERS; i++)
+        {
+            for (uint8_t tid = 0; tid < N_TIDS; tid++)
+            {
+                Enqueue(m_receivers[i], tid, 100 + 10 * n + i + tid);
+            }
+        }
+    }
+    CheckQueues(3);
+
+    // remove the MPDU at the head of every container queue
+    for (uint32_t i = 0; i < N_RECEIVERS; i++)
+    {
+        for (uint8_t tid = 0; tid < N_TIDS; tid++)
+        {
+            m_queue->Remove(m_queue->PeekByTidAndAddress(tid, m_receivers[i]));
+        }
+    }
+    CheckQueues(2);
+
+    // let the lifetime of all the MPDUs expire
+    Simulator::Schedule(MilliSeconds(20), [this]() {
+        m_queue->WipeAllExpiredMpdus();
+        CheckQueues(0);
+        NS_TEST_EXPECT_MSG_EQ(m_queue->IsEmpty(), true, "Queue should be empty");
+
+        // the container queues can be used again
+        for (uint32_t i = 0; i < N_RECEIVERS; i++)
+        {
+            for (uint8_t tid = 0; tid < N_TIDS; tid++)
+            {
+                Enqueue(m_receivers[i], tid, 500);
+            }
+        }
+        CheckQueues(1);
+    });
+    Simulator::Run();
+
+    scheduler->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -137,6 +288,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
     : TestSuite("wifi-mac-queue", UNIT)
 {
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::QUICK);
+    AddTestCase(new WifiMacQueueManyReceiversTest, TestCase::QUICK);
 }
 
 static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
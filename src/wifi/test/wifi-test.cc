@@ -23,6 +23,7 @@
 
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/error-model.h"
@@ -41,6 +42,7 @@
 #include "ns3/rng-seed-manager.h"
 #include "ns3/socket.h"
 #include "ns3/spectrum-wifi-helper.h"
+#include "ns3/sta-wifi-mac.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/vht-phy.h"
@@ -49,6 +51,7 @@
 #include "ns3/wifi-default-assoc-manager.h"
 #include "ns3/wifi-default-protection-manager.h"
 #include "ns3/wifi-net-device.h"
+#include "ns3/wifi-open-hash-map.h"
 #include "ns3/wifi-ppdu.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/wifi-spectrum-signal-parameters.h"
@@ -3603,6 +3606,401 @@ HeRuMcsDataRateTestCase::DoRun()
                           "Data rate verification for RUs above 52-tone RU (included) failed");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that WifiOpenHashMap, used by WifiRemoteStationManager to look up
+ * the remote stations, behaves like a std::map while growing.
+ */
+class WifiOpenHashMapTest : public TestCase
+{
+  public:
+    WifiOpenHashMapTest();
+
+  private:
+    void DoRun() override;
+};
+
+WifiOpenHashMapTest::WifiOpenHashMapTest()
+    : TestCase("Check the open addressing hash map used for station lookup")
+{
+}
+
+void
+WifiOpenHashMapTest::DoRun()
+{
+    WifiOpenHashMap<Mac48Address, uint32_t, WifiMac48AddressKey> map;
+    std::map<Mac48Address, uint32_t> reference;
+    uint8_t buffer[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        // addresses differing in the most and in the least significant bytes
+        buffer[0] = static_cast<uint8_t>(i % 7);
+        buffer[4] = static_cast<uint8_t>(i >> 8);
+        buffer[5] = static_cast<uint8_t>(i & 0xff);
+        Mac48Address address;
+        address.CopyFrom(buffer);
+        NS_TEST_EXPECT_MSG_EQ((map.Find(address) == nullptr),
+                              (reference.find(address) == reference.end()),
+                              "Unexpected result when looking up " << address);
+        map.Insert(address, i);
+        reference[address] = i;
+    }
+    NS_TEST_EXPECT_MSG_EQ(map.GetSize(), reference.size(), "Unexpected number of entries");
+
+    for (const auto& [address, value] : reference)
+    {
+        auto valuePtr = map.Find(address);
+        NS_TEST_ASSERT_MSG_NE(valuePtr, nullptr, "Address " << address << " not found");
+        NS_TEST_EXPECT_MSG_EQ(*valuePtr, value, "Unexpected value for address " << address);
+    }
+    NS_TEST_EXPECT_MSG_EQ((map.Find(Mac48Address::GetBroadcast()) == nullptr),
+                          true,
+                          "Broadcast address should not be found");
+
+    // replace the value associated with an existing key
+    map.Insert(reference.begin()->first, 5000);
+    NS_TEST_EXPECT_MSG_EQ(*map.Find(reference.begin()->first), 5000, "Value not replaced");
+    NS_TEST_EXPECT_MSG_EQ(map.GetSize(), reference.size(), "Unexpected number of entries");
+
+    std::size_t count = 0;
+    map.ForEach([&count](const Mac48Address&, uint32_t) { count++; });
+    NS_TEST_EXPECT_MSG_EQ(count, reference.size(), "Unexpected number of visited entries");
+
+    map.Clear();
+    NS_TEST_EXPECT_MSG_EQ(map.IsEmpty(), true, "Map should be empty after being cleared");
+    NS_TEST_EXPECT_MSG_EQ((map.Find(reference.begin()->first) == nullptr),
+                          true,
+                          "No address should be found after clearing the map");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the batched update of the Minstrel-HT statistics produces the
+ * same results as the reference implementation.
+ *
+ * An AP sends downlink traffic to a station moving away from it, so that the
+ * statistics of many rates are updated and Minstrel-HT changes the selected rate
+ * multiple times. The simulation is run twice, with the BatchedStatsUpdate
+ * attribute of MinstrelHtWifiManager disabled and enabled, and the sequences of
+ * TXVECTORs used to transmit data frames are compared.
+ */
+class MinstrelHtBatchedStatsTest : public TestCase
+{
+  public:
+    MinstrelHtBatchedStatsTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a simulation.
+     *
+     * \param batched whether the statistics are updated in batch
+     * \return a description of the TXVECTORs used to transmit data frames
+     */
+    std::vector<std::string> RunSimulation(bool batched);
+
+    /**
+     * Callback invoked when a PSDU is transmitted.
+     *
+     * \param psduMap the PSDU map
+     * \param txVector the TX vector
+     * \param txPowerW the TX power (W)
+     */
+    void Transmit(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW);
+
+    std::vector<std::string> m_txVectors; //!< the TXVECTORs used to transmit data frames
+};
+
+MinstrelHtBatchedStatsTest::MinstrelHtBatchedStatsTest()
+    : TestCase("Check that batched Minstrel-HT statistics updates match the reference")
+{
+}
+
+void
+MinstrelHtBatchedStatsTest::Transmit(WifiConstPsduMap psduMap,
+                                     WifiTxVector txVector,
+                                     double txPowerW)
+{
+    if (psduMap.begin()->second->GetHeader(0).IsQosData())
+    {
+        std::stringstream ss;
+        ss << Simulator::Now().GetNanoSeconds() << " " << txVector.GetMode() << " "
+           << +txVector.GetNss() << " " << txVector.GetChannelWidth() << " "
+           << txVector.GetGuardInterval();
+        m_txVectors.push_back(ss.str());
+    }
+}
+
+std::vector<std::string>
+MinstrelHtBatchedStatsTest::RunSimulation(bool batched)
+{
+    m_txVectors.clear();
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    int64_t streamNumber = 100;
+
+    NodeContainer wifiApNode(1);
+    NodeContainer wifiStaNode(1);
+
+    YansWifiPhyHelper phy;
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{0, 40, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager",
+                                 "BatchedStatsUpdate",
+                                 BooleanValue(batched));
+
+    WifiMacHelper mac;
+    mac.SetType("ns3::ApWifiMac");
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, wifiApNode);
+    mac.SetType("ns3::StaWifiMac");
+    NetDeviceContainer staDevice = wifi.Install(phy, mac, wifiStaNode);
+
+    wifi.AssignStreams(apDevice, streamNumber);
+    wifi.AssignStreams(staDevice, streamNumber);
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(wifiApNode);
+    mobility.SetMobilityModel("ns3::WaypointMobilityModel");
+    mobility.Install(wifiStaNode);
+    auto waypoints = wifiStaNode.Get(0)->GetObject<WaypointMobilityModel>();
+    waypoints->AddWaypoint(Waypoint(Seconds(0), Vector(5.0, 0.0, 0.0)));
+    waypoints->AddWaypoint(Waypoint(Seconds(3), Vector(100.0, 0.0, 0.0)));
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(wifiApNode);
+    packetSocket.Install(wifiStaNode);
+
+    PacketSocketAddress socket;
+    socket.SetSingleDevice(apDevice.Get(0)->GetIfIndex());
+    socket.SetPhysicalAddress(staDevice.Get(0)->GetAddress());
+    socket.SetProtocol(1);
+
+    auto client = CreateObject<PacketSocketClient>();
+    client->SetAttribute("PacketSize", UintegerValue(1000));
+    client->SetAttribute("MaxPackets", UintegerValue(0));
+    client->SetAttribute("Interval", TimeValue(MicroSeconds(500)));
+    client->SetRemote(socket);
+    wifiApNode.Get(0)->AddApplication(client);
+    client->SetStartTime(Seconds(0.5));
+
+    auto server = CreateObject<PacketSocketServer>();
+    server->SetLocal(socket);
+    wifiStaNode.Get(0)->AddApplication(server);
+
+    DynamicCast<WifiNetDevice>(apDevice.Get(0))
+        ->GetPhy()
+        ->TraceConnectWithoutContext(
+            "PhyTxPsduBegin",
+            MakeCallback(&MinstrelHtBatchedStatsTest::Transmit, this));
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return m_txVectors;
+}
+
+void
+MinstrelHtBatchedStatsTest::DoRun()
+{
+    auto reference = RunSimulation(false);
+    auto batched = RunSimulation(true);
+
+    std::set<std::string> modes;
+    for (const auto& txVector : reference)
+    {
+        modes.insert(txVector.substr(txVector.find(' ') + 1));
+    }
+    NS_TEST_EXPECT_MSG_GT(modes.size(), 1, "Expected Minstrel-HT to select different rates");
+
+    NS_TEST_ASSERT_MSG_EQ(batched.size(),
+                          reference.size(),
+                          "Unexpected number of data frames transmitted");
+    for (std::size_t i = 0; i < reference.size(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(batched[i],
+                              reference[i],
+                              "Unexpected TXVECTOR for data frame #" << i);
+    }
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check the quiescent beacon mode of the AP.
+ *
+ * An AP with QuiescentBeacons enabled serves two stations. Once both stations
+ * are associated, the AP stops transmitting Beacon frames and the stations stay
+ * associated. Then, one station switches channel (to the same channel), hence
+ * it disassociates and starts scanning: the AP resumes beaconing at the next
+ * TBTT, so that the station can associate again, and then becomes quiescent
+ * again. The number of Beacon frames transmitted plus the number of Beacon frames
+ * coalesced must equal the number of TBTTs elapsed.
+ */
+class QuiescentBeaconTest : public TestCase
+{
+  public:
+    QuiescentBeaconTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Callback invoked when a PSDU is transmitted by the AP.
+     *
+     * \param psduMap the PSDU map
+     * \param txVector the TX vector
+     * \param txPowerW the TX power (W)
+     */
+    void Transmit(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW);
+
+    /**
+     * Check that the AP is quiescent and that both stations are associated.
+     *
+     * \param apMac the AP MAC
+     * \param staMacs the MACs of the stations
+     */
+    void CheckQuiescent(Ptr<ApWifiMac> apMac, std::vector<Ptr<StaWifiMac>> staMacs);
+
+    /**
+     * Callback invoked when a station associates with the AP.
+     *
+     * \param bssid the BSSID
+     */
+    void Associated(Mac48Address bssid);
+
+    uint32_t m_nBeacons{0};      //!< number of Beacon frames transmitted by the AP
+    uint32_t m_nAssociations{0}; //!< number of associations
+};
+
+QuiescentBeaconTest::QuiescentBeaconTest()
+    : TestCase("Check that beacons are coalesced when no station is scanning")
+{
+}
+
+void
+QuiescentBeaconTest::Transmit(WifiConstPsduMap psduMap, WifiTxVector txVector, double txPowerW)
+{
+    if (psduMap.begin()->second->GetHeader(0).IsBeacon())
+    {
+        m_nBeacons++;
+    }
+}
+
+void
+QuiescentBeaconTest::Associated(Mac48Address bssid)
+{
+    m_nAssociations++;
+}
+
+void
+QuiescentBeaconTest::CheckQuiescent(Ptr<ApWifiMac> apMac, std::vector<Ptr<StaWifiMac>> staMacs)
+{
+    NS_TEST_EXPECT_MSG_NE(ApWifiMac::GetQuiescentAp(apMac->GetWifiPhy()->GetChannel(),
+                                                    apMac->GetAddress()),
+                          nullptr,
+                          "Beacons of the AP should be quiescent at " << Simulator::Now());
+    for (const auto& staMac : staMacs)
+    {
+        NS_TEST_EXPECT_MSG_EQ(staMac->IsAssociated(),
+                              true,
+                              "Station should be associated at " << Simulator::Now());
+    }
+}
+
+void
+QuiescentBeaconTest::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    int64_t streamNumber = 100;
+
+    // a station that is never initialized does not prevent beacons from being quiescent
+    Ptr<StaWifiMac> idleStaMac = CreateObject<StaWifiMac>();
+
+    NodeContainer wifiApNode(1);
+    NodeContainer wifiStaNodes(2);
+
+    YansWifiPhyHelper phy;
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    phy.SetChannel(channel.Create());
+    phy.Set("ChannelSettings", StringValue("{36, 20, BAND_5GHZ, 0}"));
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+
+    WifiMacHelper mac;
+    mac.SetType("ns3::ApWifiMac",
+                "EnableBeaconJitter",
+                BooleanValue(false),
+                "QuiescentBeacons",
+                BooleanValue(true));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, wifiApNode);
+    mac.SetType("ns3::StaWifiMac");
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, wifiStaNodes);
+
+    wifi.AssignStreams(apDevice, streamNumber);
+    wifi.AssignStreams(staDevices, streamNumber);
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(wifiApNode);
+    mobility.Install(wifiStaNodes);
+
+    auto apDev = DynamicCast<WifiNetDevice>(apDevice.Get(0));
+    auto apMac = DynamicCast<ApWifiMac>(apDev->GetMac());
+    std::vector<Ptr<StaWifiMac>> staMacs;
+    for (uint32_t i = 0; i < staDevices.GetN(); i++)
+    {
+        auto staMac =
+            DynamicCast<StaWifiMac>(DynamicCast<WifiNetDevice>(staDevices.Get(i))->GetMac());
+        staMac->TraceConnectWithoutContext("Assoc",
+                                           MakeCallback(&QuiescentBeaconTest::Associated, this));
+        staMacs.push_back(staMac);
+    }
+    apDev->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxPsduBegin",
+        MakeCallback(&QuiescentBeaconTest::Transmit, this));
+
+    Simulator::Schedule(Seconds(2), &QuiescentBeaconTest::CheckQuiescent, this, apMac, staMacs);
+    // switching channel causes the first station to disassociate and scan again
+    Simulator::Schedule(Seconds(5), [=]() {
+        DynamicCast<WifiNetDevice>(staDevices.Get(0))
+            ->GetPhy()
+            ->SetAttribute("ChannelSettings", StringValue("{36, 20, BAND_5GHZ, 0}"));
+    });
+    Simulator::Schedule(Seconds(9), &QuiescentBeaconTest::CheckQuiescent, this, apMac, staMacs);
+
+    Time stop = Seconds(10);
+    Simulator::Stop(stop);
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_nAssociations, 3, "Expected the first station to associate twice");
+    NS_TEST_EXPECT_MSG_LT(m_nBeacons, 20, "Too many Beacon frames transmitted");
+    uint64_t nTbtts = stop.GetTimeStep() / apMac->GetBeaconInterval().GetTimeStep() + 1;
+    NS_TEST_EXPECT_MSG_EQ(m_nBeacons + apMac->GetNCoalescedBeacons(),
+                          nTbtts,
+                          "Transmitted and coalesced Beacon frames do not match the elapsed TBTTs");
+    NS_TEST_EXPECT_MSG_GT(apMac->GetCoalescedBeaconAirtime(),
+                          Time(0),
+                          "Expected non-zero airtime for the coalesced Beacon frames");
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3635,6 +4033,9 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new IdealRateManagerChannelWidthTest, TestCase::QUICK);
     AddTestCase(new IdealRateManagerMimoTest, TestCase::QUICK);
     AddTestCase(new HeRuMcsDataRateTestCase, TestCase::QUICK);
+    AddTestCase(new WifiOpenHashMapTest, TestCase::QUICK);
+    AddTestCase(new MinstrelHtBatchedStatsTest, TestCase::QUICK);
+    AddTestCase(new QuiescentBeaconTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite